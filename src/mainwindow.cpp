@@ -24,20 +24,27 @@
 #include "gamslibprocess.h"
 #include "mii/filterdialog.h"
 #include "mii/modelinspector.h"
+#include "mii/search.h"
 #include "mii/searchresultmodel.h"
 #include "mii/common.h"
 
+#include <QActionGroup>
 #include <QDir>
+#include <QFile>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QRegularExpression>
 #include <QScrollBar>
 #include <QStandardPaths>
 
 #include <QDebug>
 
 using namespace gams::studio;
+using gams::studio::mii::CoefficientRangeSearch;
+using gams::studio::mii::EvaluationPointRegistry;
 using gams::studio::mii::FilterDialog;
 using gams::studio::mii::ModelInspector;
+using gams::studio::mii::RegExSearch;
 using gams::studio::mii::SearchResultModel;
 using gams::studio::mii::ViewHelper;
 using gams::studio::mii::CmdParser;
@@ -49,8 +56,11 @@ MainWindow::MainWindow(QWidget *parent)
     , mProcess(new GAMSProcess(this))
     , mFilterDialog(new FilterDialog(this))
     , mScrWatcher(this)
+    , mSearchTimer(this)
 {
     ui->setupUi(this);
+    mSearchTimer.setSingleShot(true);
+    mSearchTimer.setInterval(150);
     ui->modelInspector->setWorkspace(workspace());
     ui->modelInspector->setSystemDirectory(CommonPaths::systemDir());
     ui->paramsEdit->setText(QString("MIIMode=singleMI scrdir=%1/scratch").arg(workspace()));
@@ -62,15 +72,23 @@ MainWindow::MainWindow(QWidget *parent)
     createProjectDirectory();
     ui->actionZoom_In->setShortcut(QKeySequence::ZoomIn);
     ui->actionZoom_Out->setShortcut(QKeySequence::ZoomOut);
+    auto pointGroup = new QActionGroup(this);
+    pointGroup->addAction(ui->actionInput_Point);
+    pointGroup->addAction(ui->actionSolution_Point);
+    pointGroup->addAction(ui->actionBounds_Midpoint);
+    pointGroup->addAction(ui->actionUser_Point);
+    mPointAction = ui->actionSolution_Point;
 }
 
 MainWindow::~MainWindow()
 {
+    cancelSearch();
     delete ui;
 }
 
 void MainWindow::closeEvent(QCloseEvent *event)
 {
+    cancelSearch();
     ui->modelInspector->cancelRun();
     QMainWindow::closeEvent(event);
 }
@@ -80,6 +98,15 @@ void MainWindow::appendLogMessage(const QString &message)
     ui->logEdit->appendPlainText(message.trimmed());
 }
 
+void MainWindow::stopRun()
+{
+    if (mProcess->process()->state() != QProcess::NotRunning) {
+        mProcess->stop();
+        return;
+    }
+    ui->modelInspector->cancelRun();
+}
+
 void MainWindow::on_actionOpen_triggered()
 {
     QString workingDir = workspace();
@@ -120,6 +147,9 @@ void MainWindow::on_actionRun_triggered()
     mScrFilesUpdated = false;
     ui->modelInspector->setModelFilePath(ui->modelEdit->text());
     ui->modelInspector->setShowOutput(ui->actionShow_Output->isChecked());
+    // a new Jacobian is evaluated at the solution point
+    ui->actionSolution_Point->setChecked(true);
+    mPointAction = ui->actionSolution_Point;
     if (ui->modelEdit->text().endsWith(".dat")) {
         mLoadScrFiles = true;
         QFileInfo fi(ui->modelEdit->text());
@@ -174,9 +204,82 @@ void MainWindow::on_action_Search_triggered()
 
 void MainWindow::searchHeaders()
 {
+    mSearchTimer.stop();
+    cancelSearch();
+    auto searchModel = static_cast<SearchResultModel*>(ui->searchResultView->model());
+    if (ui->searchCoefficientBox->isChecked()) {
+        mCoefficientSearch = ui->modelInspector->createCoefficientSearch(ui->searchEdit->text(), this);
+        if (!mCoefficientSearch) {
+            searchModel->updateData(ui->modelInspector->searchResult());
+            return;
+        }
+        searchModel->updateData(mCoefficientSearch->result());
+        connect(mCoefficientSearch, &CoefficientRangeSearch::finished,
+                this, &MainWindow::coefficientSearchFinished);
+        ui->cancelSearchButton->setEnabled(true);
+        mCoefficientSearch->start();
+        return;
+    }
+    if (ui->searchRegexBox->isChecked()) {
+        if (!QRegularExpression(ui->searchEdit->text()).isValid())
+            return;
+        mRegExSearch = ui->modelInspector->createRegExSearch(ui->searchEdit->text(), this);
+    }
+    if (mRegExSearch) {
+        searchModel->updateData(mRegExSearch->result());
+        connect(mRegExSearch, &RegExSearch::entriesFound,
+                searchModel, &SearchResultModel::appendEntries);
+        connect(mRegExSearch, &RegExSearch::finished,
+                this, &MainWindow::regExSearchFinished);
+        ui->cancelSearchButton->setEnabled(true);
+        mRegExSearch->start();
+        return;
+    }
     const auto& result = ui->modelInspector->searchHeaders(ui->searchEdit->text(),
                                                            ui->searchRegexBox->isChecked());
+    searchModel->updateData(result);
+    ui->searchResultView->resizeColumnsToContents();
+    ui->searchResultView->resizeRowsToContents();
+}
+
+void MainWindow::cancelSearch()
+{
+    if (!mRegExSearch && !mCoefficientSearch)
+        return;
+    delete mRegExSearch;
+    mRegExSearch = nullptr;
+    delete mCoefficientSearch;
+    mCoefficientSearch = nullptr;
+    ui->cancelSearchButton->setEnabled(false);
+    ui->searchResultView->resizeColumnsToContents();
+    ui->searchResultView->resizeRowsToContents();
+}
+
+void MainWindow::regExSearchFinished()
+{
+    if (!mRegExSearch)
+        return;
+    static_cast<SearchResultModel*>(ui->searchResultView->model())->updateData(mRegExSearch->result());
+    mRegExSearch->deleteLater();
+    mRegExSearch = nullptr;
+    ui->cancelSearchButton->setEnabled(false);
+    ui->searchResultView->resizeColumnsToContents();
+    ui->searchResultView->resizeRowsToContents();
+}
+
+void MainWindow::coefficientSearchFinished()
+{
+    if (!mCoefficientSearch)
+        return;
+    const auto& result = mCoefficientSearch->result();
     static_cast<SearchResultModel*>(ui->searchResultView->model())->updateData(result);
+    if (result.CoefficientCount > result.Entries.size()) {
+        ui->logEdit->appendPlainText(QString("Coefficient search: %1 coefficients out of range, showing the first %2.")
+                                     .arg(result.CoefficientCount).arg(result.Entries.size()));
+    }
+    mCoefficientSearch->deleteLater();
+    mCoefficientSearch = nullptr;
+    ui->cancelSearchButton->setEnabled(false);
     ui->searchResultView->resizeColumnsToContents();
     ui->searchResultView->resizeRowsToContents();
 }
@@ -208,11 +311,58 @@ void MainWindow::showAbsoluteValues()
 
 void MainWindow::on_actionShow_Output_triggered()
 {
+    cancelSearch();
     ui->modelInspector->setShowOutput(ui->actionShow_Output->isChecked());
     ui->modelInspector->setShowAbsoluteValuesGlobal(ui->actionShow_Absolute->isChecked());
     ui->modelInspector->reloadModelInstance();
 }
 
+void MainWindow::on_actionInput_Point_triggered()
+{
+    cancelSearch();
+    mPointAction = ui->actionInput_Point;
+    ui->modelInspector->setEvaluationPoint(EvaluationPointRegistry::InputPoint);
+}
+
+void MainWindow::on_actionSolution_Point_triggered()
+{
+    cancelSearch();
+    mPointAction = ui->actionSolution_Point;
+    ui->modelInspector->setEvaluationPoint(EvaluationPointRegistry::SolutionPoint);
+}
+
+void MainWindow::on_actionBounds_Midpoint_triggered()
+{
+    cancelSearch();
+    mPointAction = ui->actionBounds_Midpoint;
+    ui->modelInspector->setEvaluationPoint(EvaluationPointRegistry::BoundsMidpoint);
+}
+
+void MainWindow::on_actionUser_Point_triggered()
+{
+    cancelSearch();
+    auto fileName = QFileDialog::getOpenFileName(this,
+                                                 tr("Open Evaluation Point"),
+                                                 workspace(),
+                                                 tr("Point coordinates (*.csv *.txt)"));
+    if (fileName.isEmpty()) {
+        mPointAction->setChecked(true);
+        return;
+    }
+    QFile file(fileName);
+    bool ok = file.open(QIODevice::ReadOnly | QIODevice::Text);
+    QVector<double> point;
+    if (ok)
+        point = EvaluationPointRegistry::parsePoint(QString::fromUtf8(file.readAll()), &ok);
+    if (!ok) {
+        appendLogMessage("The evaluation point could not be read from " + fileName);
+        mPointAction->setChecked(true);
+        return;
+    }
+    mPointAction = ui->actionUser_Point;
+    ui->modelInspector->setEvaluationPoint(EvaluationPointRegistry::UserPoint, point);
+}
+
 void MainWindow::on_actionZoom_In_triggered()
 {
     ui->logEdit->zoomIn(2);
@@ -253,6 +403,7 @@ void MainWindow::on_actionAbout_Qt_triggered()
 
 void MainWindow::loadModelInstance(int exitCode, QProcess::ExitStatus exitStatus)
 {
+    cancelSearch();
     auto miiMode = CmdParser::miiMode(ui->paramsEdit->text());
     ui->modelInspector->setMiiMode(miiMode);
     switch (miiMode) {
@@ -293,11 +444,13 @@ void MainWindow::searchResultSelectionChanged(const QModelIndex &index)
 
 void MainWindow::updateModelInstance()
 {
+    cancelSearch();
     static_cast<SearchResultModel*>(ui->searchResultView->model())->updateData({});
 }
 
 void MainWindow::viewChanged(int viewType)
 {
+    cancelSearch();
     if (viewType == (int)ViewHelper::ViewDataType::Unknown) {
         ui->action_Search->setEnabled(false);
         ui->searchEdit->setEnabled(false);
@@ -313,6 +466,8 @@ void MainWindow::viewChanged(int viewType)
     static_cast<SearchResultModel*>(ui->searchResultView->model())->updateData(searchResult);
     ui->searchEdit->setText(searchResult.Term);
     ui->searchRegexBox->setChecked(searchResult.IsRegEx);
+    ui->searchCoefficientBox->setChecked(searchResult.IsCoefficientRange);
+    ui->searchRegexBox->setEnabled(!searchResult.IsCoefficientRange);
     ui->searchResultView->resizeColumnsToContents();
     ui->searchResultView->resizeRowsToContents();
 }
@@ -341,6 +496,24 @@ void MainWindow::setupConnections()
             this, &MainWindow::appendLogMessage);
     connect(ui->searchEdit, &QLineEdit::returnPressed,
             this, &MainWindow::searchHeaders);
+    connect(ui->searchEdit, &QLineEdit::textEdited,
+            this, [this]{
+        if (!ui->searchCoefficientBox->isChecked())
+            mSearchTimer.start();
+    });
+    connect(ui->searchRegexBox, &QCheckBox::clicked,
+            &mSearchTimer, QOverload<>::of(&QTimer::start));
+    connect(ui->searchCoefficientBox, &QCheckBox::clicked,
+            this, [this](bool checked){
+        ui->searchRegexBox->setEnabled(!checked);
+        mSearchTimer.start();
+    });
+    connect(&mSearchTimer, &QTimer::timeout,
+            this, &MainWindow::searchHeaders);
+    connect(ui->cancelSearchButton, &QPushButton::clicked,
+            this, &MainWindow::cancelSearch);
+    connect(ui->stopButton, &QPushButton::clicked,
+            this, &MainWindow::stopRun);
     connect(ui->openButton, &QPushButton::clicked,
             this, &MainWindow::on_actionOpen_triggered);
     connect(ui->runButton, &QPushButton::clicked,
@@ -378,6 +551,13 @@ void MainWindow::setupConnections()
     });
     connect(ui->modelInspector, &ModelInspector::openFilterDialog,
             this, &MainWindow::on_actionFilters_triggered);
+    connect(ui->modelInspector, &ModelInspector::loadProgress,
+            this, [this](int finished, int total){
+        if (finished < total)
+            ui->statusBar->showMessage(QString("Loading views %1/%2").arg(finished).arg(total));
+        else
+            ui->statusBar->clearMessage();
+    });
 }
 
 void MainWindow::createProjectDirectory()
@@ -546,4 +726,5 @@ void MainWindow::setRunButtonState(bool enabled)
 {
     ui->runButton->setEnabled(enabled);
     ui->actionRun->setEnabled(enabled);
+    ui->stopButton->setEnabled(!enabled);
 }
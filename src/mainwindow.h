@@ -24,7 +24,9 @@
 #include <QMainWindow>
 #include <QProcess>
 #include <QSharedPointer>
+#include <QTimer>
 
+class QAction;
 class QLabel;
 
 namespace Ui {
@@ -37,7 +39,9 @@ class GAMSProcess;
 namespace gams {
 namespace studio {
 namespace mii {
+class CoefficientRangeSearch;
 class FilterDialog;
+class RegExSearch;
 }
 }
 }
@@ -59,11 +63,15 @@ private slots:
     // File
     void on_actionOpen_triggered();
     void on_actionRun_triggered();
+    void stopRun();
     void on_action_Quit_triggered();
 
     // Edit
     void on_action_Search_triggered();
     void searchHeaders();
+    void cancelSearch();
+    void regExSearchFinished();
+    void coefficientSearchFinished();
     void editMenuAboutToShow();
 
     // View
@@ -71,6 +79,10 @@ private slots:
     void on_actionShow_search_result_triggered();
     void showAbsoluteValues();
     void on_actionShow_Output_triggered();
+    void on_actionInput_Point_triggered();
+    void on_actionSolution_Point_triggered();
+    void on_actionBounds_Midpoint_triggered();
+    void on_actionUser_Point_triggered();
     void on_actionZoom_In_triggered();
     void on_actionZoom_Out_triggered();
     void on_actionZoom_Reset_triggered();
@@ -119,9 +131,18 @@ private:
     QSharedPointer<GAMSProcess> mProcess;
     gams::studio::mii::FilterDialog *mFilterDialog;
     QFileSystemWatcher mScrWatcher;
+    QTimer mSearchTimer;
+    gams::studio::mii::RegExSearch *mRegExSearch = nullptr;
+    gams::studio::mii::CoefficientRangeSearch *mCoefficientSearch = nullptr;
     const QString mScrUpdateWarning = "Warning: It looks like the scratch data has not been updated.";
     bool mScrFilesUpdated = false;
     bool mLoadScrFiles = false;
+
+    ///
+    /// \brief Evaluation point action checked again if a user point can't
+    ///        be loaded.
+    ///
+    QAction *mPointAction = nullptr;
 };
 
 #endif // MAINWINDOW_H
@@ -80,16 +80,25 @@ SOURCES += \
     mii/abstractviewframe.cpp \
     mii/bpidentifierfiltermodel.cpp \
     mii/bpviewframe.cpp \
+    mii/coefficientsearch.cpp \
     mii/common.cpp \
+    mii/componentanalysis.cpp \
+    mii/componentsviewframe.cpp \
     mii/comprehensivetablemodel.cpp \
     mii/datahandler.cpp \
     mii/datamatrix.cpp \
+    mii/datatilebuffer.cpp \
+    mii/diagnosticsviewframe.cpp \
     mii/dtoaformatproxymodel.cpp \
+    mii/dualresidual.cpp \
+    mii/evaluationpointregistry.cpp \
     mii/filterdialog.cpp \
     mii/filtertreeitem.cpp \
     mii/filtertreemodel.cpp \
     mii/hierarchicalheaderview.cpp \
+    mii/histogramviewframe.cpp \
     mii/labeltreeitem.cpp \
+    mii/loghistogram.cpp \
     mii/modelinstance.cpp    \
     mii/modelinspector.cpp \
     mii/modelinstancetableview.cpp \
@@ -98,11 +107,19 @@ SOURCES += \
     mii/postopttreemodel.cpp \
     mii/postopttreeview.cpp \
     mii/postopttreeviewframe.cpp \
+    mii/primalresidual.cpp \
+    mii/residualsviewframe.cpp \
+    mii/scalingadvisor.cpp \
+    mii/scalingadvisorviewframe.cpp \
     mii/search.cpp \
+    mii/searchindex.cpp \
     mii/searchresultmodel.cpp \
     mii/sectiontreeitem.cpp \
     mii/sectiontreemodel.cpp \
     mii/sectiontreeview.cpp \
+    mii/sparsitypyramid.cpp \
+    mii/sparsityviewframe.cpp \
+    mii/structuraldiagnostics.cpp \
     mii/symbol.cpp \
     mii/symbolfiltermodel.cpp \
     mii/symbolhierarchicalheaderview.cpp \
@@ -110,7 +127,9 @@ SOURCES += \
     mii/symbolviewframe.cpp \
     mii/valueformatproxymodel.cpp \
     mii/searchresultview.cpp \
-    mii/viewconfigurationprovider.cpp
+    mii/viewconfigurationprovider.cpp \
+    mii/viewloadscheduler.cpp \
+    mii/viewportprefetcher.cpp
 
 HEADERS += \
     exception.h \
@@ -125,29 +144,48 @@ HEADERS += \
     mii/abstractviewframe.h \
     mii/bpidentifierfiltermodel.h \
     mii/bpviewframe.h \
+    mii/coefficientsearch.h \
     mii/common.h \
+    mii/componentanalysis.h \
+    mii/componentsviewframe.h \
     mii/comprehensivetablemodel.h \
     mii/datahandler.h \
     mii/datamatrix.h \
+    mii/datatile.h \
+    mii/datatilebuffer.h \
+    mii/diagnosticsviewframe.h \
     mii/dtoaformatproxymodel.h \
+    mii/dualresidual.h \
+    mii/evaluationpointregistry.h \
     mii/filterdialog.h \
     mii/filtertreeitem.h \
     mii/filtertreemodel.h \
     mii/hierarchicalheaderview.h \
+    mii/histogramviewframe.h \
     mii/labeltreeitem.h \
+    mii/loghistogram.h \
     mii/modelinstance.h  \
     mii/modelinspector.h \
     mii/modelinstancetableview.h \
     mii/numerics.h \
+    mii/packedbitset.h \
     mii/postopttreeitem.h \
     mii/postopttreemodel.h \
     mii/postopttreeview.h \
     mii/postopttreeviewframe.h \
+    mii/primalresidual.h \
+    mii/residualsviewframe.h \
+    mii/scalingadvisor.h \
+    mii/scalingadvisorviewframe.h \
     mii/search.h \
+    mii/searchindex.h \
     mii/searchresultmodel.h \
     mii/sectiontreeitem.h \
     mii/sectiontreemodel.h \
     mii/sectiontreeview.h \
+    mii/sparsitypyramid.h \
+    mii/sparsityviewframe.h \
+    mii/structuraldiagnostics.h \
     mii/symbol.h \
     mii/symbolfiltermodel.h \
     mii/symbolhierarchicalheaderview.h \
@@ -155,7 +193,9 @@ HEADERS += \
     mii/symbolviewframe.h \
     mii/valueformatproxymodel.h \
     mii/searchresultview.h \
-    mii/viewconfigurationprovider.h
+    mii/viewconfigurationprovider.h \
+    mii/viewloadscheduler.h \
+    mii/viewportprefetcher.h
 
 FORMS += \
     mainwindow.ui \
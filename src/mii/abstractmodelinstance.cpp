@@ -19,7 +19,9 @@
  */
 #include "abstractmodelinstance.h"
 #include "datamatrix.h"
+#include "loghistogram.h"
 #include "postopttreeitem.h"
+#include "sparsitypyramid.h"
 
 #include <QDir>
 
@@ -92,6 +94,21 @@ void AbstractModelInstance::setUseOutput(bool useOutput)
     mUseOutput = useOutput;
 }
 
+const CancellationToken &AbstractModelInstance::cancellationToken() const
+{
+    return mCancellationToken;
+}
+
+void AbstractModelInstance::setCancellationToken(const CancellationToken &token)
+{
+    mCancellationToken = token;
+}
+
+bool AbstractModelInstance::isCancelled() const
+{
+    return mCancellationToken.isCancelled();
+}
+
 QString AbstractModelInstance::logMessages() {
     auto messages = mLogMessages.join("\n");
     mLogMessages.clear();
@@ -152,6 +169,11 @@ const QStringList &AbstractModelInstance::labels() const
     return mLabels;
 }
 
+const SearchIndex &AbstractModelInstance::searchIndex(Symbol::Type type) const
+{
+    return type == Symbol::Equation ? mEquationIndex : mVariableIndex;
+}
+
 int AbstractModelInstance::nlFlag(int row, int column, int viewId)
 {
     Q_UNUSED(row);
@@ -160,6 +182,108 @@ int AbstractModelInstance::nlFlag(int row, int column, int viewId)
     return 0;
 }
 
+DataTile AbstractModelInstance::fetchTile(int viewId,
+                                          const SectionRange &rows,
+                                          const SectionRange &columns)
+{
+    DataTile tile;
+    tile.ViewId = viewId;
+    tile.Revision = dataRevision();
+    tile.resize(rows, columns);
+    for (int r=0; r<tile.RowCount; ++r) {
+        for (int c=0; c<tile.ColumnCount; ++c) {
+            int i = r * tile.ColumnCount + c;
+            auto value = data(tile.FirstRow + r, tile.FirstColumn + c, viewId);
+            tile.Mask[i] = value.isValid();
+            tile.Values[i] = value.toDouble();
+            tile.NlFlags[i] = nlFlag(tile.FirstRow + r, tile.FirstColumn + c, viewId) != 0;
+        }
+    }
+    return tile;
+}
+
+int AbstractModelInstance::dataRevision() const
+{
+    return 0;
+}
+
+QSharedPointer<AbstractViewConfiguration> AbstractModelInstance::activateViewData(int viewId)
+{
+    Q_UNUSED(viewId);
+    return nullptr;
+}
+
+void AbstractModelInstance::setMemoryBudget(qint64 budget)
+{
+    Q_UNUSED(budget);
+}
+
+bool AbstractModelInstance::setEvaluationPoint(EvaluationPointRegistry::Type type,
+                                               const QVector<double> &point)
+{
+    Q_UNUSED(type);
+    Q_UNUSED(point);
+    return false;
+}
+
+EvaluationPointRegistry::Type AbstractModelInstance::evaluationPointType() const
+{
+    return EvaluationPointRegistry::SolutionPoint;
+}
+
+QSharedPointer<SparsityPyramid> AbstractModelInstance::sparsityPyramid()
+{
+    return QSharedPointer<SparsityPyramid>(new SparsityPyramid);
+}
+
+QSharedPointer<LogHistogram> AbstractModelInstance::logHistogram()
+{
+    return QSharedPointer<LogHistogram>();
+}
+
+QVector<CoefficientHit> AbstractModelInstance::findCoefficients(const CoefficientSearch::Range &range,
+                                                                const QBitArray &rows,
+                                                                const QBitArray &columns,
+                                                                int maxHits, qint64 *total,
+                                                                const CancellationToken &token)
+{
+    Q_UNUSED(range);
+    Q_UNUSED(rows);
+    Q_UNUSED(columns);
+    Q_UNUSED(maxHits);
+    Q_UNUSED(token);
+    if (total)
+        *total = 0;
+    return QVector<CoefficientHit>();
+}
+
+QSharedPointer<ScalingAdvice> AbstractModelInstance::scalingAdvice(ScalingAdvisor::Rounding rounding)
+{
+    Q_UNUSED(rounding);
+    return QSharedPointer<ScalingAdvice>(new ScalingAdvice);
+}
+
+QVector<StructuralFinding> AbstractModelInstance::structuralDiagnostics()
+{
+    return QVector<StructuralFinding>();
+}
+
+QSharedPointer<ComponentPartition> AbstractModelInstance::components(ComponentAnalysis::Level level)
+{
+    Q_UNUSED(level);
+    return QSharedPointer<ComponentPartition>(new ComponentPartition);
+}
+
+QVector<ResidualSummary> AbstractModelInstance::primalResiduals()
+{
+    return QVector<ResidualSummary>();
+}
+
+QVector<DualSummary> AbstractModelInstance::dualResiduals()
+{
+    return QVector<DualSummary>();
+}
+
 QVariant AbstractModelInstance::equationAttribute(const QString &header,
                                                   int index,
                                                   int entry,
@@ -189,6 +313,12 @@ AbstractModelInstance::State AbstractModelInstance::state() const
     return mState;
 }
 
+void AbstractModelInstance::buildSearchIndex()
+{
+    mEquationIndex.build(symbols(Symbol::Equation), equationRowCount());
+    mVariableIndex.build(symbols(Symbol::Variable), variableRowCount());
+}
+
 EmptyModelInstance::EmptyModelInstance(const QString &workspace,
                                        const QString &systemDir,
                                        const QString &scratchDir)
@@ -313,14 +443,14 @@ int EmptyModelInstance::columnEntryCount(int column, int view) const
     return 0;
 }
 
-const QList<int> &EmptyModelInstance::rowIndices(int viewId, int row) const
+QList<int> EmptyModelInstance::rowIndices(int viewId, int row) const
 {
     Q_UNUSED(row);
     Q_UNUSED(viewId);
     return mIndices;
 }
 
-const QList<int> &EmptyModelInstance::columnIndices(int viewId, int column) const
+QList<int> EmptyModelInstance::columnIndices(int viewId, int column) const
 {
     Q_UNUSED(column);
     Q_UNUSED(viewId);
@@ -346,9 +476,11 @@ QSharedPointer<AbstractViewConfiguration> EmptyModelInstance::clone(int view, in
     return nullptr;
 }
 
-void EmptyModelInstance::loadViewData(const QSharedPointer<AbstractViewConfiguration> &viewConfig)
+void EmptyModelInstance::loadViewData(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                                      const CancellationToken &token)
 {
     Q_UNUSED(viewConfig);
+    Q_UNUSED(token);
 }
 
 QVariant EmptyModelInstance::data(int row, int column, int view) const
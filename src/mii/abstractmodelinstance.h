@@ -20,19 +20,32 @@
 #ifndef ABSTRACTMODELINSTANCE_H
 #define ABSTRACTMODELINSTANCE_H
 
+#include "coefficientsearch.h"
+#include "componentanalysis.h"
+#include "datatile.h"
+#include "dualresidual.h"
+#include "evaluationpointregistry.h"
+#include "primalresidual.h"
+#include "scalingadvisor.h"
+#include "searchindex.h"
+#include "structuraldiagnostics.h"
 #include "symbol.h"
 
 #include <QString>
 #include <QStringList>
 #include <QSharedPointer>
 
+#include <atomic>
+
 namespace gams {
 namespace studio {
 namespace mii {
 
 class AbstractViewConfiguration;
 class DataMatrix;
+class LogHistogram;
 class PostoptTreeItem;
+class SparsityPyramid;
 
 class AbstractModelInstance
 {
@@ -71,6 +84,17 @@ public:
 
     void setUseOutput(bool useOutput);
 
+    /**
+     * @brief Token which interrupts the base data and view data loads.
+     * @remark A cancelled model instance keeps partial data and must be
+     *         replaced, e.g. by an EmptyModelInstance.
+     */
+    const CancellationToken& cancellationToken() const;
+
+    void setCancellationToken(const CancellationToken &token);
+
+    bool isCancelled() const;
+
     virtual double modelMinimum() const = 0;
     virtual double modelMaximum() const = 0;
 
@@ -151,6 +175,12 @@ public:
 
     const QStringList& labels() const;
 
+    /**
+     * @brief Substring index over all symbol names and labels of <c>type</c>.
+     * @remark The index is empty until the base data is loaded.
+     */
+    const SearchIndex& searchIndex(Symbol::Type type) const;
+
     virtual QString longestEquationText() const = 0;
 
     virtual QString longestVariableText() const = 0;
@@ -171,9 +201,9 @@ public:
 
     virtual int columnCount(int view) const = 0;
 
-    virtual const QList<int>& rowIndices(int viewId, int row) const = 0;
+    virtual QList<int> rowIndices(int viewId, int row) const = 0;
 
-    virtual const QList<int>& columnIndices(int viewId, int column) const = 0;
+    virtual QList<int> columnIndices(int viewId, int column) const = 0;
 
     virtual int columnEntryCount(int column, int view) const = 0;
 
@@ -183,12 +213,100 @@ public:
 
     virtual QSharedPointer<AbstractViewConfiguration> clone(int view, int newView) = 0;
 
-    virtual void loadViewData(const QSharedPointer<AbstractViewConfiguration>& viewConfig) = 0;
+    /**
+     * @brief Load the data of <c>viewConfig</c>.
+     * @param token Cancels this load only. The data of a cancelled load
+     *        is discarded.
+     */
+    virtual void loadViewData(const QSharedPointer<AbstractViewConfiguration>& viewConfig,
+                              const CancellationToken &token = CancellationToken()) = 0;
 
     virtual QVariant data(int row, int column, int view) const = 0;
 
     virtual int nlFlag(int row, int column, int viewId);
 
+    /**
+     * @brief Values, NL flags and display mask of a block of cells.
+     * @param viewId View ID of the data.
+     * @param rows First and last row of the block.
+     * @param columns First and last column of the block.
+     * @return Dense row-major tile of the requested block.
+     */
+    virtual DataTile fetchTile(int viewId, const SectionRange &rows, const SectionRange &columns);
+
+    /**
+     * @brief Revision of the view data, which changes whenever view data
+     *        is loaded, cloned or removed.
+     */
+    virtual int dataRevision() const;
+
+    /**
+     * @brief Multi-resolution sparsity pattern of the full Jacobian.
+     * @remark The pyramid is built on first use, which may take a while
+     *         for large models. Call it from a worker thread.
+     */
+    virtual QSharedPointer<SparsityPyramid> sparsityPyramid();
+
+    /**
+     * @brief log10 |a| histogram per equation x variable block.
+     * @remark The histogram is filled while loading the predefined scaling
+     *         view and is <c>nullptr</c> before.
+     */
+    virtual QSharedPointer<LogHistogram> logHistogram();
+
+    /**
+     * @brief Jacobian coefficients outside of <c>range</c>.
+     * @param rows Equation sections to search, or empty for all.
+     * @param columns Variable sections to search, or empty for all.
+     * @param maxHits Maximum number of returned hits.
+     * @param total Total number of hits in the searched sections, if not <c>nullptr</c>.
+     * @param token Stops the scan between row blocks if cancelled.
+     * @return Hits ordered by equation and variable section.
+     * @remark The scan runs on the full Jacobian. Call it from a worker thread.
+     */
+    virtual QVector<CoefficientHit> findCoefficients(const CoefficientSearch::Range &range,
+                                                     const QBitArray &rows,
+                                                     const QBitArray &columns,
+                                                     int maxHits, qint64 *total,
+                                                     const CancellationToken &token = CancellationToken());
+
+    /**
+     * @brief Suggested equation and variable scales of the Jacobian.
+     * @param rounding Rounding of the suggested scales.
+     * @remark The analysis runs on the full Jacobian. Call it from a worker thread.
+     */
+    virtual QSharedPointer<ScalingAdvice> scalingAdvice(ScalingAdvisor::Rounding rounding);
+
+    /**
+     * @brief Structural findings of the Jacobian, see StructuralDiagnostics.
+     * @remark The checks run on the full Jacobian. Call it from a worker thread.
+     */
+    virtual QVector<StructuralFinding> structuralDiagnostics();
+
+    /**
+     * @brief Independent blocks of the Jacobian, see ComponentAnalysis.
+     * @param level Components of sections or symbols.
+     * @remark The partition is built on first use. Call it from a worker thread.
+     */
+    virtual QSharedPointer<ComponentPartition> components(ComponentAnalysis::Level level);
+
+    /**
+     * @brief Residuals of the solution levels of the linear rows, one
+     *        summary per equation symbol, see PrimalResidual.
+     * @remark Only meaningful if the output (solution) data is used.
+     *         Call it from a worker thread.
+     */
+    virtual QVector<ResidualSummary> primalResiduals();
+
+    /**
+     * @brief Mismatches between the variable marginals and c - A^T y of
+     *        the equation marginals, one summary per variable symbol, see
+     *        DualResidual.
+     * @remark Only meaningful if the output (solution) data is used.
+     *         Call it from a worker thread.
+     */
+    virtual QVector<DualSummary> dualResiduals();
+
     virtual QSharedPointer<PostoptTreeItem> dataTree(int view) const = 0;
 
     virtual QVariant plainHeaderData(Qt::Orientation orientation,
@@ -199,6 +317,11 @@ public:
                                 Qt::Orientation orientation,
                                 int view, int role) const = 0;
 
+    /**
+     * @brief New Jacobian of the input data, owned by the caller. The NL
+     *        values of other evaluation points aren't part of it, see
+     *        setEvaluationPoint().
+     */
     virtual DataMatrix* jacobianData() = 0;
 
     virtual QVariant equationAttribute(const QString &header, int index, int entry, bool abs) const;
@@ -211,8 +334,40 @@ public:
 
     virtual void removeViewData() = 0;
 
+    /**
+     * @brief Mark <c>viewId</c> as the visible view.
+     * @return The configuration of <c>viewId</c> if its data was evicted
+     *         meanwhile, otherwise <c>nullptr</c>. The caller reloads it,
+     *         e.g. with the ViewLoadScheduler.
+     */
+    virtual QSharedPointer<AbstractViewConfiguration> activateViewData(int viewId);
+
+    /**
+     * @brief Memory budget of the view data in bytes, see
+     *        DataHandler::setMemoryBudget().
+     */
+    virtual void setMemoryBudget(qint64 budget);
+
+    /**
+     * @brief Evaluate the NL Jacobian entries at a point of <c>type</c>,
+     *        which becomes the output data of all views.
+     * @param point Coordinates of an EvaluationPointRegistry::UserPoint,
+     *        one per variable column.
+     * @return <c>false</c> if the point could not be evaluated.
+     * @remark Evaluated points are cached. Call it from a worker thread
+     *         and reload the views afterwards. Data that loads meanwhile
+     *         keeps the previous point.
+     */
+    virtual bool setEvaluationPoint(EvaluationPointRegistry::Type type,
+                                    const QVector<double> &point = QVector<double>());
+
+    virtual EvaluationPointRegistry::Type evaluationPointType() const;
+
     State state() const;
 
+protected:
+    void buildSearchIndex();
+
 protected:
     State mState = Valid;
 
@@ -220,13 +375,18 @@ protected:
     QString mWorkspace;
     QString mSystemDir;
 
-    bool mGlobalAbsolute = false;
+    std::atomic<bool> mGlobalAbsolute {false};
+
+    std::atomic<bool> mUseOutput {false};
 
-    bool mUseOutput = false;
+    CancellationToken mCancellationToken;
 
     QStringList mLogMessages;
 
     QStringList mLabels;
+
+    SearchIndex mEquationIndex;
+    SearchIndex mVariableIndex;
 };
 
 class EmptyModelInstance final : public AbstractModelInstance
@@ -278,9 +438,9 @@ public:
 
     int columnEntryCount(int column, int view) const override;
 
-    const QList<int>& rowIndices(int viewId, int row) const override;
+    QList<int> rowIndices(int viewId, int row) const override;
 
-    const QList<int>& columnIndices(int viewId, int column) const override;
+    QList<int> columnIndices(int viewId, int column) const override;
 
     int symbolRowCount(int view) const override;
 
@@ -288,7 +448,8 @@ public:
 
     QSharedPointer<AbstractViewConfiguration> clone(int view, int newView) override;
 
-    void loadViewData(const QSharedPointer<AbstractViewConfiguration>& viewConfig) override;
+    void loadViewData(const QSharedPointer<AbstractViewConfiguration>& viewConfig,
+                      const CancellationToken &token = CancellationToken()) override;
 
     QVariant data(int row, int column, int view) const override;
 
@@ -19,6 +19,7 @@
  */
 #include "abstracttableview.h"
 #include "common.h"
+#include "viewportprefetcher.h"
 
 #include <QEvent>
 #include <QWheelEvent>
@@ -29,6 +30,7 @@ namespace mii {
 
 AbstractTableView::AbstractTableView(QWidget *parent)
     : QTableView(parent)
+    , mPrefetcher(new ViewportPrefetcher(this))
 {
 
 }
@@ -48,6 +50,12 @@ bool AbstractTableView::eventFilter(QObject *watched, QEvent *event)
     return QTableView::eventFilter(watched, event);
 }
 
+void AbstractTableView::setModel(QAbstractItemModel *model)
+{
+    QTableView::setModel(model);
+    mPrefetcher->setModel(model);
+}
+
 void AbstractTableView::zoomIn(int range)
 {
     zoom(range);
@@ -26,6 +26,8 @@ namespace gams {
 namespace studio{
 namespace mii {
 
+class ViewportPrefetcher;
+
 class AbstractTableView : public QTableView
 {
     Q_OBJECT
@@ -35,6 +37,8 @@ public:
 
     bool eventFilter(QObject *watched, QEvent *event) override;
 
+    void setModel(QAbstractItemModel *model) override;
+
     void zoomIn(int range = 1);
     void zoomOut(int range = 1);
     void resetZoom();
@@ -44,6 +48,7 @@ private:
 
 private:
     QFont mBaseFont;
+    ViewportPrefetcher *mPrefetcher;
 };
 
 }
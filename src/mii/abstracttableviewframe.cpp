@@ -41,7 +41,11 @@ AbstractTableViewFrame::~AbstractTableViewFrame()
 void AbstractTableViewFrame::setSearchSelection(const SearchResult::SearchEntry &result)
 {
     if (result.Index < 0) return;
-    if (result.Orientation == Qt::Horizontal) {
+    if (result.isCoefficient()) {
+        auto index = ui->tableView->model()->index(result.Index, result.Column);
+        ui->tableView->setCurrentIndex(index);
+        ui->tableView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+    } else if (result.Orientation == Qt::Horizontal) {
         ui->tableView->selectColumn(result.Index);
     } else {
         ui->tableView->selectRow(result.Index);
@@ -60,6 +64,18 @@ SearchResult& AbstractTableViewFrame::search(const QString &term, bool isRegEx)
     return mViewConfig->searchResult();
 }
 
+RegExSearch *AbstractTableViewFrame::createRegExSearch(const QString &term, QObject *parent)
+{
+    if (term.isEmpty())
+        return nullptr;
+    return new RegExSearch(mViewConfig, ui->tableView->model(), term, parent);
+}
+
+CoefficientRangeSearch *AbstractTableViewFrame::createCoefficientSearch(const QString &term, QObject *parent)
+{
+    return new CoefficientRangeSearch(mViewConfig, ui->tableView->model(), term, parent);
+}
+
 void AbstractTableViewFrame::zoomIn()
 {
     ui->tableView->zoomIn(ViewHelper::ZoomFactor);
@@ -49,6 +49,10 @@ public:
 
     SearchResult& search(const QString &term, bool isRegEx) override;
 
+    RegExSearch* createRegExSearch(const QString &term, QObject *parent) override;
+
+    CoefficientRangeSearch* createCoefficientSearch(const QString &term, QObject *parent) override;
+
     void zoomIn() override;
 
     void zoomOut() override;
@@ -20,6 +20,8 @@
 #include "abstractviewframe.h"
 #include "abstractmodelinstance.h"
 
+#include <QLabel>
+
 namespace gams {
 namespace studio {
 namespace mii {
@@ -41,6 +43,24 @@ SearchResult &AbstractViewFrame::searchResult()
     return mViewConfig->searchResult();
 }
 
+RegExSearch *AbstractViewFrame::createRegExSearch(const QString &term, QObject *parent)
+{
+    Q_UNUSED(term);
+    Q_UNUSED(parent);
+    return nullptr;
+}
+
+CoefficientRangeSearch *AbstractViewFrame::createCoefficientSearch(const QString &term, QObject *parent)
+{
+    Q_UNUSED(parent);
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = false;
+    mViewConfig->searchResult().IsCoefficientRange = true;
+    mViewConfig->searchResult().CoefficientCount = 0;
+    mViewConfig->searchResult().Entries.clear();
+    return nullptr;
+}
+
 const QSharedPointer<AbstractViewConfiguration> &AbstractViewFrame::viewConfig() const
 {
     return mViewConfig;
@@ -51,11 +71,63 @@ void AbstractViewFrame::setViewConfig(const QSharedPointer<AbstractViewConfigura
     mViewConfig = viewConfig;
 }
 
+const QList<Symbol*>& AbstractViewFrame::selectedEquations() const
+{
+    return mSelectedEquations;
+}
+
+const QList<Symbol*>& AbstractViewFrame::selectedVariables() const
+{
+    return mSelectedVariables;
+}
+
+void AbstractViewFrame::setLoading(bool loading)
+{
+    if (!mLoadingLabel) {
+        if (!loading)
+            return;
+        mLoadingLabel = new QLabel("Loading...", this);
+        mLoadingLabel->setAlignment(Qt::AlignCenter);
+        mLoadingLabel->setAutoFillBackground(true);
+        mLoadingLabel->setGeometry(rect());
+    }
+    mLoadingLabel->setVisible(loading);
+    if (loading)
+        mLoadingLabel->raise();
+}
+
+bool AbstractViewFrame::isLoading() const
+{
+    return mLoadingLabel && !mLoadingLabel->isHidden();
+}
+
+void AbstractViewFrame::viewDataLoaded()
+{
+    setLoading(false);
+    if (!hasData())
+        setupView(mModelInstance);
+}
+
 void AbstractViewFrame::evaluateFilters()
 {
 
 }
 
+void AbstractViewFrame::resizeEvent(QResizeEvent *event)
+{
+    if (mLoadingLabel)
+        mLoadingLabel->setGeometry(rect());
+    QFrame::resizeEvent(event);
+}
+
+void AbstractViewFrame::requestViewData()
+{
+    setLoading(true);
+    QMetaObject::invokeMethod(this, [this]{
+        emit viewDataRequested();
+    }, Qt::QueuedConnection);
+}
+
 EmtpyViewFrame::EmtpyViewFrame(QWidget *parent, Qt::WindowFlags f)
     : AbstractViewFrame(parent, f)
 {
@@ -105,6 +177,13 @@ SearchResult &EmtpyViewFrame::search(const QString &term, bool isRegEx)
     return mSearchResult;
 }
 
+CoefficientRangeSearch *EmtpyViewFrame::createCoefficientSearch(const QString &term, QObject *parent)
+{
+    Q_UNUSED(term);
+    Q_UNUSED(parent);
+    return nullptr;
+}
+
 void EmtpyViewFrame::setSearchSelection(const SearchResult::SearchEntry &result)
 {
     Q_UNUSED(result);
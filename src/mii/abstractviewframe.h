@@ -25,11 +25,16 @@
 
 #include <QFrame>
 
+class QLabel;
+
 namespace gams {
 namespace studio {
 namespace mii {
 
 class AbstractModelInstance;
+class CoefficientRangeSearch;
+class RegExSearch;
+class Symbol;
 
 ///
 /// \brief The abstract view frame interface for all MII views.
@@ -61,6 +66,21 @@ public:
 
     SearchResult& searchResult();
 
+    ///
+    /// \brief Create a background regular expression search of the view
+    ///        headers, if supported by the view.
+    /// \return The search to be started by the caller, or <c>nullptr</c>.
+    ///
+    virtual RegExSearch* createRegExSearch(const QString &term, QObject *parent);
+
+    ///
+    /// \brief Create a background search of the view coefficients by
+    ///        magnitude, if supported by the view.
+    /// \param term Range like <c>"< 1e-9 > 1e9"</c>.
+    /// \return The search to be started by the caller, or <c>nullptr</c>.
+    ///
+    virtual CoefficientRangeSearch* createCoefficientSearch(const QString &term, QObject *parent);
+
     virtual void setSearchSelection(const SearchResult::SearchEntry &result) = 0;
 
     virtual void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) = 0;
@@ -71,12 +91,60 @@ public:
 
     virtual bool hasData() const = 0;
 
+    ///
+    /// \brief Show a placeholder on top of the view while its data is
+    ///        loaded in the background.
+    ///
+    void setLoading(bool loading);
+
+    bool isLoading() const;
+
+    ///
+    /// \brief Set the view up with the data loaded after
+    ///        viewDataRequested(), or the load was not needed.
+    ///
+    virtual void viewDataLoaded();
+
+    ///
+    /// \brief Equations of the last newSymbolViewRequested().
+    ///
+    const QList<Symbol*>& selectedEquations() const;
+
+    ///
+    /// \brief Variables of the last newSymbolViewRequested().
+    ///
+    const QList<Symbol*>& selectedVariables() const;
+
+signals:
+    void newSymbolViewRequested();
+
+    ///
+    /// \brief The data of viewConfig() is needed, which the receiver
+    ///        loads in the background before it calls viewDataLoaded().
+    ///
+    void viewDataRequested();
+
 public slots:
     virtual void evaluateFilters();
 
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+
+    ///
+    /// \brief Show the placeholder and post viewDataRequested(), so a
+    ///        receiver connected after clone() gets it, too.
+    ///
+    void requestViewData();
+
 protected:
     QSharedPointer<AbstractModelInstance> mModelInstance;
     QSharedPointer<AbstractViewConfiguration> mViewConfig;
+
+    QList<Symbol*> mSelectedEquations;
+    QList<Symbol*> mSelectedVariables;
+
+private:
+    QLabel *mLoadingLabel = nullptr;
 };
 
 ///
@@ -108,6 +176,8 @@ public:
 
     SearchResult &search(const QString &term, bool isRegEx) override;
 
+    CoefficientRangeSearch* createCoefficientSearch(const QString &term, QObject *parent) override;
+
     void setSearchSelection(const SearchResult::SearchEntry &result) override;
 
     void setupView(const QSharedPointer<AbstractModelInstance>& modelInstance) override;
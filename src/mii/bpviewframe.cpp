@@ -29,13 +29,58 @@
 #include "symbol.h"
 
 #include <QAction>
+#include <QHeaderView>
 #include <QMenu>
 #include <QSharedPointer>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
 
 namespace gams {
 namespace studio{
 namespace mii {
 
+///
+/// \brief Component of the symbol of a logical section, where sections
+///        without symbol, e.g. summary rows, go last.
+///
+static int blockKey(const QAbstractItemModel *model,
+                    const AbstractModelInstance &modelInstance,
+                    const ComponentPartition &components,
+                    Qt::Orientation orientation, int logicalIndex)
+{
+    bool ok = false;
+    int section = model->headerData(logicalIndex, orientation, ViewHelper::IndexDataRole).toInt(&ok);
+    if (!ok || section < 0)
+        return std::numeric_limits<int>::max();
+    const bool isRow = orientation == Qt::Vertical;
+    auto symbol = isRow ? modelInstance.equation(section) : modelInstance.variable(section);
+    const auto& component = isRow ? components.RowComponent : components.ColumnComponent;
+    if (!symbol || symbol->logicalIndex() < 0 || symbol->logicalIndex() >= component.size())
+        return std::numeric_limits<int>::max();
+    return component.at(symbol->logicalIndex());
+}
+
+///
+/// \brief Moves the logical sections of <c>header</c> into stable ascending
+///        order of their <c>keys</c>, where equal keys restore the model order.
+///
+static void orderSections(QHeaderView *header, const QVector<int> &keys)
+{
+    QVector<int> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+        return keys.at(a) < keys.at(b);
+    });
+    for (int visual=0; visual<order.size(); ++visual) {
+        const int current = header->visualIndex(order.at(visual));
+        if (current != visual)
+            header->moveSection(current, visual);
+    }
+}
+
 AbstractBPViewFrame::AbstractBPViewFrame(ComprehensiveTableModel *model,
                                          QWidget *parent,
                                          Qt::WindowFlags f)
@@ -45,9 +90,16 @@ AbstractBPViewFrame::AbstractBPViewFrame(ComprehensiveTableModel *model,
 {
     ui->tableView->setContextMenuPolicy(Qt::CustomContextMenu);
     mSelectionMenu->addAction(mSymbolAction);
+    mSelectionMenu->addSeparator();
+    mBlockOrderAction->setCheckable(true);
+    mBlockOrderAction->setToolTip("Order equations and variables by independent blocks");
+    mSelectionMenu->addAction(mBlockOrderAction);
     connect(mSymbolAction, &QAction::triggered, this, [this]{handleRowColumnSelection();});
+    connect(mBlockOrderAction, &QAction::toggled, this, [this]{updateSectionOrder();});
     connect(ui->tableView, &QWidget::customContextMenuRequested,
             this, &AbstractBPViewFrame::customMenuRequested);
+    connect(&mComponentWatcher, &QFutureWatcher<QSharedPointer<ComponentPartition>>::finished,
+            this, &AbstractBPViewFrame::componentsLoaded);
 }
 
 AbstractBPViewFrame::~AbstractBPViewFrame()
@@ -55,16 +107,6 @@ AbstractBPViewFrame::~AbstractBPViewFrame()
 
 }
 
-const QList<Symbol*>& AbstractBPViewFrame::selectedEquations() const
-{
-    return mSelectedEquations;
-}
-
-const QList<Symbol*>& AbstractBPViewFrame::selectedVariables() const
-{
-    return mSelectedVariables;
-}
-
 bool AbstractBPViewFrame::hasData() const
 {
     return mBaseModel && mBaseModel->rowCount() && mBaseModel->columnCount();
@@ -72,10 +114,10 @@ bool AbstractBPViewFrame::hasData() const
 
 void AbstractBPViewFrame::customMenuRequested(const QPoint &pos)
 {
-    if (ui->tableView->selectionModel()->selectedIndexes().empty())
-        return;
     auto view = mViewConfig->viewId();
-    if (ui->tableView->selectionModel()->selectedIndexes().first().row() < mModelInstance->symbolRowCount(view) &&
+    if (ui->tableView->selectionModel()->selectedIndexes().empty()) {
+        mSymbolAction->setEnabled(false);
+    } else if (ui->tableView->selectionModel()->selectedIndexes().first().row() < mModelInstance->symbolRowCount(view) &&
         ui->tableView->selectionModel()->selectedIndexes().first().column() < mModelInstance->symbolColumnCount(view)) {
         mSymbolAction->setEnabled(true);
     } else {
@@ -109,6 +151,52 @@ void AbstractBPViewFrame::handleRowColumnSelection()
     emit newSymbolViewRequested();
 }
 
+void AbstractBPViewFrame::componentsLoaded()
+{
+    if (mComponentsOutdated) {
+        mComponentsOutdated = false;
+        updateSectionOrder();
+        return;
+    }
+    if (mBlockOrderAction->isChecked())
+        applySectionOrder(mComponentWatcher.result());
+}
+
+void AbstractBPViewFrame::updateSectionOrder()
+{
+    if (!ui->tableView->model())
+        return;
+    if (!mBlockOrderAction->isChecked()) {
+        applySectionOrder(QSharedPointer<ComponentPartition>());
+        return;
+    }
+    if (mComponentWatcher.isRunning()) {
+        mComponentsOutdated = true;
+        return;
+    }
+    auto modelInstance = mModelInstance;
+    auto decompose = [modelInstance]{
+        return modelInstance->components(ComponentAnalysis::Symbols);
+    };
+    mComponentWatcher.setFuture(QtConcurrent::run(decompose));
+}
+
+void AbstractBPViewFrame::applySectionOrder(const QSharedPointer<ComponentPartition> &components)
+{
+    auto model = ui->tableView->model();
+    if (!model)
+        return;
+    for (auto orientation : { Qt::Vertical, Qt::Horizontal }) {
+        const int count = orientation == Qt::Vertical ? model->rowCount() : model->columnCount();
+        QVector<int> keys(count, 0);
+        for (int i=0; components && i<count; ++i)
+            keys[i] = blockKey(model, *mModelInstance, *components, orientation, i);
+        auto header = orientation == Qt::Vertical ? ui->tableView->verticalHeader()
+                                                  : ui->tableView->horizontalHeader();
+        orderSections(header, keys);
+    }
+}
+
 void AbstractBPViewFrame::setIdentifierFilterCheckState(int symbolIndex,
                                                         Qt::CheckState state,
                                                         Qt::Orientation orientation)
@@ -145,6 +233,7 @@ AbstractTableViewFrame *BPOverviewViewFrame::clone(int viewId)
         viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
                                                                                                         mModelInstance));
     auto frame = new BPOverviewViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    frame->mBlockOrderAction->setChecked(mBlockOrderAction->isChecked());
     frame->setupView();
     frame->evaluateFilters();
     return frame;
@@ -156,7 +245,12 @@ void BPOverviewViewFrame::setupView(const QSharedPointer<AbstractModelInstance>
     mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(), mModelInstance));
     mViewConfig->currentValueFilter().UseAbsoluteValues = modelInstance->globalAbsolute();
     mViewConfig->currentValueFilter().UseAbsoluteValuesGlobal = modelInstance->globalAbsolute();
-    mModelInstance->loadViewData(mViewConfig);
+    requestViewData();
+}
+
+void BPOverviewViewFrame::viewDataLoaded()
+{
+    setLoading(false);
     setupView();
 }
 
@@ -171,6 +265,7 @@ void BPOverviewViewFrame::evaluateFilters()
         mIdentifierFilterModel->setIdentifierFilter(mViewConfig->currentIdentifierFilter());
     ui->tableView->resizeColumnsToContents();
     ui->tableView->resizeRowsToContents();
+    updateSectionOrder();
 }
 
 void BPOverviewViewFrame::setupView()
@@ -191,6 +286,7 @@ void BPOverviewViewFrame::setupView()
 
     ui->tableView->resizeColumnsToContents();
     ui->tableView->resizeRowsToContents();
+    updateSectionOrder();
 }
 
 BPCountViewFrame::BPCountViewFrame(QWidget *parent, Qt::WindowFlags f)
@@ -215,6 +311,7 @@ AbstractTableViewFrame *BPCountViewFrame::clone(int viewId)
         viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
                                                                                                         mModelInstance));
     auto frame = new BPCountViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    frame->mBlockOrderAction->setChecked(mBlockOrderAction->isChecked());
     frame->setupView();
     frame->evaluateFilters();
     return frame;
@@ -226,7 +323,12 @@ void BPCountViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &mo
     mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(), mModelInstance));
     mViewConfig->currentValueFilter().UseAbsoluteValues = modelInstance->globalAbsolute();
     mViewConfig->currentValueFilter().UseAbsoluteValuesGlobal = modelInstance->globalAbsolute();
-    mModelInstance->loadViewData(mViewConfig);
+    requestViewData();
+}
+
+void BPCountViewFrame::viewDataLoaded()
+{
+    setLoading(false);
     setupView();
 }
 
@@ -243,6 +345,7 @@ void BPCountViewFrame::evaluateFilters()
         mValueFormatModel->setValueFilter(mViewConfig->currentValueFilter());
     ui->tableView->resizeColumnsToContents();
     ui->tableView->resizeRowsToContents();
+    updateSectionOrder();
 }
 
 void BPCountViewFrame::setupView()
@@ -269,6 +372,7 @@ void BPCountViewFrame::setupView()
 
     ui->tableView->resizeColumnsToContents();
     ui->tableView->resizeRowsToContents();
+    updateSectionOrder();
 }
 
 BPAverageViewFrame::BPAverageViewFrame(QWidget *parent, Qt::WindowFlags f)
@@ -294,6 +398,7 @@ AbstractTableViewFrame *BPAverageViewFrame::clone(int viewId)
         viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
                                                                                                         mModelInstance));
     auto frame = new BPAverageViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    frame->mBlockOrderAction->setChecked(mBlockOrderAction->isChecked());
     frame->setupView();
     frame->evaluateFilters();
     return frame;
@@ -305,7 +410,12 @@ void BPAverageViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &
     mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(), mModelInstance));
     mViewConfig->currentValueFilter().UseAbsoluteValues = modelInstance->globalAbsolute();
     mViewConfig->currentValueFilter().UseAbsoluteValuesGlobal = modelInstance->globalAbsolute();
-    mModelInstance->loadViewData(mViewConfig);
+    requestViewData();
+}
+
+void BPAverageViewFrame::viewDataLoaded()
+{
+    setLoading(false);
     setupView();
 }
 
@@ -322,6 +432,7 @@ void BPAverageViewFrame::evaluateFilters()
         mValueFormatModel->setValueFilter(mViewConfig->currentValueFilter());
     ui->tableView->resizeColumnsToContents();
     ui->tableView->resizeRowsToContents();
+    updateSectionOrder();
 }
 
 void BPAverageViewFrame::setupView()
@@ -350,6 +461,7 @@ void BPAverageViewFrame::setupView()
 
     ui->tableView->resizeColumnsToContents();
     ui->tableView->resizeRowsToContents();
+    updateSectionOrder();
 }
 
 BPScalingViewFrame::BPScalingViewFrame(QWidget *parent, Qt::WindowFlags f)
@@ -375,6 +487,7 @@ AbstractTableViewFrame* BPScalingViewFrame::clone(int viewId)
         viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
                                                                                                         mModelInstance));
     auto frame = new BPScalingViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    frame->mBlockOrderAction->setChecked(mBlockOrderAction->isChecked());
     frame->setupView();
     frame->evaluateFilters();
     return frame;
@@ -385,9 +498,7 @@ void BPScalingViewFrame::setShowAbsoluteValues(bool absoluteValues)
     Q_UNUSED(absoluteValues);
     if (!mBaseModel || !mValueFormatModel)
         return;
-    mModelInstance->loadViewData(mViewConfig);
-    emit mBaseModel->dataChanged(QModelIndex(), QModelIndex(), {Qt::DisplayRole});
-    mValueFormatModel->setValueFilter(mViewConfig->currentValueFilter());
+    requestViewData();
 }
 
 void BPScalingViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &modelInstance)
@@ -396,21 +507,35 @@ void BPScalingViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &
     mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(), mModelInstance));
     mViewConfig->currentValueFilter().UseAbsoluteValues = modelInstance->globalAbsolute();
     mViewConfig->currentValueFilter().UseAbsoluteValuesGlobal = modelInstance->globalAbsolute();
-    mModelInstance->loadViewData(mViewConfig);
-    setupView();
+    mSetupPending = true;
+    requestViewData();
 }
 
 void BPScalingViewFrame::evaluateFilters()
 {
+    if (!mBaseModel)
+        return;
+    requestViewData();
+}
+
+void BPScalingViewFrame::viewDataLoaded()
+{
+    setLoading(false);
+    if (mSetupPending) {
+        mSetupPending = false;
+        setupView();
+        return;
+    }
     if (!mBaseModel)
         return;
     if (mIdentifierFilterModel)
         mIdentifierFilterModel->setIdentifierFilter(mViewConfig->currentIdentifierFilter());
-    mModelInstance->loadViewData(mViewConfig);
+    emit mBaseModel->dataChanged(QModelIndex(), QModelIndex(), {Qt::DisplayRole});
     if (mValueFormatModel)
         mValueFormatModel->setValueFilter(mViewConfig->currentValueFilter());
     ui->tableView->resizeColumnsToContents();
     ui->tableView->resizeRowsToContents();
+    updateSectionOrder();
 }
 
 void BPScalingViewFrame::setupView()
@@ -439,6 +564,7 @@ void BPScalingViewFrame::setupView()
 
     ui->tableView->resizeColumnsToContents();
     ui->tableView->resizeRowsToContents();
+    updateSectionOrder();
 }
 
 }
@@ -22,6 +22,8 @@
 
 #include "abstracttableviewframe.h"
 
+#include <QFutureWatcher>
+
 namespace gams {
 namespace studio{
 namespace mii {
@@ -33,6 +35,7 @@ class HierarchicalHeaderView;
 class ComprehensiveTableModel;
 class ValueFormatProxyModel;
 class Symbol;
+struct ComponentPartition;
 
 class AbstractBPViewFrame : public AbstractTableViewFrame
 {
@@ -45,33 +48,47 @@ public:
 
     virtual ~AbstractBPViewFrame();
 
-    const QList<Symbol*>& selectedEquations() const;
-    const QList<Symbol*>& selectedVariables() const;
-
     bool hasData() const override;
 
-signals:
-    void newSymbolViewRequested();
-
 private slots:
     void customMenuRequested(const QPoint &pos);
 
     void handleRowColumnSelection();
 
+    void componentsLoaded();
+
 protected:
+    ///
+    /// \brief Moves rows and columns into block-diagonal order of the
+    ///        symbol components if enabled, or restores the model order.
+    /// \remark The components are computed on a worker thread, the order
+    ///         is applied once they are available.
+    ///
+    void updateSectionOrder();
+
     void setIdentifierFilterCheckState(int symbolIndex,
                                        Qt::CheckState state,
                                        Qt::Orientation orientation);
 
+private:
+    void applySectionOrder(const QSharedPointer<ComponentPartition> &components);
+
 protected:
     QSharedPointer<ComprehensiveTableModel> mBaseModel;
     BPIdentifierFilterModel* mIdentifierFilterModel = nullptr;
 
     QMenu *mSelectionMenu;
     QAction *mSymbolAction = new QAction("Show selected symbols", this);
+    QAction *mBlockOrderAction = new QAction("Block-diagonal order", this);
 
-    QList<Symbol*> mSelectedEquations;
-    QList<Symbol*> mSelectedVariables;
+private:
+    QFutureWatcher<QSharedPointer<ComponentPartition>> mComponentWatcher;
+
+    ///
+    /// \brief The order was requested again while the components were
+    ///        computed, e.g. for a new model instance.
+    ///
+    bool mComponentsOutdated = false;
 };
 
 class BPOverviewViewFrame final : public AbstractBPViewFrame
@@ -90,6 +107,8 @@ public:
 
     void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
 
+    void viewDataLoaded() override;
+
     void setShowAbsoluteValues(bool absoluteValues) override;
 
     inline ViewHelper::ViewDataType type() const override
@@ -120,6 +139,8 @@ public:
 
     void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
 
+    void viewDataLoaded() override;
+
     void setShowAbsoluteValues(bool absoluteValues) override;
 
     inline ViewHelper::ViewDataType type() const override
@@ -154,6 +175,8 @@ public:
 
     void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
 
+    void viewDataLoaded() override;
+
     void setShowAbsoluteValues(bool absoluteValues) override;
 
     inline ViewHelper::ViewDataType type() const override
@@ -194,6 +217,8 @@ public:
 
     void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
 
+    void viewDataLoaded() override;
+
 public slots:
     void evaluateFilters() override;
 
@@ -203,6 +228,12 @@ private:
 private:
     ValueFormatProxyModel* mValueFormatModel = nullptr;
     HierarchicalHeaderView* mVerticalHeader = nullptr;
+
+    ///
+    /// \brief The models are set up again once the requested data is
+    ///        loaded, otherwise only the filters are applied.
+    ///
+    bool mSetupPending = false;
 };
 
 }
@@ -0,0 +1,142 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "coefficientsearch.h"
+#include "datamatrix.h"
+
+#include <QRegularExpression>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+bool CoefficientSearch::parse(const QString &term, Range &range)
+{
+    static const QRegularExpression bound(R"(\s*([<>])\s*([^\s<>]+)\s*)");
+    range = Range();
+    bool found = false;
+    int position = 0;
+    auto iter = bound.globalMatch(term);
+    while (iter.hasNext()) {
+        auto match = iter.next();
+        if (match.capturedStart() != position)
+            return false;
+        position = match.capturedEnd();
+        bool ok = false;
+        double value = match.captured(2).toDouble(&ok);
+        if (!ok || value < 0 || std::isnan(value))
+            return false;
+        if (match.captured(1) == "<")
+            range.Minimum = value;
+        else
+            range.Maximum = value;
+        found = true;
+    }
+    return found && position == term.size();
+}
+
+QVector<CoefficientHit> CoefficientSearch::run(DataMatrix &matrix,
+                                               bool useOutput,
+                                               const Range &range,
+                                               int maxHits,
+                                               qint64 *total,
+                                               const QBitArray &rows,
+                                               const QBitArray &columns,
+                                               const CancellationToken &token)
+{
+    struct Block
+    {
+        int FirstRow = 0;
+        int LastRow = -1;
+        qint64 Count = 0;
+        QVector<CoefficientHit> Hits;
+    };
+
+    const int rowsPerBlock = 512;
+    const double minimum = range.Minimum;
+    const double maximum = range.Maximum;
+    QVector<Block> blocks;
+    for (int first=0; first<matrix.rowCount(); first+=rowsPerBlock) {
+        Block block;
+        block.FirstRow = first;
+        block.LastRow = std::min(first+rowsPerBlock, matrix.rowCount())-1;
+        blocks.append(block);
+    }
+    // the section filters apply before the hits are counted and capped
+    auto inColumns = [&columns](int column) {
+        return columns.isEmpty() || (column >= 0 && column < columns.size() && columns.testBit(column));
+    };
+    auto values = matrix.values(useOutput);
+    QtConcurrent::blockingMap(blocks, [&](Block &block) {
+        if (token.isCancelled())
+            return;
+        for (int r=block.FirstRow; r<=block.LastRow; ++r) {
+            if (!rows.isEmpty() && (r >= rows.size() || !rows.testBit(r)))
+                continue;
+            auto row = matrix.row(r);
+            auto data = values.row(r);
+            const int entries = row->entries();
+            if (!data || !entries)
+                continue;
+            const int *colIdx = row->colIdx();
+            int count = 0;
+            for (int e=0; e<entries; ++e) {
+                const double value = std::fabs(data[e]);
+                count += int(value > 0.0 && value < minimum) | int(value > maximum);
+            }
+            if (!count)
+                continue;
+            if (!columns.isEmpty()) {
+                count = 0;
+                for (int e=0; e<entries; ++e) {
+                    const double value = std::fabs(data[e]);
+                    if (((value > 0.0 && value < minimum) || value > maximum) && inColumns(colIdx[e]))
+                        ++count;
+                }
+                if (!count)
+                    continue;
+            }
+            block.Count += count;
+            for (int e=0; e<entries && block.Hits.size()<maxHits; ++e) {
+                const double value = std::fabs(data[e]);
+                if (((value > 0.0 && value < minimum) || value > maximum) && inColumns(colIdx[e]))
+                    block.Hits.append(CoefficientHit{r, colIdx[e], data[e]});
+            }
+        }
+    });
+    qint64 count = 0;
+    QVector<CoefficientHit> hits;
+    for (const auto& block : std::as_const(blocks)) {
+        count += block.Count;
+        for (int i=0; i<block.Hits.size() && hits.size()<maxHits; ++i)
+            hits.append(block.Hits.at(i));
+    }
+    if (total)
+        *total = count;
+    return hits;
+}
+
+}
+}
+}
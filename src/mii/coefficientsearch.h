@@ -0,0 +1,94 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef COEFFICIENTSEARCH_H
+#define COEFFICIENTSEARCH_H
+
+#include "common.h"
+
+#include <QBitArray>
+#include <QString>
+#include <QVector>
+
+#include <limits>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class DataMatrix;
+
+struct CoefficientHit
+{
+    int Row = -1;
+    int Column = -1;
+    double Value = 0.0;
+};
+
+///
+/// \brief Search of Jacobian coefficients by magnitude.
+///
+/// A coefficient is a hit if its absolute value is nonzero and below the
+/// minimum, or above the maximum. The rows of the matrix are scanned in
+/// parallel blocks, where every row is first checked by a branch-free
+/// (vectorizable) count and only rows with hits are scanned again.
+///
+class CoefficientSearch final
+{
+public:
+    static const int MaxHits = 100000;
+
+    struct Range
+    {
+        double Minimum = 0.0;
+        double Maximum = std::numeric_limits<double>::infinity();
+    };
+
+    ///
+    /// \brief Parse a range like <c>"< 1e-9 > 1e9"</c>, where either
+    ///        bound is optional but at least one is required.
+    /// \return <c>true</c> if <c>term</c> is a valid range.
+    ///
+    static bool parse(const QString &term, Range &range);
+
+    ///
+    /// \brief Find all coefficients outside of <c>range</c>.
+    /// \param useOutput Use the output (evaluated) coefficients if available.
+    /// \param maxHits Maximum number of returned hits, ordered by row and column.
+    /// \param total Total number of hits, if not <c>nullptr</c>.
+    /// \param rows Rows to search, where an empty set means all rows.
+    /// \param columns Columns to search, where an empty set means all columns.
+    /// \param token Stops the scan before the next row block if cancelled,
+    ///        where the result is incomplete.
+    ///
+    static QVector<CoefficientHit> run(DataMatrix &matrix,
+                                       bool useOutput,
+                                       const Range &range,
+                                       int maxHits = MaxHits,
+                                       qint64 *total = nullptr,
+                                       const QBitArray &rows = QBitArray(),
+                                       const QBitArray &columns = QBitArray(),
+                                       const CancellationToken &token = CancellationToken());
+};
+
+}
+}
+}
+
+#endif // COEFFICIENTSEARCH_H
@@ -55,13 +55,20 @@ const QString ViewHelper::PredefinedViews = "Predefined Views";
 const QString ViewHelper::CustomViews     = "Custom Views";
 const QString ViewHelper::Blockpic        = "Blockpic";
 const QString ViewHelper::SymbolView      = "Symbol View";
+const QString ViewHelper::Analysis        = "Analysis";
 
 const QString ViewHelper::Jacobian      = "Jacobian";
 const QString ViewHelper::BPScaling     = "Scaling";
 const QString ViewHelper::BPOverview    = "Overview";
 const QString ViewHelper::BPCount       = "Count";
 const QString ViewHelper::BPAverage     = "Average";
+const QString ViewHelper::BPSparsity    = "Sparsity";
 const QString ViewHelper::Postopt       = "Postopt";
+const QString ViewHelper::ScalingAdvisor = "Scaling Advisor";
+const QString ViewHelper::Histogram     = "Histogram";
+const QString ViewHelper::Diagnostics   = "Diagnostics";
+const QString ViewHelper::Components    = "Components";
+const QString ViewHelper::Residuals     = "Residuals";
 const QString ViewHelper::Preopt        = "Preopt";
 const QStringList ViewHelper::PredefinedViewTexts = {
                                                 Jacobian,
@@ -69,7 +76,13 @@ const QStringList ViewHelper::PredefinedViewTexts = {
                                                 BPCount,
                                                 BPAverage,
                                                 BPScaling,
-                                                Postopt
+                                                BPSparsity,
+                                                Postopt,
+                                                ScalingAdvisor,
+                                                Histogram,
+                                                Diagnostics,
+                                                Components,
+                                                Residuals
                                             };
 
 const QString FileHelper::GamsCntr = "gamscntr.dat";
@@ -20,10 +20,14 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <limits>
 
 #include <QMap>
 #include <QRegularExpression>
+#include <QSharedPointer>
 #include <QString>
 #include <QVariant>
 #include <QVector>
@@ -241,7 +245,14 @@ public:
         BP_Average          = 2,
         BP_Scaling          = 3,
         Postopt             = 4,
-        Symbols             = 5,
+        BP_Sparsity         = 5,
+        ScalingAdvisor      = 6,
+        Histogram           = 7,
+        Diagnostics         = 8,
+        Components          = 9,
+        Residuals           = 10,
+        Symbols             = 11,
+        AnalysisGroup       = 120,
         BlockpicGroup       = 121,
         SymbolsGroup        = 122,
         PostoptGroup        = 123,
@@ -268,6 +279,20 @@ public:
         }
     }
 
+    static bool isAnalysis(ViewDataType type)
+    {
+        switch (type) {
+        case ViewDataType::ScalingAdvisor:
+        case ViewDataType::Histogram:
+        case ViewDataType::Diagnostics:
+        case ViewDataType::Components:
+        case ViewDataType::Residuals:
+            return true;
+        default:
+            return false;
+        }
+    }
+
     static const int ZoomFactor = 2;
 
     static const QString AttributeHeaderText;
@@ -279,13 +304,20 @@ public:
     static const QString CustomViews;
     static const QString Blockpic;
     static const QString SymbolView;
+    static const QString Analysis;
 
     static const QString Jacobian;
     static const QString BPScaling;
     static const QString BPOverview;
     static const QString BPCount;
     static const QString BPAverage;
+    static const QString BPSparsity;
     static const QString Postopt;
+    static const QString ScalingAdvisor;
+    static const QString Histogram;
+    static const QString Diagnostics;
+    static const QString Components;
+    static const QString Residuals;
     static const QString Preopt;
     static const QStringList PredefinedViewTexts;
 };
@@ -387,6 +419,41 @@ struct ViewActionStates
     bool LoadInstance = true;
 };
 
+///
+/// \brief Cooperative cancellation flag of a load, which is polled by the
+///        load loops at chunk granularity.
+///
+/// \remark Copies share the same flag, i.e. cancel() of any copy cancels
+///         all of them.
+///
+class CancellationToken
+{
+public:
+    ///
+    /// \brief Number of rows or entries between two checks.
+    ///
+    static constexpr int CheckInterval = 1024;
+
+    CancellationToken()
+        : mCancelled(new std::atomic<bool>(false))
+    {
+
+    }
+
+    void cancel()
+    {
+        mCancelled->store(true, std::memory_order_relaxed);
+    }
+
+    bool isCancelled() const
+    {
+        return mCancelled->load(std::memory_order_relaxed);
+    }
+
+private:
+    QSharedPointer<std::atomic<bool>> mCancelled;
+};
+
 ///
 /// \brief Symbol domain labels.
 ///
@@ -416,9 +483,23 @@ struct SearchResult
         int Index = -1;
         Qt::Orientation Orientation = Qt::Horizontal;
 
+        ///
+        /// \brief Logical column of a coefficient, where <c>Index</c> is
+        ///        the logical row. -1 for header entries.
+        ///
+        int Column = -1;
+
+        double Value = 0.0;
+
+        bool isCoefficient() const
+        {
+            return Column >= 0;
+        }
+
         bool operator==(const SearchEntry& other) const
         {
-            return Index == other.Index && Orientation == other.Orientation;
+            return Index == other.Index && Orientation == other.Orientation &&
+                   Column == other.Column;
         }
 
         bool operator!=(const SearchEntry& other) const
@@ -430,6 +511,7 @@ struct SearchResult
     bool operator==(const SearchResult& other) const
     {
         return Term == other.Term && IsRegEx == other.IsRegEx &&
+               IsCoefficientRange == other.IsCoefficientRange &&
                Entries == other.Entries;
     }
 
@@ -441,6 +523,17 @@ struct SearchResult
     QString Term;
     bool IsRegEx = false;
     QList<SearchEntry> Entries;
+
+    ///
+    /// \brief Term is a coefficient range, see CoefficientSearch::parse.
+    ///
+    bool IsCoefficientRange = false;
+
+    ///
+    /// \brief Number of coefficients out of range, which may exceed the
+    ///        number of entries.
+    ///
+    qint64 CoefficientCount = 0;
 };
 
 struct IdentifierState
@@ -565,6 +658,73 @@ struct ValueFilter
     }
 };
 
+///
+/// \brief Jacobian entry of a Postopt line and its contribution.
+///
+struct Contribution
+{
+    int Section = -1;
+    double Jacobian = 0.0;
+    double Value = 0.0;
+    double Product = 0.0;
+};
+
+///
+/// \brief Reduction of the Postopt lines to the dominant contributions.
+///
+struct ContributionFilter
+{
+    ///
+    /// \brief Number of listed contributions per line, all if 0.
+    ///
+    int TopK = 0;
+
+    ///
+    /// \brief Contributions with |Product| below are skipped.
+    ///
+    double Threshold = 0.0;
+
+    bool isActive() const
+    {
+        return TopK > 0 || Threshold > 0.0;
+    }
+
+    ///
+    /// \brief Keep the TopK largest |Product| not below Threshold, ordered
+    ///        by decreasing |Product|.
+    ///
+    void apply(QVector<Contribution> &contributions) const
+    {
+        if (Threshold > 0.0) {
+            auto threshold = Threshold;
+            contributions.erase(std::remove_if(contributions.begin(), contributions.end(),
+                                               [threshold](const Contribution &c) {
+                                                   return !(std::abs(c.Product) >= threshold);
+                                               }),
+                                contributions.end());
+        }
+        auto larger = [](const Contribution &a, const Contribution &b) {
+            return std::abs(a.Product) > std::abs(b.Product);
+        };
+        if (TopK > 0 && contributions.size() > TopK) {
+            std::nth_element(contributions.begin(), contributions.begin()+TopK,
+                             contributions.end(), larger);
+            contributions.resize(TopK);
+        }
+        std::sort(contributions.begin(), contributions.end(), larger);
+    }
+
+    bool operator==(const ContributionFilter& other) const
+    {
+        return TopK == other.TopK && Threshold == other.Threshold;
+    }
+
+    bool operator!=(const ContributionFilter& other) const
+    {
+        return !(*this == other);
+    }
+};
+
 }
 }
 }
@@ -0,0 +1,194 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "componentanalysis.h"
+#include "datamatrix.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Lock-free union-find, where every parent is smaller or equal to
+///        its node. Linking a root to a smaller root thus never creates a
+///        cycle, even if several threads link concurrently.
+///
+class ConcurrentUnionFind
+{
+public:
+    ConcurrentUnionFind(int nodes)
+        : mParent(nodes)
+    {
+        for (int i=0; i<nodes; ++i)
+            mParent[i].store(i, std::memory_order_relaxed);
+    }
+
+    int find(int node)
+    {
+        while (true) {
+            int parent = mParent[node].load(std::memory_order_relaxed);
+            if (parent == node)
+                return node;
+            int grandParent = mParent[parent].load(std::memory_order_relaxed);
+            if (parent != grandParent) // path halving, a failed CAS is harmless
+                mParent[node].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+            node = grandParent;
+        }
+    }
+
+    void unite(int a, int b)
+    {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+                return;
+            if (a < b)
+                std::swap(a, b);
+            int root = a;
+            if (mParent[a].compare_exchange_strong(root, b, std::memory_order_acq_rel))
+                return;
+        }
+    }
+
+private:
+    std::vector<std::atomic<int>> mParent;
+};
+
+///
+/// \brief Rows of one parallel task.
+///
+struct ComponentBlock
+{
+    int First = 0;
+    int Last = -1;
+};
+
+static const int RowsPerTask = 1024;
+
+static QVector<ComponentBlock> componentBlocks(int sections)
+{
+    QVector<ComponentBlock> blocks;
+    for (int first=0; first<sections; first+=RowsPerTask) {
+        ComponentBlock block;
+        block.First = first;
+        block.Last = std::min(first+RowsPerTask, sections)-1;
+        blocks.append(block);
+    }
+    return blocks;
+}
+
+static void blockDiagonalOrder(const QVector<int> &component, int count,
+                               QVector<int> &order, QVector<int> &start)
+{
+    start.fill(0, count+1);
+    for (int c : component)
+        ++start[c+1];
+    for (int k=0; k<count; ++k)
+        start[k+1] += start[k];
+    order.resize(component.size());
+    QVector<int> next(start);
+    for (int i=0; i<component.size(); ++i)
+        order[next[component[i]]++] = i;
+}
+
+ComponentPartition ComponentAnalysis::run(DataMatrix &matrix)
+{
+    QVector<int> rowGroups(matrix.rowCount());
+    std::iota(rowGroups.begin(), rowGroups.end(), 0);
+    QVector<int> columnGroups(matrix.columnCount());
+    std::iota(columnGroups.begin(), columnGroups.end(), 0);
+    return run(matrix, rowGroups, rowGroups.size(), columnGroups, columnGroups.size());
+}
+
+ComponentPartition ComponentAnalysis::run(DataMatrix &matrix,
+                                          const QVector<int> &rowGroups, int rowGroupCount,
+                                          const QVector<int> &columnGroups, int columnGroupCount)
+{
+    ComponentPartition partition;
+    const int rows = std::min(matrix.rowCount(), int(rowGroups.size()));
+    const int columns = std::min(matrix.columnCount(), int(columnGroups.size()));
+    const int nodes = rowGroupCount + columnGroupCount;
+    const int *rowGroup = rowGroups.constData();
+    const int *columnGroup = columnGroups.constData();
+
+    ConcurrentUnionFind unionFind(nodes);
+    auto blocks = componentBlocks(rows);
+    QtConcurrent::blockingMap(blocks, [&matrix, &unionFind, rowGroup, columnGroup,
+                                       rowGroupCount, columns](const ComponentBlock &block) {
+        for (int r=block.First; r<=block.Last; ++r) {
+            auto row = matrix.row(r);
+            const int rowNode = rowGroup[r];
+            if (rowNode < 0)
+                continue;
+            int lastColumnNode = -1;
+            for (int e=0; e<row->entries(); ++e) {
+                const int column = row->colIdx()[e];
+                if (column >= columns || columnGroup[column] < 0)
+                    continue;
+                const int columnNode = rowGroupCount + columnGroup[column];
+                if (columnNode == lastColumnNode) // e.g. columns of the same symbol
+                    continue;
+                unionFind.unite(rowNode, columnNode);
+                lastColumnNode = columnNode;
+            }
+        }
+    });
+
+    // the root is the smallest node of a component, hence a root is
+    // labeled before any other node of its component
+    QVector<int> roots(nodes);
+    int *root = roots.data();
+    auto nodeBlocks = componentBlocks(nodes);
+    QtConcurrent::blockingMap(nodeBlocks, [&unionFind, root](const ComponentBlock &block) {
+        for (int i=block.First; i<=block.Last; ++i)
+            root[i] = unionFind.find(i);
+    });
+    QVector<int> labels(nodes);
+    int count = 0;
+    for (int i=0; i<nodes; ++i)
+        labels[i] = root[i] == i ? count++ : labels[root[i]];
+
+    partition.RowComponent = labels.mid(0, rowGroupCount);
+    partition.ColumnComponent = labels.mid(rowGroupCount);
+    partition.Info.resize(count);
+    for (int c : std::as_const(partition.RowComponent))
+        ++partition.Info[c].Equations;
+    for (int c : std::as_const(partition.ColumnComponent))
+        ++partition.Info[c].Variables;
+    for (int r=0; r<rows; ++r) {
+        if (rowGroup[r] >= 0)
+            partition.Info[partition.RowComponent[rowGroup[r]]].NonZeros += matrix.row(r)->entries();
+    }
+    blockDiagonalOrder(partition.RowComponent, count, partition.RowOrder, partition.RowStart);
+    blockDiagonalOrder(partition.ColumnComponent, count, partition.ColumnOrder, partition.ColumnStart);
+    return partition;
+}
+
+}
+}
+}
@@ -0,0 +1,115 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef COMPONENTANALYSIS_H
+#define COMPONENTANALYSIS_H
+
+#include <QVector>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class DataMatrix;
+
+struct ComponentInfo
+{
+    int Equations = 0;
+    int Variables = 0;
+    qint64 NonZeros = 0;
+
+    bool isSingleton() const
+    {
+        return Equations + Variables == 1;
+    }
+};
+
+///
+/// \brief Connected components of the bipartite equation-variable graph,
+///        where rows and columns are either matrix sections or symbols.
+///
+/// Components are numbered by their first row. Components without any
+/// row, i.e. empty columns, follow by their first column.
+///
+struct ComponentPartition
+{
+    QVector<int> RowComponent;
+    QVector<int> ColumnComponent;
+    QVector<ComponentInfo> Info;
+
+    ///
+    /// \brief Rows in block-diagonal order, i.e. by component and row.
+    ///        The rows of component <c>k</c> are
+    ///        <c>RowOrder[RowStart[k]] .. RowOrder[RowStart[k+1]-1]</c>.
+    ///
+    QVector<int> RowOrder;
+    QVector<int> RowStart;
+
+    ///
+    /// \brief Columns in block-diagonal order, see RowOrder.
+    ///
+    QVector<int> ColumnOrder;
+    QVector<int> ColumnStart;
+
+    int count() const
+    {
+        return Info.size();
+    }
+};
+
+///
+/// \brief Union-find decomposition of the Jacobian into independent blocks.
+///
+/// Every nonzero unites its row and column. Rows are processed in parallel
+/// blocks on a lock-free union-find, where roots are linked by CAS towards
+/// the smaller node and paths are halved on every find. The root of a
+/// component is thus its smallest node, which gives the component order
+/// without any sorting. The block-diagonal order is a counting sort.
+///
+class ComponentAnalysis final
+{
+public:
+    enum Level
+    {
+        Sections,
+        Symbols
+    };
+
+    ///
+    /// \brief Components of the equation and variable sections.
+    ///
+    static ComponentPartition run(DataMatrix &matrix);
+
+    ///
+    /// \brief Components of groups of sections, e.g. symbols.
+    /// \param rowGroups Group of each matrix row, in <c>[0, rowGroupCount)</c>.
+    /// \param columnGroups Group of each matrix column, in <c>[0, columnGroupCount)</c>.
+    /// \remark Rows and columns of a partition are groups. Sections of a
+    ///         negative group are ignored.
+    ///
+    static ComponentPartition run(DataMatrix &matrix,
+                                  const QVector<int> &rowGroups, int rowGroupCount,
+                                  const QVector<int> &columnGroups, int columnGroupCount);
+};
+
+}
+}
+}
+
+#endif // COMPONENTANALYSIS_H
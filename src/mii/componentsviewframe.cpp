@@ -0,0 +1,389 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "componentsviewframe.h"
+#include "abstractmodelinstance.h"
+#include "numerics.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QRegularExpression>
+#include <QSortFilterProxyModel>
+#include <QTableView>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+ComponentModel::ComponentModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+
+}
+
+void ComponentModel::setComponents(const QSharedPointer<ComponentPartition> &components,
+                                   const QSharedPointer<ComponentComposition> &composition)
+{
+    beginResetModel();
+    mComponents = components;
+    mComposition = composition;
+    endResetModel();
+}
+
+QList<Symbol*> ComponentModel::symbols(int component, bool isEquation) const
+{
+    QList<Symbol*> symbols;
+    if (!mComposition || component < 0 || component >= rowCount())
+        return symbols;
+    const auto& start = isEquation ? mComposition->EquationStart : mComposition->VariableStart;
+    for (int i=start.at(component); i<start.at(component+1); ++i)
+        symbols.append(mComposition->Symbols.at(i));
+    return symbols;
+}
+
+QVariant ComponentModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+    const int component = index.row();
+    if (role == Qt::TextAlignmentRole)
+        return index.column() < 4 ? QVariant(Qt::AlignRight | Qt::AlignVCenter) : QVariant();
+    if (role == Qt::UserRole + 1) // filter role
+        return index.column() == 0 ? int(mComponents->Info.at(component).isSingleton()) : QVariant();
+    if (role != Qt::DisplayRole && role != Qt::UserRole)
+        return QVariant();
+    switch (index.column()) {
+    case 0:
+        return component + 1;
+    case 1:
+        return mComposition->EquationRows.at(component);
+    case 2:
+        return mComposition->VariableColumns.at(component);
+    case 3:
+        return mComponents->Info.at(component).NonZeros;
+    case 4:
+        return compositionText(component, true);
+    default:
+        return compositionText(component, false);
+    }
+}
+
+QVariant ComponentModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
+        return mHeaderData.at(section);
+    }
+    return QVariant();
+}
+
+int ComponentModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mHeaderData.size();
+}
+
+int ComponentModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mComponents && mComposition ? mComponents->count() : 0;
+}
+
+QString ComponentModel::compositionText(int component, bool isEquation) const
+{
+    const auto& start = isEquation ? mComposition->EquationStart : mComposition->VariableStart;
+    QStringList symbols;
+    for (int i=start.at(component); i<start.at(component+1); ++i) {
+        if (symbols.size() == MaxListedSymbols) {
+            symbols.append(QString("... %1 more").arg(start.at(component+1) - i));
+            break;
+        }
+        auto symbol = mComposition->Symbols.at(i);
+        if (symbol->isScalar() || mComposition->Sections.at(i) == symbol->entries())
+            symbols.append(symbol->name());
+        else
+            symbols.append(QString("%1 (%2 of %3)").arg(symbol->name())
+                                                   .arg(mComposition->Sections.at(i))
+                                                   .arg(symbol->entries()));
+    }
+    return symbols.join(", ");
+}
+
+ComponentsViewFrame::ComponentsViewFrame(QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::defaultConfiguration());
+    setupUi();
+}
+
+ComponentsViewFrame::ComponentsViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                         const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                                         QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mModelInstance = modelInstance;
+    mViewConfig = viewConfig;
+    setupUi();
+}
+
+ComponentsViewFrame::~ComponentsViewFrame()
+{
+    mComponentWatcher.waitForFinished();
+}
+
+AbstractViewFrame *ComponentsViewFrame::clone(int viewId)
+{
+    auto viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
+                                                                                                         mModelInstance));
+    viewConfig->setViewId(viewId);
+    auto frame = new ComponentsViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    frame->mLevelBox->blockSignals(true);
+    frame->mLevelBox->setCurrentIndex(mLevelBox->currentIndex());
+    frame->mLevelBox->blockSignals(false);
+    frame->mSingletonBox->setChecked(mSingletonBox->isChecked());
+    if (mComponentWatcher.isRunning()) {
+        frame->setupView(mModelInstance);
+    } else {
+        frame->mIsLoaded = mIsLoaded;
+        frame->setResult(mResult);
+    }
+    return frame;
+}
+
+void ComponentsViewFrame::setShowAbsoluteValues(bool absoluteValues)
+{// the components only depend on the sparsity pattern
+    Q_UNUSED(absoluteValues);
+}
+
+void ComponentsViewFrame::zoomIn()
+{
+    QFont font = mComponentView->font();
+    font.setPointSize(font.pointSize() + ViewHelper::ZoomFactor);
+    mComponentView->setFont(font);
+}
+
+void ComponentsViewFrame::zoomOut()
+{
+    QFont font = mComponentView->font();
+    if (font.pointSize() <= ViewHelper::ZoomFactor)
+        return;
+    font.setPointSize(font.pointSize() - ViewHelper::ZoomFactor);
+    mComponentView->setFont(font);
+}
+
+void ComponentsViewFrame::resetZoom()
+{
+    mComponentView->setFont(font());
+}
+
+SearchResult &ComponentsViewFrame::search(const QString &term, bool isRegEx)
+{
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = isRegEx;
+    mViewConfig->searchResult().Entries.clear();
+    return mViewConfig->searchResult();
+}
+
+void ComponentsViewFrame::setSearchSelection(const SearchResult::SearchEntry &result)
+{
+    Q_UNUSED(result);
+}
+
+void ComponentsViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &modelInstance)
+{
+    mModelInstance = modelInstance;
+    loadComponents();
+}
+
+bool ComponentsViewFrame::hasData() const
+{
+    return mComponentWatcher.isRunning() || (mIsLoaded && mModelInstance->equationRowCount());
+}
+
+void ComponentsViewFrame::componentsLoaded()
+{
+    mIsLoaded = true;
+    setResult(mComponentWatcher.result());
+}
+
+void ComponentsViewFrame::loadComponents()
+{
+    if (!mModelInstance)
+        return;
+    mComponentWatcher.waitForFinished();
+    mIsLoaded = false;
+    setResult(Result());
+    mInfoLabel->setText("Decomposing the Jacobian...");
+    auto level = ComponentAnalysis::Level(mLevelBox->currentData().toInt());
+    auto modelInstance = mModelInstance;
+    auto decompose = [modelInstance, level]{
+        Result result;
+        result.Components = modelInstance->components(level);
+        result.Composition = composition(modelInstance, *result.Components, level);
+        return result;
+    };
+    mComponentWatcher.setFuture(QtConcurrent::run(decompose));
+}
+
+void ComponentsViewFrame::updateFilter()
+{
+    mProxyModel->setFilterRegularExpression(mSingletonBox->isChecked() ? QString("^0$") : QString());
+}
+
+void ComponentsViewFrame::showSymbols(const QModelIndex &index)
+{
+    if (!index.isValid())
+        return;
+    const int component = mProxyModel->mapToSource(index).row();
+    auto equations = mComponentModel->symbols(component, true);
+    auto variables = mComponentModel->symbols(component, false);
+    if (equations.isEmpty() || variables.isEmpty()) {
+        mInfoLabel->setText(QString("Block %1 has no entries to show.").arg(component+1));
+        return;
+    }
+    mSelectedEquations = equations;
+    mSelectedVariables = variables;
+    emit newSymbolViewRequested();
+}
+
+void ComponentsViewFrame::setupUi()
+{
+    mLevelBox = new QComboBox(this);
+    mLevelBox->addItem("Symbols", ComponentAnalysis::Symbols);
+    mLevelBox->addItem("Entries", ComponentAnalysis::Sections);
+    mLevelBox->setToolTip("Decompose the Jacobian of the symbols, as in the blockpic, or of the single entries");
+    mSingletonBox = new QCheckBox("Hide single equations or variables", this);
+    mInfoLabel = new QLabel(this);
+    auto controls = new QHBoxLayout;
+    controls->addWidget(new QLabel("Blocks of", this));
+    controls->addWidget(mLevelBox);
+    controls->addWidget(mSingletonBox);
+    controls->addStretch();
+    controls->addWidget(mInfoLabel);
+
+    mComponentModel = new ComponentModel(this);
+    mProxyModel = new QSortFilterProxyModel(this);
+    mProxyModel->setSourceModel(mComponentModel);
+    mProxyModel->setSortRole(Qt::UserRole);
+    mProxyModel->setFilterRole(Qt::UserRole + 1);
+    mProxyModel->setFilterKeyColumn(0);
+    mComponentView = new QTableView(this);
+    mComponentView->setModel(mProxyModel);
+    mComponentView->setSortingEnabled(true);
+    mComponentView->sortByColumn(-1, Qt::AscendingOrder);
+    mComponentView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mComponentView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mComponentView->verticalHeader()->setVisible(false);
+    mComponentView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    mComponentView->horizontalHeader()->setStretchLastSection(true);
+    mComponentView->setToolTip("Double click a block to open its symbol view.");
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(controls);
+    layout->addWidget(mComponentView);
+    connect(mLevelBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &ComponentsViewFrame::loadComponents);
+    connect(mSingletonBox, &QCheckBox::toggled,
+            this, &ComponentsViewFrame::updateFilter);
+    connect(mComponentView, &QTableView::doubleClicked,
+            this, &ComponentsViewFrame::showSymbols);
+    connect(&mComponentWatcher, &QFutureWatcher<Result>::finished,
+            this, &ComponentsViewFrame::componentsLoaded);
+}
+
+void ComponentsViewFrame::setResult(const Result &result)
+{
+    mResult = result;
+    mComponentModel->setComponents(mResult.Components, mResult.Composition);
+    mComponentView->resizeColumnsToContents();
+    if (!mIsLoaded || !mResult.Components) {
+        mInfoLabel->clear();
+        return;
+    }
+    const auto& info = mResult.Components->Info;
+    const int singletons = int(std::count_if(info.cbegin(), info.cend(), [](const ComponentInfo &component) {
+        return component.isSingleton();
+    }));
+    mInfoLabel->setText(QString("%1 blocks, %2 of a single equation or variable")
+                        .arg(info.size()).arg(singletons));
+}
+
+QSharedPointer<ComponentComposition> ComponentsViewFrame::composition(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                                                      const ComponentPartition &components,
+                                                                      ComponentAnalysis::Level level)
+{
+    QSharedPointer<ComponentComposition> composition(new ComponentComposition);
+    composition->EquationStart.reserve(components.count()+1);
+    composition->VariableStart.reserve(components.count()+1);
+    composition->EquationRows.fill(0, components.count());
+    composition->VariableColumns.fill(0, components.count());
+    auto appendRuns = [&modelInstance, &composition, level](bool isEquation, const int *first,
+                                                             const int *last, int &sections) {
+        const auto& symbols = isEquation ? modelInstance->equations() : modelInstance->variables();
+        Symbol *previous = nullptr;
+        for (auto index=first; index!=last; ++index) {
+            Symbol *symbol = nullptr;
+            int count = 1;
+            if (level == ComponentAnalysis::Symbols) {
+                symbol = *index < symbols.size() ? symbols.at(*index) : nullptr;
+                count = symbol ? symbol->entries() : 0;
+            } else {
+                symbol = isEquation ? modelInstance->equation(*index) : modelInstance->variable(*index);
+            }
+            if (!symbol)
+                continue;
+            sections += count;
+            if (symbol == previous) { // sections of a component are ordered
+                composition->Sections.last() += count;
+                continue;
+            }
+            composition->Symbols.append(symbol);
+            composition->Sections.append(count);
+            previous = symbol;
+        }
+    };
+    for (int k=0; k<components.count(); ++k) {
+        composition->EquationStart.append(composition->Symbols.size());
+        appendRuns(true,
+                   components.RowOrder.constData() + components.RowStart.at(k),
+                   components.RowOrder.constData() + components.RowStart.at(k+1),
+                   composition->EquationRows[k]);
+    }
+    composition->EquationStart.append(composition->Symbols.size());
+    for (int k=0; k<components.count(); ++k) {
+        composition->VariableStart.append(composition->Symbols.size());
+        appendRuns(false,
+                   components.ColumnOrder.constData() + components.ColumnStart.at(k),
+                   components.ColumnOrder.constData() + components.ColumnStart.at(k+1),
+                   composition->VariableColumns[k]);
+    }
+    composition->VariableStart.append(composition->Symbols.size());
+    return composition;
+}
+
+}
+}
+}
@@ -0,0 +1,188 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef COMPONENTSVIEWFRAME_H
+#define COMPONENTSVIEWFRAME_H
+
+#include "abstractviewframe.h"
+#include "componentanalysis.h"
+
+#include <QAbstractTableModel>
+#include <QFutureWatcher>
+
+class QComboBox;
+class QCheckBox;
+class QLabel;
+class QSortFilterProxyModel;
+class QTableView;
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class Symbol;
+
+///
+/// \brief Symbol composition of all components, where the equation and
+///        variable symbols of component <c>k</c> are the runs
+///        <c>EquationStart[k] .. EquationStart[k+1]-1</c> and
+///        <c>VariableStart[k] .. VariableStart[k+1]-1</c> of Symbols.
+///
+struct ComponentComposition
+{
+    QVector<Symbol*> Symbols;
+
+    ///
+    /// \brief Number of sections of each symbol run in its component.
+    ///
+    QVector<int> Sections;
+
+    QVector<int> EquationStart;
+    QVector<int> VariableStart;
+
+    ///
+    /// \brief Number of equation rows and variable columns per component.
+    ///
+    QVector<int> EquationRows;
+    QVector<int> VariableColumns;
+};
+
+///
+/// \brief One row per component of a ComponentPartition.
+///
+class ComponentModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    ComponentModel(QObject *parent = nullptr);
+
+    void setComponents(const QSharedPointer<ComponentPartition> &components,
+                       const QSharedPointer<ComponentComposition> &composition);
+
+    QList<Symbol*> symbols(int component, bool isEquation) const;
+
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+private:
+    QString compositionText(int component, bool isEquation) const;
+
+private:
+    ///
+    /// \brief Maximum number of symbols listed per cell.
+    ///
+    static const int MaxListedSymbols = 8;
+
+    const QStringList mHeaderData { "Block", "Equations", "Variables", "Nonzeros",
+                                    "Equation symbols", "Variable symbols" };
+    QSharedPointer<ComponentPartition> mComponents;
+    QSharedPointer<ComponentComposition> mComposition;
+};
+
+///
+/// \brief Independent blocks of the Jacobian, computed by
+///        ComponentAnalysis on a worker thread.
+///
+class ComponentsViewFrame final : public AbstractViewFrame
+{
+    Q_OBJECT
+
+public:
+    ComponentsViewFrame(QWidget *parent = nullptr,
+                        Qt::WindowFlags f = Qt::WindowFlags());
+
+    ComponentsViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                        const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                        QWidget *parent = nullptr,
+                        Qt::WindowFlags f = Qt::WindowFlags());
+
+    ~ComponentsViewFrame() override;
+
+    AbstractViewFrame* clone(int viewId) override;
+
+    void setShowAbsoluteValues(bool absoluteValues) override;
+
+    inline ViewHelper::ViewDataType type() const override
+    {
+        return ViewHelper::ViewDataType::Components;
+    }
+
+    void zoomIn() override;
+
+    void zoomOut() override;
+
+    void resetZoom() override;
+
+    SearchResult& search(const QString &term, bool isRegEx) override;
+
+    void setSearchSelection(const SearchResult::SearchEntry &result) override;
+
+    void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
+
+    bool hasData() const override;
+
+private slots:
+    void componentsLoaded();
+
+    void loadComponents();
+
+    void updateFilter();
+
+    void showSymbols(const QModelIndex &index);
+
+private:
+    struct Result
+    {
+        QSharedPointer<ComponentPartition> Components;
+        QSharedPointer<ComponentComposition> Composition;
+    };
+
+    void setupUi();
+
+    void setResult(const Result &result);
+
+    static QSharedPointer<ComponentComposition> composition(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                                            const ComponentPartition &components,
+                                                            ComponentAnalysis::Level level);
+
+private:
+    QComboBox *mLevelBox;
+    QCheckBox *mSingletonBox;
+    QLabel *mInfoLabel;
+    QTableView *mComponentView;
+    ComponentModel *mComponentModel;
+    QSortFilterProxyModel *mProxyModel;
+    Result mResult;
+    bool mIsLoaded = false;
+    QFutureWatcher<Result> mComponentWatcher;
+};
+
+}
+}
+}
+
+#endif // COMPONENTSVIEWFRAME_H
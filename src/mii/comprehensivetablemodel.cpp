@@ -52,6 +52,7 @@ void ComprehensiveTableModel::setModelInstance(const QSharedPointer<AbstractMode
 {
     beginResetModel();
     mModelInstance = modelInstance;
+    mTileBuffer.invalidate();
     endResetModel();
 }
 
@@ -61,7 +62,7 @@ QVariant ComprehensiveTableModel::data(const QModelIndex &index, int role) const
         return Qt::AlignRight;
     }
     if (role == Qt::FontRole) {
-        if (mModelInstance->nlFlag(index.row(), index.column(), mView)) {
+        if (cellNlFlag(index)) {
             QFont font;
             font.setBold(true);
             font.setItalic(true);
@@ -69,7 +70,7 @@ QVariant ComprehensiveTableModel::data(const QModelIndex &index, int role) const
         }
     }
     if (role == Qt::DisplayRole && index.isValid()) {
-        return mModelInstance->data(index.row(), index.column(), mView);
+        return cellData(index);
     }
     return QVariant();
 }
@@ -140,6 +141,16 @@ QHash<int, QByteArray> ComprehensiveTableModel::roleNames() const
     return ViewHelper::roleNames();
 }
 
+void ComprehensiveTableModel::prefetch(const QVector<int> &rows, const QVector<int> &columns)
+{
+    mTileBuffer.prefetch(mModelInstance, mView, rows, columns);
+}
+
+DataTileBuffer *ComprehensiveTableModel::tileBuffer()
+{
+    return &mTileBuffer;
+}
+
 int ComprehensiveTableModel::view() const
 {
     return mView;
@@ -148,6 +159,27 @@ int ComprehensiveTableModel::view() const
 void ComprehensiveTableModel::setView(int view)
 {
     mView = view;
+    mTileBuffer.invalidate();
+}
+
+QVariant ComprehensiveTableModel::cellData(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return QVariant();
+    const auto& tile = mTileBuffer.tile(*mModelInstance, mView, index.row(), index.column());
+    if (!tile.contains(index.row(), index.column()))
+        return QVariant();
+    int i = tile.offset(index.row(), index.column());
+    return tile.Mask[i] ? QVariant(tile.Values[i]) : QVariant();
+}
+
+bool ComprehensiveTableModel::cellNlFlag(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return false;
+    const auto& tile = mTileBuffer.tile(*mModelInstance, mView, index.row(), index.column());
+    return tile.contains(index.row(), index.column()) &&
+           tile.NlFlags[tile.offset(index.row(), index.column())];
 }
 
 BPOverviewTableModel::BPOverviewTableModel(QObject *parent)
@@ -170,7 +202,7 @@ QVariant BPOverviewTableModel::data(const QModelIndex &index, int role) const
         return Qt::AlignRight;
     }
     if (role == Qt::DisplayRole && index.isValid()) {
-        auto value = mModelInstance->data(index.row(), index.column(), mView).toInt();
+        auto value = cellData(index).toInt();
         if (!value)
             return QVariant();
         if (value == ValueHelper::Mixed)
@@ -219,10 +251,10 @@ QVariant BPCountTableModel::data(const QModelIndex &index, int role) const
     if (role == Qt::DisplayRole && index.isValid()) {
         if (index.column() == mModelInstance->columnCount(mView)-4 ||
             index.row() == mModelInstance->rowCount(mView)-1) {
-            auto value = mModelInstance->data(index.row(), index.column(), mView).toInt();
+            auto value = cellData(index).toInt();
             return value ? QChar(value) : QVariant();
         }
-        return mModelInstance->data(index.row(), index.column(), mView);
+        return cellData(index);
     }
     return ComprehensiveTableModel::data(index, role);
 }
@@ -249,10 +281,10 @@ QVariant BPAverageTableModel::data(const QModelIndex &index, int role) const
     if (role == Qt::DisplayRole && index.isValid()) {
         if (index.column() == mModelInstance->columnCount(mView)-4 ||
             index.row() == mModelInstance->rowCount(mView)-1) {
-            auto value = mModelInstance->data(index.row(), index.column(), mView).toInt();
+            auto value = cellData(index).toInt();
             return value ? QChar(value) : QVariant();
         }
-        return mModelInstance->data(index.row(), index.column(), mView);
+        return cellData(index);
     }
     return ComprehensiveTableModel::data(index, role);
 }
@@ -20,6 +20,8 @@
 #ifndef COMPREHENSIVETABLEMODEL_H
 #define COMPREHENSIVETABLEMODEL_H
 
+#include "datatilebuffer.h"
+
 #include <QAbstractTableModel>
 #include <QSharedPointer>
 
@@ -29,7 +31,7 @@ namespace mii {
 
 class AbstractModelInstance;
 
-class ComprehensiveTableModel : public QAbstractTableModel
+class ComprehensiveTableModel : public QAbstractTableModel, public AbstractTileModel
 {
     Q_OBJECT
 
@@ -60,13 +62,28 @@ public:
 
     QHash<int, QByteArray> roleNames() const override;
 
+    void prefetch(const QVector<int> &rows, const QVector<int> &columns) override;
+
+    DataTileBuffer* tileBuffer() override;
+
     int view() const;
 
     void setView(int view);
 
+protected:
+    ///
+    /// \brief Cell value served from the tile buffer.
+    ///
+    QVariant cellData(const QModelIndex &index) const;
+
+    bool cellNlFlag(const QModelIndex &index) const;
+
 protected:
     QSharedPointer<AbstractModelInstance> mModelInstance;
     int mView;
+
+private:
+    mutable DataTileBuffer mTileBuffer;
 };
 
 class BPOverviewTableModel final : public ComprehensiveTableModel
@@ -20,12 +20,15 @@
 #include "datahandler.h"
 #include "abstractmodelinstance.h"
 #include "datamatrix.h"
+#include "loghistogram.h"
 #include "postopttreeitem.h"
 #include "viewconfigurationprovider.h"
 #include "numerics.h"
+#include "sparsitypyramid.h"
 
 #include <algorithm>
 #include <functional>
+#include <utility>
 
 #include <QSet>
 
@@ -37,6 +40,11 @@ namespace gams {
 namespace studio {
 namespace mii {
 
+///
+/// \brief Serial of the last created DataHandler.
+///
+static std::atomic<quint64> HandlerSerial {0};
+
 class DataHandler::AbstractDataProvider
 {
 protected:
@@ -93,6 +101,14 @@ public:
         return mDataHandler->mDataMatrix->row(row);
     }
 
+    ///
+    /// \brief Jacobian values of one load pass, see DataMatrix::values().
+    ///
+    MatrixValues jacobianValues(bool useOutput)
+    {
+        return mDataHandler->mDataMatrix->values(useOutput);
+    }
+
     virtual void loadData() = 0;
 
     virtual double data(int row, int column) const = 0;
@@ -104,6 +120,22 @@ public:
         return 0;
     }
 
+    ///
+    /// \brief Fills values, NL flags and mask of all cells covered by the tile.
+    ///
+    virtual void fillTile(DataTile &tile) const
+    {
+        for (int r=0; r<tile.RowCount; ++r) {
+            int row = tile.FirstRow + r;
+            for (int c=0; c<tile.ColumnCount; ++c) {
+                int i = r * tile.ColumnCount + c;
+                tile.Values[i] = data(row, tile.FirstColumn + c);
+                tile.Mask[i] = tile.Values[i] != 0.0;
+                tile.NlFlags[i] = nlFlag(row, tile.FirstColumn + c) != 0;
+            }
+        }
+    }
+
     virtual QVariant plainHeaderData(Qt::Orientation orientation,
                                      int logicalIndex,
                                      int dimension) const
@@ -202,6 +234,28 @@ public:
         return mIsAbsoluteData;
     }
 
+    ///
+    /// \brief Approximate heap size of the loaded data in bytes.
+    ///
+    virtual qint64 byteSize() const
+    {
+        return 0;
+    }
+
+    void setCancellationToken(const CancellationToken &token)
+    {
+        mCancellationToken = token;
+    }
+
+    ///
+    /// \brief Whether the load or the whole model instance was cancelled,
+    ///        polled by the aggregation loops.
+    ///
+    bool isCancelled() const
+    {
+        return mCancellationToken.isCancelled() || mModelInstance.isCancelled();
+    }
+
     auto& operator=(const AbstractDataProvider& other)
     {
         mRowCount = other.mRowCount;
@@ -248,6 +302,7 @@ protected:
     QList<int> mRowIndices;
     QList<int> mColumnIndices;
     bool mIsAbsoluteData;
+    CancellationToken mCancellationToken;
 };
 
 class IdentityDataProvider : public DataHandler::AbstractDataProvider
@@ -283,9 +338,11 @@ public:
     BPScalingProvider(DataHandler *dataHandler,
                       AbstractModelInstance& modelInstance,
                       const QSharedPointer<AbstractViewConfiguration> &viewConfig,
-                      const QSharedPointer<DataHandler::CoefficientInfo> &coeffInfo)
+                      const QSharedPointer<DataHandler::CoefficientInfo> &coeffInfo,
+                      const QSharedPointer<LogHistogram> &histogram)
         : DataHandler::AbstractDataProvider(dataHandler, modelInstance, viewConfig)
         , mCoeffInfo(coeffInfo)
+        , mHistogram(histogram)
     {
         mSymbolRowCount = mModelInstance.equationCount() * 2;
         mRowCount = mSymbolRowCount + 2; // one row for max and min
@@ -329,6 +386,7 @@ public:
         , mDataMatrix(other.mDataMatrix)
         , mCoeffInfo(std::move(other.mCoeffInfo))
         , mNlFlags(other.mNlFlags)
+        , mHistogram(std::move(other.mHistogram))
     {
         other.mDataMatrix = nullptr;
         other.mNlFlags = nullptr;
@@ -367,6 +425,16 @@ public:
         return mNlFlags[row][column];
     }
 
+    qint64 byteSize() const override
+    {
+        return qint64(mRowCount) * mColumnCount * (sizeof(double) + sizeof(int));
+    }
+
+    const QSharedPointer<DataHandler::CoefficientInfo>& coefficientInfo() const
+    {
+        return mCoeffInfo;
+    }
+
     auto& operator=(const BPScalingProvider& other)
     {
         for (int r=0; r<mRowCount; ++r) {
@@ -401,15 +469,20 @@ private:
     void aggregateId()
     {
         int minRow = 1, maxRow = 0;
+        auto values = jacobianValues(mModelInstance.useOutput());
         for (const auto& equation : mModelInstance.equations()) {
+            if (isCancelled())
+                return;
             double rhsMin = std::numeric_limits<double>::max();
             double rhsMax = std::numeric_limits<double>::lowest();
             double eqnMin = std::numeric_limits<double>::max();
             double eqnMax = std::numeric_limits<double>::lowest();
             mCoeffInfo->count()[maxRow][mColumnCount-2] = mModelInstance.equationType(equation->firstSection());
             for (int r=equation->firstSection(); r<=equation->lastSection(); ++r) {
+                if (!(r % CancellationToken::CheckInterval) && isCancelled())
+                    return;
                 auto sparseRow = dataRow(r);
-                auto data = mModelInstance.useOutput() ? sparseRow->outputData() : sparseRow->inputData();
+                auto data = values.row(r);
                 auto rhs = mModelInstance.rhs(r);
                 if (rhs != 0.0) {
                     rhsMin = std::min(rhsMin, rhs);
@@ -420,7 +493,7 @@ private:
                 for (int i=0; i<sparseRow->entries(); ++i) {
                     auto value = data[i];
                     auto column = mModelInstance.variable(sparseRow->colIdx()[i])->logicalIndex();
-                    if (sparseRow->nlFlags()[i]) {
+                    if (sparseRow->isNonlinear(i)) {
                         ++mCoeffInfo->nlFlags()[minRow][column];
                         ++mCoeffInfo->nlFlags()[maxRow][column];
                         ++mNlFlags[minRow][column];
@@ -428,6 +501,8 @@ private:
                     }
                     mDataMatrix[minRow][column] = std::min(value, mDataMatrix[minRow][column]);
                     mDataMatrix[maxRow][column] = std::max(value, mDataMatrix[maxRow][column]);
+                    if (mHistogram)
+                        mHistogram->add(column, value);
                     if (value < 0) {
                         ++mCoeffInfo->count()[minRow][column];
                     } else if (value > 0) {
@@ -435,6 +510,8 @@ private:
                     }
                 }
             }
+            if (mHistogram)
+                mHistogram->finishRow(equation->logicalIndex());
             mDataMatrix[minRow][mColumnCount-2] = rhsMin;
             mDataMatrix[maxRow][mColumnCount-2] = rhsMax;
             mDataMatrix[mRowCount-1][mColumnCount-2] = std::min(mDataMatrix[mRowCount-1][mColumnCount-2], rhsMin);
@@ -476,20 +553,29 @@ private:
         }
         mDataHandler->setModelMinimum(mDataMinimum);
         mDataHandler->setModelMaximum(mDataMaximum);
+        if (mHistogram) {
+            mHistogram->finish();
+            mDataHandler->setLogHistogram(mHistogram);
+        }
     }
 
     void aggregateAbs()
     {
         int minRow = 1, maxRow = 0;
+        auto values = jacobianValues(mModelInstance.useOutput());
         for (const auto& equation : mModelInstance.equations()) {
+            if (isCancelled())
+                return;
             double rhsMin = std::numeric_limits<double>::max();
             double rhsMax = std::numeric_limits<double>::lowest();
             double eqnMin = std::numeric_limits<double>::max();
             double eqnMax = std::numeric_limits<double>::lowest();
             mCoeffInfo->count()[maxRow][mColumnCount-2] = mModelInstance.equationType(equation->firstSection());
             for (int r=equation->firstSection(); r<=equation->lastSection(); ++r) {
+                if (!(r % CancellationToken::CheckInterval) && isCancelled())
+                    return;
                 auto sparseRow = dataRow(r);
-                auto data = mModelInstance.useOutput() ? sparseRow->outputData() : sparseRow->inputData();
+                auto data = values.row(r);
                 auto rhs = mModelInstance.rhs(r);
                 if (rhs != 0.0) {
                     rhsMin = std::min(rhsMin, std::abs(rhs));
@@ -500,7 +586,7 @@ private:
                 for (int i=0; i<sparseRow->entries(); ++i) {
                     auto value = data[i];
                     auto column = mModelInstance.variable(sparseRow->colIdx()[i])->logicalIndex();
-                    if (sparseRow->nlFlags()[i]) {
+                    if (sparseRow->isNonlinear(i)) {
                         ++mCoeffInfo->nlFlags()[minRow][column];
                         ++mCoeffInfo->nlFlags()[maxRow][column];
                         ++mNlFlags[minRow][column];
@@ -508,6 +594,8 @@ private:
                     }
                     mDataMatrix[minRow][column] = std::min(std::abs(data[i]), mDataMatrix[minRow][column]);
                     mDataMatrix[maxRow][column] = std::max(std::abs(data[i]), mDataMatrix[maxRow][column]);
+                    if (mHistogram)
+                        mHistogram->add(column, value);
                     if (value < 0) {
                         ++mCoeffInfo->count()[minRow][column];
                     } else if (value > 0) {
@@ -515,6 +603,8 @@ private:
                     }
                 }
             }
+            if (mHistogram)
+                mHistogram->finishRow(equation->logicalIndex());
             mDataMatrix[minRow][mColumnCount-2] = rhsMin;
             mDataMatrix[maxRow][mColumnCount-2] = rhsMax;
             mDataMatrix[mRowCount-1][mColumnCount-2] = std::min(mDataMatrix[mRowCount-1][mColumnCount-2], rhsMin);
@@ -556,6 +646,10 @@ private:
         }
         mDataHandler->setModelMinimum(mDataMinimum);
         mDataHandler->setModelMaximum(mDataMaximum);
+        if (mHistogram) {
+            mHistogram->finish();
+            mDataHandler->setLogHistogram(mHistogram);
+        }
     }
 
     void setEmtpyCell(int row, int column)
@@ -570,6 +664,12 @@ private:
     double** mDataMatrix;
     QSharedPointer<DataHandler::CoefficientInfo> mCoeffInfo;
     int** mNlFlags;
+
+    ///
+    /// \brief Histogram filled in the aggregation pass, only set for the
+    ///        predefined scaling view.
+    ///
+    QSharedPointer<LogHistogram> mHistogram;
 };
 
 class SymbolsDataProvider final : public DataHandler::AbstractDataProvider
@@ -604,29 +704,26 @@ private:
             : mEntries(other.mEntries)
             , mFirstIdx(other.mFirstIdx)
             , mData(new double[other.mEntries])
-            , mNlFlags(new int[other.mEntries])
+            , mNlFlags(other.mNlFlags)
         {
             std::copy(other.mData, other.mData+other.mEntries, mData);
-            std::copy(other.mNlFlags, other.mNlFlags+other.mEntries, mNlFlags);
         }
 
         SymbolRow(SymbolRow&& other) noexcept
             : mEntries(other.mEntries)
             , mFirstIdx(other.mFirstIdx)
             , mData(other.mData)
-            , mNlFlags(other.mNlFlags)
+            , mNlFlags(std::move(other.mNlFlags))
             , mIndices(std::move(other.mIndices))
         {
             other.mEntries = 0;
             other.mFirstIdx = 0;
             other.mData = nullptr;
-            other.mNlFlags = nullptr;
         }
 
         ~SymbolRow()
         {
             if (mData) delete [] mData;
-            if (mNlFlags) delete [] mNlFlags;
         }
 
         inline int entries() const
@@ -664,12 +761,12 @@ private:
             mData = data;
         }
 
-        inline int* nlFlags()
+        inline PackedBitSet& nlFlags()
         {
             return mNlFlags;
         }
 
-        inline void setNlFlags(int* nlFlags)
+        inline void setNlFlags(const PackedBitSet& nlFlags)
         {
             mNlFlags = nlFlags;
         }
@@ -682,14 +779,12 @@ private:
         auto& operator=(const SymbolRow& other)
         {
             if (mData) delete [] mData;
-            if (mNlFlags) delete [] mNlFlags;
             mEntries = other.mEntries;
             mFirstIdx = other.mFirstIdx;
             mData = new double[other.mEntries];
-            mNlFlags = new int[other.mEntries];
+            mNlFlags = other.mNlFlags;
             mIndices = other.mIndices;
             std::copy(other.mData, other.mData+other.mEntries, mData);
-            std::copy(other.mNlFlags, other.mNlFlags+other.mEntries, mNlFlags);
             return *this;
         }
 
@@ -701,8 +796,7 @@ private:
             other.mFirstIdx = 0;
             mData = other.mData;
             other.mData = nullptr;
-            mNlFlags = other.mNlFlags;
-            other.mNlFlags = nullptr;
+            mNlFlags = std::move(other.mNlFlags);
             mIndices = std::move(other.mIndices);
             return *this;
         }
@@ -711,7 +805,7 @@ private:
         int mEntries = 0;
         int mFirstIdx = 0;
         double* mData = nullptr;
-        int *mNlFlags = nullptr;
+        PackedBitSet mNlFlags;
         QList<int> mIndices;
     };
 
@@ -815,7 +909,40 @@ public:
         if (column < mRows[row].firstIdx() || column > mRows[row].lastIdx()) {
             return 0;
         }
-        return mRows[row].nlFlags()[column-mRows[row].firstIdx()];
+        return mRows[row].nlFlags().test(column-mRows[row].firstIdx());
+    }
+
+    qint64 byteSize() const override
+    {
+        if (!mRows || !mColumns)
+            return 0;
+        qint64 size = qint64(mRowCount) * sizeof(SymbolRow) + qint64(mColumnCount) * sizeof(SymbolColumn);
+        for (int r=0; r<mRowCount; ++r)
+            size += qint64(mRows[r].entries()) * sizeof(double) + mRows[r].nlFlags().byteSize() + mRows[r].indices().size() * sizeof(int);
+        for (int c=0; c<mColumnCount; ++c)
+            size += mColumns[c].entries() * sizeof(int);
+        return size;
+    }
+
+    void fillTile(DataTile &tile) const override
+    {
+        if (!mRows)
+            return;
+        int lastColumn = tile.FirstColumn + tile.ColumnCount - 1;
+        for (int r=0; r<tile.RowCount; ++r) {
+            auto& symbolRow = mRows[tile.FirstRow + r];
+            if (!symbolRow.entries())
+                continue;
+            int first = std::max(tile.FirstColumn, symbolRow.firstIdx());
+            int last = std::min(lastColumn, symbolRow.lastIdx());
+            for (int column=first; column<=last; ++column) {
+                int i = tile.offset(tile.FirstRow + r, column);
+                int entry = column - symbolRow.firstIdx();
+                tile.Values[i] = symbolRow.data()[entry];
+                tile.Mask[i] = tile.Values[i] != 0.0;
+                tile.NlFlags[i] = symbolRow.nlFlags().test(entry);
+            }
+        }
     }
 
     int columnEntryCount(int column) const override
@@ -871,10 +998,13 @@ private:
     void aggregate(QList<Symbol*>& equations, QList<Symbol*>& variables)
     {
         int rr = 0;
+        auto values = jacobianValues(mModelInstance.useOutput());
         for (auto* equation : equations) {
             for (int r=equation->firstSection(); r<=equation->lastSection(); ++r, ++rr) {
+                if (!(r % CancellationToken::CheckInterval) && isCancelled())
+                    return;
                 auto sparseRow = dataRow(r);
-                auto data = mModelInstance.useOutput() ? sparseRow->outputData() : sparseRow->inputData();
+                auto data = values.row(r);
                 int sparseIdx = 0;
                 int variableEntries = 0;
                 QList<int> sparseIndicies, rIndices;
@@ -901,25 +1031,24 @@ private:
                 SymbolRow* row = &mRows[rr];
                 row->setEntries(lastIdx - firstIdx + 1);
                 row->setData(new double[row->entries()]);
-                row->setNlFlags(new int[row->entries()]);
+                row->setNlFlags(PackedBitSet(row->entries()));
                 row->setFirstIdx(firstIdx - firstSection);
                 row->indices() = std::move(rIndices);
                 if (variableEntries == sparseIndicies.size()) {
                     for (auto idx : sparseIndicies) {
                         int column = sparseRow->colIdx()[idx] - firstSection;
                         row->data()[column] = value(data[idx]);
-                        row->nlFlags()[column] = sparseRow->nlFlags()[idx];
+                        row->nlFlags().set(column, sparseRow->isNonlinear(idx));
                         mDataMinimum = std::min(mDataMinimum, row->data()[idx]);
                         mDataMaximum = std::max(mDataMaximum, row->data()[idx]);
                         mColumns[column].indices().append(rr);
                     }
                 } else {
                     std::fill(row->data(), row->data()+row->entries(), 0.0);
-                    std::fill(row->nlFlags(), row->nlFlags()+row->entries(), 0);
                     for (auto idx : sparseIndicies) {
                         int column = sparseRow->colIdx()[idx] - firstIdx;
                         row->data()[column] = value(data[idx]);
-                        row->nlFlags()[column] = sparseRow->nlFlags()[idx];
+                        row->nlFlags().set(column, sparseRow->isNonlinear(idx));
                         mDataMinimum = std::min(mDataMinimum, row->data()[idx]);
                         mDataMaximum = std::max(mDataMaximum, row->data()[idx]);
                         mColumns[sparseRow->colIdx()[idx] - firstSection].indices().append(rr);
@@ -1045,6 +1174,8 @@ public:
             mLogicalSectionMapping[Qt::Horizontal].append(variable->firstSection());
         }
         for (int r=0; r<mModelInstance.equationCount(); ++r, negRow += 2, posRow += 2) {
+            if (!(r % CancellationToken::CheckInterval) && isCancelled())
+                return;
             for (int c=0; c<mColumnCount-2; ++c) {
                 if (mCoeffCount->count()[negRow][c] == 0 && mCoeffCount->count()[posRow][c] == 0) {
                     mDataMatrix[r][c] = 0x0;
@@ -1110,6 +1241,11 @@ public:
         return mNlFlags[row][column];
     }
 
+    qint64 byteSize() const override
+    {
+        return qint64(mRowCount) * mColumnCount * (sizeof(char) + sizeof(int));
+    }
+
     auto& operator=(const BPOverviewDataProvider& other)
     {
         for (int r=0; r<mRowCount; ++r) {
@@ -1240,6 +1376,8 @@ public:
             mLogicalSectionMapping[Qt::Horizontal].append(variable->firstSection());
         }
         for (int r=0, negRow = 1, posRow = 0; r<mModelInstance.equationCount(); ++r, negRow += 2, posRow += 2) {
+            if (!(r % CancellationToken::CheckInterval) && isCancelled())
+                return;
             for (int v=0; v<mModelInstance.variableCount(); ++v) {
                 mDataMatrix[negRow][mColumnCount-2] += mDataMatrix[negRow][v];
                 mDataMatrix[posRow][mColumnCount-2] += mDataMatrix[posRow][v];
@@ -1327,6 +1465,11 @@ public:
         return mNlFlags[row][column];
     }
 
+    qint64 byteSize() const override
+    {
+        return qint64(mRowCount) * mColumnCount * (sizeof(int) + sizeof(int));
+    }
+
     auto& operator=(const BPCountDataProvider& other)
     {
         for (int r=0; r<mRowCount; ++r) {
@@ -1460,6 +1603,8 @@ public:
             ++index;
         }
         for (int r=0, negRow = 1, posRow = 0; r<mModelInstance.equationCount(); ++r, negRow += 2, posRow += 2) {
+            if (!(r % CancellationToken::CheckInterval) && isCancelled())
+                return;
             for (int c=0; c<mColumnCount-4; ++c) {
                 mDataMatrix[negRow][c] = mCoeffInfo->count()[negRow][c] / mDataMatrix[mRowCount-2][c];
                 mDataMatrix[negRow][mColumnCount-2] += mCoeffInfo->count()[negRow][c];
@@ -1547,6 +1692,11 @@ public:
         return mNlFlags[row][column];
     }
 
+    qint64 byteSize() const override
+    {
+        return qint64(mRowCount) * mColumnCount * (sizeof(double) + sizeof(int));
+    }
+
     auto& operator=(const BPAverageDataProvider& other)
     {
         for (int r=0; r<mRowCount; ++r) {
@@ -1596,7 +1746,7 @@ public:
         : DataHandler::AbstractDataProvider(dataHandler, modelInstance, viewConfig)
     {
         mColumnCount = 5;
-        mRootItem = QSharedPointer<PostoptTreeItem>(new LinePostoptTreeItem());
+        mRootItem = QSharedPointer<RootPostoptTreeItem>(new RootPostoptTreeItem);
         value = std::bind(&PostoptDataProvider::identity, this, std::placeholders::_1);
     }
 
@@ -1626,77 +1776,84 @@ public:
         } else {
             value = std::bind(&PostoptDataProvider::identity, this, std::placeholders::_1);
         }
-        mRootItem = QSharedPointer<PostoptTreeItem>(new LinePostoptTreeItem());
+        mRootItem = QSharedPointer<RootPostoptTreeItem>(new RootPostoptTreeItem);
+        auto& arena = mRootItem->arena();
 
-        auto equations = new GroupPostoptTreeItem(ViewHelper::EquationHeaderText);
+        auto equationsMark = arena.mark();
+        auto equations = arena.create<GroupPostoptTreeItem>(ViewHelper::EquationHeaderText);
         auto eqnFilter = mViewConfig->currentIdentifierFilter()[Qt::Vertical];
         for (auto equation : mModelInstance.equations()) {
             if (!eqnFilter[equation->firstSection()].Checked) {
                 continue;
             }
-            auto eqnGroup = new GroupPostoptTreeItem(equation->name(), equations);
-            for (int e=0; e<equation->entries(); ++e) {
+            auto eqnGroupMark = arena.mark();
+            auto eqnGroup = arena.create<GroupPostoptTreeItem>(equation->name(), equations);
+            for (int e=0; e<equation->entries() && !isCancelled(); ++e) {
                 if (skipEntry(equation, e, Qt::Vertical))
                     continue;
-                auto eqnLine = new GroupPostoptTreeItem(symbolName(equation, e));
+                auto eqnLineMark = arena.mark();
+                auto eqnLine = arena.create<GroupPostoptTreeItem>(symbolName(equation, e));
                 loadAttributes(equation, e, eqnLine);
                 loadVariables(equation, e, eqnLine);
                 if (eqnLine->rowCount()) {
                     eqnLine->setParent(eqnGroup);
                     eqnGroup->append(eqnLine);
                 } else {
-                    delete eqnLine;
+                    arena.rollback(eqnLineMark);
                 }
             }
             if (eqnGroup->rowCount()) {
                 eqnGroup->setParent(equations);
                 equations->append(eqnGroup);
             } else {
-                delete eqnGroup;
+                arena.rollback(eqnGroupMark);
             }
         }
         if (equations->rowCount()) {
             equations->setParent(mRootItem.get());
             mRootItem->append(equations);
         } else {
-            delete equations;
+            arena.rollback(equationsMark);
         }
 
-        auto variables = new GroupPostoptTreeItem(ViewHelper::VariableHeaderText);
+        auto variablesMark = arena.mark();
+        auto variables = arena.create<GroupPostoptTreeItem>(ViewHelper::VariableHeaderText);
         auto varFilter = mViewConfig->currentIdentifierFilter()[Qt::Horizontal];
         for (auto variable : mModelInstance.variables()) {
             if (!varFilter[variable->firstSection()].Checked) {
                 continue;
             }
-            auto varGroup = new GroupPostoptTreeItem(variable->name());
-            for (int e=0; e<variable->entries(); ++e) {
+            auto varGroupMark = arena.mark();
+            auto varGroup = arena.create<GroupPostoptTreeItem>(variable->name());
+            for (int e=0; e<variable->entries() && !isCancelled(); ++e) {
                 if (skipEntry(variable, e, Qt::Horizontal))
                     continue;
-                auto varLine = new GroupPostoptTreeItem(symbolName(variable, e));
+                auto varLineMark = arena.mark();
+                auto varLine = arena.create<GroupPostoptTreeItem>(symbolName(variable, e));
                 loadAttributes(variable, e, varLine);
                 loadEquations(variable, e, varLine);
                 if (varLine->rowCount()) {
                     varLine->setParent(varGroup);
                     varGroup->append(varLine);
                 } else {
-                    delete varLine;
+                    arena.rollback(varLineMark);
                 }
             }
             if (varGroup->rowCount()) {
                 varGroup->setParent(variables);
                 variables->append(varGroup);
             } else {
-                delete varGroup;
+                arena.rollback(varGroupMark);
             }
         }
         if (variables->rowCount()) {
             variables->setParent(mRootItem.get());
             mRootItem->append(variables);
         } else {
-            delete variables;
+            arena.rollback(variablesMark);
         }
         if (!mRootItem->rowCount()) {
-            auto line = new ClickPostoptTreeItem("Please click here to configure the views content.", mRootItem.get());
+            auto line = arena.create<ClickPostoptTreeItem>("Please click here to configure the views content.", mRootItem.get());
             mRootItem->append(line);
         }
     }
@@ -1713,6 +1870,11 @@ public:
         return mRootItem;
     }
 
+    qint64 byteSize() const override
+    {
+        return mRootItem ? qint64(mRootItem->arena().blockCount()) * PostoptTreeArena::BlockSize : 0;
+    }
+
     auto& operator=(const PostoptDataProvider& other)
     {
         mRootItem = other.mRootItem;
@@ -1730,7 +1892,9 @@ private:
     void loadAttributes(Symbol *symbol, int entry, PostoptTreeItem *parent)
     {
         bool abs = mViewConfig->currentValueFilter().isAbsolute();
-        auto attributes = new GroupPostoptTreeItem(ViewHelper::AttributeHeaderText);
+        auto& arena = mRootItem->arena();
+        auto attributesMark = arena.mark();
+        auto attributes = arena.create<GroupPostoptTreeItem>(ViewHelper::AttributeHeaderText);
         for (const auto& label : AttributeHelper::attributeTextList()) {
             if (mViewConfig->currentAttributeFilter().value(label) == Qt::Unchecked) {
                 continue;
@@ -1741,102 +1905,198 @@ private:
             } else if (symbol->isVariable()) {
                 value = mModelInstance.variableAttribute(label, symbol->firstSection(), entry, abs);
             }
-            attributes->append(new LinePostoptTreeItem({label, value}, attributes));
+            attributes->append(arena.create<LinePostoptTreeItem>(QVector<QVariant>({label, value}), attributes));
         }
         if (attributes->rowCount()) {
             attributes->setParent(parent);
             parent->append(attributes);
         } else {
-            delete attributes;
+            arena.rollback(attributesMark);
         }
     }
 
     void loadEquations(Symbol *variable, int entry, PostoptTreeItem *parent)
     {
+        if (mViewConfig->currentContributionFilter().isActive()) {
+            loadTopEquations(variable, entry, parent);
+            return;
+        }
         bool abs = mViewConfig->currentValueFilter().isAbsolute();
-        auto equations = new LinePostoptTreeItem(PostoptTreeItem::EquationLineHeader);
+        auto values = jacobianValues(true);
+        auto& arena = mRootItem->arena();
+        auto equationsMark = arena.mark();
+        auto equations = arena.create<LinePostoptTreeItem>(PostoptTreeItem::EquationLineHeader);
         for (auto equation : mModelInstance.equations()) {
-            auto eqnGroup = new GroupPostoptTreeItem(equation->name());
-            for (int e=0; e<equation->entries(); ++e) {
+            auto eqnGroupMark = arena.mark();
+            auto eqnGroup = arena.create<GroupPostoptTreeItem>(equation->name());
+            for (int e=0; e<equation->entries() && !isCancelled(); ++e) {
                 if (skipEntry(equation, e, Qt::Vertical))
                     continue;
                 auto row = dataRow(equation->firstSection()+e);
                 QVariant jacval;
                 if (row) {
-                    jacval = row->outputValue(variable->firstSection()+entry, variable->lastSection());
+                    jacval = row->outputValue(values.nlValues(equation->firstSection()+e),
+                                              variable->firstSection()+entry, variable->lastSection());
                 }
                 if (jacval.isValid()) {
                     auto name = symbolName(equation, e);
                     double jac = value(jacval.toDouble());
                     double xi = value(mModelInstance.equationAttribute(AttributeHelper::MarginalNumText, equation->firstSection(), e, abs).toDouble());
                     double jacxi = value(jacval.toDouble() * xi);
-                    eqnGroup->append(new LinePostoptTreeItem(
-                        {
-                         name,
-                         DoubleFormatter::format(jac, DoubleFormatter::g, 6, true),
-                         DoubleFormatter::format(xi, DoubleFormatter::g, 6, true),
-                         DoubleFormatter::format(jacxi, DoubleFormatter::g, 6, true)
-                        },
-                        eqnGroup));
+                    eqnGroup->append(arena.create<ValuePostoptTreeItem>(name, jac, xi, jacxi, eqnGroup));
                 }
             }
             if (eqnGroup->rowCount()) {
                 eqnGroup->setParent(equations);
                 equations->append(eqnGroup);
             } else {
-                delete eqnGroup;
+                arena.rollback(eqnGroupMark);
             }
         }
         if (equations->rowCount()) {
             equations->setParent(parent);
             parent->append(equations);
         } else {
-            delete equations;
+            arena.rollback(equationsMark);
         }
     }
 
     void loadVariables(Symbol *equation, int entry, PostoptTreeItem *parent)
     {
+        if (mViewConfig->currentContributionFilter().isActive()) {
+            loadTopVariables(equation, entry, parent);
+            return;
+        }
         bool abs = mViewConfig->currentValueFilter().isAbsolute();
-        auto variables = new LinePostoptTreeItem(PostoptTreeItem::VariableLineHeader);
+        auto values = jacobianValues(true);
+        auto& arena = mRootItem->arena();
+        auto variablesMark = arena.mark();
+        auto variables = arena.create<LinePostoptTreeItem>(PostoptTreeItem::VariableLineHeader);
         for (auto variable : mModelInstance.variables()) {
-            auto varGroup = new GroupPostoptTreeItem(variable->name());
-            for (int e=0; e<variable->entries(); ++e) {
+            auto varGroupMark = arena.mark();
+            auto varGroup = arena.create<GroupPostoptTreeItem>(variable->name());
+            for (int e=0; e<variable->entries() && !isCancelled(); ++e) {
                 if (skipEntry(variable, e, Qt::Horizontal))
                     continue;
                 auto row = dataRow(equation->firstSection()+entry);
                 QVariant jacval;
                 if (row) {
-                    jacval = row->outputValue(variable->firstSection()+e, variable->lastSection());
+                    jacval = row->outputValue(values.nlValues(equation->firstSection()+entry),
+                                              variable->firstSection()+e, variable->lastSection());
                 }
                 if (jacval.isValid()) {
                     auto name = symbolName(variable, e);
                     double jac = value(jacval.toDouble());
                     double ui = value(mModelInstance.variableAttribute(AttributeHelper::LevelText, variable->firstSection(), e, abs).toDouble());
                     double jacui = value(jac * ui);
-                    varGroup->append(new LinePostoptTreeItem(
-                        {
-                         name,
-                         DoubleFormatter::format(jac, DoubleFormatter::g, 6, true),
-                         DoubleFormatter::format(ui, DoubleFormatter::g, 6, true),
-                         DoubleFormatter::format(jacui, DoubleFormatter::g, 6, true)
-                        },
-                        varGroup));
+                    varGroup->append(arena.create<ValuePostoptTreeItem>(name, jac, ui, jacui, varGroup));
                 }
             }
             if (varGroup->rowCount()) {
                 varGroup->setParent(variables);
                 variables->append(varGroup);
             } else {
-                delete varGroup;
+                arena.rollback(varGroupMark);
             }
         }
         if (variables->rowCount()) {
             variables->setParent(parent);
             parent->append(variables);
         } else {
-            delete variables;
+            arena.rollback(variablesMark);
+        }
+    }
+
+    ///
+    /// \brief Equations of the largest jac*marginal products of a variable
+    ///        column, see ContributionFilter.
+    ///
+    void loadTopEquations(Symbol *variable, int entry, PostoptTreeItem *parent)
+    {
+        bool abs = mViewConfig->currentValueFilter().isAbsolute();
+        const int column = variable->firstSection()+entry;
+        auto values = jacobianValues(true);
+        QVector<Contribution> contributions;
+        for (auto equation : mModelInstance.equations()) {
+            for (int e=0; e<equation->entries() && !isCancelled(); ++e) {
+                if (skipEntry(equation, e, Qt::Vertical))
+                    continue;
+                auto row = dataRow(equation->firstSection()+e);
+                if (!row)
+                    continue;
+                const int *index = row->colIdx();
+                auto last = index + row->entries();
+                auto pos = std::find(index, last, column);
+                if (pos == last)
+                    continue;
+                Contribution contribution;
+                contribution.Section = equation->firstSection()+e;
+                auto jac = values.row(contribution.Section);
+                contribution.Jacobian = value(jac[pos-index]);
+                contribution.Value = value(mModelInstance.equationAttribute(AttributeHelper::MarginalNumText,
+                                                                            equation->firstSection(), e, abs).toDouble());
+                contribution.Product = value(jac[pos-index] * contribution.Value);
+                contributions.append(contribution);
+            }
         }
+        appendContributions(contributions, Qt::Vertical, parent);
+    }
+
+    ///
+    /// \brief Variables of the largest jac*level products of an equation
+    ///        row, selected from the row's sparse entries, see
+    ///        ContributionFilter.
+    ///
+    void loadTopVariables(Symbol *equation, int entry, PostoptTreeItem *parent)
+    {
+        auto row = dataRow(equation->firstSection()+entry);
+        if (!row)
+            return;
+        bool abs = mViewConfig->currentValueFilter().isAbsolute();
+        QVector<Contribution> contributions;
+        contributions.reserve(row->entries());
+        const int *index = row->colIdx();
+        auto values = jacobianValues(true);
+        auto jac = values.row(equation->firstSection()+entry);
+        for (int e=0; e<row->entries(); ++e) {
+            auto variable = mModelInstance.variable(index[e]);
+            if (!variable)
+                continue;
+            const int varEntry = index[e] - variable->firstSection();
+            if (skipEntry(variable, varEntry, Qt::Horizontal))
+                continue;
+            Contribution contribution;
+            contribution.Section = index[e];
+            contribution.Jacobian = value(jac[e]);
+            contribution.Value = value(mModelInstance.variableAttribute(AttributeHelper::LevelText,
+                                                                        variable->firstSection(), varEntry, abs).toDouble());
+            contribution.Product = value(contribution.Jacobian * contribution.Value);
+            contributions.append(contribution);
+        }
+        appendContributions(contributions, Qt::Horizontal, parent);
+    }
+
+    void appendContributions(QVector<Contribution> &contributions,
+                             Qt::Orientation orientation,
+                             PostoptTreeItem *parent)
+    {
+        mViewConfig->currentContributionFilter().apply(contributions);
+        if (contributions.isEmpty())
+            return;
+        const bool isEquation = orientation == Qt::Vertical;
+        auto& arena = mRootItem->arena();
+        auto lines = arena.create<LinePostoptTreeItem>(isEquation ? PostoptTreeItem::EquationLineHeader
+                                                                  : PostoptTreeItem::VariableLineHeader,
+                                                       parent);
+        for (const auto& contribution : std::as_const(contributions)) {
+            auto symbol = isEquation ? mModelInstance.equation(contribution.Section)
+                                     : mModelInstance.variable(contribution.Section);
+            auto name = symbolName(symbol, contribution.Section - symbol->firstSection());
+            lines->append(arena.create<ValuePostoptTreeItem>(name, contribution.Jacobian,
+                                                             contribution.Value, contribution.Product,
+                                                             lines));
+        }
+        parent->append(lines);
     }
 
     QString symbolName(Symbol *symbol, int entry)
@@ -1882,13 +2142,15 @@ private:
     }
 
 private:
-    QSharedPointer<PostoptTreeItem> mRootItem;
+    QSharedPointer<RootPostoptTreeItem> mRootItem;
     std::function<double(double)> value;
 };
 
 DataHandler::DataHandler(AbstractModelInstance& modelInstance)
     : mModelInstance(modelInstance)
     , mDataMatrix(new DataMatrix)
+    , mDataCache(std::make_shared<const ProviderCache>())
+    , mSerial(++HandlerSerial)
 {
 
 }
@@ -1898,120 +2160,284 @@ DataHandler::~DataHandler()
 
 }
 
-void DataHandler::loadData(const QSharedPointer<AbstractViewConfiguration> &viewConfig)
+void DataHandler::loadData(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                           const CancellationToken &token)
 {
     if (!viewConfig)
         return;
-    if (viewConfig->viewType() == ViewHelper::ViewDataType::BP_Scaling &&
-        mDataCache.contains(viewConfig->viewId()) &&
-        mDataCache[viewConfig->viewId()]->isAbsoluteData() == viewConfig->currentValueFilter().isAbsolute()) {
-        return;
+    if (viewConfig->viewType() == ViewHelper::ViewDataType::BP_Scaling) {
+        // the predefined view is loaded again if its histogram was dropped
+        auto current = provider(viewConfig->viewId());
+        if (current && current->isAbsoluteData() == viewConfig->currentValueFilter().isAbsolute() &&
+            (viewConfig->viewId() != (int)ViewHelper::ViewDataType::BP_Scaling ||
+             logHistogram(mModelInstance.useOutput())))
+            return;
     }
     auto provider = newProvider(viewConfig);
-    mDataCache.remove(viewConfig->viewId());
+    provider->setCancellationToken(token);
     provider->loadData();
-    mDataCache[viewConfig->viewId()] = provider;
+    if (provider->isCancelled()) {
+        ++mRevision;
+        return;
+    }
+    if (viewConfig->viewId() == (int)ViewHelper::ViewDataType::BP_Scaling) {
+        // the counts are complete and not written anymore
+        QMutexLocker locker(&mCoeffLock);
+        mCoeffCount = static_cast<BPScalingProvider*>(provider.get())->coefficientInfo();
+    }
+    setProvider(viewConfig->viewId(), provider);
 }
 
 QVariant DataHandler::data(int row, int column, int viewId) const
 {
-    if (mDataCache.contains(viewId) && mDataCache[viewId]->data(row, column) != 0.0) {
-        return mDataCache[viewId]->data(row, column);
+    auto provider = this->provider(viewId);
+    if (provider && provider->data(row, column) != 0.0) {
+        return provider->data(row, column);
     }
     return QVariant();
 }
 
 int DataHandler::nlFlag(int row, int column, int viewId)
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->nlFlag(row, column) : 0;
+    auto provider = this->provider(viewId);
+    return provider ? provider->nlFlag(row, column) : 0;
+}
+
+DataTile DataHandler::fetchTile(int viewId,
+                                const SectionRange &rows,
+                                const SectionRange &columns) const
+{
+    DataTile tile;
+    tile.ViewId = viewId;
+    tile.Revision = mRevision;
+    auto provider = this->provider(viewId);
+    if (!provider)
+        return tile;
+    tile.resize(SectionRange(qMax(0, rows.first), qMin(rows.second, provider->rowCount()-1)),
+                SectionRange(qMax(0, columns.first), qMin(columns.second, provider->columnCount()-1)));
+    provider->fillTile(tile);
+    return tile;
+}
+
+int DataHandler::revision() const
+{
+    return mRevision;
+}
+
+QSharedPointer<SparsityPyramid> DataHandler::sparsityPyramid(bool useOutput)
+{
+    QMutexLocker locker(&mPyramidLock);
+    if (!mSparsityPyramid || mSparsityPyramid->usesOutput() != useOutput)
+        mSparsityPyramid = SparsityPyramid::build(*mDataMatrix, useOutput);
+    return mSparsityPyramid;
+}
+
+QVector<CoefficientHit> DataHandler::findCoefficients(const CoefficientSearch::Range &range,
+                                                      bool useOutput,
+                                                      const QBitArray &rows,
+                                                      const QBitArray &columns,
+                                                      int maxHits, qint64 *total,
+                                                      const CancellationToken &token)
+{
+    return CoefficientSearch::run(*mDataMatrix, useOutput, range, maxHits, total, rows, columns, token);
+}
+
+QSharedPointer<ScalingAdvice> DataHandler::scalingAdvice(bool useOutput,
+                                                         const QVector<double> &equationScales,
+                                                         const QVector<double> &variableScales,
+                                                         const ScalingAdvisor::Options &options)
+{
+    return ScalingAdvisor::run(*mDataMatrix, useOutput, equationScales, variableScales, options);
+}
+
+QVector<StructuralFinding> DataHandler::structuralDiagnostics(bool useOutput,
+                                                              const QByteArray &equationTypes,
+                                                              const QVector<double> &lower,
+                                                              const QVector<double> &upper)
+{
+    return StructuralDiagnostics::run(*mDataMatrix, useOutput, equationTypes, lower, upper);
+}
+
+QSharedPointer<ComponentPartition> DataHandler::components(ComponentAnalysis::Level level)
+{
+    QMutexLocker locker(&mComponentLock);
+    if (level == ComponentAnalysis::Sections) {
+        if (!mSectionComponents)
+            mSectionComponents.reset(new ComponentPartition(ComponentAnalysis::run(*mDataMatrix)));
+        return mSectionComponents;
+    }
+    if (!mSymbolComponents) {
+        auto rowGroups = sectionSymbols(mModelInstance.equations(), mDataMatrix->rowCount());
+        auto columnGroups = sectionSymbols(mModelInstance.variables(), mDataMatrix->columnCount());
+        auto partition = ComponentAnalysis::run(*mDataMatrix,
+                                                rowGroups, mModelInstance.equations().size(),
+                                                columnGroups, mModelInstance.variables().size());
+        mSymbolComponents.reset(new ComponentPartition(std::move(partition)));
+    }
+    return mSymbolComponents;
+}
+
+QVector<ResidualSummary> DataHandler::primalResiduals(const QVector<double> &levels,
+                                                      const QVector<double> &rowLevels,
+                                                      const QVector<double> &rhs,
+                                                      const QByteArray &equationTypes)
+{
+    auto rowSymbols = sectionSymbols(mModelInstance.equations(), mDataMatrix->rowCount());
+    return PrimalResidual::run(*mDataMatrix, levels, rowLevels, rhs, equationTypes,
+                               rowSymbols, mModelInstance.equations().size());
+}
+
+QVector<DualSummary> DataHandler::dualResiduals(bool useOutput,
+                                                const QVector<double> &objective,
+                                                const QVector<int> &objectiveNlFlags,
+                                                const QVector<double> &rowMarginals,
+                                                const QVector<double> &marginals)
+{
+    auto columnSymbols = sectionSymbols(mModelInstance.variables(), mDataMatrix->columnCount());
+    return DualResidual::run(*mDataMatrix, useOutput, objective, objectiveNlFlags,
+                             rowMarginals, marginals, columnSymbols,
+                             mModelInstance.variables().size());
+}
+
+QSharedPointer<LogHistogram> DataHandler::logHistogram(bool useOutput)
+{
+    QMutexLocker locker(&mHistogramLock);
+    if (mLogHistogram && mLogHistogram->usesOutput() == useOutput)
+        return mLogHistogram;
+    return QSharedPointer<LogHistogram>();
+}
+
+void DataHandler::setLogHistogram(const QSharedPointer<LogHistogram> &histogram)
+{
+    QMutexLocker locker(&mHistogramLock);
+    mLogHistogram = histogram;
 }
 
 QSharedPointer<PostoptTreeItem> DataHandler::dataTree(int viewId) const
 {
-    if (mDataCache.contains(viewId)) {
-        auto provider = static_cast<PostoptDataProvider*>(mDataCache[viewId].get());
-        return provider->dataTree();
-    }
+    auto provider = this->provider(viewId);
+    if (provider)
+        return static_cast<PostoptDataProvider*>(provider.get())->dataTree();
     return nullptr;
 }
 
 void DataHandler::removeViewData(int viewId)
 {
-    if (mDataCache.contains(viewId))
-        mDataCache.remove(viewId);
+    setProvider(viewId, nullptr);
 }
 
 void DataHandler::removeViewData()
 {
-    mDataCache.clear();
+    QMutexLocker locker(&mCacheLock);
+    std::atomic_store(&mDataCache, std::make_shared<const ProviderCache>());
+    mProviderSizes.clear();
+    mUsage.clear();
+    mEvicted.clear();
+    ++mRevision;
+}
+
+QSharedPointer<AbstractViewConfiguration> DataHandler::activateViewData(int viewId)
+{
+    QMutexLocker locker(&mCacheLock);
+    mActiveView = viewId;
+    if (mUsage.removeOne(viewId))
+        mUsage.append(viewId);
+    return mEvicted.take(viewId);
+}
+
+qint64 DataHandler::memoryBudget() const
+{
+    return mMemoryBudget;
+}
+
+void DataHandler::setMemoryBudget(qint64 budget)
+{
+    mMemoryBudget = budget;
+    QMutexLocker locker(&mCacheLock);
+    auto cache = std::make_shared<ProviderCache>(*std::atomic_load(&mDataCache));
+    if (evict(*cache, -1)) {
+        std::atomic_store(&mDataCache, std::shared_ptr<const ProviderCache>(std::move(cache)));
+        ++mRevision;
+    }
+}
+
+qint64 DataHandler::cacheSize() const
+{
+    QMutexLocker locker(&mCacheLock);
+    qint64 size = 0;
+    for (auto bytes : mProviderSizes)
+        size += bytes;
+    return size;
 }
 
 int DataHandler::headerData(int logicalIndex,
                             Qt::Orientation orientation,
                             int viewId) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->headerData(orientation, logicalIndex)
-                                       : -1;
+    auto provider = this->provider(viewId);
+    return provider ? provider->headerData(orientation, logicalIndex) : -1;
 }
 
 QVariant DataHandler::plainHeaderData(Qt::Orientation orientation,
                                       int viewId, int logicalIndex,
                                       int dimension) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->plainHeaderData(orientation, logicalIndex, dimension)
-                                       : QVariant();
+    auto provider = this->provider(viewId);
+    return provider ? provider->plainHeaderData(orientation, logicalIndex, dimension) : QVariant();
 }
 
 QVariant DataHandler::sectionLabels(Qt::Orientation orientation, int viewId, int logicalIndex) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->sectionLabels(orientation, logicalIndex)
-                                       : QStringList();
+    auto provider = this->provider(viewId);
+    return provider ? provider->sectionLabels(orientation, logicalIndex) : QStringList();
 }
 
 int DataHandler::rowCount(int viewId) const
 {
-    if (mDataCache.contains(viewId)) {
-        return mDataCache[viewId]->rowCount();
-    }
-    return 0;
+    auto provider = this->provider(viewId);
+    return provider ? provider->rowCount() : 0;
 }
 
 int DataHandler::rowEntryCount(int row, int viewId) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->rowEntryCount(row) : 0;
+    auto provider = this->provider(viewId);
+    return provider ? provider->rowEntryCount(row) : 0;
 }
 
 int DataHandler::columnCount(int viewId) const
 {
-    if (mDataCache.contains(viewId)) {
-        return mDataCache[viewId]->columnCount();
-    }
-    return 0;
+    auto provider = this->provider(viewId);
+    return provider ? provider->columnCount() : 0;
 }
 
 int DataHandler::columnEntryCount(int column, int viewId) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->columnEntryCount(column) : 0;
+    auto provider = this->provider(viewId);
+    return provider ? provider->columnEntryCount(column) : 0;
 }
 
-const QList<int> &DataHandler::rowIndices(int viewId, int row) const
+QList<int> DataHandler::rowIndices(int viewId, int row) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->rowIndices(row) : mDummyIndices;
+    auto provider = this->provider(viewId);
+    return provider ? provider->rowIndices(row) : QList<int>();
 }
 
-const QList<int> &DataHandler::columnIndices(int viewId, int column) const
+QList<int> DataHandler::columnIndices(int viewId, int column) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->columnIndices(column) : mDummyIndices;
+    auto provider = this->provider(viewId);
+    return provider ? provider->columnIndices(column) : QList<int>();
 }
 
 int DataHandler::symbolRowCount(int viewId) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->symbolRowCount() : 0;
+    auto provider = this->provider(viewId);
+    return provider ? provider->symbolRowCount() : 0;
 }
 
 int DataHandler::symbolColumnCount(int viewId) const
 {
-    return mDataCache.contains(viewId) ? mDataCache[viewId]->symbolColumnCount() : 0;
+    auto provider = this->provider(viewId);
+    return provider ? provider->symbolColumnCount() : 0;
 }
 
 double DataHandler::modelMinimum() const
@@ -2036,61 +2462,162 @@ void DataHandler::setModelMaximum(double maximum)
 
 int DataHandler::maxSymbolDimension(int viewId, Qt::Orientation orientation)
 {
-    if (!mDataCache.contains(viewId))
-        return 0;
-    return mDataCache[viewId]->maxSymbolDimension(orientation);
+    auto provider = this->provider(viewId);
+    return provider ? provider->maxSymbolDimension(orientation) : 0;
 }
 
 QSharedPointer<AbstractViewConfiguration> DataHandler::clone(int viewId, int newView)
 {
-    if (!mDataCache.contains(viewId))
+    auto source = provider(viewId);
+    if (!source)
         return nullptr;
-    mDataCache[newView] = QSharedPointer<AbstractDataProvider>(cloneProvider(viewId));
-    mDataCache[newView]->viewConfig()->setViewId(newView);
-    return mDataCache[newView]->viewConfig();
+    auto provider = QSharedPointer<AbstractDataProvider>(cloneProvider(source));
+    provider->viewConfig()->setViewId(newView);
+    setProvider(newView, provider);
+    return provider->viewConfig();
 }
 
 void DataHandler::loadJacobian()
 {
     mDataMatrix.reset(mModelInstance.jacobianData());
+    mPyramidLock.lock();
+    mSparsityPyramid.reset();
+    mPyramidLock.unlock();
+    mComponentLock.lock();
+    mSectionComponents.reset();
+    mSymbolComponents.reset();
+    mComponentLock.unlock();
+    setLogHistogram(QSharedPointer<LogHistogram>());
+    ++mRevision;
+}
+
+DataMatrix* DataHandler::jacobian() const
+{
+    return mDataMatrix.data();
+}
+
+void DataHandler::setNlOverlay(const std::shared_ptr<const NlOverlay> &overlay)
+{
+    mDataMatrix->setNlOverlay(overlay);
+    mPyramidLock.lock();
+    mSparsityPyramid.reset();
+    mPyramidLock.unlock();
+    setLogHistogram(QSharedPointer<LogHistogram>());
+    // the components only depend on the sparsity pattern, which the NL
+    // values don't change
+    ++mRevision;
+}
+
+QVector<int> DataHandler::sectionSymbols(const QVector<Symbol*> &symbols, int sections)
+{
+    QVector<int> sectionSymbols(sections, -1);
+    for (auto symbol : symbols) {
+        for (int s=symbol->firstSection(); s<=symbol->lastSection() && s<sections; ++s)
+            sectionSymbols[s] = symbol->logicalIndex();
+    }
+    return sectionSymbols;
+}
+
+QSharedPointer<DataHandler::AbstractDataProvider> DataHandler::provider(int viewId) const
+{
+    // the header and count lookups of a view come in long runs, so each
+    // thread keeps its last lookup until the next cache change
+    struct LastProvider
+    {
+        quint64 Handler = 0;
+        int ViewId = 0;
+        int Revision = 0;
+        QWeakPointer<AbstractDataProvider> Provider;
+    };
+    thread_local LastProvider last;
+    const int revision = mRevision;
+    if (last.Handler == mSerial && last.ViewId == viewId && last.Revision == revision)
+        return last.Provider.toStrongRef();
+    auto provider = std::atomic_load(&mDataCache)->value(viewId);
+    last.Handler = mSerial;
+    last.ViewId = viewId;
+    last.Revision = revision;
+    last.Provider = provider;
+    return provider;
+}
+
+void DataHandler::setProvider(int viewId, const QSharedPointer<AbstractDataProvider> &provider)
+{
+    QMutexLocker locker(&mCacheLock);
+    auto cache = std::make_shared<ProviderCache>(*std::atomic_load(&mDataCache));
+    mUsage.removeOne(viewId);
+    mEvicted.remove(viewId);
+    if (provider) {
+        cache->insert(viewId, provider);
+        mProviderSizes[viewId] = provider->byteSize();
+        mUsage.append(viewId);
+        evict(*cache, viewId);
+    } else {
+        cache->remove(viewId);
+        mProviderSizes.remove(viewId);
+    }
+    std::atomic_store(&mDataCache, std::shared_ptr<const ProviderCache>(std::move(cache)));
+    ++mRevision;
 }
 
-DataHandler::AbstractDataProvider* DataHandler::cloneProvider(int viewId)
+bool DataHandler::evict(ProviderCache &cache, int keep)
 {
-    switch (mDataCache[viewId]->viewConfig()->viewType()) {
+    qint64 size = 0;
+    for (auto bytes : mProviderSizes)
+        size += bytes;
+    bool evicted = false;
+    for (int i=0; i<mUsage.size() && size > mMemoryBudget;) {
+        int viewId = mUsage.at(i);
+        if (viewId == keep || viewId == mActiveView || viewId <= int(ViewHelper::ViewDataType::Unknown)) {
+            ++i;
+            continue;
+        }
+        auto provider = cache.take(viewId);
+        if (provider)
+            mEvicted[viewId] = provider->viewConfig();
+        size -= mProviderSizes.take(viewId);
+        mUsage.removeAt(i);
+        evicted = true;
+    }
+    return evicted;
+}
+
+DataHandler::AbstractDataProvider* DataHandler::cloneProvider(const QSharedPointer<AbstractDataProvider> &source)
+{
+    switch (source->viewConfig()->viewType()) {
     case ViewHelper::ViewDataType::BP_Scaling:
     {
-        auto provider = static_cast<BPScalingProvider*>(mDataCache[viewId].get());
+        auto provider = static_cast<BPScalingProvider*>(source.get());
         return new BPScalingProvider(*provider);
     }
     case ViewHelper::ViewDataType::Symbols:
     {
-        auto provider = static_cast<SymbolsDataProvider*>(mDataCache[viewId].get());
+        auto provider = static_cast<SymbolsDataProvider*>(source.get());
         return new SymbolsDataProvider(*provider);
     }
     case ViewHelper::ViewDataType::BP_Overview:
     {
-        auto provider = static_cast<BPOverviewDataProvider*>(mDataCache[viewId].get());
+        auto provider = static_cast<BPOverviewDataProvider*>(source.get());
         return new BPOverviewDataProvider(*provider);
     }
     case ViewHelper::ViewDataType::BP_Count:
     {
-        auto provider = static_cast<BPCountDataProvider*>(mDataCache[viewId].get());
+        auto provider = static_cast<BPCountDataProvider*>(source.get());
         return new BPCountDataProvider(*provider);
     }
     case ViewHelper::ViewDataType::BP_Average:
     {
-        auto provider = static_cast<BPAverageDataProvider*>(mDataCache[viewId].get());
+        auto provider = static_cast<BPAverageDataProvider*>(source.get());
         return new BPAverageDataProvider(*provider);
     }
     case ViewHelper::ViewDataType::Postopt:
     {
-        auto provider = static_cast<PostoptDataProvider*>(mDataCache[viewId].get());
+        auto provider = static_cast<PostoptDataProvider*>(source.get());
         return new PostoptDataProvider(*provider);
     }
     default:
     {
-        auto provider = static_cast<IdentityDataProvider*>(mDataCache[viewId].get());
+        auto provider = static_cast<IdentityDataProvider*>(source.get());
         return new IdentityDataProvider(*provider);
     }
     }
@@ -2098,16 +2625,34 @@ DataHandler::AbstractDataProvider* DataHandler::cloneProvider(int viewId)
 
 QSharedPointer<DataHandler::AbstractDataProvider> DataHandler::newProvider(const QSharedPointer<AbstractViewConfiguration> &viewConfig)
 {
-    if (!mCoeffCount || viewConfig->viewId() == (int)ViewHelper::ViewDataType::BP_Scaling) {
-        mCoeffCount.reset(new CoefficientInfo(mModelInstance.variableCount()+2,
-                                              mModelInstance.equationCount()*2));
+    QSharedPointer<CoefficientInfo> coeffCount;
+    if (viewConfig->viewType() == ViewHelper::ViewDataType::BP_Scaling) {
+        // every scaling provider fills its own counts; loadData() publishes
+        // the counts of the predefined view once they are complete
+        coeffCount.reset(new CoefficientInfo(mModelInstance.variableCount()+2,
+                                             mModelInstance.equationCount()*2));
+    } else {
+        QMutexLocker locker(&mCoeffLock);
+        if (!mCoeffCount) {
+            mCoeffCount.reset(new CoefficientInfo(mModelInstance.variableCount()+2,
+                                                  mModelInstance.equationCount()*2));
+        }
+        coeffCount = mCoeffCount;
     }
     switch (viewConfig->viewType()) {
     case ViewHelper::ViewDataType::BP_Scaling:
+    {
+        QSharedPointer<LogHistogram> histogram;
+        if (viewConfig->viewId() == (int)ViewHelper::ViewDataType::BP_Scaling)
+            histogram.reset(new LogHistogram(mModelInstance.equationCount(),
+                                             mModelInstance.variableCount(),
+                                             mModelInstance.useOutput()));
         return QSharedPointer<AbstractDataProvider>(new BPScalingProvider(this,
                                                                           mModelInstance,
                                                                           viewConfig,
-                                                                          mCoeffCount));
+                                                                          coeffCount,
+                                                                          histogram));
+    }
     case ViewHelper::ViewDataType::Symbols:
         return QSharedPointer<AbstractDataProvider>(new SymbolsDataProvider(this,
                                                                             mModelInstance,
@@ -2116,17 +2661,17 @@ QSharedPointer<DataHandler::AbstractDataProvider> DataHandler::newProvider(const
         return QSharedPointer<AbstractDataProvider>(new BPOverviewDataProvider(this,
                                                                                mModelInstance,
                                                                                viewConfig,
-                                                                               mCoeffCount));
+                                                                               coeffCount));
     case ViewHelper::ViewDataType::BP_Count:
         return QSharedPointer<AbstractDataProvider>(new BPCountDataProvider(this,
                                                                             mModelInstance,
                                                                             viewConfig,
-                                                                            mCoeffCount));
+                                                                            coeffCount));
     case ViewHelper::ViewDataType::BP_Average:
         return QSharedPointer<AbstractDataProvider>(new BPAverageDataProvider(this,
                                                                               mModelInstance,
                                                                               viewConfig,
-                                                                              mCoeffCount));
+                                                                              coeffCount));
     case ViewHelper::ViewDataType::Postopt:
         return QSharedPointer<AbstractDataProvider>(new PostoptDataProvider(this,
                                                                             mModelInstance,
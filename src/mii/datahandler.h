@@ -20,9 +20,22 @@
 #ifndef DATAHANDLER_H
 #define DATAHANDLER_H
 
+#include "coefficientsearch.h"
+#include "common.h"
+#include "componentanalysis.h"
+#include "datatile.h"
+#include "dualresidual.h"
+#include "primalresidual.h"
+#include "scalingadvisor.h"
+#include "structuraldiagnostics.h"
+
+#include <QMutex>
 #include <QVariant>
 #include <QSharedPointer>
 
+#include <atomic>
+#include <memory>
+
 namespace gams {
 namespace studio {
 namespace mii {
@@ -31,7 +44,11 @@ class Aggregation;
 class AbstractModelInstance;
 class AbstractViewConfiguration;
 class DataMatrix;
+class LogHistogram;
+struct NlOverlay;
 class PostoptTreeItem;
+class SparsityPyramid;
+class Symbol;
 
 typedef QMap<Qt::Orientation, QList<int>> SectionMapping;
 
@@ -163,18 +180,125 @@ public:
 
     ~DataHandler();
 
-    void loadData(const QSharedPointer<AbstractViewConfiguration> &viewConfig);
+    ///
+    /// \brief Load the provider of <c>viewConfig</c>, which is dropped if
+    ///        <c>token</c> or the model instance is cancelled meanwhile.
+    ///
+    void loadData(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                  const CancellationToken &token = CancellationToken());
 
     QVariant data(int row, int column, int viewId) const;
 
     int nlFlag(int row, int column, int viewId);
 
+    ///
+    /// \brief Dense tile of a view, safe to call from worker threads.
+    ///
+    DataTile fetchTile(int viewId, const SectionRange &rows, const SectionRange &columns) const;
+
+    ///
+    /// \brief Revision of the view data, incremented on every change of
+    ///        the provider cache or the Jacobian.
+    ///
+    int revision() const;
+
+    ///
+    /// \brief Sparsity pyramid of the Jacobian, built on first request and
+    ///        kept until the Jacobian is reloaded.
+    ///
+    QSharedPointer<SparsityPyramid> sparsityPyramid(bool useOutput);
+
+    ///
+    /// \brief Parallel scan of the Jacobian for coefficients outside of
+    ///        <c>range</c>, restricted to the <c>rows</c> and <c>columns</c>
+    ///        if not empty.
+    ///
+    QVector<CoefficientHit> findCoefficients(const CoefficientSearch::Range &range,
+                                             bool useOutput,
+                                             const QBitArray &rows,
+                                             const QBitArray &columns,
+                                             int maxHits, qint64 *total,
+                                             const CancellationToken &token = CancellationToken());
+
+    ///
+    /// \brief Suggested scales of the Jacobian, see ScalingAdvisor.
+    ///
+    QSharedPointer<ScalingAdvice> scalingAdvice(bool useOutput,
+                                                const QVector<double> &equationScales,
+                                                const QVector<double> &variableScales,
+                                                const ScalingAdvisor::Options &options);
+
+    ///
+    /// \brief Structural findings of the Jacobian, see StructuralDiagnostics.
+    ///
+    QVector<StructuralFinding> structuralDiagnostics(bool useOutput,
+                                                     const QByteArray &equationTypes,
+                                                     const QVector<double> &lower,
+                                                     const QVector<double> &upper);
+
+    ///
+    /// \brief Connected components of the Jacobian, built on first request
+    ///        and kept until the Jacobian is reloaded.
+    ///
+    QSharedPointer<ComponentPartition> components(ComponentAnalysis::Level level);
+
+    ///
+    /// \brief Residuals of the linear rows per equation symbol, see
+    ///        PrimalResidual.
+    ///
+    QVector<ResidualSummary> primalResiduals(const QVector<double> &levels,
+                                             const QVector<double> &rowLevels,
+                                             const QVector<double> &rhs,
+                                             const QByteArray &equationTypes);
+
+    ///
+    /// \brief Reduced cost mismatches per variable symbol, see
+    ///        DualResidual.
+    ///
+    QVector<DualSummary> dualResiduals(bool useOutput,
+                                       const QVector<double> &objective,
+                                       const QVector<int> &objectiveNlFlags,
+                                       const QVector<double> &rowMarginals,
+                                       const QVector<double> &marginals);
+
+    ///
+    /// \brief log10 |a| histogram of the last aggregation pass of the
+    ///        predefined scaling view, or <c>nullptr</c> if that view isn't
+    ///        loaded for <c>useOutput</c> yet.
+    ///
+    QSharedPointer<LogHistogram> logHistogram(bool useOutput);
+
+    void setLogHistogram(const QSharedPointer<LogHistogram> &histogram);
+
     QSharedPointer<PostoptTreeItem> dataTree(int viewId) const;
 
     void removeViewData(int viewId);
 
     void removeViewData();
 
+    ///
+    /// \brief Mark <c>viewId</c> as the active view, which is never evicted.
+    /// \return The configuration of an evicted provider of <c>viewId</c>,
+    ///         which the caller reloads with loadData(), or <c>nullptr</c>.
+    ///
+    QSharedPointer<AbstractViewConfiguration> activateViewData(int viewId);
+
+    ///
+    /// \brief Upper bound of the provider cache size in bytes. Least
+    ///        recently used custom views beyond it are evicted and reloaded
+    ///        on their next activation.
+    ///
+    qint64 memoryBudget() const;
+
+    void setMemoryBudget(qint64 budget);
+
+    ///
+    /// \brief Approximate size of all cached providers in bytes.
+    ///
+    qint64 cacheSize() const;
+
+    static constexpr qint64 DefaultMemoryBudget = 1024ll * 1024 * 1024;
+
     int headerData(int logicalIndex, Qt::Orientation orientation, int viewId) const;
 
     QVariant plainHeaderData(Qt::Orientation orientation,
@@ -192,9 +316,9 @@ public:
 
     int columnEntryCount(int column, int viewId) const;
 
-    const QList<int>& rowIndices(int viewId, int row) const;
+    QList<int> rowIndices(int viewId, int row) const;
 
-    const QList<int>& columnIndices(int viewId, int column) const;
+    QList<int> columnIndices(int viewId, int column) const;
 
     int symbolRowCount(int viewId) const;
 
@@ -212,8 +336,51 @@ public:
     
     void loadJacobian();
 
+    ///
+    /// \brief Jacobian of the view data, e.g. to evaluate further points.
+    ///
+    DataMatrix* jacobian() const;
+
+    ///
+    /// \brief Switch the output data of the Jacobian to the NL values of
+    ///        <c>overlay</c>. The value based analyses are rebuilt on their
+    ///        next request.
+    /// \remark The overlay is published atomically, so view data and
+    ///         analyses that load meanwhile finish with the previous one.
+    ///
+    void setNlOverlay(const std::shared_ptr<const NlOverlay> &overlay);
+
 private:
-    AbstractDataProvider *cloneProvider(int viewId);
+    typedef QMap<int, QSharedPointer<AbstractDataProvider>> ProviderCache;
+
+    ///
+    /// \brief Provider of <c>viewId</c> in the current cache snapshot, safe
+    ///        to call from any thread.
+    /// \remark The last lookup of each thread is cached as long as the
+    ///         revision doesn't change.
+    ///
+    QSharedPointer<AbstractDataProvider> provider(int viewId) const;
+
+    ///
+    /// \brief Publish a copy of the cache where <c>viewId</c> maps to
+    ///        <c>provider</c>, or is removed if <c>provider</c> is null.
+    ///
+    void setProvider(int viewId, const QSharedPointer<AbstractDataProvider> &provider);
+
+    ///
+    /// \brief Evict least recently used providers from <c>cache</c> until
+    ///        it fits into the memory budget. Predefined views, the active
+    ///        view and <c>keep</c> stay. Requires mCacheLock.
+    /// \return <c>true</c> if any provider was evicted.
+    ///
+    bool evict(ProviderCache &cache, int keep);
+
+    AbstractDataProvider *cloneProvider(const QSharedPointer<AbstractDataProvider> &source);
+
+    ///
+    /// \brief Logical symbol index of each of <c>sections</c> sections.
+    ///
+    static QVector<int> sectionSymbols(const QVector<Symbol*> &symbols, int sections);
     QSharedPointer<AbstractDataProvider> newProvider(const QSharedPointer<AbstractViewConfiguration> &viewConfig);
 
 private:
@@ -222,14 +389,63 @@ private:
     double mModelMaximum = std::numeric_limits<double>::lowest();
 
     QScopedPointer<DataMatrix> mDataMatrix;
+    ///
+    /// \brief Guards mCoeffCount, the counts of the last complete load of
+    ///        the predefined scaling view. The block picture providers
+    ///        share them read-only.
+    ///
+    QMutex mCoeffLock;
     QSharedPointer<CoefficientInfo> mCoeffCount;
 
     ///
-    /// \brief Abstract data provider cache, where key is the view ID.
+    /// \brief Immutable snapshot of the data provider cache, where key is
+    ///        the view ID. Readers load it with std::atomic_load(), writers
+    ///        publish a modified copy with std::atomic_store().
+    ///
+    std::shared_ptr<const ProviderCache> mDataCache;
+
+    ///
+    /// \brief Unique ID of this handler, which tells the thread local
+    ///        provider lookups of different handlers apart.
+    ///
+    const quint64 mSerial;
+
+    ///
+    /// \brief Serializes the writers of mDataCache.
+    ///
+    mutable QMutex mCacheLock;
+
+    std::atomic<qint64> mMemoryBudget {DefaultMemoryBudget};
+
+    ///
+    /// \brief Approximate provider sizes in bytes, guarded by mCacheLock.
     ///
-    QMap<int, QSharedPointer<AbstractDataProvider>> mDataCache;
+    QMap<int, qint64> mProviderSizes;
+
+    ///
+    /// \brief Cached view IDs, least recently used first, guarded by
+    ///        mCacheLock.
+    ///
+    QList<int> mUsage;
+
+    ///
+    /// \brief Configurations of evicted views, guarded by mCacheLock.
+    ///
+    QMap<int, QSharedPointer<AbstractViewConfiguration>> mEvicted;
+
+    int mActiveView = -1;
+
+    std::atomic<int> mRevision {0};
+
+    QMutex mPyramidLock;
+    QSharedPointer<SparsityPyramid> mSparsityPyramid;
+
+    QMutex mComponentLock;
+    QSharedPointer<ComponentPartition> mSectionComponents;
+    QSharedPointer<ComponentPartition> mSymbolComponents;
 
-    QList<int> mDummyIndices;
+    QMutex mHistogramLock;
+    QSharedPointer<LogHistogram> mLogHistogram;
 };
 
 }
@@ -27,62 +27,46 @@ namespace mii {
 
 DataRow::DataRow()
     : mEntries(0)
-    , mEntriesNl(0)
     , mColIdx(nullptr)
     , mInputData(nullptr)
-    , mOutputData(nullptr)
-    , mNlFlags(nullptr)
 {
 
 }
 
 DataRow::DataRow(int entries)
     : mEntries(entries)
-    , mEntriesNl(0)
     , mColIdx(new int[mEntries])
     , mInputData(new double[mEntries])
-    , mOutputData(new double[mEntries])
-    , mNlFlags(new int[mEntries])
+    , mNlFlags(mEntries)
 {
 
 }
 
 DataRow::DataRow(const DataRow &other)
     : mEntries(other.entries())
-    , mEntriesNl(other.mEntriesNl)
     , mColIdx(new int[mEntries])
     , mInputData(new double[mEntries])
-    , mOutputData(new double[mEntries])
-    , mNlFlags(new int[mEntries])
+    , mNlFlags(other.mNlFlags)
 {
     std::copy(other.mColIdx, other.mColIdx+other.mEntries, mColIdx);
     std::copy(other.mInputData, other.mInputData+other.mEntries, mInputData);
-    std::copy(other.mOutputData, other.mOutputData+other.mEntries, mOutputData);
-    std::copy(other.mNlFlags, other.mNlFlags+other.mEntries, mNlFlags);
 }
 
 DataRow::DataRow(DataRow &&other) noexcept
     : mEntries(other.mEntries)
-    , mEntriesNl(other.mEntriesNl)
     , mColIdx(other.mColIdx)
     , mInputData(other.mInputData)
-    , mOutputData(other.mOutputData)
-    , mNlFlags(other.mNlFlags)
+    , mNlFlags(std::move(other.mNlFlags))
 {
     other.mEntries = 0;
-    other.mEntriesNl = 0;
     other.mColIdx = nullptr;
     other.mInputData = nullptr;
-    other.mOutputData = nullptr;
-    other.mNlFlags = nullptr;
 }
 
 DataRow::~DataRow()
 {
     if (mColIdx) delete [] mInputData;
-    if (mOutputData) delete [] mOutputData;
     if (mInputData) delete [] mColIdx;
-    if (mNlFlags) delete [] mNlFlags;
 }
 
 int DataRow::entries() const
@@ -97,12 +81,7 @@ void DataRow::setEntries(int entries)
 
 int DataRow::entriesNl() const
 {
-    return mEntriesNl;
-}
-
-void DataRow::setEntriesNl(int entries)
-{
-    mEntriesNl = entries;
+    return mNlFlags.count();
 }
 
 int *DataRow::colIdx() const
@@ -125,24 +104,29 @@ void DataRow::setInputData(double *inputData)
     mInputData = inputData;
 }
 
-double *DataRow::outputData() const
+RowValues DataRow::outputData(const double *nlValues) const
 {
-    return mOutputData ? mOutputData : mInputData;
+    return RowValues(mInputData, nlValues, &mNlFlags);
 }
 
-void DataRow::setOutputData(double *outputData)
+const PackedBitSet &DataRow::nlFlags() const
 {
-    mOutputData = outputData;
+    return mNlFlags;
 }
 
-int *DataRow::nlFlags() const
+PackedBitSet &DataRow::nlFlags()
 {
     return mNlFlags;
 }
 
-void DataRow::setNlFlags(int *nlFlags)
+void DataRow::setNlFlags(const int *nlFlags)
 {
-    mNlFlags = nlFlags;
+    mNlFlags = PackedBitSet::fromFlags(nlFlags, mEntries);
+}
+
+bool DataRow::isNonlinear(int entry) const
+{
+    return mNlFlags.test(entry);
 }
 
 QVariant DataRow::inputValue(int index, int lastSymIndex)
@@ -156,12 +140,13 @@ QVariant DataRow::inputValue(int index, int lastSymIndex)
     return QVariant();
 }
 
-QVariant DataRow::outputValue(int index, int lastSymIndex)
+QVariant DataRow::outputValue(const double *nlValues, int index, int lastSymIndex) const
 {
     int entries = lastSymIndex < mEntries ? lastSymIndex+1 : mEntries;
+    auto data = outputData(nlValues);
     for (int i=0; i<entries; ++i) {
         if (mColIdx[i] == index) {
-            return outputData()[i];
+            return data[i];
         }
     }
     return QVariant();
@@ -171,35 +156,24 @@ DataRow& DataRow::operator=(const DataRow &other)
 {
     delete [] mColIdx;
     delete [] mInputData;
-    delete [] mOutputData;
-    delete [] mNlFlags;
     mEntries = other.mEntries;
-    mEntriesNl = other.mEntriesNl;
     mColIdx = new int[mEntries];
     mInputData = new double[mEntries];
-    mOutputData = new double[mEntries];
-    mNlFlags = new int[mEntries];
+    mNlFlags = other.mNlFlags;
     std::copy(other.mColIdx, other.mColIdx+other.mEntries, mColIdx);
     std::copy(other.mInputData, other.mInputData+other.mEntries, mInputData);
-    std::copy(other.mOutputData, other.mOutputData+other.mEntries, mOutputData);
-    std::copy(other.mNlFlags, other.mNlFlags+other.mEntries, mNlFlags);
     return *this;
 }
 
 DataRow& DataRow::operator=(DataRow &&other) noexcept
 {
     mEntries = other.mEntries;
-    mEntriesNl = other.mEntriesNl;
     mColIdx = other.mColIdx;
     mInputData = other.mInputData;
-    mOutputData = other.mOutputData;
-    mNlFlags = other.mNlFlags;
+    mNlFlags = std::move(other.mNlFlags);
     other.mEntries = 0;
-    other.mEntriesNl = 0;
     other.mColIdx = nullptr;
     other.mInputData = nullptr;
-    other.mOutputData = nullptr;
-    other.mNlFlags = nullptr;
     return *this;
 }
 
@@ -229,6 +203,7 @@ DataMatrix::DataMatrix(const DataMatrix &other)
     , mRows(new DataRow[mRowCount])
     , mEvalPoint(new double[mColumnCount])
     , mModelType(other.mModelType)
+    , mNlOverlay(other.nlOverlay())
 {
     std::copy(other.mRows, other.mRows+other.mRowCount, mRows);
     std::copy(other.mEvalPoint, other.mEvalPoint+other.mColumnCount, mEvalPoint);
@@ -240,6 +215,7 @@ DataMatrix::DataMatrix(DataMatrix &&other) noexcept
     , mRows(other.mRows)
     , mEvalPoint(other.mEvalPoint)
     , mModelType(other.mModelType)
+    , mNlOverlay(std::move(other.mNlOverlay))
 {
     other.mRowCount = 0;
     other.mColumnCount = 0;
@@ -278,6 +254,21 @@ bool DataMatrix::isLinear() const
     return !mModelType;
 }
 
+std::shared_ptr<const NlOverlay> DataMatrix::nlOverlay() const
+{
+    return std::atomic_load(&mNlOverlay);
+}
+
+void DataMatrix::setNlOverlay(const std::shared_ptr<const NlOverlay> &overlay)
+{
+    std::atomic_store(&mNlOverlay, overlay);
+}
+
+MatrixValues DataMatrix::values(bool useOutput)
+{
+    return MatrixValues(*this, useOutput ? nlOverlay() : nullptr);
+}
+
 DataMatrix& DataMatrix::operator=(const DataMatrix &other)
 {
     delete [] mRows;
@@ -288,6 +279,7 @@ DataMatrix& DataMatrix::operator=(const DataMatrix &other)
     mEvalPoint = new double[mColumnCount];
     std::copy(other.mEvalPoint, other.mEvalPoint+other.mColumnCount, mEvalPoint);
     mModelType = other.mModelType;
+    setNlOverlay(other.nlOverlay());
     return *this;
 }
 
@@ -302,6 +294,7 @@ DataMatrix& DataMatrix::operator=(DataMatrix &&other) noexcept
     other.mRows = nullptr;
     other.mEvalPoint = nullptr;
     mModelType = other.mModelType;
+    std::atomic_store(&mNlOverlay, std::move(other.mNlOverlay));
     return *this;
 }
 
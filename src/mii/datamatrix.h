@@ -20,12 +20,71 @@
 #ifndef DATAMATRIX_H
 #define DATAMATRIX_H
 
+#include "packedbitset.h"
+
 #include <QVariant>
 
+#include <memory>
+
 namespace gams {
 namespace studio {
 namespace mii {
 
+///
+/// \brief Read-only view of the values of a row, where the evaluated NL
+///        values of the overlay replace the input values.
+///
+/// The rank of the last NL entry is kept, so a pass in entry order counts
+/// each flag word once instead of ranking every entry from the start.
+///
+class RowValues
+{
+public:
+    RowValues(const double *input = nullptr,
+              const double *overlay = nullptr,
+              const PackedBitSet *nlFlags = nullptr)
+        : mInput(input)
+        , mOverlay(overlay)
+        , mNlFlags(nlFlags)
+    {
+
+    }
+
+    double operator[](int entry) const
+    {
+        if (mOverlay && mNlFlags->test(entry))
+            return mOverlay[rank(entry)];
+        return mInput[entry];
+    }
+
+    explicit operator bool() const
+    {
+        return mInput;
+    }
+
+private:
+    int rank(int entry) const
+    {
+        if (entry < mRankEntry)
+            mRank = mNlFlags->rank(entry);
+        else
+            mRank += mNlFlags->count(mRankEntry, entry-1);
+        mRankEntry = entry;
+        return mRank;
+    }
+
+private:
+    const double *mInput;
+    const double *mOverlay;
+    const PackedBitSet *mNlFlags;
+
+    ///
+    /// \brief Entry of the last rank() call and its rank.
+    ///
+    mutable int mRankEntry = 0;
+    mutable int mRank = 0;
+};
+
 class DataRow
 {
 public:
@@ -43,10 +102,11 @@ public:
 
     void setEntries(int entries);
 
+    ///
+    /// \brief Number of nonlinear entries, counted in the NL flags.
+    ///
     int entriesNl() const;
 
-    void setEntriesNl(int entries);
-
     int* colIdx() const;
 
     void setColIdx(int* colIdx);
@@ -60,20 +120,30 @@ public:
     void setInputData(double* inputData);
 
     ///
-    /// \brief Pointer to output data, if available.
-    /// \return Pointer to ouput data.
+    /// \brief Output data, i.e. the input data merged with
+    ///        <c>nlValues</c>.
+    /// \param nlValues Evaluated values of the NL entries in entry order,
+    ///        one per set NL flag, or <c>nullptr</c> if not evaluated.
     ///
-    double* outputData() const;
+    RowValues outputData(const double *nlValues) const;
 
-    void setOutputData(double* outputData);
+    ///
+    /// \brief NL flag of each entry, aligned with colIdx().
+    ///
+    const PackedBitSet& nlFlags() const;
 
-    int* nlFlags() const;
+    PackedBitSet& nlFlags();
 
-    void setNlFlags(int *nlFlags);
+    ///
+    /// \brief Pack the <c>entries()</c> GMO NL flags of <c>nlFlags</c>.
+    ///
+    void setNlFlags(const int *nlFlags);
+
+    bool isNonlinear(int entry) const;
 
     QVariant inputValue(int index, int lastSymIndex);
 
-    QVariant outputValue(int index, int lastSymIndex);
+    QVariant outputValue(const double *nlValues, int index, int lastSymIndex) const;
 
     DataRow& operator=(const DataRow& other);
 
@@ -81,13 +151,33 @@ public:
 
 private:
     int mEntries;
-    int mEntriesNl;
     int* mColIdx;
     double *mInputData;
-    double *mOutputData;
-    int *mNlFlags;
+    PackedBitSet mNlFlags;
+};
+
+///
+/// \brief Evaluated NL values of all rows at one evaluation point, i.e. the
+///        DataRow::outputData() NL values of the whole matrix.
+///
+struct NlOverlay
+{
+    ///
+    /// \brief Offset of the first NL value of each row in Values, followed
+    ///        by the total number of values.
+    ///
+    QVector<qint64> RowStart;
+
+    QVector<double> Values;
+
+    qint64 byteSize() const
+    {
+        return qint64(RowStart.size()) * sizeof(qint64) + qint64(Values.size()) * sizeof(double);
+    }
 };
 
+class MatrixValues;
+
 class DataMatrix
 {
 public:
@@ -111,6 +201,29 @@ public:
 
     bool isLinear() const;
 
+    ///
+    /// \brief Evaluated NL values of the rows, or <c>nullptr</c> if the
+    ///        output data equals the input data. Safe to call from any
+    ///        thread.
+    ///
+    std::shared_ptr<const NlOverlay> nlOverlay() const;
+
+    ///
+    /// \brief Use the NL values of <c>overlay</c> as output data, which is
+    ///        referenced and not copied, or drop them if <c>overlay</c> is
+    ///        <c>nullptr</c>.
+    /// \remark The overlay must match the NL flags of the rows. It is
+    ///         swapped atomically, so passes over values() that already
+    ///         run keep their overlay.
+    ///
+    void setNlOverlay(const std::shared_ptr<const NlOverlay> &overlay);
+
+    ///
+    /// \brief Values of all rows, where the output data uses the current
+    ///        NL overlay.
+    ///
+    MatrixValues values(bool useOutput);
+
     DataMatrix& operator=(const DataMatrix& other);
 
     DataMatrix& operator=(DataMatrix&& other) noexcept;
@@ -121,6 +234,58 @@ private:
     DataRow *mRows;
     double *mEvalPoint;
     int mModelType;
+
+    ///
+    /// \brief Immutable NL values of the output data. Readers load it with
+    ///        std::atomic_load(), setNlOverlay() publishes a new one with
+    ///        std::atomic_store().
+    ///
+    std::shared_ptr<const NlOverlay> mNlOverlay;
+};
+
+///
+/// \brief Values of the rows of a DataMatrix. The NL overlay is taken once
+///        when the values are created, so one pass over the matrix sees
+///        one evaluation point.
+///
+class MatrixValues
+{
+public:
+    MatrixValues(DataMatrix &matrix, const std::shared_ptr<const NlOverlay> &overlay)
+        : mMatrix(&matrix)
+        , mOverlay(overlay)
+    {
+
+    }
+
+    ///
+    /// \brief NL values of <c>row</c>, or <c>nullptr</c> for input data.
+    ///
+    const double* nlValues(int row) const
+    {
+        return mOverlay ? mOverlay->Values.constData() + mOverlay->RowStart.at(row) : nullptr;
+    }
+
+    ///
+    /// \brief Values of <c>row</c>, which are valid as long as these
+    ///        MatrixValues.
+    ///
+    RowValues row(int row) const
+    {
+        return mMatrix->row(row)->outputData(nlValues(row));
+    }
+
+    ///
+    /// \brief DataRow::outputValue() of <c>row</c>.
+    ///
+    QVariant value(int row, int index, int lastSymIndex) const
+    {
+        return mMatrix->row(row)->outputValue(nlValues(row), index, lastSymIndex);
+    }
+
+private:
+    DataMatrix *mMatrix;
+    std::shared_ptr<const NlOverlay> mOverlay;
 };
 
 }
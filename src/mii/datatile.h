@@ -0,0 +1,104 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DATATILE_H
+#define DATATILE_H
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief First and last section index of a range, both inclusive.
+///
+typedef QPair<int, int> SectionRange;
+
+///
+/// \brief Dense row-major block of view data, as returned by
+///        AbstractModelInstance::fetchTile.
+///
+struct DataTile
+{
+    static constexpr int DefaultRowCount = 64;
+    static constexpr int DefaultColumnCount = 32;
+
+    bool contains(int row, int column) const
+    {
+        return row >= FirstRow && row < FirstRow + RowCount &&
+               column >= FirstColumn && column < FirstColumn + ColumnCount;
+    }
+
+    int offset(int row, int column) const
+    {
+        return (row - FirstRow) * ColumnCount + column - FirstColumn;
+    }
+
+    bool isEmpty() const
+    {
+        return !RowCount || !ColumnCount;
+    }
+
+    void resize(const SectionRange &rows, const SectionRange &columns)
+    {
+        FirstRow = rows.first;
+        FirstColumn = columns.first;
+        RowCount = qMax(0, rows.second - rows.first + 1);
+        ColumnCount = qMax(0, columns.second - columns.first + 1);
+        Values.fill(0.0, RowCount * ColumnCount);
+        NlFlags.fill(0, RowCount * ColumnCount);
+        Mask.fill(0, RowCount * ColumnCount);
+    }
+
+    int ViewId = -1;
+    int Revision = -1;
+    int FirstRow = 0;
+    int FirstColumn = 0;
+    int RowCount = 0;
+    int ColumnCount = 0;
+
+    ///
+    /// \brief Cell values, 0.0 where no value is present.
+    ///
+    QVector<double> Values;
+
+    ///
+    /// \brief Cell NL flags.
+    ///
+    QVector<char> NlFlags;
+
+    ///
+    /// \brief Non-zero where a cell has a value to display.
+    ///
+    QVector<char> Mask;
+
+    ///
+    /// \brief Display texts of the masked cells, only filled by prefetching.
+    ///
+    QVector<QString> Texts;
+};
+
+}
+}
+}
+
+#endif // DATATILE_H
@@ -0,0 +1,190 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "datatilebuffer.h"
+#include "abstractmodelinstance.h"
+#include "dtoaformatproxymodel.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+const int DataTileBuffer::DefaultCapacity = 256;
+
+DataTileBuffer::DataTileBuffer(int tileRows, int tileColumns, QObject *parent)
+    : QObject(parent)
+    , mTiles(DefaultCapacity)
+    , mTileRows(qMax(1, tileRows))
+    , mTileColumns(qMax(1, tileColumns))
+{
+    connect(&mPrefetchWatcher, &QFutureWatcher<QVector<DataTile>>::finished,
+            this, &DataTileBuffer::storePrefetchedTiles);
+}
+
+DataTileBuffer::~DataTileBuffer()
+{
+    mPrefetchWatcher.waitForFinished();
+}
+
+const DataTile &DataTileBuffer::tile(AbstractModelInstance &modelInstance,
+                                     int viewId, int row, int column)
+{
+    if (viewId != mViewId) {
+        mTiles.clear();
+        mViewId = viewId;
+    }
+    auto key = tileKey(row, column);
+    if (isBuffered(key, viewId, modelInstance.dataRevision()))
+        return *mTiles.object(key);
+    int firstRow = row / mTileRows * mTileRows;
+    int firstColumn = column / mTileColumns * mTileColumns;
+    int lastRow = qMin(firstRow + mTileRows, modelInstance.rowCount(viewId)) - 1;
+    int lastColumn = qMin(firstColumn + mTileColumns, modelInstance.columnCount(viewId)) - 1;
+    auto tile = new DataTile(modelInstance.fetchTile(viewId,
+                                                     SectionRange(firstRow, lastRow),
+                                                     SectionRange(firstColumn, lastColumn)));
+    if (tile->isEmpty()) {
+        delete tile;
+        return mEmptyTile;
+    }
+    mTiles.insert(key, tile);
+    return *tile;
+}
+
+void DataTileBuffer::prefetch(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                              int viewId, const QVector<int> &rows, const QVector<int> &columns)
+{
+    if (!modelInstance || rows.isEmpty() || columns.isEmpty())
+        return;
+    PrefetchRequest request;
+    request.ModelInstance = modelInstance;
+    request.ViewId = viewId;
+    request.Rows = rows;
+    request.Columns = columns;
+    if (mPrefetchWatcher.isRunning()) {
+        mPendingRequest = request;
+        return;
+    }
+    startPrefetch(request);
+}
+
+void DataTileBuffer::invalidate()
+{
+    mTiles.clear();
+    mViewId = -1;
+    mPendingRequest = PrefetchRequest();
+}
+
+void DataTileBuffer::storePrefetchedTiles()
+{
+    auto tiles = mPrefetchWatcher.result();
+    auto modelInstance = mPrefetchInstance;
+    mPrefetchInstance.reset();
+    QVector<DataTile> stored;
+    if (modelInstance) {
+        int revision = modelInstance->dataRevision();
+        for (const auto& tile : tiles) {
+            if (tile.ViewId != mViewId || tile.Revision != revision || tile.isEmpty())
+                continue;
+            mTiles.insert(tileKey(tile.FirstRow, tile.FirstColumn), new DataTile(tile));
+            stored << tile;
+        }
+    }
+    if (!stored.isEmpty())
+        emit tilesPrefetched(stored);
+    if (mPendingRequest.ModelInstance) {
+        auto request = mPendingRequest;
+        mPendingRequest = PrefetchRequest();
+        startPrefetch(request);
+    }
+}
+
+quint64 DataTileBuffer::tileKey(int row, int column) const
+{
+    return (quint64(quint32(row / mTileRows)) << 32) | quint32(column / mTileColumns);
+}
+
+QVector<int> DataTileBuffer::tileStarts(const QVector<int> &sections, int tileSize, int count)
+{
+    QVector<int> starts;
+    starts.reserve(sections.size());
+    for (auto section : sections) {
+        if (section >= 0 && section < count)
+            starts << section / tileSize * tileSize;
+    }
+    std::sort(starts.begin(), starts.end());
+    starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+    return starts;
+}
+
+bool DataTileBuffer::isBuffered(quint64 key, int viewId, int revision) const
+{
+    auto tile = mTiles.object(key);
+    return tile && tile->ViewId == viewId && tile->Revision == revision;
+}
+
+void DataTileBuffer::startPrefetch(const PrefetchRequest &request)
+{
+    if (request.ViewId != mViewId)
+        return;
+    auto modelInstance = request.ModelInstance;
+    int revision = modelInstance->dataRevision();
+    int rowCount = modelInstance->rowCount(request.ViewId);
+    int columnCount = modelInstance->columnCount(request.ViewId);
+    auto rowStarts = tileStarts(request.Rows, mTileRows, rowCount);
+    auto columnStarts = tileStarts(request.Columns, mTileColumns, columnCount);
+    QVector<QPair<SectionRange, SectionRange>> blocks;
+    for (auto r : rowStarts) {
+        for (auto c : columnStarts) {
+            if (isBuffered(tileKey(r, c), request.ViewId, revision))
+                continue;
+            blocks << qMakePair(SectionRange(r, qMin(r + mTileRows, rowCount) - 1),
+                                SectionRange(c, qMin(c + mTileColumns, columnCount) - 1));
+        }
+    }
+    if (blocks.isEmpty())
+        return;
+    int viewId = request.ViewId;
+    auto loadTiles = [modelInstance, viewId, blocks]{
+        QVector<DataTile> tiles;
+        for (const auto& block : blocks) {
+            auto tile = modelInstance->fetchTile(viewId, block.first, block.second);
+            tile.Texts.resize(tile.Values.size());
+            for (int i=0; i<tile.Values.size(); ++i) {
+                if (tile.Mask[i])
+                    tile.Texts[i] = DoubleFormatter::format(tile.Values[i],
+                                                            FormatCache::TextFormat,
+                                                            FormatCache::TextPrecision,
+                                                            true);
+            }
+            tiles << tile;
+        }
+        return tiles;
+    };
+    mPrefetchInstance = modelInstance;
+    mPrefetchWatcher.setFuture(QtConcurrent::run(loadTiles));
+}
+
+}
+}
+}
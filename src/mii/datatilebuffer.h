@@ -0,0 +1,138 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DATATILEBUFFER_H
+#define DATATILEBUFFER_H
+
+#include "datatile.h"
+
+#include <QCache>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QSharedPointer>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class AbstractModelInstance;
+
+///
+/// \brief Keeps recently fetched tiles of a view, used by the table models
+///        to serve cell requests without a model instance round trip per
+///        cell. Tiles ahead of the viewport can be prefetched on a worker
+///        thread.
+///
+class DataTileBuffer final : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int DefaultCapacity;
+
+    DataTileBuffer(int tileRows = DataTile::DefaultRowCount,
+                   int tileColumns = DataTile::DefaultColumnCount,
+                   QObject *parent = nullptr);
+
+    ~DataTileBuffer() override;
+
+    ///
+    /// \brief Tile containing the cell, fetched if no buffered tile
+    ///        contains it or the view data changed since.
+    ///
+    const DataTile& tile(AbstractModelInstance &modelInstance,
+                         int viewId, int row, int column);
+
+    ///
+    /// \brief Fetches and formats all tiles covering the cells of
+    ///        <c>rows</c> x <c>columns</c> on a worker thread, skipping
+    ///        tiles which are already buffered. The sections need not be
+    ///        sorted or contiguous. While a prefetch is running only the
+    ///        latest request is kept.
+    ///
+    void prefetch(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                  int viewId, const QVector<int> &rows, const QVector<int> &columns);
+
+    void invalidate();
+
+signals:
+    ///
+    /// \brief Emitted on the GUI thread for every completed prefetch.
+    ///
+    void tilesPrefetched(const QVector<DataTile> &tiles);
+
+private slots:
+    void storePrefetchedTiles();
+
+private:
+    struct PrefetchRequest
+    {
+        QSharedPointer<AbstractModelInstance> ModelInstance;
+        int ViewId = -1;
+        QVector<int> Rows;
+        QVector<int> Columns;
+    };
+
+    quint64 tileKey(int row, int column) const;
+
+    ///
+    /// \brief Sorted first sections of the tiles covering <c>sections</c>
+    ///        within [0, <c>count</c>).
+    ///
+    static QVector<int> tileStarts(const QVector<int> &sections, int tileSize, int count);
+
+    bool isBuffered(quint64 key, int viewId, int revision) const;
+
+    void startPrefetch(const PrefetchRequest &request);
+
+private:
+    QCache<quint64, DataTile> mTiles;
+    DataTile mEmptyTile;
+    int mTileRows;
+    int mTileColumns;
+    int mViewId = -1;
+
+    QFutureWatcher<QVector<DataTile>> mPrefetchWatcher;
+    QSharedPointer<AbstractModelInstance> mPrefetchInstance;
+    PrefetchRequest mPendingRequest;
+};
+
+///
+/// \brief Interface of table models backed by a DataTileBuffer, used by
+///        the table views to prefetch tiles ahead of scrolling.
+///
+class AbstractTileModel
+{
+public:
+    virtual ~AbstractTileModel() {}
+
+    ///
+    /// \brief Prefetches the cells of <c>rows</c> x <c>columns</c>, in
+    ///        model coordinates.
+    ///
+    virtual void prefetch(const QVector<int> &rows, const QVector<int> &columns) = 0;
+
+    virtual DataTileBuffer* tileBuffer() = 0;
+};
+
+}
+}
+}
+
+#endif // DATATILEBUFFER_H
@@ -0,0 +1,351 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "diagnosticsviewframe.h"
+#include "abstractmodelinstance.h"
+#include "numerics.h"
+
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QRegularExpression>
+#include <QSet>
+#include <QSortFilterProxyModel>
+#include <QTableView>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <utility>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+StructuralFindingModel::StructuralFindingModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+
+}
+
+void StructuralFindingModel::setFindings(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                         const QVector<StructuralFinding> &findings)
+{
+    beginResetModel();
+    mModelInstance = modelInstance;
+    mFindings = findings;
+    endResetModel();
+}
+
+const StructuralFinding &StructuralFindingModel::finding(int row) const
+{
+    return mFindings.at(row);
+}
+
+QVariant StructuralFindingModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= mFindings.size())
+        return QVariant();
+    const auto& finding = mFindings.at(index.row());
+    const bool isDuplicate = finding.Type == StructuralFinding::DuplicateRow ||
+                             finding.Type == StructuralFinding::DuplicateColumn;
+    if (role == Qt::TextAlignmentRole)
+        return index.column() == 4 ? QVariant(Qt::AlignRight | Qt::AlignVCenter) : QVariant();
+    if (role == Qt::UserRole) {
+        switch (index.column()) {
+        case 0:
+            return int(finding.Type);
+        case 1:
+            return finding.Section;
+        case 2:
+            return finding.isRow();
+        case 3:
+            return finding.Original;
+        default:
+            return isDuplicate ? QVariant(finding.Factor) : QVariant();
+        }
+    }
+    if (role != Qt::DisplayRole)
+        return QVariant();
+    switch (index.column()) {
+    case 0:
+        if (isDuplicate && finding.Factor != 1.0)
+            return finding.isRow() ? QString("Parallel row") : QString("Parallel column");
+        return StructuralDiagnostics::kindText(finding.Type);
+    case 1:
+        return sectionText(finding.isRow(), finding.Section);
+    case 2:
+        return finding.isRow() ? ViewHelper::EquationHeaderText : ViewHelper::VariableHeaderText;
+    case 3:
+        return isDuplicate ? sectionText(finding.isRow(), finding.Original) : QString();
+    default:
+        return isDuplicate ? DoubleFormatter::format(finding.Factor, DoubleFormatter::g, 6, true)
+                           : QString();
+    }
+}
+
+QVariant StructuralFindingModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
+        return mHeaderData.at(section);
+    }
+    return QVariant();
+}
+
+int StructuralFindingModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mHeaderData.size();
+}
+
+int StructuralFindingModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mFindings.size();
+}
+
+QString StructuralFindingModel::sectionText(bool isRow, int section) const
+{
+    auto symbol = isRow ? mModelInstance->equation(section) : mModelInstance->variable(section);
+    if (!symbol)
+        return QString::number(section);
+    if (symbol->isScalar())
+        return symbol->name();
+    auto labels = std::as_const(symbol->sectionLabels()).value(section);
+    return QString("%1(%2)").arg(symbol->name(), labels.join(","));
+}
+
+DiagnosticsViewFrame::DiagnosticsViewFrame(QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::defaultConfiguration());
+    setupUi();
+}
+
+DiagnosticsViewFrame::DiagnosticsViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                           const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                                           QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mModelInstance = modelInstance;
+    mViewConfig = viewConfig;
+    setupUi();
+}
+
+DiagnosticsViewFrame::~DiagnosticsViewFrame()
+{
+    mFindingWatcher.waitForFinished();
+}
+
+AbstractViewFrame *DiagnosticsViewFrame::clone(int viewId)
+{
+    auto viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
+                                                                                                         mModelInstance));
+    viewConfig->setViewId(viewId);
+    auto frame = new DiagnosticsViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    if (mFindingWatcher.isRunning()) {
+        frame->setupView(mModelInstance);
+    } else {
+        frame->mIsLoaded = mIsLoaded;
+        frame->setFindings(mFindings);
+    }
+    frame->mCheckBox->setCurrentIndex(mCheckBox->currentIndex());
+    return frame;
+}
+
+void DiagnosticsViewFrame::setShowAbsoluteValues(bool absoluteValues)
+{// the checks don't depend on the sign
+    Q_UNUSED(absoluteValues);
+}
+
+void DiagnosticsViewFrame::zoomIn()
+{
+    QFont font = mFindingView->font();
+    font.setPointSize(font.pointSize() + ViewHelper::ZoomFactor);
+    mFindingView->setFont(font);
+}
+
+void DiagnosticsViewFrame::zoomOut()
+{
+    QFont font = mFindingView->font();
+    if (font.pointSize() <= ViewHelper::ZoomFactor)
+        return;
+    font.setPointSize(font.pointSize() - ViewHelper::ZoomFactor);
+    mFindingView->setFont(font);
+}
+
+void DiagnosticsViewFrame::resetZoom()
+{
+    mFindingView->setFont(font());
+}
+
+SearchResult &DiagnosticsViewFrame::search(const QString &term, bool isRegEx)
+{
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = isRegEx;
+    mViewConfig->searchResult().Entries.clear();
+    return mViewConfig->searchResult();
+}
+
+void DiagnosticsViewFrame::setSearchSelection(const SearchResult::SearchEntry &result)
+{
+    Q_UNUSED(result);
+}
+
+void DiagnosticsViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &modelInstance)
+{
+    mModelInstance = modelInstance;
+    mIsLoaded = false;
+    setFindings(QVector<StructuralFinding>());
+    mInfoLabel->setText("Checking the Jacobian...");
+    auto loadFindings = [modelInstance]{
+        return modelInstance->structuralDiagnostics();
+    };
+    mFindingWatcher.setFuture(QtConcurrent::run(loadFindings));
+}
+
+bool DiagnosticsViewFrame::hasData() const
+{
+    return mFindingWatcher.isRunning() || (mIsLoaded && mModelInstance->equationRowCount());
+}
+
+void DiagnosticsViewFrame::findingsLoaded()
+{
+    mIsLoaded = true;
+    setFindings(mFindingWatcher.result());
+}
+
+void DiagnosticsViewFrame::updateFilter()
+{
+    auto check = mCheckBox->currentData();
+    mProxyModel->setFilterRegularExpression(check.isValid() ? QString("^%1$").arg(check.toInt())
+                                                            : QString());
+}
+
+void DiagnosticsViewFrame::showSymbols(const QModelIndex &index)
+{
+    if (!index.isValid())
+        return;
+    const int row = mProxyModel->mapToSource(index).row();
+    const auto& finding = mFindingModel->finding(row);
+    const bool isRow = finding.isRow();
+    QList<Symbol*> symbols;
+    for (int section : { finding.Section, finding.Original }) {
+        if (section < 0)
+            continue;
+        auto symbol = isRow ? mModelInstance->equation(section) : mModelInstance->variable(section);
+        if (symbol && !symbols.contains(symbol))
+            symbols.append(symbol);
+    }
+    auto entries = entrySymbols(finding);
+    if (symbols.isEmpty() || entries.isEmpty()) {
+        mInfoLabel->setText(QString("%1 has no entries to show.")
+                            .arg(mFindingModel->index(row, 1).data().toString()));
+        return;
+    }
+    std::sort(symbols.begin(), symbols.end(), [](Symbol *a, Symbol *b) {
+        return a->firstSection() < b->firstSection();
+    });
+    mSelectedEquations = isRow ? symbols : entries;
+    mSelectedVariables = isRow ? entries : symbols;
+    emit newSymbolViewRequested();
+}
+
+void DiagnosticsViewFrame::setupUi()
+{
+    mCheckBox = new QComboBox(this);
+    mCheckBox->addItem("All checks");
+    for (int kind=0; kind<StructuralFinding::KindCount; ++kind)
+        mCheckBox->addItem(StructuralDiagnostics::kindText(StructuralFinding::Kind(kind)), kind);
+    mInfoLabel = new QLabel(this);
+    auto controls = new QHBoxLayout;
+    controls->addWidget(new QLabel("Show", this));
+    controls->addWidget(mCheckBox);
+    controls->addStretch();
+    controls->addWidget(mInfoLabel);
+
+    mFindingModel = new StructuralFindingModel(this);
+    mProxyModel = new QSortFilterProxyModel(this);
+    mProxyModel->setSourceModel(mFindingModel);
+    mProxyModel->setSortRole(Qt::UserRole);
+    mProxyModel->setFilterRole(Qt::UserRole);
+    mProxyModel->setFilterKeyColumn(0);
+    mFindingView = new QTableView(this);
+    mFindingView->setModel(mProxyModel);
+    mFindingView->setSortingEnabled(true);
+    mFindingView->sortByColumn(-1, Qt::AscendingOrder);
+    mFindingView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mFindingView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mFindingView->verticalHeader()->setVisible(false);
+    mFindingView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    mFindingView->horizontalHeader()->setStretchLastSection(true);
+    mFindingView->setToolTip("Double click an entry to open its symbol view.");
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(controls);
+    layout->addWidget(mFindingView);
+    connect(mCheckBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &DiagnosticsViewFrame::updateFilter);
+    connect(mFindingView, &QTableView::doubleClicked,
+            this, &DiagnosticsViewFrame::showSymbols);
+    connect(&mFindingWatcher, &QFutureWatcher<QVector<StructuralFinding>>::finished,
+            this, &DiagnosticsViewFrame::findingsLoaded);
+}
+
+void DiagnosticsViewFrame::setFindings(const QVector<StructuralFinding> &findings)
+{
+    mFindings = findings;
+    mFindingModel->setFindings(mModelInstance, mFindings);
+    QVector<int> counts(StructuralFinding::KindCount, 0);
+    for (const auto& finding : mFindings)
+        ++counts[finding.Type];
+    for (int kind=0; kind<StructuralFinding::KindCount; ++kind) {
+        mCheckBox->setItemText(kind+1, QString("%1 (%2)").arg(StructuralDiagnostics::kindText(StructuralFinding::Kind(kind)))
+                                                        .arg(counts.at(kind)));
+    }
+    mFindingView->resizeColumnsToContents();
+    if (!mIsLoaded) {
+        mInfoLabel->clear();
+        return;
+    }
+    mInfoLabel->setText(mFindings.isEmpty() ? QString("No structural issues found.")
+                                            : QString("%1 findings").arg(mFindings.size()));
+}
+
+QList<Symbol*> DiagnosticsViewFrame::entrySymbols(const StructuralFinding &finding) const
+{
+    QSet<Symbol*> symbols;
+    for (int section : finding.Entries) {
+        auto symbol = finding.isRow() ? mModelInstance->variable(section)
+                                      : mModelInstance->equation(section);
+        if (symbol)
+            symbols.insert(symbol);
+    }
+    auto list = symbols.values();
+    std::sort(list.begin(), list.end(), [](Symbol *a, Symbol *b) {
+        return a->firstSection() < b->firstSection();
+    });
+    return list;
+}
+
+}
+}
+}
@@ -0,0 +1,148 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DIAGNOSTICSVIEWFRAME_H
+#define DIAGNOSTICSVIEWFRAME_H
+
+#include "abstractviewframe.h"
+#include "structuraldiagnostics.h"
+
+#include <QAbstractTableModel>
+#include <QFutureWatcher>
+
+class QComboBox;
+class QLabel;
+class QSortFilterProxyModel;
+class QTableView;
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class Symbol;
+
+///
+/// \brief One row per StructuralFinding.
+///
+class StructuralFindingModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    StructuralFindingModel(QObject *parent = nullptr);
+
+    void setFindings(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                     const QVector<StructuralFinding> &findings);
+
+    const StructuralFinding& finding(int row) const;
+
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+private:
+    QString sectionText(bool isRow, int section) const;
+
+private:
+    const QStringList mHeaderData { "Check", "Entry", "Type", "Duplicate of", "Factor" };
+    QSharedPointer<AbstractModelInstance> mModelInstance;
+    QVector<StructuralFinding> mFindings;
+};
+
+///
+/// \brief Structural diagnostics of the Jacobian, computed by
+///        StructuralDiagnostics on a worker thread.
+///
+class DiagnosticsViewFrame final : public AbstractViewFrame
+{
+    Q_OBJECT
+
+public:
+    DiagnosticsViewFrame(QWidget *parent = nullptr,
+                         Qt::WindowFlags f = Qt::WindowFlags());
+
+    DiagnosticsViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                         const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                         QWidget *parent = nullptr,
+                         Qt::WindowFlags f = Qt::WindowFlags());
+
+    ~DiagnosticsViewFrame() override;
+
+    AbstractViewFrame* clone(int viewId) override;
+
+    void setShowAbsoluteValues(bool absoluteValues) override;
+
+    inline ViewHelper::ViewDataType type() const override
+    {
+        return ViewHelper::ViewDataType::Diagnostics;
+    }
+
+    void zoomIn() override;
+
+    void zoomOut() override;
+
+    void resetZoom() override;
+
+    SearchResult& search(const QString &term, bool isRegEx) override;
+
+    void setSearchSelection(const SearchResult::SearchEntry &result) override;
+
+    void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
+
+    bool hasData() const override;
+
+private slots:
+    void findingsLoaded();
+
+    void updateFilter();
+
+    void showSymbols(const QModelIndex &index);
+
+private:
+    void setupUi();
+
+    void setFindings(const QVector<StructuralFinding> &findings);
+
+    ///
+    /// \brief Symbols of the entries of <c>finding</c>.
+    ///
+    QList<Symbol*> entrySymbols(const StructuralFinding &finding) const;
+
+private:
+    QComboBox *mCheckBox;
+    QLabel *mInfoLabel;
+    QTableView *mFindingView;
+    StructuralFindingModel *mFindingModel;
+    QSortFilterProxyModel *mProxyModel;
+    QVector<StructuralFinding> mFindings;
+    bool mIsLoaded = false;
+    QFutureWatcher<QVector<StructuralFinding>> mFindingWatcher;
+};
+
+}
+}
+}
+
+#endif // DIAGNOSTICSVIEWFRAME_H
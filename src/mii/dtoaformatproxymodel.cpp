@@ -18,30 +18,125 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "dtoaformatproxymodel.h"
-#include "numerics.h"
+
+#include <QLoggingCategory>
+
+#include <cstring>
 
 namespace gams {
 namespace studio {
 namespace mii {
 
+Q_LOGGING_CATEGORY(formatCacheLog, "gams.mii.formatcache", QtWarningMsg)
+
+const int FormatCache::DefaultCapacity = 16384;
+const DoubleFormatter::Format FormatCache::TextFormat = DoubleFormatter::g;
+const int FormatCache::TextPrecision = 6;
+
+FormatCache::FormatCache(int capacity)
+    : mCache(capacity)
+{
+
+}
+
+QString FormatCache::format(double value)
+{
+    quint64 key;
+    std::memcpy(&key, &value, sizeof(key));
+    if (auto text = mCache.object(key)) {
+        ++mHits;
+        return *text;
+    }
+    ++mMisses;
+    auto text = DoubleFormatter::format(value, TextFormat, TextPrecision, true);
+    mCache.insert(key, new QString(text));
+    return text;
+}
+
+void FormatCache::insert(double value, const QString &text)
+{
+    quint64 key;
+    std::memcpy(&key, &value, sizeof(key));
+    mCache.insert(key, new QString(text));
+}
+
+void FormatCache::clear()
+{
+    mCache.clear();
+    mHits = 0;
+    mMisses = 0;
+}
+
+int FormatCache::capacity() const
+{
+    return mCache.maxCost();
+}
+
+void FormatCache::setCapacity(int capacity)
+{
+    mCache.setMaxCost(capacity);
+}
+
+quint64 FormatCache::hits() const
+{
+    return mHits;
+}
+
+quint64 FormatCache::misses() const
+{
+    return mMisses;
+}
+
+double FormatCache::hitRate() const
+{
+    auto total = mHits + mMisses;
+    return total ? double(mHits) / double(total) : 0.0;
+}
+
 DtoaFormatProxyModel::DtoaFormatProxyModel(QObject *parent)
     : QIdentityProxyModel(parent)
 {
 
 }
 
+DtoaFormatProxyModel::~DtoaFormatProxyModel()
+{
+    qCDebug(formatCacheLog) << metaObject()->className() << "hits:" << mFormatCache.hits()
+                            << "misses:" << mFormatCache.misses()
+                            << "hit rate:" << mFormatCache.hitRate();
+}
+
 QVariant DtoaFormatProxyModel::data(const QModelIndex &index, int role) const
 {
     if (!index.isValid())
         return QVariant();
     auto data = QIdentityProxyModel::data(index, role);
     if (role == Qt::DisplayRole && data.isValid()) {
-        auto value = data.toDouble();
-        return DoubleFormatter::format(value, DoubleFormatter::g, 6, true);
+        return format(data.toDouble());
     }
     return data;
 }
 
+const FormatCache &DtoaFormatProxyModel::formatCache() const
+{
+    return mFormatCache;
+}
+
+void DtoaFormatProxyModel::preloadTiles(const QVector<DataTile> &tiles)
+{
+    for (const auto& tile : tiles) {
+        for (int i=0; i<tile.Texts.size(); ++i) {
+            if (tile.Mask[i])
+                mFormatCache.insert(tile.Values[i], tile.Texts[i]);
+        }
+    }
+}
+
+QString DtoaFormatProxyModel::format(double value) const
+{
+    return mFormatCache.format(value);
+}
+
 DtoaBpAverageFormatProxyModel::DtoaBpAverageFormatProxyModel(QObject *parent)
     : DtoaFormatProxyModel(parent)
 {
@@ -55,8 +150,7 @@ QVariant DtoaBpAverageFormatProxyModel::data(const QModelIndex &index, int role)
     auto data = QIdentityProxyModel::data(index, role);
     if (role == Qt::DisplayRole && data.isValid() && index.column() < columnCount()-4 &&
         index.row() < rowCount()-4){
-        auto value = data.toDouble();
-        return DoubleFormatter::format(value, DoubleFormatter::g, 6, true);
+        return format(data.toDouble());
     }
     return data;
 }
@@ -20,12 +20,58 @@
 #ifndef DTOAFORMATPROXYMODEL_H
 #define DTOAFORMATPROXYMODEL_H
 
+#include "datatile.h"
+#include "numerics.h"
+
+#include <QCache>
 #include <QIdentityProxyModel>
 
 namespace gams {
 namespace studio {
 namespace mii {
 
+///
+/// \brief LRU cache of formatted display strings keyed by the bit pattern
+///        of the formatted double.
+///
+class FormatCache
+{
+public:
+    static const int DefaultCapacity;
+
+    ///
+    /// \brief Number format and precision of all display strings.
+    ///
+    static const DoubleFormatter::Format TextFormat;
+    static const int TextPrecision;
+
+    FormatCache(int capacity = DefaultCapacity);
+
+    QString format(double value);
+
+    ///
+    /// \brief Adds an already formatted text, e.g. from a prefetched tile.
+    ///
+    void insert(double value, const QString &text);
+
+    void clear();
+
+    int capacity() const;
+
+    void setCapacity(int capacity);
+
+    quint64 hits() const;
+
+    quint64 misses() const;
+
+    double hitRate() const;
+
+private:
+    QCache<quint64, QString> mCache;
+    quint64 mHits = 0;
+    quint64 mMisses = 0;
+};
+
 class DtoaFormatProxyModel : public QIdentityProxyModel
 {
     Q_OBJECT
@@ -33,7 +79,27 @@ class DtoaFormatProxyModel : public QIdentityProxyModel
 public:
     DtoaFormatProxyModel(QObject *parent = nullptr);
 
+    ///
+    /// \brief Reports the hit rate of the format cache to the
+    ///        <c>gams.mii.formatcache</c> logging category.
+    ///
+    ~DtoaFormatProxyModel() override;
+
     virtual QVariant data(const QModelIndex &index, int role) const override;
+
+    const FormatCache& formatCache() const;
+
+    ///
+    /// \brief Fills the format cache with the display texts of prefetched
+    ///        tiles.
+    ///
+    void preloadTiles(const QVector<DataTile> &tiles);
+
+protected:
+    QString format(double value) const;
+
+private:
+    mutable FormatCache mFormatCache;
 };
 
 class DtoaBpAverageFormatProxyModel : public DtoaFormatProxyModel
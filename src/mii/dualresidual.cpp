@@ -0,0 +1,171 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "dualresidual.h"
+#include "datamatrix.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Row range of one accumulation task, which sums its terms into
+///        <c>Sum</c>.
+///
+struct DualRowBlock
+{
+    int First = 0;
+    int Last = -1;
+    double *Sum = nullptr;
+};
+
+///
+/// \brief Column range of one reduction task.
+///
+struct DualColumnBlock
+{
+    int First = 0;
+    int Last = -1;
+};
+
+static const int DualMaxRowBlocks = 16;
+static const int DualMinRowsPerBlock = 4096;
+static const int DualColumnsPerTask = 4096;
+
+///
+/// \brief Memory of the partial sums of the row blocks, which limits the
+///        number of row blocks for models with many columns.
+///
+static const qint64 DualPartialSumBudget = 256 * 1024 * 1024;
+
+QVector<double> DualResidual::transposeProduct(DataMatrix &matrix, bool useOutput,
+                                               const QVector<double> &y)
+{
+    const int rows = std::min(matrix.rowCount(), int(y.size()));
+    const int columns = matrix.columnCount();
+    QVector<double> product(columns, 0.0);
+    if (!rows || !columns)
+        return product;
+
+    // every row block sums a_ij * y_i of its rows into a dense column
+    // vector, where the first block uses the product itself; the block
+    // count only depends on the matrix size, which keeps the summation
+    // order and thus the result independent of the thread count
+    const qint64 budgetBlocks = DualPartialSumBudget / (qint64(columns) * qint64(sizeof(double))) + 1;
+    const int blockCount = int(std::min<qint64>({ DualMaxRowBlocks, budgetBlocks,
+                                                  qint64(rows-1) / DualMinRowsPerBlock + 1 }));
+    const int rowsPerBlock = (rows + blockCount - 1) / blockCount;
+    QVector<double> partialSums((blockCount-1) * columns, 0.0);
+    QVector<DualRowBlock> rowBlocks;
+    for (int b=0; b<blockCount; ++b) {
+        DualRowBlock block;
+        block.First = b * rowsPerBlock;
+        block.Last = std::min(block.First+rowsPerBlock, rows)-1;
+        block.Sum = b ? partialSums.data() + qint64(b-1) * columns : product.data();
+        rowBlocks.append(block);
+    }
+    const double *multiplier = y.constData();
+    auto values = matrix.values(useOutput);
+    QtConcurrent::blockingMap(rowBlocks, [&matrix, &values, multiplier, columns](const DualRowBlock &block) {
+        for (int r=block.First; r<=block.Last; ++r) {
+            if (multiplier[r] == 0.0)
+                continue;
+            auto row = matrix.row(r);
+            const int *index = row->colIdx();
+            auto a = values.row(r);
+            for (int e=0; e<row->entries(); ++e) {
+                if (index[e] < columns)
+                    block.Sum[index[e]] += a[e] * multiplier[r];
+            }
+        }
+    });
+    if (blockCount == 1)
+        return product;
+
+    QVector<DualColumnBlock> columnBlocks;
+    for (int first=0; first<columns; first+=DualColumnsPerTask) {
+        DualColumnBlock block;
+        block.First = first;
+        block.Last = std::min(first+DualColumnsPerTask, columns)-1;
+        columnBlocks.append(block);
+    }
+    double *result = product.data();
+    const double *partial = partialSums.constData();
+    QtConcurrent::blockingMap(columnBlocks, [result, partial, blockCount, columns](const DualColumnBlock &block) {
+        for (int b=0; b<blockCount-1; ++b) {
+            const double *sum = partial + qint64(b) * columns;
+            for (int c=block.First; c<=block.Last; ++c)
+                result[c] += sum[c];
+        }
+    });
+    return product;
+}
+
+QVector<DualSummary> DualResidual::run(DataMatrix &matrix,
+                                       bool useOutput,
+                                       const QVector<double> &objective,
+                                       const QVector<int> &objectiveNlFlags,
+                                       const QVector<double> &rowMarginals,
+                                       const QVector<double> &marginals,
+                                       const QVector<int> &columnSymbols,
+                                       int symbolCount)
+{
+    QVector<DualSummary> summaries(symbolCount);
+    for (int s=0; s<symbolCount; ++s)
+        summaries[s].Symbol = s;
+    auto product = transposeProduct(matrix, useOutput, rowMarginals);
+    const int columns = std::min({ int(product.size()), int(objective.size()),
+                                   int(marginals.size()), int(columnSymbols.size()) });
+    for (int c=0; c<columns; ++c) {
+        const int symbol = columnSymbols.at(c);
+        if (symbol < 0 || symbol >= symbolCount)
+            continue;
+        auto& summary = summaries[symbol];
+        if (c < objectiveNlFlags.size() && objectiveNlFlags.at(c)) {
+            ++summary.SkippedColumns;
+            continue;
+        }
+        ++summary.Columns;
+        const double computed = objective.at(c) - product.at(c);
+        double mismatch = std::abs(computed - marginals.at(c));
+        if (!std::isfinite(mismatch))
+            mismatch = std::numeric_limits<double>::infinity();
+        const double scale = std::max({ 1.0, std::abs(marginals.at(c)), std::abs(objective.at(c)) });
+        if (mismatch > Tolerance * scale)
+            ++summary.Mismatches;
+        summary.MaxRelativeMismatch = std::max(summary.MaxRelativeMismatch, mismatch / scale);
+        if (summary.MismatchColumn < 0 || mismatch > summary.MaxMismatch) {
+            summary.MaxMismatch = mismatch;
+            summary.MismatchColumn = c;
+            summary.ComputedMarginal = computed;
+            summary.ReportedMarginal = marginals.at(c);
+        }
+    }
+    return summaries;
+}
+
+}
+}
+}
@@ -0,0 +1,128 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DUALRESIDUAL_H
+#define DUALRESIDUAL_H
+
+#include <QVector>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class DataMatrix;
+
+///
+/// \brief Reduced cost mismatches of the columns of one variable symbol.
+///
+struct DualSummary
+{
+    ///
+    /// \brief Logical index of the variable symbol.
+    ///
+    int Symbol = -1;
+
+    ///
+    /// \brief Number of checked columns.
+    ///
+    int Columns = 0;
+
+    ///
+    /// \brief Number of skipped columns with a nonlinear objective.
+    ///
+    int SkippedColumns = 0;
+
+    ///
+    /// \brief Number of columns whose marginal differs from c - A^T y by
+    ///        more than DualResidual::Tolerance.
+    ///
+    int Mismatches = 0;
+
+    ///
+    /// \brief Largest |c_j - A_j^T y - marginal_j|, its column and both
+    ///        reduced costs of that column.
+    ///
+    double MaxMismatch = 0.0;
+    int MismatchColumn = -1;
+    double ComputedMarginal = 0.0;
+    double ReportedMarginal = 0.0;
+
+    ///
+    /// \brief Largest mismatch relative to the reported marginal or the
+    ///        objective coefficient, at least 1.
+    ///
+    double MaxRelativeMismatch = 0.0;
+};
+
+///
+/// \brief Verification of the variable marginals against the equation
+///        marginals.
+///
+/// The reduced costs c - A^T y of all columns are computed by a transpose
+/// sparse matrix-vector product. The terms a_ij * y_i are scattered once
+/// into compressed column order and each column is then summed in row
+/// order by parallel column blocks, so the result doesn't depend on the
+/// thread scheduling and no per-thread accumulator is needed. Nonlinear
+/// entries use the Jacobian at the evaluation point if the output data is
+/// used.
+///
+/// The marginals follow the GAMS convention, where a marginal is the
+/// derivative of the objective with respect to the row level or the
+/// variable. Thus the reduced cost is c - A^T y for both minimization and
+/// maximization and the objective sense isn't needed.
+///
+class DualResidual final
+{
+public:
+    ///
+    /// \brief Relative tolerance of the mismatches.
+    ///
+    static constexpr double Tolerance = 1e-6;
+
+    ///
+    /// \brief A^T y of all columns.
+    ///
+    static QVector<double> transposeProduct(DataMatrix &matrix, bool useOutput,
+                                            const QVector<double> &y);
+
+    ///
+    /// \brief Check all columns.
+    /// \param objective Objective coefficient per column, i.e. c.
+    /// \param objectiveNlFlags Columns with a nonlinear objective, which
+    ///        aren't checked; may be empty.
+    /// \param rowMarginals Equation marginals, i.e. y.
+    /// \param marginals Variable marginals reported by the solver.
+    /// \param columnSymbols Logical variable symbol index of each column.
+    /// \return One summary per variable symbol.
+    ///
+    static QVector<DualSummary> run(DataMatrix &matrix,
+                                    bool useOutput,
+                                    const QVector<double> &objective,
+                                    const QVector<int> &objectiveNlFlags,
+                                    const QVector<double> &rowMarginals,
+                                    const QVector<double> &marginals,
+                                    const QVector<int> &columnSymbols,
+                                    int symbolCount);
+};
+
+}
+}
+}
+
+#endif // DUALRESIDUAL_H
@@ -0,0 +1,185 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "evaluationpointregistry.h"
+#include "datamatrix.h"
+
+#include <QRegularExpression>
+
+#include <cmath>
+#include <cstring>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+static inline quint64 coordinateBits(double value)
+{
+    if (value == 0.0)
+        value = 0.0; // no -0.0
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+///
+/// \brief Whether <c>a</c> and <c>b</c> are the same point in the sense
+///        of EvaluationPointRegistry::hash().
+///
+static bool samePoint(const QVector<double> &a, const QVector<double> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (int i=0; i<a.size(); ++i) {
+        if (coordinateBits(a.at(i)) != coordinateBits(b.at(i)))
+            return false;
+    }
+    return true;
+}
+
+quint64 EvaluationPointRegistry::hash(const QVector<double> &point)
+{
+    quint64 hash = quint64(point.size()) ^ 0x9e3779b97f4a7c15ull;
+    for (double value : point)
+        hash ^= coordinateBits(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+QVector<double> EvaluationPointRegistry::boundsMidpoint(const QVector<double> &lower,
+                                                        const QVector<double> &upper)
+{
+    QVector<double> point(std::min(lower.size(), upper.size()), 0.0);
+    for (int i=0; i<point.size(); ++i) {
+        const bool hasLower = std::isfinite(lower.at(i));
+        const bool hasUpper = std::isfinite(upper.at(i));
+        if (hasLower && hasUpper)
+            point[i] = lower.at(i) + (upper.at(i) - lower.at(i)) / 2.0;
+        else if (hasLower)
+            point[i] = lower.at(i);
+        else if (hasUpper)
+            point[i] = upper.at(i);
+    }
+    return point;
+}
+
+QVector<double> EvaluationPointRegistry::parsePoint(const QString &text, bool *ok)
+{
+    static const QRegularExpression separator("[,;\\s]+");
+    QVector<double> point;
+    bool valid = true;
+    for (const auto &coordinate : text.split(separator, Qt::SkipEmptyParts)) {
+        point.append(coordinate.toDouble(&valid));
+        if (!valid)
+            break;
+    }
+    valid = valid && !point.isEmpty();
+    if (!valid)
+        point.clear();
+    if (ok)
+        *ok = valid;
+    return point;
+}
+
+std::shared_ptr<const NlOverlay> EvaluationPointRegistry::overlay(const QVector<double> &point,
+                                                                  const Evaluator &evaluate)
+{
+    auto cached = overlay(point);
+    if (cached)
+        return cached;
+    auto evaluated = evaluate(point);
+    if (evaluated)
+        insert(point, evaluated);
+    return evaluated;
+}
+
+std::shared_ptr<const NlOverlay> EvaluationPointRegistry::overlay(const QVector<double> &point)
+{
+    const quint64 key = hash(point);
+    QMutexLocker locker(&mLock);
+    auto entry = mEntries.constFind(key);
+    if (entry == mEntries.constEnd() || !samePoint(entry->Point, point))
+        return nullptr;
+    mUsage.removeOne(key);
+    mUsage.append(key);
+    return entry->Overlay;
+}
+
+void EvaluationPointRegistry::insert(const QVector<double> &point,
+                                     const std::shared_ptr<const NlOverlay> &overlay)
+{
+    const quint64 key = hash(point);
+    QMutexLocker locker(&mLock);
+    mEntries.insert(key, Entry { point, overlay });
+    mUsage.removeOne(key);
+    mUsage.append(key);
+    evict();
+}
+
+int EvaluationPointRegistry::count() const
+{
+    QMutexLocker locker(&mLock);
+    return mEntries.size();
+}
+
+qint64 EvaluationPointRegistry::byteSize() const
+{
+    QMutexLocker locker(&mLock);
+    qint64 size = 0;
+    for (const auto &entry : mEntries)
+        size += entry.byteSize();
+    return size;
+}
+
+qint64 EvaluationPointRegistry::memoryBudget() const
+{
+    QMutexLocker locker(&mLock);
+    return mMemoryBudget;
+}
+
+void EvaluationPointRegistry::setMemoryBudget(qint64 budget)
+{
+    QMutexLocker locker(&mLock);
+    mMemoryBudget = budget;
+    evict();
+}
+
+void EvaluationPointRegistry::clear()
+{
+    QMutexLocker locker(&mLock);
+    mEntries.clear();
+    mUsage.clear();
+}
+
+qint64 EvaluationPointRegistry::Entry::byteSize() const
+{
+    return Overlay->byteSize() + Point.size() * qint64(sizeof(double));
+}
+
+void EvaluationPointRegistry::evict()
+{
+    qint64 size = 0;
+    for (const auto &entry : mEntries)
+        size += entry.byteSize();
+    while (mUsage.size() > 1 && size > mMemoryBudget)
+        size -= mEntries.take(mUsage.takeFirst()).byteSize();
+}
+
+}
+}
+}
@@ -0,0 +1,167 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef EVALUATIONPOINTREGISTRY_H
+#define EVALUATIONPOINTREGISTRY_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+struct NlOverlay;
+
+///
+/// \brief Cache of the NL overlays of the evaluation points of a Jacobian,
+///        keyed by the hash of the point.
+///
+/// Each entry keeps the coordinates of its point, so a hash collision is a
+/// miss. The least recently used points beyond the memory budget are
+/// dropped.
+///
+class EvaluationPointRegistry
+{
+public:
+    enum Type : std::uint8_t
+    {
+        ///
+        /// \brief Point of the input Jacobian, which needs no overlay.
+        ///
+        InputPoint,
+
+        ///
+        /// \brief Variable levels of the solution.
+        ///
+        SolutionPoint,
+
+        ///
+        /// \brief Midpoint of the variable bounds.
+        ///
+        BoundsMidpoint,
+
+        ///
+        /// \brief Point supplied by the user.
+        ///
+        UserPoint
+    };
+
+    typedef std::function<std::shared_ptr<const NlOverlay>(const QVector<double>&)> Evaluator;
+
+    ///
+    /// \brief Hash of the coordinates of <c>point</c>, where 0.0 and -0.0
+    ///        are the same coordinate.
+    ///
+    static quint64 hash(const QVector<double> &point);
+
+    ///
+    /// \brief Midpoint of <c>lower</c> and <c>upper</c>. A single finite
+    ///        bound is taken as is, free coordinates are 0.
+    ///
+    static QVector<double> boundsMidpoint(const QVector<double> &lower,
+                                          const QVector<double> &upper);
+
+    ///
+    /// \brief Coordinates of a user point in column order, e.g. a CSV
+    ///        file, separated by commas, semicolons or white space.
+    /// \param ok Set to <c>false</c> if <c>text</c> has no or a
+    ///        non-numeric coordinate, where the point is empty.
+    ///
+    static QVector<double> parsePoint(const QString &text, bool *ok = nullptr);
+
+    ///
+    /// \brief Cached overlay of <c>point</c>, or the result of
+    ///        <c>evaluate</c>, which is cached if not <c>nullptr</c>.
+    /// \remark <c>evaluate</c> runs without the registry lock, so points
+    ///         can be evaluated concurrently.
+    ///
+    std::shared_ptr<const NlOverlay> overlay(const QVector<double> &point,
+                                             const Evaluator &evaluate);
+
+    ///
+    /// \brief Cached overlay of <c>point</c>, or <c>nullptr</c>.
+    ///
+    std::shared_ptr<const NlOverlay> overlay(const QVector<double> &point);
+
+    ///
+    /// \brief Cache <c>overlay</c> as the most recently used point, which
+    ///        replaces a point of the same hash.
+    ///
+    void insert(const QVector<double> &point, const std::shared_ptr<const NlOverlay> &overlay);
+
+    int count() const;
+
+    ///
+    /// \brief Approximate size of all cached overlays and their points in
+    ///        bytes.
+    ///
+    qint64 byteSize() const;
+
+    ///
+    /// \brief Upper bound of byteSize(). The most recently used point is
+    ///        kept even if it exceeds the budget alone.
+    ///
+    qint64 memoryBudget() const;
+
+    void setMemoryBudget(qint64 budget);
+
+    void clear();
+
+    static constexpr qint64 DefaultMemoryBudget = 256ll * 1024 * 1024;
+
+private:
+    struct Entry
+    {
+        QVector<double> Point;
+        std::shared_ptr<const NlOverlay> Overlay;
+
+        qint64 byteSize() const;
+    };
+
+    ///
+    /// \brief Drop least recently used entries until byteSize() fits into
+    ///        the memory budget. Requires mLock.
+    ///
+    void evict();
+
+private:
+    mutable QMutex mLock;
+    QHash<quint64, Entry> mEntries;
+
+    ///
+    /// \brief Keys of mEntries, least recently used first.
+    ///
+    QList<quint64> mUsage;
+
+    qint64 mMemoryBudget = DefaultMemoryBudget;
+};
+
+}
+}
+}
+
+#endif // EVALUATIONPOINTREGISTRY_H
@@ -0,0 +1,501 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "histogramviewframe.h"
+#include "abstractmodelinstance.h"
+#include "numerics.h"
+
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QHelpEvent>
+#include <QLabel>
+#include <QPainter>
+#include <QSortFilterProxyModel>
+#include <QSpinBox>
+#include <QSplitter>
+#include <QTabWidget>
+#include <QTableView>
+#include <QToolTip>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+static QString symbolName(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                          bool isEquation, int index)
+{
+    const auto& symbols = isEquation ? modelInstance->equations() : modelInstance->variables();
+    return index >= 0 && index < symbols.size() ? symbols.at(index)->name() : QString::number(index);
+}
+
+HistogramPlot::HistogramPlot(QWidget *parent)
+    : QWidget(parent)
+{
+    setMouseTracking(true);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setMinimumHeight(120);
+}
+
+void HistogramPlot::setCounts(const LogHistogram::Buckets &counts, const QString &title)
+{
+    mCounts = counts;
+    mMaxCount = *std::max_element(mCounts.cbegin(), mCounts.cend());
+    mTitle = title;
+    update();
+}
+
+void HistogramPlot::clear(const QString &placeholder)
+{
+    mCounts.fill(0);
+    mMaxCount = 0;
+    mTitle.clear();
+    mPlaceholder = placeholder;
+    update();
+}
+
+bool HistogramPlot::event(QEvent *event)
+{
+    if (event->type() != QEvent::ToolTip)
+        return QWidget::event(event);
+    auto helpEvent = static_cast<QHelpEvent*>(event);
+    int bucket = bucketAt(helpEvent->pos());
+    if (bucket < 0 || !mMaxCount) {
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+    QToolTip::showText(helpEvent->globalPos(),
+                       QString("|a| in %1\nNonzeros: %2").arg(LogHistogram::bucketText(bucket))
+                                                         .arg(mCounts[bucket]),
+                       this);
+    return true;
+}
+
+void HistogramPlot::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+    if (!mMaxCount) {
+        painter.drawText(rect(), Qt::AlignCenter, mPlaceholder);
+        return;
+    }
+    auto area = plotArea();
+    const double barWidth = double(area.width()) / LogHistogram::BucketCount;
+    painter.drawText(QRect(area.left(), 0, area.width(), area.top()),
+                     Qt::AlignCenter, mTitle);
+    painter.setPen(palette().text().color());
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+    for (int b=0; b<LogHistogram::BucketCount; ++b) {
+        const int x = area.left() + int(b * barWidth);
+        if (mCounts[b]) {
+            const int height = std::max(1, int(double(mCounts[b]) / mMaxCount * area.height()));
+            painter.fillRect(QRect(x+1, area.bottom()-height, std::max(1, int(barWidth)-2), height),
+                             palette().highlight());
+        }
+        if (b % 2 == 1) {
+            const int decade = LogHistogram::MinExponent + b - 1;
+            painter.drawText(QRect(x, area.bottom()+2, int(barWidth*2), fontMetrics().height()),
+                             Qt::AlignLeft, QString("1e%1").arg(decade));
+        }
+    }
+}
+
+int HistogramPlot::bucketAt(const QPoint &pos) const
+{
+    auto area = plotArea();
+    if (!area.contains(pos))
+        return -1;
+    return std::min(LogHistogram::BucketCount-1,
+                    int(double(pos.x() - area.left()) / area.width() * LogHistogram::BucketCount));
+}
+
+QRect HistogramPlot::plotArea() const
+{
+    const int margin = fontMetrics().height() + 4;
+    return rect().adjusted(margin, margin, -margin, -margin);
+}
+
+HistogramBlockModel::HistogramBlockModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+
+}
+
+void HistogramBlockModel::setHistogram(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                       const QSharedPointer<LogHistogram> &histogram)
+{
+    beginResetModel();
+    mModelInstance = modelInstance;
+    mHistogram = histogram;
+    endResetModel();
+}
+
+const LogHistogram::Buckets &HistogramBlockModel::counts(int row) const
+{
+    if (row <= 0)
+        return mHistogram->total();
+    return mHistogram->blocks().at(row-1).Counts;
+}
+
+QString HistogramBlockModel::title(int row) const
+{
+    if (row <= 0)
+        return "All equations and variables";
+    const auto& block = mHistogram->blocks().at(row-1);
+    return QString("%1 x %2").arg(symbolName(mModelInstance, true, block.Row),
+                                  symbolName(mModelInstance, false, block.Column));
+}
+
+QVariant HistogramBlockModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+    if (role == Qt::TextAlignmentRole)
+        return index.column() < 2 ? QVariant() : QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    if (role != Qt::DisplayRole && role != Qt::UserRole)
+        return QVariant();
+    if (index.column() < 2) {
+        if (!index.row())
+            return role == Qt::UserRole ? QVariant() : QVariant("All");
+        const auto& block = mHistogram->blocks().at(index.row()-1);
+        return symbolName(mModelInstance, !index.column(), index.column() ? block.Column : block.Row);
+    }
+    const auto& buckets = counts(index.row());
+    if (index.column() == 2)
+        return LogHistogram::sum(buckets);
+    int first = 0;
+    while (first < LogHistogram::BucketCount-1 && !buckets[first])
+        ++first;
+    int last = LogHistogram::BucketCount-1;
+    while (last > 0 && !buckets[last])
+        --last;
+    switch (index.column()) {
+    case 3:
+        return role == Qt::UserRole ? QVariant(first) : QVariant(LogHistogram::bucketText(first));
+    case 4:
+        return role == Qt::UserRole ? QVariant(last) : QVariant(LogHistogram::bucketText(last));
+    default:
+        return std::max(0, last - first + 1);
+    }
+}
+
+QVariant HistogramBlockModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
+        return mHeaderData.at(section);
+    }
+    return QVariant();
+}
+
+int HistogramBlockModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mHeaderData.size();
+}
+
+int HistogramBlockModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mHistogram ? mHistogram->blocks().size() + 1 : 0;
+}
+
+ScalingRankModel::ScalingRankModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+
+}
+
+void ScalingRankModel::setRanks(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                const QVector<LogHistogram::Rank> &ranks)
+{
+    beginResetModel();
+    mModelInstance = modelInstance;
+    mRanks = ranks;
+    endResetModel();
+}
+
+const LogHistogram::Rank &ScalingRankModel::rank(int row) const
+{
+    return mRanks.at(row);
+}
+
+QVariant ScalingRankModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= mRanks.size())
+        return QVariant();
+    if (role == Qt::TextAlignmentRole)
+        return index.column() == 1 || index.column() == 2 ? QVariant()
+                                                          : QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    if (role != Qt::DisplayRole)
+        return QVariant();
+    const auto& rank = mRanks.at(index.row());
+    switch (index.column()) {
+    case 0:
+        return index.row() + 1;
+    case 1:
+        return rank.Row < 0 ? QVariant() : QVariant(symbolName(mModelInstance, true, rank.Row));
+    case 2:
+        return rank.Column < 0 ? QVariant() : QVariant(symbolName(mModelInstance, false, rank.Column));
+    case 3:
+        return rank.NonZeros;
+    case 4:
+        return DoubleFormatter::format(rank.Minimum, DoubleFormatter::g, 6, true);
+    case 5:
+        return DoubleFormatter::format(rank.Maximum, DoubleFormatter::g, 6, true);
+    default:
+        return DoubleFormatter::format(rank.ratio(), DoubleFormatter::g, 6, true);
+    }
+}
+
+QVariant ScalingRankModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
+        return mHeaderData.at(section);
+    }
+    return QVariant();
+}
+
+int ScalingRankModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mHeaderData.size();
+}
+
+int ScalingRankModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mRanks.size();
+}
+
+HistogramViewFrame::HistogramViewFrame(QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::defaultConfiguration());
+    setupUi();
+}
+
+HistogramViewFrame::HistogramViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                       const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                                       QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mModelInstance = modelInstance;
+    mViewConfig = viewConfig;
+    setupUi();
+}
+
+AbstractViewFrame *HistogramViewFrame::clone(int viewId)
+{
+    auto viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
+                                                                                                         mModelInstance));
+    viewConfig->setViewId(viewId);
+    auto frame = new HistogramViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    frame->mRankScopeBox->setCurrentIndex(mRankScopeBox->currentIndex());
+    frame->mRankCountBox->setValue(mRankCountBox->value());
+    frame->setHistogram(mHistogram);
+    // ModelInspector sets the clone up again once the histogram is loaded
+    frame->setLoading(isLoading());
+    return frame;
+}
+
+void HistogramViewFrame::setShowAbsoluteValues(bool absoluteValues)
+{// the histogram is always of |a|
+    Q_UNUSED(absoluteValues);
+}
+
+void HistogramViewFrame::zoomIn()
+{
+    for (auto view : { mBlockView, mRankView }) {
+        QFont font = view->font();
+        font.setPointSize(font.pointSize() + ViewHelper::ZoomFactor);
+        view->setFont(font);
+    }
+}
+
+void HistogramViewFrame::zoomOut()
+{
+    for (auto view : { mBlockView, mRankView }) {
+        QFont font = view->font();
+        if (font.pointSize() <= ViewHelper::ZoomFactor)
+            continue;
+        font.setPointSize(font.pointSize() - ViewHelper::ZoomFactor);
+        view->setFont(font);
+    }
+}
+
+void HistogramViewFrame::resetZoom()
+{
+    mBlockView->setFont(font());
+    mRankView->setFont(font());
+}
+
+SearchResult &HistogramViewFrame::search(const QString &term, bool isRegEx)
+{
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = isRegEx;
+    mViewConfig->searchResult().Entries.clear();
+    return mViewConfig->searchResult();
+}
+
+void HistogramViewFrame::setSearchSelection(const SearchResult::SearchEntry &result)
+{
+    Q_UNUSED(result);
+}
+
+void HistogramViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &modelInstance)
+{
+    mModelInstance = modelInstance;
+    auto histogram = mModelInstance->logHistogram();
+    setLoading(!histogram && mModelInstance->equationCount());
+    setHistogram(histogram);
+    if (isLoading())
+        emit histogramRequested();
+}
+
+bool HistogramViewFrame::hasData() const
+{
+    return mHistogram && mHistogram->nonZeros();
+}
+
+void HistogramViewFrame::currentRowChanged(const QModelIndex &current)
+{
+    if (!mHistogram)
+        return;
+    int row = current.isValid() ? mProxyModel->mapToSource(current).row() : 0;
+    mPlot->setCounts(mBlockModel->counts(row), mBlockModel->title(row));
+}
+
+void HistogramViewFrame::updateRanks()
+{
+    if (!mHistogram) {
+        mRankModel->setRanks(mModelInstance, QVector<LogHistogram::Rank>());
+        return;
+    }
+    auto scope = static_cast<LogHistogram::RankScope>(mRankScopeBox->currentIndex());
+    mRankModel->setRanks(mModelInstance, mHistogram->worstScaled(scope, mRankCountBox->value()));
+    mRankView->resizeColumnsToContents();
+}
+
+void HistogramViewFrame::showRankSymbols(const QModelIndex &index)
+{
+    if (!index.isValid() || !mHistogram)
+        return;
+    const auto& rank = mRankModel->rank(index.row());
+    mSelectedEquations.clear();
+    mSelectedVariables.clear();
+    if (rank.Row >= 0)
+        mSelectedEquations.append(mModelInstance->equations().at(rank.Row));
+    if (rank.Column >= 0)
+        mSelectedVariables.append(mModelInstance->variables().at(rank.Column));
+    for (const auto& block : mHistogram->blocks()) {
+        if (rank.Column < 0 && block.Row == rank.Row)
+            mSelectedVariables.append(mModelInstance->variables().at(block.Column));
+        else if (rank.Row < 0 && block.Column == rank.Column)
+            mSelectedEquations.append(mModelInstance->equations().at(block.Row));
+    }
+    emit newSymbolViewRequested();
+}
+
+void HistogramViewFrame::setupUi()
+{
+    mInfoLabel = new QLabel(this);
+    mBlockModel = new HistogramBlockModel(this);
+    mProxyModel = new QSortFilterProxyModel(this);
+    mProxyModel->setSourceModel(mBlockModel);
+    mProxyModel->setSortRole(Qt::UserRole);
+    mBlockView = new QTableView(this);
+    mBlockView->setModel(mProxyModel);
+    mBlockView->setSortingEnabled(true);
+    mBlockView->sortByColumn(-1, Qt::AscendingOrder);
+    mBlockView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mBlockView->setSelectionMode(QAbstractItemView::SingleSelection);
+    mBlockView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mBlockView->verticalHeader()->setVisible(false);
+    mBlockView->horizontalHeader()->setStretchLastSection(true);
+    mPlot = new HistogramPlot(this);
+    auto splitter = new QSplitter(Qt::Vertical, this);
+    splitter->addWidget(mBlockView);
+    splitter->addWidget(mPlot);
+
+    mRankScopeBox = new QComboBox(this);
+    mRankScopeBox->addItems({ "Blocks", "Equations", "Variables" });
+    mRankCountBox = new QSpinBox(this);
+    mRankCountBox->setRange(1, 10000);
+    mRankCountBox->setValue(50);
+    mRankModel = new ScalingRankModel(this);
+    mRankView = new QTableView(this);
+    mRankView->setModel(mRankModel);
+    mRankView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mRankView->setSelectionMode(QAbstractItemView::SingleSelection);
+    mRankView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mRankView->verticalHeader()->setVisible(false);
+    mRankView->horizontalHeader()->setStretchLastSection(true);
+    mRankView->setToolTip("Double click an entry to open its symbol view.");
+    auto rankWidget = new QWidget(this);
+    auto rankOptions = new QHBoxLayout;
+    rankOptions->addWidget(new QLabel("Worst scaled", rankWidget));
+    rankOptions->addWidget(mRankCountBox);
+    rankOptions->addWidget(mRankScopeBox);
+    rankOptions->addStretch();
+    auto rankLayout = new QVBoxLayout(rankWidget);
+    rankLayout->setContentsMargins(0, 0, 0, 0);
+    rankLayout->addLayout(rankOptions);
+    rankLayout->addWidget(mRankView);
+
+    auto tabWidget = new QTabWidget(this);
+    tabWidget->addTab(splitter, "Distribution");
+    tabWidget->addTab(rankWidget, "Worst Scaled");
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(mInfoLabel);
+    layout->addWidget(tabWidget);
+    connect(mBlockView->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &HistogramViewFrame::currentRowChanged);
+    connect(mRankScopeBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &HistogramViewFrame::updateRanks);
+    connect(mRankCountBox, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &HistogramViewFrame::updateRanks);
+    connect(mRankView, &QTableView::doubleClicked,
+            this, &HistogramViewFrame::showRankSymbols);
+}
+
+void HistogramViewFrame::setHistogram(const QSharedPointer<LogHistogram> &histogram)
+{
+    mHistogram = histogram;
+    mBlockModel->setHistogram(mModelInstance, mHistogram);
+    updateRanks();
+    if (!mHistogram || !mHistogram->nonZeros()) {
+        mInfoLabel->clear();
+        mPlot->clear(isLoading() ? "Loading histogram..." : "No Jacobian data available.");
+        return;
+    }
+    mInfoLabel->setText(QString("%1 nonzeros in %2 blocks, log10 |a| per decade")
+                        .arg(mHistogram->nonZeros()).arg(mHistogram->blocks().size()));
+    mBlockView->resizeColumnsToContents();
+    currentRowChanged(QModelIndex());
+}
+
+}
+}
+}
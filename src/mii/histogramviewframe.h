@@ -0,0 +1,212 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef HISTOGRAMVIEWFRAME_H
+#define HISTOGRAMVIEWFRAME_H
+
+#include "abstractviewframe.h"
+#include "loghistogram.h"
+
+#include <QAbstractTableModel>
+
+class QComboBox;
+class QLabel;
+class QSortFilterProxyModel;
+class QSpinBox;
+class QTableView;
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Bar chart of one LogHistogram bucket array.
+///
+class HistogramPlot final : public QWidget
+{
+    Q_OBJECT
+
+public:
+    HistogramPlot(QWidget *parent = nullptr);
+
+    void setCounts(const LogHistogram::Buckets &counts, const QString &title);
+
+    void clear(const QString &placeholder);
+
+protected:
+    bool event(QEvent *event) override;
+
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    int bucketAt(const QPoint &pos) const;
+
+    QRect plotArea() const;
+
+private:
+    LogHistogram::Buckets mCounts {};
+    quint32 mMaxCount = 0;
+    QString mTitle;
+    QString mPlaceholder;
+};
+
+///
+/// \brief The whole model in the first row and all nonempty blocks of
+///        a LogHistogram in the following rows.
+///
+class HistogramBlockModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    HistogramBlockModel(QObject *parent = nullptr);
+
+    void setHistogram(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                      const QSharedPointer<LogHistogram> &histogram);
+
+    ///
+    /// \brief Bucket counts of <c>row</c>.
+    ///
+    const LogHistogram::Buckets& counts(int row) const;
+
+    QString title(int row) const;
+
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+private:
+    const QStringList mHeaderData { "Equation", "Variable", "Nonzeros",
+                                    "Smallest |a|", "Largest |a|", "Decades" };
+    QSharedPointer<AbstractModelInstance> mModelInstance;
+    QSharedPointer<LogHistogram> mHistogram;
+};
+
+///
+/// \brief The worst scaled blocks, equations or variables of a
+///        LogHistogram, see LogHistogram::worstScaled().
+///
+class ScalingRankModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    ScalingRankModel(QObject *parent = nullptr);
+
+    void setRanks(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                  const QVector<LogHistogram::Rank> &ranks);
+
+    const LogHistogram::Rank& rank(int row) const;
+
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+private:
+    const QStringList mHeaderData { "Rank", "Equation", "Variable", "Nonzeros",
+                                    "Smallest |a|", "Largest |a|", "Ratio" };
+    QSharedPointer<AbstractModelInstance> mModelInstance;
+    QVector<LogHistogram::Rank> mRanks;
+};
+
+class HistogramViewFrame final : public AbstractViewFrame
+{
+    Q_OBJECT
+
+public:
+    HistogramViewFrame(QWidget *parent = nullptr,
+                       Qt::WindowFlags f = Qt::WindowFlags());
+
+    HistogramViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                       const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                       QWidget *parent = nullptr,
+                       Qt::WindowFlags f = Qt::WindowFlags());
+
+    AbstractViewFrame* clone(int viewId) override;
+
+    void setShowAbsoluteValues(bool absoluteValues) override;
+
+    inline ViewHelper::ViewDataType type() const override
+    {
+        return ViewHelper::ViewDataType::Histogram;
+    }
+
+    void zoomIn() override;
+
+    void zoomOut() override;
+
+    void resetZoom() override;
+
+    SearchResult& search(const QString &term, bool isRegEx) override;
+
+    void setSearchSelection(const SearchResult::SearchEntry &result) override;
+
+    void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
+
+    bool hasData() const override;
+
+signals:
+    ///
+    /// \brief The histogram isn't collected yet, which is done by loading
+    ///        the predefined scaling view.
+    ///
+    void histogramRequested();
+
+private slots:
+    void currentRowChanged(const QModelIndex &current);
+
+    void updateRanks();
+
+    void showRankSymbols(const QModelIndex &index);
+
+private:
+    void setupUi();
+
+    void setHistogram(const QSharedPointer<LogHistogram> &histogram);
+
+private:
+    QLabel *mInfoLabel;
+    QTableView *mBlockView;
+    HistogramBlockModel *mBlockModel;
+    QSortFilterProxyModel *mProxyModel;
+    HistogramPlot *mPlot;
+    QComboBox *mRankScopeBox;
+    QSpinBox *mRankCountBox;
+    QTableView *mRankView;
+    ScalingRankModel *mRankModel;
+    QSharedPointer<LogHistogram> mHistogram;
+};
+
+}
+}
+}
+
+#endif // HISTOGRAMVIEWFRAME_H
@@ -0,0 +1,221 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "loghistogram.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Powers of ten from 10^(MinExponent-1) to 10^(MaxExponent+1).
+///
+static const std::array<double, LogHistogram::BucketCount+1> PowersOfTen = []{
+    std::array<double, LogHistogram::BucketCount+1> powers;
+    for (int i=0; i<int(powers.size()); ++i) {
+        auto text = "1e" + std::to_string(LogHistogram::MinExponent-1+i);
+        powers[i] = std::strtod(text.c_str(), nullptr);
+    }
+    return powers;
+}();
+
+///
+/// \brief Order of the rank heap, where the least badly scaled rank is on
+///        top. Ties are ordered by index to get a stable result.
+///
+static bool worseScaled(const LogHistogram::Rank &a, const LogHistogram::Rank &b)
+{
+    const double ratioA = a.ratio(), ratioB = b.ratio();
+    if (ratioA != ratioB)
+        return ratioA > ratioB;
+    return a.Row < b.Row || (a.Row == b.Row && a.Column < b.Column);
+}
+
+static void pushRank(QVector<LogHistogram::Rank> &heap, const LogHistogram::Rank &rank, int k)
+{
+    if (heap.size() < k) {
+        heap.append(rank);
+        std::push_heap(heap.begin(), heap.end(), worseScaled);
+    } else if (worseScaled(rank, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), worseScaled);
+        heap.back() = rank;
+        std::push_heap(heap.begin(), heap.end(), worseScaled);
+    }
+}
+
+LogHistogram::LogHistogram(int rows, int columns, bool useOutput)
+    : mUseOutput(useOutput)
+    , mRowCount(rows)
+    , mColumnCount(columns)
+    , mScratch(columns * BucketCount, 0)
+    , mRowCounts(columns, 0)
+    , mMinimum(columns, 0.0)
+    , mMaximum(columns, 0.0)
+{
+
+}
+
+bool LogHistogram::usesOutput() const
+{
+    return mUseOutput;
+}
+
+int LogHistogram::rowCount() const
+{
+    return mRowCount;
+}
+
+int LogHistogram::columnCount() const
+{
+    return mColumnCount;
+}
+
+int LogHistogram::bucket(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const int exponent = int((bits >> 52) & 0x7ff) - 1023;
+    // floor(exponent * log10(2)), which is the decade or one below it
+    int decade = (exponent * 1233) >> 12;
+    decade = std::clamp(decade, MinExponent-1, MaxExponent);
+    decade += std::abs(value) >= PowersOfTen[decade-MinExponent+2];
+    return std::clamp(decade-MinExponent+1, 0, BucketCount-1);
+}
+
+QString LogHistogram::bucketText(int bucket)
+{
+    if (bucket <= 0)
+        return QString("< 1e%1").arg(MinExponent);
+    if (bucket >= BucketCount-1)
+        return QString(">= 1e%1").arg(MaxExponent);
+    const int decade = MinExponent + bucket - 1;
+    return QString("1e%1 .. 1e%2").arg(decade).arg(decade+1);
+}
+
+void LogHistogram::finishRow(int row)
+{
+    std::sort(mTouched.begin(), mTouched.end());
+    for (int column : std::as_const(mTouched)) {
+        Block block;
+        block.Row = row;
+        block.Column = column;
+        block.Minimum = mMinimum[column];
+        block.Maximum = mMaximum[column];
+        auto counts = mScratch.data() + column * BucketCount;
+        for (int b=0; b<BucketCount; ++b) {
+            block.Counts[b] = counts[b];
+            mTotal[b] += counts[b];
+        }
+        std::fill(counts, counts+BucketCount, 0);
+        mRowCounts[column] = 0;
+        mBlocks.append(block);
+    }
+    mTouched.clear();
+}
+
+void LogHistogram::finish()
+{
+    std::sort(mBlocks.begin(), mBlocks.end(), [](const Block &a, const Block &b) {
+        return a.Row < b.Row || (a.Row == b.Row && a.Column < b.Column);
+    });
+}
+
+const QVector<LogHistogram::Block> &LogHistogram::blocks() const
+{
+    return mBlocks;
+}
+
+const LogHistogram::Block *LogHistogram::block(int row, int column) const
+{
+    auto iter = std::lower_bound(mBlocks.cbegin(), mBlocks.cend(), std::make_pair(row, column),
+                                 [](const Block &block, const std::pair<int, int> &key) {
+        return block.Row < key.first || (block.Row == key.first && block.Column < key.second);
+    });
+    if (iter == mBlocks.cend() || iter->Row != row || iter->Column != column)
+        return nullptr;
+    return &*iter;
+}
+
+const LogHistogram::Buckets &LogHistogram::total() const
+{
+    return mTotal;
+}
+
+qint64 LogHistogram::nonZeros() const
+{
+    return sum(mTotal);
+}
+
+qint64 LogHistogram::sum(const Buckets &counts)
+{
+    qint64 total = 0;
+    for (auto count : counts)
+        total += count;
+    return total;
+}
+
+QVector<LogHistogram::Rank> LogHistogram::worstScaled(RankScope scope, int k) const
+{
+    QVector<Rank> heap;
+    if (k <= 0)
+        return heap;
+    heap.reserve(k);
+    if (scope == BlockRanks) {
+        for (const auto& block : mBlocks) {
+            Rank rank;
+            rank.Row = block.Row;
+            rank.Column = block.Column;
+            rank.Minimum = block.Minimum;
+            rank.Maximum = block.Maximum;
+            rank.NonZeros = sum(block.Counts);
+            pushRank(heap, rank, k);
+        }
+    } else {
+        const bool rows = scope == RowRanks;
+        QVector<Rank> ranks(rows ? mRowCount : mColumnCount);
+        for (const auto& block : mBlocks) {
+            auto& rank = ranks[rows ? block.Row : block.Column];
+            if (rank.NonZeros) {
+                rank.Minimum = std::min(rank.Minimum, block.Minimum);
+                rank.Maximum = std::max(rank.Maximum, block.Maximum);
+            } else {
+                rank.Minimum = block.Minimum;
+                rank.Maximum = block.Maximum;
+            }
+            rank.NonZeros += sum(block.Counts);
+        }
+        for (int i=0; i<ranks.size(); ++i) {
+            if (!ranks[i].NonZeros)
+                continue;
+            (rows ? ranks[i].Row : ranks[i].Column) = i;
+            pushRank(heap, ranks[i], k);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), worseScaled);
+    return heap;
+}
+
+}
+}
+}
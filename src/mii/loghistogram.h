@@ -0,0 +1,208 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef LOGHISTOGRAM_H
+#define LOGHISTOGRAM_H
+
+#include <QString>
+#include <QVector>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Distribution of log10 |a| per equation x variable block and for
+///        the whole model.
+///
+/// Bucket 0 counts all |a| below 10^MinExponent and the last bucket all
+/// |a| of at least 10^(MaxExponent). Every other bucket is one decade.
+/// Zeros aren't counted.
+///
+class LogHistogram final
+{
+public:
+    static constexpr int MinExponent = -10;
+    static constexpr int MaxExponent = 10;
+    static constexpr int BucketCount = MaxExponent - MinExponent + 2;
+
+    typedef std::array<quint32, BucketCount> Buckets;
+
+    struct Block
+    {
+        ///
+        /// \brief Equation symbol index.
+        ///
+        int Row = 0;
+
+        ///
+        /// \brief Variable symbol index.
+        ///
+        int Column = 0;
+
+        ///
+        /// \brief Smallest |a| of the block.
+        ///
+        double Minimum = 0.0;
+
+        ///
+        /// \brief Largest |a| of the block.
+        ///
+        double Maximum = 0.0;
+
+        Buckets Counts {};
+    };
+
+    enum RankScope
+    {
+        BlockRanks,
+        RowRanks,
+        ColumnRanks
+    };
+
+    ///
+    /// \brief Magnitude range of a block, an equation symbol or a variable
+    ///        symbol.
+    ///
+    struct Rank
+    {
+        ///
+        /// \brief Equation symbol index, or -1 for column ranks.
+        ///
+        int Row = -1;
+
+        ///
+        /// \brief Variable symbol index, or -1 for row ranks.
+        ///
+        int Column = -1;
+
+        double Minimum = 0.0;
+        double Maximum = 0.0;
+        qint64 NonZeros = 0;
+
+        double ratio() const
+        {
+            return Maximum / Minimum;
+        }
+    };
+
+    ///
+    /// \param rows Number of equation symbols.
+    /// \param columns Number of variable symbols.
+    /// \param useOutput <c>true</c> if the output values are counted.
+    ///
+    LogHistogram(int rows, int columns, bool useOutput = false);
+
+    ///
+    /// \brief <c>true</c> if the histogram counts the output values.
+    ///
+    bool usesOutput() const;
+
+    int rowCount() const;
+
+    int columnCount() const;
+
+    ///
+    /// \brief Bucket of a nonzero finite value.
+    /// \remark The decade is taken from the IEEE exponent, so there is no
+    ///         call to log10.
+    ///
+    static int bucket(double value);
+
+    ///
+    /// \brief Text of the value range of <c>bucket</c>, e.g. "1e-3 .. 1e-2".
+    ///
+    static QString bucketText(int bucket);
+
+    ///
+    /// \brief Count <c>value</c> in <c>column</c> of the current row.
+    ///
+    inline void add(int column, double value)
+    {
+        if (value == 0.0 || !std::isfinite(value))
+            return;
+        const double magnitude = std::abs(value);
+        if (!mRowCounts[column]) {
+            mTouched.append(column);
+            mMinimum[column] = magnitude;
+            mMaximum[column] = magnitude;
+        } else {
+            mMinimum[column] = std::min(mMinimum[column], magnitude);
+            mMaximum[column] = std::max(mMaximum[column], magnitude);
+        }
+        ++mRowCounts[column];
+        ++mScratch[column * BucketCount + bucket(value)];
+    }
+
+    ///
+    /// \brief Store the counts collected by add() as blocks of <c>row</c>.
+    ///
+    void finishRow(int row);
+
+    ///
+    /// \brief Order the blocks by row and column after the last
+    ///        finishRow(), which block() relies on.
+    ///
+    void finish();
+
+    const QVector<Block>& blocks() const;
+
+    ///
+    /// \brief Block of <c>row</c> and <c>column</c>, or <c>nullptr</c> if
+    ///        it is empty.
+    ///
+    const Block* block(int row, int column) const;
+
+    const Buckets& total() const;
+
+    qint64 nonZeros() const;
+
+    static qint64 sum(const Buckets &counts);
+
+    ///
+    /// \brief The <c>k</c> blocks, rows or columns with the largest
+    ///        max/min |a| ratio, worst first.
+    /// \remark Rows and columns are aggregated from the blocks, which are
+    ///         then ranked in one pass with a bounded heap of size
+    ///         <c>k</c>.
+    ///
+    QVector<Rank> worstScaled(RankScope scope, int k) const;
+
+private:
+    bool mUseOutput;
+    int mRowCount;
+    int mColumnCount;
+    QVector<quint32> mScratch;
+    QVector<quint32> mRowCounts;
+    QVector<double> mMinimum;
+    QVector<double> mMaximum;
+    QVector<int> mTouched;
+    QVector<Block> mBlocks;
+    Buckets mTotal {};
+};
+
+}
+}
+}
+
+#endif // LOGHISTOGRAM_H
@@ -19,11 +19,13 @@
  */
 #include "modelinspector.h"
 #include "ui_modelinspector.h"
+#include "datahandler.h"
 #include "modelinstance.h"
 #include "sectiontreemodel.h"
 #include "sectiontreeitem.h"
 #include "viewconfigurationprovider.h"
 #include "symbolviewframe.h"
+#include "viewloadscheduler.h"
 
 #include <QtConcurrent>
 #include <QDir>
@@ -39,12 +41,20 @@ ModelInspector::ModelInspector(QWidget *parent)
     , ui(new Ui::ModelInspector)
     , mSectionModel(new SectionTreeModel(this))
     , mModelInstance(new EmptyModelInstance)
+    , mLoadScheduler(new ViewLoadScheduler(this))
+    , mMemoryBudget(DataHandler::DefaultMemoryBudget)
 {
     ui->setupUi(this);
     ui->bpScalingFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::BP_Scaling);
     ui->bpOverviewFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::BP_Overview);
     ui->bpCountFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::BP_Count);
     ui->bpAverageFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::BP_Average);
+    ui->bpSparsityFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::BP_Sparsity);
+    ui->scalingAdvisorFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::ScalingAdvisor);
+    ui->histogramFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::Histogram);
+    ui->diagnosticsFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::Diagnostics);
+    ui->componentsFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::Components);
+    ui->residualsFrame->viewConfig()->setViewId((int)ViewHelper::ViewDataType::Residuals);
     mSectionModel->loadModelData(ui->stackedWidget, ViewHelper::MiiModeType::None);
     ui->sectionView->setModel(mSectionModel);
     loadModelInstance(false);
@@ -55,6 +65,9 @@ ModelInspector::ModelInspector(QWidget *parent)
 
 ModelInspector::~ModelInspector()
 {
+    // the background tasks post their results to this object
+    mFutureData.waitForFinished();
+    mFutureEvaluation.waitForFinished();
     delete ui;
 }
 
@@ -108,6 +121,17 @@ void ModelInspector::setShowOutput(bool showOutput)
     mModelInstance->setUseOutput(showOutput);
 }
 
+qint64 ModelInspector::memoryBudget() const
+{
+    return mMemoryBudget;
+}
+
+void ModelInspector::setMemoryBudget(qint64 budget)
+{
+    mMemoryBudget = budget;
+    mModelInstance->setMemoryBudget(budget);
+}
+
 ViewHelper::MiiModeType ModelInspector::miiMode() const
 {
     return mMiiMode;
@@ -141,6 +165,18 @@ SearchResult& ModelInspector::searchHeaders(const QString &term, bool isRegEx)
     return frame ? frame->search(term, isRegEx) : mDefaultSearchResult;
 }
 
+RegExSearch* ModelInspector::createRegExSearch(const QString &term, QObject *parent)
+{
+    auto frame = currentView();
+    return frame ? frame->createRegExSearch(term, parent) : nullptr;
+}
+
+CoefficientRangeSearch* ModelInspector::createCoefficientSearch(const QString &term, QObject *parent)
+{
+    auto frame = currentView();
+    return frame ? frame->createCoefficientSearch(term, parent) : nullptr;
+}
+
 SearchResult& ModelInspector::searchResult()
 {
     auto frame = currentView();
@@ -183,22 +219,52 @@ void ModelInspector::reloadModelInstance()
     ui->bpOverviewFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
     ui->bpCountFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
     ui->bpAverageFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
-    auto loadData = [this]{
-        mModelInstance->loadViewData(ui->bpScalingFrame->viewConfig());
-        auto customGroup = mSectionModel->rootItem()->customGroup();
-        if (!customGroup)
-            return;
-        for (auto view : customGroup->widgets()) {
-            if (view->type() == ViewHelper::ViewDataType::Postopt)
-                continue;
-            mModelInstance->loadViewData(view->viewConfig());
-        }
-        if (mModelInstance->state() == AbstractModelInstance::Error)
-            emit newLogMessage(mModelInstance->logMessages());
-        emit dataLoaded();
-        emit filtersChanged();
+    ui->bpSparsityFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->scalingAdvisorFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->histogramFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->diagnosticsFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->componentsFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->residualsFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    mLoadScheduler->cancelAll();
+    mReloading = true;
+    mLoadScheduler->load(mModelInstance, ui->bpScalingFrame->viewConfig());
+    auto customGroup = mSectionModel->rootItem()->customGroup();
+    if (!customGroup)
+        return;
+    for (auto view : customGroup->widgets()) {
+        if (view->type() == ViewHelper::ViewDataType::Postopt)
+            continue;
+        loadViewData(view, view->viewConfig());
+    }
+}
+
+void ModelInspector::setEvaluationPoint(EvaluationPointRegistry::Type type,
+                                        const QVector<double> &point)
+{
+    if (mInstancePending || mEvaluationPending)
+        return;
+    mEvaluationPending = true;
+    mEvaluationType = type;
+    mEvaluationPoint = point;
+    mEvaluationQueued = true;
+    mLoadScheduler->cancelAll();
+    // the running loads still read the instance, see viewLoadsFinished()
+    if (!mLoadScheduler->pendingCount())
+        startEvaluation();
+}
+
+void ModelInspector::startEvaluation()
+{
+    mEvaluationQueued = false;
+    auto evaluate = [this, instance = mModelInstance, type = mEvaluationType,
+                     point = mEvaluationPoint]{
+        bool evaluated = instance->setEvaluationPoint(type, point);
+        auto message = instance->logMessages();
+        QMetaObject::invokeMethod(this, [this, instance, evaluated, message]{
+            publishEvaluationPoint(instance, evaluated, message);
+        }, Qt::QueuedConnection);
     };
-    mFutureData = QtConcurrent::run(loadData);
+    mFutureEvaluation = QtConcurrent::run(evaluate);
 }
 
 QSharedPointer<AbstractViewConfiguration> ModelInspector::viewConfig()
@@ -213,10 +279,15 @@ QSharedPointer<AbstractViewConfiguration> ModelInspector::viewConfig()
 
 void ModelInspector::cancelRun()
 {
-    if (mFutureData.isRunning()) {
-        mFutureData.cancel();
-        mFutureData.waitForFinished();
+    // the cancelled tasks finish in the background and post their results
+    if (mInstancePending)
+        mLoadToken.cancel();
+    if (mEvaluationQueued) {
+        mEvaluationQueued = false;
+        mEvaluationPending = false;
     }
+    mLoadScheduler->cancelAll();
+    mFutureData.cancel();
 }
 
 void ModelInspector::zoomIn()
@@ -261,6 +332,8 @@ void ModelInspector::saveModelView()
     auto index = ui->sectionView->currentIndex();
     auto text = index.data().toString();
     auto clone = view->clone(ViewConfigurationProvider::nextViewId());
+    connect(clone, &AbstractViewFrame::viewDataRequested,
+            this, [this, clone]{ viewDataRequested(clone); });
     ui->stackedWidget->addWidget(clone);
     ViewHelper::ViewDataType dataType = ViewHelper::ViewDataType::Unknown;
     switch (clone->type()) {
@@ -274,6 +347,9 @@ void ModelInspector::saveModelView()
         connect(static_cast<AbstractBPViewFrame*>(clone), &AbstractBPViewFrame::newSymbolViewRequested,
                 this, &ModelInspector::createNewSymbolView);
         break;
+    case ViewHelper::ViewDataType::BP_Sparsity:
+        dataType = ViewHelper::ViewDataType::BlockpicGroup;
+        break;
     case ViewHelper::ViewDataType::Postopt:
         dataType = ViewHelper::ViewDataType::PostoptGroup;
         connect(static_cast<PostoptTreeViewFrame*>(clone), &PostoptTreeViewFrame::openFilterDialog,
@@ -282,6 +358,23 @@ void ModelInspector::saveModelView()
     case ViewHelper::ViewDataType::Symbols:
         dataType = ViewHelper::ViewDataType::SymbolsGroup;
         break;
+    case ViewHelper::ViewDataType::ScalingAdvisor:
+    case ViewHelper::ViewDataType::Residuals:
+        dataType = ViewHelper::ViewDataType::AnalysisGroup;
+        break;
+    case ViewHelper::ViewDataType::Histogram:
+        dataType = ViewHelper::ViewDataType::AnalysisGroup;
+        connect(clone, &AbstractViewFrame::newSymbolViewRequested,
+                this, &ModelInspector::createNewSymbolView);
+        connect(static_cast<HistogramViewFrame*>(clone), &HistogramViewFrame::histogramRequested,
+                this, &ModelInspector::loadHistogram);
+        break;
+    case ViewHelper::ViewDataType::Diagnostics:
+    case ViewHelper::ViewDataType::Components:
+        dataType = ViewHelper::ViewDataType::AnalysisGroup;
+        connect(clone, &AbstractViewFrame::newSymbolViewRequested,
+                this, &ModelInspector::createNewSymbolView);
+        break;
     default:
         dataType = clone->type();
         break;
@@ -299,37 +392,39 @@ void ModelInspector::saveModelView()
 
 void ModelInspector::createNewSymbolView()
 {
-    auto currentBPView = static_cast<BPScalingViewFrame*>(currentView());
-    if (!currentBPView) {
+    auto currentFrame = currentView();
+    if (!currentFrame) {
         emit newLogMessage("ERROR: ModelInspector::createNewSymbolView() widget nullptr!");
         return;
     }
     auto view = new SymbolViewFrame(ViewConfigurationProvider::nextViewId(),
                                     mModelInstance,
                                     ui->stackedWidget,
-                                    currentBPView->windowFlags());
+                                    currentFrame->windowFlags());
     view->viewConfig()->currentValueFilter().UseAbsoluteValues =
-            currentBPView->viewConfig()->currentValueFilter().UseAbsoluteValues;
+            currentFrame->viewConfig()->currentValueFilter().UseAbsoluteValues;
     view->viewConfig()->currentValueFilter().UseAbsoluteValuesGlobal =
-            currentBPView->viewConfig()->currentValueFilter().UseAbsoluteValuesGlobal;
-    view->viewConfig()->updateIdentifierFilter(currentBPView->selectedEquations(),
-                                               currentBPView->selectedVariables());
+            currentFrame->viewConfig()->currentValueFilter().UseAbsoluteValuesGlobal;
+    view->viewConfig()->updateIdentifierFilter(currentFrame->selectedEquations(),
+                                               currentFrame->selectedVariables());
+    connect(view, &AbstractViewFrame::viewDataRequested,
+            this, [this, view]{ viewDataRequested(view); });
     view->setupView(mModelInstance);
     auto page = ui->stackedWidget->addWidget(view);
     QString pageName = ViewHelper::SymbolView;
-    if (currentBPView->selectedEquations().size() == 1 && currentBPView->selectedVariables().size() == 1) {
-        pageName = currentBPView->selectedEquations().constFirst()->name() + " + " +
-                   currentBPView->selectedVariables().constFirst()->name();
-    } else if (currentBPView->selectedEquations().size() > 1 && currentBPView->selectedVariables().size() > 1) {
-        pageName = currentBPView->selectedEquations().constFirst()->name() + ".."  +
-                   currentBPView->selectedEquations().constLast()->name() + " + " +
-                   currentBPView->selectedVariables().constFirst()->name() + ".."  +
-                   currentBPView->selectedVariables().constLast()->name();
-    }
-    view->viewConfig()->setEquationLabels(currentBPView->selectedEquations());
-    view->viewConfig()->setVariableLabels(currentBPView->selectedVariables());
-    view->viewConfig()->setSelectedEquations(currentBPView->selectedEquations());
-    view->viewConfig()->setSelectedVariables(currentBPView->selectedVariables());
+    if (currentFrame->selectedEquations().size() == 1 && currentFrame->selectedVariables().size() == 1) {
+        pageName = currentFrame->selectedEquations().constFirst()->name() + " + " +
+                   currentFrame->selectedVariables().constFirst()->name();
+    } else if (currentFrame->selectedEquations().size() > 1 && currentFrame->selectedVariables().size() > 1) {
+        pageName = currentFrame->selectedEquations().constFirst()->name() + ".."  +
+                   currentFrame->selectedEquations().constLast()->name() + " + " +
+                   currentFrame->selectedVariables().constFirst()->name() + ".."  +
+                   currentFrame->selectedVariables().constLast()->name();
+    }
+    view->viewConfig()->setEquationLabels(currentFrame->selectedEquations());
+    view->viewConfig()->setVariableLabels(currentFrame->selectedVariables());
+    view->viewConfig()->setSelectedEquations(currentFrame->selectedEquations());
+    view->viewConfig()->setSelectedVariables(currentFrame->selectedVariables());
     ui->stackedWidget->setCurrentIndex(page);
     auto index = ui->sectionView->currentIndex();
     auto item = static_cast<AbstractSectionTreeItem*>(index.internalPointer());
@@ -359,6 +454,7 @@ void ModelInspector::removeModelView()
     auto predefinedViewIndex = predefinedIndex(item->modelInstanceGroup());
     for (auto widget : mSectionModel->removeItem(item)) {
         ui->stackedWidget->removeWidget(widget);
+        mLoadScheduler->cancel(widget->viewConfig()->viewId());
         mModelInstance->removeViewData(widget->viewConfig()->viewId());
         delete widget;
     }
@@ -385,8 +481,15 @@ void ModelInspector::setCurrentView()
     }
     int index = currentViewIndex(view);
     ui->stackedWidget->setCurrentIndex(index);
-    if (!view->hasData() && mFutureData.isFinished()) {
-        view->setupView(mModelInstance);
+    if (!mInstancePending && !mEvaluationPending &&
+        !mLoadScheduler->isLoading(view->viewConfig()->viewId())) {
+        auto evicted = mModelInstance->activateViewData(view->viewConfig()->viewId());
+        if (evicted) {
+            // viewDataLoaded() sets the view up again
+            loadViewData(view, evicted);
+        } else if (!view->hasData()) {
+            view->setupView(mModelInstance);
+        }
     }
     emit viewChanged((int)view->type());
 }
@@ -444,41 +547,127 @@ void ModelInspector::setupConnections()
             this, &ModelInspector::createNewSymbolView);
     connect(ui->bpScalingFrame, &AbstractBPViewFrame::newSymbolViewRequested,
             this, &ModelInspector::createNewSymbolView);
+    connect(ui->histogramFrame, &AbstractViewFrame::newSymbolViewRequested,
+            this, &ModelInspector::createNewSymbolView);
+    connect(ui->histogramFrame, &HistogramViewFrame::histogramRequested,
+            this, &ModelInspector::loadHistogram);
+    connect(ui->diagnosticsFrame, &AbstractViewFrame::newSymbolViewRequested,
+            this, &ModelInspector::createNewSymbolView);
+    connect(ui->componentsFrame, &AbstractViewFrame::newSymbolViewRequested,
+            this, &ModelInspector::createNewSymbolView);
     connect(this, &ModelInspector::dataLoaded,
             this, &ModelInspector::selectScalingView);
+    connect(mLoadScheduler, &ViewLoadScheduler::viewLoaded,
+            this, &ModelInspector::viewDataLoaded);
+    connect(mLoadScheduler, &ViewLoadScheduler::viewCancelled,
+            this, &ModelInspector::viewDataCancelled);
+    connect(mLoadScheduler, &ViewLoadScheduler::progressChanged,
+            this, &ModelInspector::loadProgress);
+    connect(mLoadScheduler, &ViewLoadScheduler::finished,
+            this, &ModelInspector::viewLoadsFinished);
     connect(ui->postoptFrame, &PostoptTreeViewFrame::openFilterDialog,
             this, &ModelInspector::openFilterDialog);
+    const QList<AbstractViewFrame*> loadedViews { ui->bpScalingFrame, ui->bpOverviewFrame,
+                                                  ui->bpCountFrame, ui->bpAverageFrame,
+                                                  ui->postoptFrame };
+    for (auto view : loadedViews) {
+        connect(view, &AbstractViewFrame::viewDataRequested,
+                this, [this, view]{ viewDataRequested(view); });
+    }
 }
 
 void ModelInspector::setupModelInstanceView(bool loadModel)
 {
-    auto loadData = [this, loadModel]{
-        bool useOutput = mModelInstance->useOutput();
-        bool globalAbs = mModelInstance->globalAbsolute();
-        if (loadModel) {
-            mModelInstance = QSharedPointer<AbstractModelInstance>(new ModelInstance(useOutput,
-                                                                                     mWorkspace,
-                                                                                     mSystemDir,
-                                                                                     mScratchDir));
-            mModelInstance->setGlobalAbsolute(globalAbs);
+    // a previous load still running is superseded by this one
+    mLoadToken.cancel();
+    mLoadToken = CancellationToken();
+    const int generation = ++mLoadGeneration;
+    mInstancePending = true;
+    bool useOutput = mModelInstance->useOutput();
+    bool globalAbs = mModelInstance->globalAbsolute();
+    auto current = loadModel ? QSharedPointer<AbstractModelInstance>() : mModelInstance;
+    // the new instance is only visible to the GUI thread once it is fully loaded
+    auto loadData = [this, current, useOutput, globalAbs, generation,
+                     workspace = mWorkspace, systemDir = mSystemDir,
+                     scratchDir = mScratchDir, token = mLoadToken]{
+        auto instance = current;
+        if (!instance) {
+            instance = QSharedPointer<AbstractModelInstance>(new ModelInstance(useOutput,
+                                                                               workspace,
+                                                                               systemDir,
+                                                                               scratchDir,
+                                                                               token));
+            instance->setGlobalAbsolute(globalAbs);
+        } else {
+            instance->setCancellationToken(token);
+        }
+        if (instance->state() == AbstractModelInstance::Error) {
+            instance = QSharedPointer<AbstractModelInstance>(new EmptyModelInstance);
+            instance->setUseOutput(useOutput);
         }
-        if (mModelInstance->state() == AbstractModelInstance::Error) {
-            mModelInstance = QSharedPointer<AbstractModelInstance>(new EmptyModelInstance);
-            mModelInstance->setUseOutput(useOutput);
+        if (!token.isCancelled())
+            instance->loadBaseData();
+        QString message;
+        if (token.isCancelled()) {
+            instance = QSharedPointer<AbstractModelInstance>(new EmptyModelInstance);
+            instance->setUseOutput(useOutput);
+            message = "Loading of the model instance cancelled.";
+        } else if (instance->state() == AbstractModelInstance::Error) {
+            message = instance->logMessages();
         }
-        mModelInstance->loadBaseData();
-        if (mModelInstance->state() == AbstractModelInstance::Error)
-            emit newLogMessage(mModelInstance->logMessages());
-        emit dataLoaded();
+        QMetaObject::invokeMethod(this, [this, instance, message, generation]{
+            publishModelInstance(instance, message, generation);
+        }, Qt::QueuedConnection);
     };
     mFutureData = QtConcurrent::run(loadData);
 }
 
+void ModelInspector::publishEvaluationPoint(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                            bool evaluated, const QString &message)
+{
+    mEvaluationPending = false;
+    if (!message.isEmpty())
+        emit newLogMessage(message);
+    else if (!evaluated)
+        emit newLogMessage("The NL coefficients could not be evaluated at the selected point.");
+    if (evaluated && modelInstance == mModelInstance) {
+        // the predefined scaling view is kept for the same absolute filter
+        mModelInstance->removeViewData((int)ViewHelper::ViewDataType::BP_Scaling);
+        reloadModelInstance();
+    }
+    // the requests made while the point was evaluated
+    const auto views = mDeferredViews;
+    mDeferredViews.clear();
+    for (const auto &view : views) {
+        if (view)
+            viewDataRequested(view);
+    }
+}
+
+void ModelInspector::publishModelInstance(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                          const QString &message, int generation)
+{
+    if (generation != mLoadGeneration)
+        return;
+    mModelInstance = modelInstance;
+    mModelInstance->setMemoryBudget(mMemoryBudget);
+    mInstancePending = false;
+    if (!message.isEmpty())
+        emit newLogMessage(message);
+    emit dataLoaded();
+}
+
 void ModelInspector::clearDefaultViewData()
 {
     ui->bpOverviewFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
     ui->bpCountFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
     ui->bpAverageFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->bpSparsityFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->scalingAdvisorFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->histogramFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->diagnosticsFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->componentsFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
+    ui->residualsFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
     ui->postoptFrame->setupView(QSharedPointer<AbstractModelInstance>(new EmptyModelInstance));
 }
 
@@ -512,6 +701,7 @@ void ModelInspector::switchModelInstance()
             continue;
         auto wgts = mSectionModel->removeCustomRows(sibling->customGroup());
         for (auto wgt : wgts) {
+            mLoadScheduler->cancel(wgt->viewConfig()->viewId());
             ui->stackedWidget->removeWidget(wgt);
             wgt->setParent(nullptr);
             delete wgt;
@@ -525,6 +715,100 @@ void ModelInspector::switchModelInstance()
     loadModelInstance(inst->scratchDir());
 }
 
+void ModelInspector::viewDataLoaded(int viewId)
+{
+    if (viewId == (int)ViewHelper::ViewDataType::BP_Scaling)
+        updateHistogramViews(true);
+    const auto views = mRequestedViews.values(viewId);
+    mRequestedViews.remove(viewId);
+    for (const auto &view : views) {
+        if (view)
+            view->viewDataLoaded();
+    }
+}
+
+void ModelInspector::viewDataCancelled(int viewId)
+{
+    if (viewId == (int)ViewHelper::ViewDataType::BP_Scaling)
+        updateHistogramViews(false);
+    // the views wait for the load which replaced the cancelled one
+    if (mLoadScheduler->isLoading(viewId))
+        return;
+    const auto views = mRequestedViews.values(viewId);
+    mRequestedViews.remove(viewId);
+    for (const auto &view : views) {
+        if (view)
+            view->setLoading(false);
+    }
+}
+
+void ModelInspector::viewLoadsFinished()
+{
+    if (mEvaluationQueued) {
+        startEvaluation();
+        return;
+    }
+    if (!mReloading)
+        return;
+    mReloading = false;
+    if (mModelInstance->state() == AbstractModelInstance::Error)
+        emit newLogMessage(mModelInstance->logMessages());
+    emit dataLoaded();
+    emit filtersChanged();
+}
+
+void ModelInspector::loadHistogram()
+{
+    if (mInstancePending || mEvaluationPending)
+        return;
+    auto viewConfig = ui->bpScalingFrame->viewConfig();
+    if (!mLoadScheduler->isLoading(viewConfig->viewId()))
+        mLoadScheduler->load(mModelInstance, viewConfig);
+}
+
+void ModelInspector::updateHistogramViews(bool loaded)
+{
+    QList<AbstractViewFrame*> views { ui->histogramFrame };
+    auto customGroup = mSectionModel->rootItem()->customGroup();
+    if (customGroup) {
+        for (auto view : customGroup->widgets()) {
+            if (view->type() == ViewHelper::ViewDataType::Histogram)
+                views << view;
+        }
+    }
+    for (auto view : views) {
+        if (!view->isLoading())
+            continue;
+        view->setLoading(false);
+        if (loaded)
+            view->setupView(mModelInstance);
+    }
+}
+
+void ModelInspector::viewDataRequested(AbstractViewFrame *view)
+{
+    auto viewConfig = view->viewConfig();
+    if (viewConfig->modelInstance() != mModelInstance) {
+        // nothing to load for a placeholder instance
+        view->viewDataLoaded();
+        return;
+    }
+    if (mEvaluationPending && !mEvaluationQueued) {
+        mDeferredViews.append(view);
+        return;
+    }
+    loadViewData(view, viewConfig);
+}
+
+void ModelInspector::loadViewData(AbstractViewFrame *view,
+                                  const QSharedPointer<AbstractViewConfiguration> &viewConfig)
+{
+    view->setLoading(true);
+    if (!mRequestedViews.contains(viewConfig->viewId(), view))
+        mRequestedViews.insert(viewConfig->viewId(), view);
+    mLoadScheduler->load(mModelInstance, viewConfig);
+}
+
 AbstractViewFrame* ModelInspector::currentView() const
 {
     auto currentIndex = ui->sectionView->currentIndex();
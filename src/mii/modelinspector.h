@@ -21,10 +21,13 @@
 #define MODELINSPECTOR_H
 
 #include <QFuture>
+#include <QMultiMap>
+#include <QPointer>
 #include <QSharedPointer>
 #include <QWidget>
 
 #include "common.h"
+#include "evaluationpointregistry.h"
 
 namespace gams {
 namespace studio{
@@ -38,8 +41,11 @@ class AbstractViewFrame;
 class AbstractModelInstance;
 class AbstractSectionTreeItem;
 class AbstractViewConfiguration;
+class CoefficientRangeSearch;
+class RegExSearch;
 class SectionTreeModel;
 class SearchResultModel;
+class ViewLoadScheduler;
 
 class ModelInspector final : public QWidget
 {
@@ -67,6 +73,13 @@ public:
     bool showOutput() const;
     void setShowOutput(bool showOutpu);
 
+    ///
+    /// \brief Memory budget of the view data in bytes. Inactive custom
+    ///        views beyond it are evicted and reloaded when shown again.
+    ///
+    qint64 memoryBudget() const;
+    void setMemoryBudget(qint64 budget);
+
     ViewHelper::MiiModeType miiMode() const;
     void setMiiMode(ViewHelper::MiiModeType miiMode);
     
@@ -75,11 +88,33 @@ public:
     SearchResult& searchHeaders(const QString &term, bool isRegEx);
     SearchResult& searchResult();
 
+    ///
+    /// \brief Background regular expression search in the current view.
+    /// \return The search to be started by the caller, or <c>nullptr</c>
+    ///         if the view doesn't support it.
+    ///
+    RegExSearch* createRegExSearch(const QString &term, QObject *parent);
+
+    ///
+    /// \brief Background coefficient search in the current view.
+    /// \return The search to be started by the caller, or <c>nullptr</c>
+    ///         if the view doesn't support it.
+    ///
+    CoefficientRangeSearch* createCoefficientSearch(const QString &term, QObject *parent);
+
     ViewActionStates viewActionStates() const;
 
     void loadModelInstance(bool loadModel);
     void reloadModelInstance();
 
+    ///
+    /// \brief Evaluate the NL Jacobian entries at a point of <c>type</c> in
+    ///        the background and reload the views with it, see
+    ///        AbstractModelInstance::setEvaluationPoint().
+    ///
+    void setEvaluationPoint(EvaluationPointRegistry::Type type,
+                            const QVector<double> &point = QVector<double>());
+
     QSharedPointer<AbstractViewConfiguration> viewConfig();
 
     void cancelRun();
@@ -101,6 +136,11 @@ signals:
 
     void dataLoaded();
 
+    ///
+    /// \brief Progress of the background view loads.
+    ///
+    void loadProgress(int finished, int total);
+
 public slots:
     void saveModelView();
 
@@ -117,11 +157,44 @@ private slots:
 
     void switchModelInstance();
 
+    void viewDataLoaded(int viewId);
+
+    void viewDataCancelled(int viewId);
+
+    void viewLoadsFinished();
+
+    ///
+    /// \brief Load the predefined scaling view, which collects the
+    ///        histogram, unless it is already loading.
+    ///
+    void loadHistogram();
+
 private:
     void setupConnections();
 
     void setupModelInstanceView(bool loadModel);
 
+    ///
+    /// \brief Swap in the instance evaluated by setEvaluationPoint(),
+    ///        called on the GUI thread.
+    ///
+    void publishEvaluationPoint(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                bool evaluated, const QString &message);
+
+    ///
+    /// \brief Swap in the instance loaded by setupModelInstanceView(),
+    ///        called on the GUI thread. The result of a load superseded
+    ///        by a later <c>generation</c> is dropped.
+    ///
+    void publishModelInstance(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                              const QString &message, int generation);
+
+    ///
+    /// \brief Start the evaluation requested by setEvaluationPoint() once
+    ///        no view load reads the instance anymore.
+    ///
+    void startEvaluation();
+
     void clearDefaultViewData();
 
     void loadModelInstance(const QString &scrdir);
@@ -130,6 +203,21 @@ private:
 
     AbstractViewFrame* currentView() const;
 
+    ///
+    /// \brief Load the data requested by <c>view</c> through the scheduler,
+    ///        deferred while the evaluation point is evaluated.
+    ///
+    void viewDataRequested(AbstractViewFrame *view);
+
+    void loadViewData(AbstractViewFrame *view,
+                      const QSharedPointer<AbstractViewConfiguration> &viewConfig);
+
+    ///
+    /// \brief Set the histogram views up again after the predefined scaling
+    ///        view is <c>loaded</c> or cancelled.
+    ///
+    void updateHistogramViews(bool loaded);
+
     int currentViewIndex(AbstractViewFrame* view) const;
 
     QModelIndex customIndex(AbstractSectionTreeItem* instanceRoot);
@@ -149,6 +237,19 @@ private:
     SectionTreeModel* mSectionModel = nullptr;
     QSharedPointer<AbstractModelInstance> mModelInstance;
     QFuture<void> mFutureData;
+    QFuture<void> mFutureEvaluation;
+    CancellationToken mLoadToken;
+    int mLoadGeneration = 0;
+    bool mInstancePending = false;
+    bool mEvaluationPending = false;
+    bool mEvaluationQueued = false;
+    EvaluationPointRegistry::Type mEvaluationType = EvaluationPointRegistry::InputPoint;
+    QVector<double> mEvaluationPoint;
+    ViewLoadScheduler* mLoadScheduler = nullptr;
+    QMultiMap<int, QPointer<AbstractViewFrame>> mRequestedViews;
+    QList<QPointer<AbstractViewFrame>> mDeferredViews;
+    bool mReloading = false;
+    qint64 mMemoryBudget;
 };
 
 }
@@ -26,6 +26,9 @@
 #include <QAbstractItemModel>
 #include <QVector>
 
+#include <algorithm>
+#include <limits>
+
 #include <QDebug>
 
 namespace gams {
@@ -35,11 +38,13 @@ namespace mii {
 ModelInstance::ModelInstance(bool useOutput,
                              const QString &workspace,
                              const QString &systemDir,
-                             const QString &scratchDir)
+                             const QString &scratchDir,
+                             const CancellationToken &token)
     : AbstractModelInstance(workspace, systemDir, scratchDir)
     , mDataHandler(new DataHandler(*this))
 {
     setUseOutput(useOutput);
+    setCancellationToken(token);
     initialize();
     loadScratchData();
 }
@@ -207,7 +212,7 @@ double ModelInstance::modelMaximum() const
 
 void ModelInstance::loadScratchData()
 {
-    if (mState == Error)
+    if (mState == Error || isCancelled())
         return;
     mLogMessages << "Model Workspace: " + mWorkspace;
     QString ctrlFile = mScratchDir + "/" + FileHelper::GamsCntr;
@@ -220,13 +225,15 @@ void ModelInstance::loadScratchData()
 
     char msg[GMS_SSSIZE];
     gmoRegisterEnvironment(mGMO, mGEV, msg);
+    if (isCancelled())
+        return;
     if (gmoLoadDataLegacy(mGMO, msg)) {
         mLogMessages << "ERROR: Could not load model instance (input): " + QString(msg);
         mState = Error;
         return;
     }
 
-    if (mUseOutput) {
+    if (mUseOutput && !isCancelled()) {
         QString solFile = mScratchDir + "/" + FileHelper::GamsSolu;
         mLogMessages << "Solution File: " + solFile;
         gmoNameSolFileSet(mGMO, solFile.toStdString().c_str());
@@ -247,30 +254,23 @@ void ModelInstance::loadScratchData()
     mLogMessages << "Absolute Scratch Path: " + mScratchDir;
 }
 
-void ModelInstance::loadEvaluationPoint(double *evalPoint, int size)
+bool ModelInstance::loadEvaluationPoint(double *evalPoint, int size)
 {
-    int i = 0;
-    double value;
-    for (auto var : variables()) {
-        if (i >= size)
-            continue;
-        if (var->isScalar()) {
-            value = variableAttribute(AttributeHelper::LevelText, var->firstSection(), 0, false).toDouble();
-            evalPoint[i++] = value;
-        } else {
-            for (auto e=var->firstSection(); e<var->entries(); ++e) {
-                value = variableAttribute(AttributeHelper::LevelText, var->firstSection(), e, false).toDouble();
-                evalPoint[i++] = value;
-            }
-        }
+    // the levels in GMO column order, like the Jacobian columns
+    QVector<double> levels(gmoN(mGMO));
+    if (gmoGetVarL(mGMO, levels.data())) {
+        mLogMessages << "loadEvaluationPoint() -> Could not load the variable levels.";
+        return false;
     }
+    std::copy_n(levels.constData(), std::min(size, int(levels.size())), evalPoint);
+    return true;
 }
 
 void ModelInstance::loadSymbols()
 {
     int eqnIndex = 0, varIndex = 0;
     int sectionIndexEqn = 0, sectionIndexVar = 0;
-    for (int i=1; i<=symbolCount(); ++i) {
+    for (int i=1; !isCancelled() && i<=symbolCount(); ++i) {
         auto sym = loadSymbol(i);
         if (Symbol::Equation == sym->type()) {
             mMaxEquationDimension = std::max(mMaxEquationDimension, sym->dimension());
@@ -357,6 +357,8 @@ void ModelInstance::loadEquationDimensions(Symbol *symbol)
     int domains[GLOBAL_MAX_INDEX_DIM];
     symbol->dimLabels() = QVector<QSet<QString>>(symbol->dimension());
     for (int j=0; j<symbol->entries(); ++j) {
+        if (!(j % CancellationToken::CheckInterval) && isCancelled())
+            return;
         if (gmoGetiSolverQuiet(mGMO, symbol->offset() + j) < 0) {
             mLogMessages << "ERROR: calling gmoGetiSolverQuiet() in ModelInstance::loadDimensions()";
             continue;
@@ -385,6 +387,8 @@ void ModelInstance::loadVariableDimensions(Symbol *symbol)
     int domains[GLOBAL_MAX_INDEX_DIM];
     symbol->dimLabels() = QVector<QSet<QString>>(symbol->dimension());
     for (int j=0; j<symbol->entries(); ++j) {
+        if (!(j % CancellationToken::CheckInterval) && isCancelled())
+            return;
         if (gmoGetjSolverQuiet(mGMO, symbol->offset() + j) < 0) {
             mLogMessages << "ERROR: calling gmoGetjSolverQuiet() in ModelInstance::loadDimensions()";
             continue;
@@ -413,8 +417,19 @@ const QVector<Symbol*>& ModelInstance::symbols(Symbol::Type type) const
 void ModelInstance::loadBaseData()
 {
     loadSymbols();
+    if (isCancelled())
+        return;
     loadLabels();
+    if (isCancelled())
+        return;
+    buildSearchIndex();
     mDataHandler->loadJacobian();
+    // the output data of a new Jacobian is evaluated at the solution point
+    mEvaluationPoints.clear();
+    mEvaluationPointType = EvaluationPointRegistry::SolutionPoint;
+    auto matrix = mDataHandler->jacobian();
+    if (matrix && !matrix->isLinear() && !isCancelled())
+        setEvaluationPoint(EvaluationPointRegistry::SolutionPoint);
 }
 
 void ModelInstance::variableLowerBounds(double *bounds)
@@ -456,12 +471,12 @@ int ModelInstance::columnEntryCount(int column, int viewId) const
     return mDataHandler->columnEntryCount(column, viewId);
 }
 
-const QList<int> &ModelInstance::rowIndices(int viewId, int row) const
+QList<int> ModelInstance::rowIndices(int viewId, int row) const
 {
     return mDataHandler->rowIndices(viewId, row);
 }
 
-const QList<int> &ModelInstance::columnIndices(int viewId, int column) const
+QList<int> ModelInstance::columnIndices(int viewId, int column) const
 {
     return mDataHandler->columnIndices(viewId, column);
 }
@@ -481,9 +496,10 @@ QSharedPointer<AbstractViewConfiguration> ModelInstance::clone(int viewId, int n
     return mDataHandler->clone(viewId, newViewId);
 }
 
-void ModelInstance::loadViewData(const QSharedPointer<AbstractViewConfiguration>& viewConfig)
+void ModelInstance::loadViewData(const QSharedPointer<AbstractViewConfiguration>& viewConfig,
+                                 const CancellationToken &token)
 {
-    return mDataHandler->loadData(viewConfig);
+    return mDataHandler->loadData(viewConfig, token);
 }
 
 void ModelInstance::loadLabels()
@@ -491,6 +507,8 @@ void ModelInstance::loadLabels()
     char q;
     char label[GMS_SSSIZE];
     for (int i=1; i<=dctNUels(mDCT); ++i) {
+        if (!(i % CancellationToken::CheckInterval) && isCancelled())
+            return;
         dctUelLabel(mDCT, i, &q, label, GMS_SSSIZE);
         mLabels << label;
     }
@@ -518,6 +536,118 @@ int ModelInstance::nlFlag(int row, int column, int viewId)
     return mDataHandler->nlFlag(row, column, viewId);
 }
 
+DataTile ModelInstance::fetchTile(int viewId,
+                                  const SectionRange &rows,
+                                  const SectionRange &columns)
+{
+    return mDataHandler->fetchTile(viewId, rows, columns);
+}
+
+int ModelInstance::dataRevision() const
+{
+    return mDataHandler->revision();
+}
+
+QSharedPointer<SparsityPyramid> ModelInstance::sparsityPyramid()
+{
+    return mDataHandler->sparsityPyramid(mUseOutput);
+}
+
+QSharedPointer<LogHistogram> ModelInstance::logHistogram()
+{
+    return mDataHandler->logHistogram(mUseOutput);
+}
+
+QVector<CoefficientHit> ModelInstance::findCoefficients(const CoefficientSearch::Range &range,
+                                                        const QBitArray &rows,
+                                                        const QBitArray &columns,
+                                                        int maxHits, qint64 *total,
+                                                        const CancellationToken &token)
+{
+    return mDataHandler->findCoefficients(range, mUseOutput, rows, columns, maxHits, total, token);
+}
+
+QSharedPointer<ScalingAdvice> ModelInstance::scalingAdvice(ScalingAdvisor::Rounding rounding)
+{
+    QVector<double> equationScales(gmoM(mGMO));
+    for (int i=0; i<equationScales.size(); ++i)
+        equationScales[i] = gmoGetEquScaleOne(mGMO, i);
+    QVector<double> variableScales(gmoN(mGMO));
+    for (int i=0; i<variableScales.size(); ++i)
+        variableScales[i] = gmoGetVarScaleOne(mGMO, i);
+    ScalingAdvisor::Options options;
+    options.Round = rounding;
+    return mDataHandler->scalingAdvice(mUseOutput, equationScales, variableScales, options);
+}
+
+QVector<StructuralFinding> ModelInstance::structuralDiagnostics()
+{
+    QByteArray equationTypes(gmoM(mGMO), 'E');
+    for (int i=0; i<equationTypes.size(); ++i) {
+        if (gmoGetEquTypeOne(mGMO, i) == gmoequ_N)
+            equationTypes[i] = 'N';
+    }
+    QVector<double> lower(gmoN(mGMO));
+    QVector<double> upper(gmoN(mGMO));
+    variableLowerBounds(lower.data());
+    variableUpperBounds(upper.data());
+    return mDataHandler->structuralDiagnostics(mUseOutput, equationTypes, lower, upper);
+}
+
+QSharedPointer<ComponentPartition> ModelInstance::components(ComponentAnalysis::Level level)
+{
+    return mDataHandler->components(level);
+}
+
+QVector<ResidualSummary> ModelInstance::primalResiduals()
+{
+    QVector<double> levels(gmoN(mGMO));
+    QVector<double> rowLevels(gmoM(mGMO));
+    QVector<double> rhs(gmoM(mGMO));
+    if (gmoGetVarL(mGMO, levels.data()) || gmoGetEquL(mGMO, rowLevels.data()) ||
+            gmoGetRhs(mGMO, rhs.data())) {
+        mLogMessages << "primalResiduals() -> Could not load the solution levels.";
+        return QVector<ResidualSummary>();
+    }
+    QByteArray equationTypes(gmoM(mGMO), 'X');
+    for (int i=0; i<equationTypes.size(); ++i) {
+        switch (gmoGetEquTypeOne(mGMO, i)) {
+        case gmoequ_E:
+            equationTypes[i] = 'E';
+            break;
+        case gmoequ_G:
+            equationTypes[i] = 'G';
+            break;
+        case gmoequ_L:
+            equationTypes[i] = 'L';
+            break;
+        case gmoequ_N:
+            equationTypes[i] = 'N';
+            break;
+        }
+    }
+    return mDataHandler->primalResiduals(levels, rowLevels, rhs, equationTypes);
+}
+
+QVector<DualSummary> ModelInstance::dualResiduals()
+{
+    QVector<double> objective(gmoN(mGMO));
+    QVector<int> objectiveNlFlags(gmoN(mGMO));
+    QVector<double> rowMarginals(gmoM(mGMO));
+    QVector<double> marginals(gmoN(mGMO));
+    if (gmoGetObjVector(mGMO, objective.data(), objectiveNlFlags.data()) ||
+            gmoGetEquM(mGMO, rowMarginals.data()) || gmoGetVarM(mGMO, marginals.data())) {
+        mLogMessages << "dualResiduals() -> Could not load the marginals.";
+        return QVector<DualSummary>();
+    }
+    for (auto& value : rowMarginals)
+        value = specialValue(value);
+    for (auto& value : marginals)
+        value = specialValue(value);
+    return mDataHandler->dualResiduals(mUseOutput, objective, objectiveNlFlags,
+                                       rowMarginals, marginals);
+}
+
 QSharedPointer<PostoptTreeItem> ModelInstance::dataTree(int viewId) const
 {
     return mDataHandler->dataTree(viewId);
@@ -616,57 +746,126 @@ DataMatrix* ModelInstance::jacobianData()
     int nz = 0, nlnz = 0, unused1 = 0;
     auto matrix = new DataMatrix(equationRowCount(), variableRowCount(), gmoNLM(mGMO));
     loadEvaluationPoint(matrix->evalPoint(), matrix->columnCount());
-    if (matrix->isLinear()) {
-        for (int row=0; row<equationRowCount(); ++row) {
-            if (gmoGetRowStat(mGMO, row, &nz, &unused1, &nlnz))
-                continue;
-            auto* dataRow = matrix->row(row);
-            dataRow->setEntries(nz);
-            dataRow->setEntriesNl(nlnz);
-            dataRow->setColIdx(new int[nz]);
-            dataRow->setInputData(new double[nz]);
-            dataRow->setNlFlags(new int[nz]);
-            if (gmoGetRowSparse(mGMO, row, dataRow->colIdx(), dataRow->inputData(),
-                                dataRow->nlFlags(), &unused1, &nlnz)) {
-                continue;
-            }
+    // GMO writes one int per NL flag, which is packed into the row afterwards
+    QVector<int> nlFlags;
+    for (int row=0; row<equationRowCount(); ++row) {
+        if (!(row % CancellationToken::CheckInterval) && isCancelled())
+            break;
+        if (gmoGetRowStat(mGMO, row, &nz, &unused1, &nlnz))
+            continue;
+        auto* dataRow = matrix->row(row);
+        dataRow->setEntries(nz);
+        dataRow->setColIdx(new int[nz]);
+        dataRow->setInputData(new double[nz]);
+        nlFlags.resize(nz);
+        if (gmoGetRowSparse(mGMO, row, dataRow->colIdx(), dataRow->inputData(),
+                            nlFlags.data(), &unused1, &nlnz)) {
+            continue;
         }
-    } else {
-        double* scratch = new double[matrix->columnCount()];
-        for (int row=0; row<equationRowCount(); ++row) {
-            if (gmoGetRowStat(mGMO, row, &nz, &unused1, &nlnz))
-                continue;
-            auto* dataRow = matrix->row(row);
-            dataRow->setEntries(nz);
-            dataRow->setEntriesNl(nlnz);
-            dataRow->setColIdx(new int[nz]);
-            dataRow->setInputData(new double[nz]);
-            dataRow->setOutputData(new double[nz]);
-            dataRow->setNlFlags(new int[nz]);
-            if (gmoGetRowSparse(mGMO, row, dataRow->colIdx(), dataRow->inputData(),
-                                dataRow->nlFlags(), &unused1, &nlnz)) {
-                continue;
-            }
-            std::copy(dataRow->inputData(), dataRow->inputData()+dataRow->entries(), dataRow->outputData());
-            if (!dataRow->entriesNl()) {
-                continue;
-            }
-            int numerr = 0;
-            double fnl = 0, gxnl = 0; // not needed
-            if (gmoEvalGradNL(mGMO, row, matrix->evalPoint(), &fnl, scratch, &gxnl, &numerr)) {
-                mLogMessages << QString("Gradient evaluation in Line %1 failed. Please check your model").arg(row);
-                mState = Error;
-                continue;
-            }
-            for (int c=0; c<dataRow->entries(); ++c) {
-                if (dataRow->nlFlags()[c]) {
-                    dataRow->outputData()[c] = scratch[dataRow->colIdx()[c]];
-                }
+        dataRow->setNlFlags(nlFlags.constData());
+    }
+    return matrix;
+}
+
+bool ModelInstance::setEvaluationPoint(EvaluationPointRegistry::Type type,
+                                       const QVector<double> &point)
+{
+    auto matrix = mDataHandler->jacobian();
+    if (!matrix || matrix->isLinear()) {
+        mLogMessages << "The model has no NL coefficients to evaluate.";
+        return false;
+    }
+    if (type == EvaluationPointRegistry::InputPoint) {
+        mDataHandler->setNlOverlay(nullptr);
+        mEvaluationPointType = type;
+        return true;
+    }
+    auto coordinates = type == EvaluationPointRegistry::UserPoint ? point : evaluationPoint(type);
+    if (coordinates.size() != matrix->columnCount()) {
+        mLogMessages << QString("Evaluation point has %1 instead of %2 coordinates.")
+                            .arg(coordinates.size()).arg(matrix->columnCount());
+        return false;
+    }
+    auto overlay = mEvaluationPoints.overlay(coordinates, [this, matrix](const QVector<double> &point) {
+        return evaluateNlOverlay(*matrix, point);
+    });
+    if (!overlay)
+        return false;
+    mDataHandler->setNlOverlay(overlay);
+    mEvaluationPointType = type;
+    return true;
+}
+
+EvaluationPointRegistry::Type ModelInstance::evaluationPointType() const
+{
+    return mEvaluationPointType;
+}
+
+QVector<double> ModelInstance::evaluationPoint(EvaluationPointRegistry::Type type)
+{
+    QVector<double> point(variableRowCount());
+    switch (type) {
+    case EvaluationPointRegistry::SolutionPoint:
+        if (!loadEvaluationPoint(point.data(), point.size()))
+            point.clear();
+        break;
+    case EvaluationPointRegistry::BoundsMidpoint:
+    {
+        QVector<double> lower(point.size());
+        QVector<double> upper(point.size());
+        variableLowerBounds(lower.data());
+        variableUpperBounds(upper.data());
+        for (int i=0; i<point.size(); ++i) {
+            // GMO infinities are finite numbers
+            if (isInf(lower[i])) lower[i] = -std::numeric_limits<double>::infinity();
+            if (isInf(upper[i])) upper[i] = std::numeric_limits<double>::infinity();
+        }
+        point = EvaluationPointRegistry::boundsMidpoint(lower, upper);
+        break;
+    }
+    default:
+        break;
+    }
+    return point;
+}
+
+std::shared_ptr<const NlOverlay> ModelInstance::evaluateNlOverlay(DataMatrix &matrix,
+                                                                  const QVector<double> &point)
+{
+    auto overlay = std::make_shared<NlOverlay>();
+    overlay->RowStart.resize(matrix.rowCount()+1);
+    overlay->RowStart[0] = 0;
+    for (int row=0; row<matrix.rowCount(); ++row)
+        overlay->RowStart[row+1] = overlay->RowStart[row] + matrix.row(row)->entriesNl();
+    overlay->Values.resize(overlay->RowStart.constLast());
+    // GMO takes a non-const point
+    QVector<double> x(point);
+    QVector<double> scratch(matrix.columnCount());
+    QMutexLocker locker(&mEvaluationLock);
+    for (int row=0; row<matrix.rowCount(); ++row) {
+        if (!(row % CancellationToken::CheckInterval) && isCancelled())
+            return nullptr;
+        auto* dataRow = matrix.row(row);
+        if (!dataRow->entriesNl())
+            continue;
+        double* values = overlay->Values.data() + overlay->RowStart.at(row);
+        int numerr = 0;
+        double fnl = 0, gxnl = 0; // not needed
+        if (gmoEvalGradNL(mGMO, row, x.data(), &fnl, scratch.data(), &gxnl, &numerr)) {
+            mLogMessages << QString("Gradient evaluation in Line %1 failed. Please check your model").arg(row);
+            mState = Error;
+            for (int c=0, nl=0; c<dataRow->entries(); ++c) {
+                if (dataRow->isNonlinear(c))
+                    values[nl++] = dataRow->inputData()[c];
             }
+            continue;
+        }
+        for (int c=0, nl=0; c<dataRow->entries(); ++c) {
+            if (dataRow->isNonlinear(c))
+                values[nl++] = scratch[dataRow->colIdx()[c]];
         }
-        delete[] scratch;
     }
-    return matrix;
+    return overlay;
 }
 
 QVariant ModelInstance::equationAttribute(const QString &header, int index, int entry, bool abs) const
@@ -845,6 +1044,16 @@ void ModelInstance::removeViewData()
     mDataHandler->removeViewData();
 }
 
+QSharedPointer<AbstractViewConfiguration> ModelInstance::activateViewData(int viewId)
+{
+    return mDataHandler->activateViewData(viewId);
+}
+
+void ModelInstance::setMemoryBudget(qint64 budget)
+{
+    mDataHandler->setMemoryBudget(budget);
+}
+
 QPair<double, double> ModelInstance::equationBounds(int row) const
 {
     QPair<double, double> bounds;
@@ -26,14 +26,18 @@
 #include "gmomcc.h"
 #include "dctmcc.h"
 
+#include <QMutex>
 #include <QVariant>
 
+#include <memory>
+
 namespace gams {
 namespace studio {
 namespace mii {
 
 class DataHandler;
 class DataMatrix;
+struct NlOverlay;
 
 class ModelInstance final : public AbstractModelInstance
 {
@@ -41,7 +45,8 @@ public:
     ModelInstance(bool useOutput = false,
                   const QString &workspace = ".",
                   const QString &systemDir = QString(),
-                  const QString &scratchDir = QString());
+                  const QString &scratchDir = QString(),
+                  const CancellationToken &token = CancellationToken());
 
     ~ModelInstance() override;
 
@@ -95,7 +100,8 @@ public:
 
     void loadBaseData() override;
 
-    void loadViewData(const QSharedPointer<AbstractViewConfiguration> &viewConfig) override;
+    void loadViewData(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                      const CancellationToken &token = CancellationToken()) override;
 
     int rowCount(int viewId) const override;
 
@@ -105,9 +111,9 @@ public:
 
     int columnEntryCount(int column, int viewId) const override;
 
-    const QList<int>& rowIndices(int viewId, int row) const override;
+    QList<int> rowIndices(int viewId, int row) const override;
 
-    const QList<int>& columnIndices(int viewId, int column) const override;
+    QList<int> columnIndices(int viewId, int column) const override;
 
     int symbolRowCount(int viewId) const override;
 
@@ -119,6 +125,30 @@ public:
 
     int nlFlag(int row, int column, int viewId) override;
 
+    DataTile fetchTile(int viewId, const SectionRange &rows, const SectionRange &columns) override;
+
+    int dataRevision() const override;
+
+    QSharedPointer<SparsityPyramid> sparsityPyramid() override;
+
+    QSharedPointer<LogHistogram> logHistogram() override;
+
+    QVector<CoefficientHit> findCoefficients(const CoefficientSearch::Range &range,
+                                             const QBitArray &rows,
+                                             const QBitArray &columns,
+                                             int maxHits, qint64 *total,
+                                             const CancellationToken &token = CancellationToken()) override;
+
+    QSharedPointer<ScalingAdvice> scalingAdvice(ScalingAdvisor::Rounding rounding) override;
+
+    QVector<StructuralFinding> structuralDiagnostics() override;
+
+    QSharedPointer<ComponentPartition> components(ComponentAnalysis::Level level) override;
+
+    QVector<ResidualSummary> primalResiduals() override;
+
+    QVector<DualSummary> dualResiduals() override;
+
     QSharedPointer<PostoptTreeItem> dataTree(int viewId) const override;
 
     QVariant headerData(int logicalIndex,
@@ -145,6 +175,15 @@ public:
 
     void removeViewData() override;
 
+    QSharedPointer<AbstractViewConfiguration> activateViewData(int viewId) override;
+
+    void setMemoryBudget(qint64 budget) override;
+
+    bool setEvaluationPoint(EvaluationPointRegistry::Type type,
+                            const QVector<double> &point = QVector<double>()) override;
+
+    EvaluationPointRegistry::Type evaluationPointType() const override;
+
 private:
     void initialize();
 
@@ -152,7 +191,23 @@ private:
 
     void loadScratchData();
 
-    void loadEvaluationPoint(double *evalPoint, int size);
+    ///
+    /// \brief Copy the variable levels to <c>evalPoint</c> in column order.
+    /// \return <c>false</c> if GMO can't provide the levels.
+    ///
+    bool loadEvaluationPoint(double *evalPoint, int size);
+
+    ///
+    /// \brief Coordinates of the evaluation point of <c>type</c>.
+    ///
+    QVector<double> evaluationPoint(EvaluationPointRegistry::Type type);
+
+    ///
+    /// \brief Gradients of the NL entries of <c>matrix</c> at <c>point</c>,
+    ///        or <c>nullptr</c> if cancelled.
+    ///
+    std::shared_ptr<const NlOverlay> evaluateNlOverlay(DataMatrix &matrix,
+                                                       const QVector<double> &point);
 
     void loadSymbols();
     Symbol* loadSymbol(int index);
@@ -192,6 +247,14 @@ private:
     QString mLongestLabel;
     QString mLongestEqnText;
     QString mLongestVarText;
+
+    EvaluationPointRegistry mEvaluationPoints;
+    std::atomic<EvaluationPointRegistry::Type> mEvaluationPointType {EvaluationPointRegistry::SolutionPoint};
+
+    ///
+    /// \brief Serializes the gradient evaluations of the GMO handle.
+    ///
+    QMutex mEvaluationLock;
 };
 
 }
@@ -24,6 +24,8 @@
 #include <string.h>
 #include <math.h>
 
+#include <charconv>
+
 #include <dtoaloc/dtoaLoc.h>
 
 /* doubleFormat.c
@@ -99,15 +101,14 @@ static char* dig2Exp(const char digits[], int nDigits, int decPt, int isNeg,
     else
         *d++ = '+';
 #endif
-    *bufLen = (int)(d-outBuf);
-    if (e <= 99) {
-        sprintf (d, "%02d", e);
-        *bufLen += 2;
-    }
-    else {
-        sprintf (d, "%d", e);
-        *bufLen += 3;
+    if (e > 99) {
+        *d++ = (char)('0' + e / 100);
+        e %= 100;
     }
+    *d++ = (char)('0' + e / 10);
+    *d++ = (char)('0' + e % 10);
+    *d = '\0';
+    *bufLen = (int)(d-outBuf);
     return outBuf;
 } /* dig2Exp */
 
@@ -299,35 +300,108 @@ char *x2efmt (double v, int nSigFigs, int squeeze, char outBuf[], int *outLen, c
     return outBuf;
 } /* x2efmt */
 
-/* x2gfmt: use g-format, with nSigFigs digits of precision
- * if nSigFigs <= 0, we do shortest round-trip digits and behave
- *    as if squeeze=true (the squeeze input is ignored)
- * if squeeze is true, squeeze out trailing zeros.
- * the output is placed in outBuf, and *outLen gives the length of this buffer
- * On error, NULL is returned.
+/* isIntegerHalfDown: true if v is an integer below 1e15 (dtoaLoc's
+ * "small integer" path) and rounding it to the nDigits digits given in
+ * digits was a half-way case rounded down, i.e. the integer consists of
+ * these digits followed by a 5 and zeros only
  */
-char *x2gfmt (double v, int nSigFigs, int squeeze, char outBuf[], int *outLen, char decSep)
+static int isIntegerHalfDown (double v, const char digits[], int nDigits)
 {
-    char *p, *pEnd;
-    char digBuf[32];              /* buffer for the digits */
-    int nDigits, decPt, isNeg, zCount;
-    int sigFigs;                  /* max(digits returned, digits requested) */
-    int mode = DTOA_MODE_EFMT;
+    char intBuf[24];
+    std::to_chars_result res;
+    char *s;
+    int k = 0;
 
-    *outLen = 0;
-    if (nSigFigs > 17)
-        nSigFigs = 17;
-    if (nSigFigs <= 0) {
-        nSigFigs = 0;
-        mode = DTOA_MODE_RT;
+    if (!(fabs(v) < 1e15) || v != floor(v))
+        return 0;
+    res = std::to_chars(intBuf, intBuf+sizeof(intBuf), fabs(v), std::chars_format::fixed, 0);
+    if (res.ec != std::errc())
+        return 0;
+    for (s = intBuf; s < res.ptr; s++, k++) {
+        if (k < nDigits && digits[k] != *s)
+            return 0;
+        if (k == nDigits && '5' != *s)
+            return 0;
+        if (k > nDigits && '0' != *s)
+            return 0;
     }
-    if (!isfinite(v))
+    return k > nDigits;
+} /* isIntegerHalfDown */
+
+/* toCharsDigits: drop-in replacement for dtoaLoc in the modes used by
+ * x2gfmt (DTOA_MODE_RT and DTOA_MODE_EFMT), based on std::to_chars.
+ * The digits come back exactly as dtoaLoc delivers them: no trailing
+ * zeros, decimal point position in *decPt, sign in *isNeg.
+ */
+static char* toCharsDigits (double v, int mode, int nDigits,
+                            char digBuf[], int digBufLen,
+                            int *decPt, int *isNeg, char **pEnd)
+{
+    char sciBuf[40];
+    std::to_chars_result res;
+    char *s, *d, *dEnd;
+    int e, eNeg;
+
+    if (DTOA_MODE_RT == mode)
+        res = std::to_chars(sciBuf, sciBuf+sizeof(sciBuf), v, std::chars_format::scientific);
+    else if (DTOA_MODE_EFMT == mode && nDigits > 0)
+        res = std::to_chars(sciBuf, sciBuf+sizeof(sciBuf), v, std::chars_format::scientific, nDigits-1);
+    else
         return NULL;
-    p = dtoaLoc (v, mode, nSigFigs,
-                digBuf, sizeof(digBuf), &decPt, &isNeg, &pEnd);
-    if (!p)
+    if (res.ec != std::errc())
         return NULL;
-    nDigits = (int) (pEnd - p);
+    *res.ptr = '\0';
+
+    s = sciBuf;
+    *isNeg = ('-' == *s);
+    if (*isNeg)
+        s++;
+    d = digBuf;
+    dEnd = digBuf + digBufLen - 1;
+    for (; *s && *s != 'e'; s++) {
+        if (*s < '0' || *s > '9')
+            continue;
+        if (d == dEnd)
+            return NULL;
+        *d++ = *s;
+    }
+    if (*s++ != 'e')
+        return NULL;
+    eNeg = ('-' == *s);
+    if ('-' == *s || '+' == *s)
+        s++;
+    for (e = 0; *s; s++)
+        e = 10*e + (*s - '0');
+    if (eNeg)
+        e = -e;
+
+    /* for integers dtoaLoc keeps the trailing zeros of a half-way case
+     * rounded down to even (3705 with 3 digits gives "370"), otherwise
+     * trailing zeros are dropped
+     */
+    if (DTOA_MODE_RT == mode || d == digBuf || '0' != d[-1] ||
+            !isIntegerHalfDown(v, digBuf, (int)(d - digBuf)))
+        while (d > digBuf && '0' == d[-1])
+            d--;
+    if (d == digBuf) {            /* zero: dtoaLoc returns "0" with decPt=1 */
+        *d++ = '0';
+        e = 0;
+    }
+    *d = '\0';
+    *decPt = e + 1;
+    *pEnd = d;
+    return digBuf;
+} /* toCharsDigits */
+
+/* gfmtDigits: the formatting step shared by x2gfmt and x2gfmtToChars
+ * digBuf holds nDigits digits as returned by dtoaLoc or toCharsDigits
+ */
+static char *gfmtDigits (char digBuf[], int nDigits, int decPt, int isNeg,
+                         int nSigFigs, int squeeze, char outBuf[], int *outLen, char decSep)
+{
+    int zCount;
+    int sigFigs;                  /* max(digits returned, digits requested) */
+
     zeroPatch(digBuf, &nDigits, &decPt);
     sigFigs = nDigits;
 #define MAXTRAILZEROS 5  /* reasonable options include 4 and 5 */
@@ -355,8 +429,93 @@ char *x2gfmt (double v, int nSigFigs, int squeeze, char outBuf[], int *outLen, c
     }
 
     return outBuf;
+} /* gfmtDigits */
+
+/* x2gfmt: use g-format, with nSigFigs digits of precision
+ * if nSigFigs <= 0, we do shortest round-trip digits and behave
+ *    as if squeeze=true (the squeeze input is ignored)
+ * if squeeze is true, squeeze out trailing zeros.
+ * the output is placed in outBuf, and *outLen gives the length of this buffer
+ * On error, NULL is returned.
+ */
+char *x2gfmt (double v, int nSigFigs, int squeeze, char outBuf[], int *outLen, char decSep)
+{
+    char *p, *pEnd;
+    char digBuf[32];              /* buffer for the digits */
+    int decPt, isNeg;
+    int mode = DTOA_MODE_EFMT;
+
+    *outLen = 0;
+    if (nSigFigs > 17)
+        nSigFigs = 17;
+    if (nSigFigs <= 0) {
+        nSigFigs = 0;
+        mode = DTOA_MODE_RT;
+    }
+    if (!isfinite(v))
+        return NULL;
+    p = dtoaLoc (v, mode, nSigFigs,
+                digBuf, sizeof(digBuf), &decPt, &isNeg, &pEnd);
+    if (!p)
+        return NULL;
+    return gfmtDigits(digBuf, (int)(pEnd - p), decPt, isNeg,
+                      nSigFigs, squeeze, outBuf, outLen, decSep);
 } /* x2gfmt */
 
+/* x2gfmtToChars: same contract and output as x2gfmt, but the digits are
+ * computed by std::to_chars instead of dtoaLoc
+ */
+char *x2gfmtToChars (double v, int nSigFigs, int squeeze, char outBuf[], int *outLen, char decSep)
+{
+    char *p, *pEnd;
+    char digBuf[32];              /* buffer for the digits */
+    int decPt, isNeg;
+    int mode = DTOA_MODE_EFMT;
+
+    *outLen = 0;
+    if (nSigFigs > 17)
+        nSigFigs = 17;
+    if (nSigFigs <= 0) {
+        nSigFigs = 0;
+        mode = DTOA_MODE_RT;
+    }
+    if (!isfinite(v))
+        return NULL;
+    p = toCharsDigits (v, mode, nSigFigs,
+                      digBuf, sizeof(digBuf), &decPt, &isNeg, &pEnd);
+    if (!p)
+        return NULL;
+    return gfmtDigits(digBuf, (int)(pEnd - p), decPt, isNeg,
+                      nSigFigs, squeeze, outBuf, outLen, decSep);
+} /* x2gfmtToChars */
+
+/* x2gfmtBatch: format n values with x2gfmtToChars into one buffer
+ * the strings are written back to back, each terminated by '\0';
+ * offsets[i] is the start of the i-th string and offsets[n] the end of
+ * the used buffer, values that cannot be formatted yield an empty string
+ * returns the number of values written, which is less than n if outBuf
+ * (of size bufLen) is exhausted
+ */
+int x2gfmtBatch (const double v[], int n, int nSigFigs, int squeeze,
+                 char outBuf[], int bufLen, int offsets[], char decSep)
+{
+    char tmpBuf[32];
+    int i, len, pos = 0;
+
+    for (i = 0; i < n; i++) {
+        offsets[i] = pos;
+        if (!x2gfmtToChars(v[i], nSigFigs, squeeze, tmpBuf, &len, decSep))
+            len = 0;
+        if (pos + len + 1 > bufLen)
+            break;
+        (void) memcpy (outBuf+pos, tmpBuf, len);
+        pos += len;
+        outBuf[pos++] = '\0';
+    }
+    offsets[i] = pos;
+    return i;
+} /* x2gfmtBatch */
+
 namespace gams {
 namespace studio {
 namespace mii {
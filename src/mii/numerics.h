@@ -36,6 +36,11 @@ char *x2efmt (double v, int nSigFigs, int squeeze, char outBuf[], int *outLen, c
 
 char *x2gfmt (double v, int nSigFigs, int squeeze, char outBuf[], int *outLen, char decSep);
 
+char *x2gfmtToChars (double v, int nSigFigs, int squeeze, char outBuf[], int *outLen, char decSep);
+
+int x2gfmtBatch (const double v[], int n, int nSigFigs, int squeeze,
+                 char outBuf[], int bufLen, int offsets[], char decSep);
+
 #ifdef __cplusplus
 };
 #endif
@@ -0,0 +1,188 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef PACKEDBITSET_H
+#define PACKEDBITSET_H
+
+#include <QtAlgorithms>
+#include <QVector>
+
+#include <algorithm>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Fixed size set of bits packed into 64 bit words, e.g. the NL flags
+///        of a sparse row aligned with its column indices.
+///
+/// The first word is stored inline and only the words of bits 64 and above
+/// are allocated, so sets of at most 64 bits, like most Jacobian rows, need
+/// no heap allocation.
+///
+class PackedBitSet
+{
+public:
+    PackedBitSet() = default;
+
+    explicit PackedBitSet(int size)
+        : mSize(size)
+        , mWords(std::max(0, wordCount(size)-1), 0)
+    {
+
+    }
+
+    ///
+    /// \brief Pack <c>size</c> flags, where each non-zero flag sets its bit.
+    ///
+    static PackedBitSet fromFlags(const int *flags, int size)
+    {
+        PackedBitSet bits(size);
+        for (int i=0; i<size; ++i) {
+            if (flags[i])
+                bits.word(i >> WordShift) |= quint64(1) << (i & WordMask);
+        }
+        return bits;
+    }
+
+    int size() const
+    {
+        return mSize;
+    }
+
+    bool test(int index) const
+    {
+        return (word(index >> WordShift) >> (index & WordMask)) & 1;
+    }
+
+    void set(int index, bool value = true)
+    {
+        if (value)
+            word(index >> WordShift) |= quint64(1) << (index & WordMask);
+        else
+            word(index >> WordShift) &= ~(quint64(1) << (index & WordMask));
+    }
+
+    ///
+    /// \brief Number of set bits.
+    ///
+    int count() const
+    {
+        int bits = qPopulationCount(mFirstWord);
+        for (auto word : mWords)
+            bits += qPopulationCount(word);
+        return bits;
+    }
+
+    ///
+    /// \brief Number of set bits in [<c>first</c>, <c>last</c>].
+    ///
+    int count(int first, int last) const
+    {
+        if (first > last)
+            return 0;
+        int firstWord = first >> WordShift;
+        int lastWord = last >> WordShift;
+        quint64 firstMask = ~quint64(0) << (first & WordMask);
+        quint64 lastMask = ~quint64(0) >> (WordMask - (last & WordMask));
+        if (firstWord == lastWord)
+            return qPopulationCount(word(firstWord) & firstMask & lastMask);
+        int bits = qPopulationCount(word(firstWord) & firstMask);
+        for (int w=firstWord+1; w<lastWord; ++w)
+            bits += qPopulationCount(word(w));
+        return bits + qPopulationCount(word(lastWord) & lastMask);
+    }
+
+    ///
+    /// \brief Number of set bits before <c>index</c>, i.e. the position of
+    ///        bit <c>index</c> in a compact array of the set bits.
+    ///
+    int rank(int index) const
+    {
+        return index ? count(0, index-1) : 0;
+    }
+
+    bool any() const
+    {
+        if (mFirstWord)
+            return true;
+        for (auto word : mWords) {
+            if (word)
+                return true;
+        }
+        return false;
+    }
+
+    ///
+    /// \brief Heap memory of the words beyond the inline word.
+    ///
+    qint64 byteSize() const
+    {
+        return qint64(mWords.size()) * sizeof(quint64);
+    }
+
+    bool operator==(const PackedBitSet &other) const
+    {
+        return mSize == other.mSize && mFirstWord == other.mFirstWord && mWords == other.mWords;
+    }
+
+    bool operator!=(const PackedBitSet &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    static int wordCount(int size)
+    {
+        return (size + WordMask) >> WordShift;
+    }
+
+    quint64 word(int index) const
+    {
+        return index ? mWords.at(index-1) : mFirstWord;
+    }
+
+    quint64& word(int index)
+    {
+        return index ? mWords[index-1] : mFirstWord;
+    }
+
+private:
+    static constexpr int WordShift = 6;
+    static constexpr int WordMask = 63;
+
+    int mSize = 0;
+
+    ///
+    /// \brief Bits 0 to 63.
+    ///
+    quint64 mFirstWord = 0;
+
+    ///
+    /// \brief Bits 64 and above, empty for sets of at most 64 bits.
+    ///
+    QVector<quint64> mWords;
+};
+
+}
+}
+}
+
+#endif // PACKEDBITSET_H
@@ -27,6 +27,34 @@ namespace mii {
 const QVector<QVariant> PostoptTreeItem::EquationLineHeader = {ViewHelper::EquationHeaderText, "Aij", "Ui", "Aij*Ui"};
 const QVector<QVariant> PostoptTreeItem::VariableLineHeader = {ViewHelper::VariableHeaderText, "Aij", "Xj", "Aij*Xj"};
 
+PostoptTreeArena::~PostoptTreeArena()
+{
+    rollback(Mark());
+}
+
+void PostoptTreeArena::rollback(const Mark &mark)
+{
+    while (int(mItems.size()) > mark.Items) {
+        mItems.back()->~PostoptTreeItem();
+        mItems.pop_back();
+    }
+    mBlock = mark.Block;
+    mOffset = mark.Block < 0 ? BlockSize : mark.Offset;
+}
+
+void *PostoptTreeArena::allocate(size_t size, size_t alignment)
+{
+    size_t offset = (mOffset + alignment - 1) & ~(alignment - 1);
+    if (mBlock < 0 || offset + size > BlockSize) {
+        ++mBlock;
+        if (mBlock == int(mBlocks.size()))
+            mBlocks.emplace_back(new char[BlockSize]);
+        offset = 0;
+    }
+    mOffset = offset + size;
+    return mBlocks[mBlock].get() + offset;
+}
+
 }
 }
 }
@@ -23,10 +23,18 @@
 #include <QVector>
 #include <QVariant>
 
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace gams {
 namespace studio {
 namespace mii {
 
+class PostoptTreeArena;
+
 class PostoptTreeItem
 {
 public:
@@ -45,7 +53,8 @@ public:
 
     virtual ~PostoptTreeItem()
     {
-        qDeleteAll(mChilds);
+        if (mOwnsChilds)
+            qDeleteAll(mChilds);
     }
 
     virtual QVariant data(int index) const = 0;
@@ -92,7 +101,16 @@ public:
     static const QVector<QVariant> EquationLineHeader;
     static const QVector<QVariant> VariableLineHeader;
 
+protected:
+    ///
+    /// \brief Children are deleted with their parent, unless they live in
+    ///        a PostoptTreeArena.
+    ///
+    bool mOwnsChilds = true;
+
 private:
+    friend class PostoptTreeArena;
+
     PostoptTreeItem *mParent;
 
     QVector<PostoptTreeItem*> mChilds;
@@ -159,6 +177,49 @@ private:
     QVector<QVariant> mData;
 };
 
+///
+/// \brief Line of a Jacobian entry with its numeric values, which are
+///        formatted by the model on display.
+///
+class ValuePostoptTreeItem : public PostoptTreeItem
+{
+public:
+    explicit ValuePostoptTreeItem(const QString &name = QString(),
+                                  double jacobian = 0.0,
+                                  double value = 0.0,
+                                  double product = 0.0,
+                                  PostoptTreeItem* parent = nullptr)
+        : PostoptTreeItem(parent)
+        , mName(name)
+        , mValues { jacobian, value, product }
+    {
+
+    }
+
+    QVariant data(int index) const override
+    {
+        if (index == 0)
+            return mName;
+        if (index < 0 || index > 3)
+            return QVariant();
+        return mValues[index-1];
+    }
+
+    int columnCount() const override
+    {
+        return 4;
+    }
+
+    Type type() const override
+    {
+        return LineItem;
+    }
+
+private:
+    QString mName;
+    double mValues[3];
+};
+
 class ClickPostoptTreeItem : public PostoptTreeItem
 {
 public:
@@ -189,6 +250,118 @@ private:
     QString mText;
 };
 
+///
+/// \brief Bump allocator of the items of one Postopt tree.
+///
+/// Items are placed into large blocks and destroyed together with the
+/// arena, so building and dropping a big tree doesn't allocate every node
+/// on the heap. Subtrees which turn out empty are dropped by rolling back
+/// to a mark taken before they were created; this requires that nothing
+/// created after the mark is still referenced.
+///
+class PostoptTreeArena final
+{
+public:
+    struct Mark
+    {
+        int Block = -1;
+        size_t Offset = 0;
+        int Items = 0;
+    };
+
+    PostoptTreeArena() = default;
+
+    PostoptTreeArena(const PostoptTreeArena &) = delete;
+
+    PostoptTreeArena& operator=(const PostoptTreeArena &) = delete;
+
+    ~PostoptTreeArena();
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(std::is_base_of<PostoptTreeItem, T>::value, "T must be a PostoptTreeItem");
+        static_assert(sizeof(T) <= BlockSize, "T must fit into a block");
+        auto item = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        item->mOwnsChilds = false;
+        mItems.push_back(item);
+        return item;
+    }
+
+    Mark mark() const
+    {
+        return Mark { mBlock, mOffset, int(mItems.size()) };
+    }
+
+    ///
+    /// \brief Destroy all items created after <c>mark</c> and reuse their
+    ///        memory.
+    ///
+    void rollback(const Mark &mark);
+
+    int itemCount() const
+    {
+        return int(mItems.size());
+    }
+
+    int blockCount() const
+    {
+        return int(mBlocks.size());
+    }
+
+    static constexpr size_t BlockSize = 64 * 1024;
+
+private:
+    void* allocate(size_t size, size_t alignment);
+
+private:
+    std::vector<std::unique_ptr<char[]>> mBlocks;
+    int mBlock = -1;
+    size_t mOffset = BlockSize;
+    std::vector<PostoptTreeItem*> mItems;
+};
+
+///
+/// \brief Root of a Postopt tree whose items live in its arena.
+///
+class RootPostoptTreeItem final : public PostoptTreeItem
+{
+public:
+    RootPostoptTreeItem()
+    {
+        mOwnsChilds = false;
+    }
+
+    QVariant data(int index) const override
+    {
+        Q_UNUSED(index);
+        return QVariant();
+    }
+
+    int columnCount() const override
+    {
+        return 0;
+    }
+
+    Type type() const override
+    {
+        return LineItem;
+    }
+
+    PostoptTreeArena& arena()
+    {
+        return mArena;
+    }
+
+    const PostoptTreeArena& arena() const
+    {
+        return mArena;
+    }
+
+private:
+    PostoptTreeArena mArena;
+};
+
 }
 }
 }
@@ -20,6 +20,7 @@
 #include "postopttreemodel.h"
 #include "postopttreeitem.h"
 #include "abstractmodelinstance.h"
+#include "numerics.h"
 
 namespace gams {
 namespace studio {
@@ -47,7 +48,10 @@ QVariant PostoptTreeModel::data(const QModelIndex &index, int role) const
         return QVariant();
     if (role == Qt::DisplayRole) {
         auto *item = static_cast<PostoptTreeItem*>(index.internalPointer());
-        return item->data(index.column());
+        auto value = item->data(index.column());
+        if (value.userType() == QMetaType::Double)
+            return DoubleFormatter::format(value.toDouble(), DoubleFormatter::g, 6, true);
+        return value;
     }
     if (role == Qt::TextAlignmentRole && index.column() > 0) {
         return Qt::AlignRight;
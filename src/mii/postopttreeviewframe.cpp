@@ -24,6 +24,11 @@
 #include "abstractmodelinstance.h"
 #include "valueformatproxymodel.h"
 
+#include <QDoubleValidator>
+#include <QSignalBlocker>
+
+#include <limits>
+
 namespace gams {
 namespace studio{
 namespace mii {
@@ -35,6 +40,12 @@ PostoptTreeViewFrame::PostoptTreeViewFrame(QWidget *parent, Qt::WindowFlags f)
     ui->setupUi(this);
     connect(ui->treeView, &PostoptTreeView::openFilterDialog,
             this, &PostoptTreeViewFrame::openFilterDialog);
+    ui->thresholdEdit->setValidator(new QDoubleValidator(0.0, std::numeric_limits<double>::max(),
+                                                         1000, ui->thresholdEdit));
+    connect(ui->topKBox, qOverload<int>(&QSpinBox::valueChanged),
+            this, &PostoptTreeViewFrame::applyContributionFilter);
+    connect(ui->thresholdEdit, &QLineEdit::editingFinished,
+            this, &PostoptTreeViewFrame::applyContributionFilter);
     mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::defaultConfiguration());
 }
 
@@ -46,6 +57,7 @@ PostoptTreeViewFrame::PostoptTreeViewFrame(const QSharedPointer<AbstractModelIns
 {
     mModelInstance = modelInstance;
     mViewConfig = viewConfig;
+    showContributionFilter();
 }
 
 PostoptTreeViewFrame::~PostoptTreeViewFrame()
@@ -68,8 +80,7 @@ AbstractViewFrame *PostoptTreeViewFrame::clone(int viewId)
 void PostoptTreeViewFrame::setShowAbsoluteValues(bool absoluteValues)
 {
     Q_UNUSED(absoluteValues);
-    mModelInstance->loadViewData(mViewConfig);
-    setupView();
+    requestViewData();
 }
 
 SearchResult &PostoptTreeViewFrame::search(const QString &term, bool isRegEx)
@@ -90,8 +101,19 @@ void PostoptTreeViewFrame::setupView(const QSharedPointer<AbstractModelInstance>
     mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(), mModelInstance));
     mViewConfig->currentValueFilter().UseAbsoluteValues = modelInstance->globalAbsolute();
     mViewConfig->currentValueFilter().UseAbsoluteValuesGlobal = modelInstance->globalAbsolute();
-    mModelInstance->loadViewData(mViewConfig);
+    mViewConfig->currentContributionFilter().TopK = ui->topKBox->value();
+    mViewConfig->currentContributionFilter().Threshold = ui->thresholdEdit->text().toDouble();
+    requestViewData();
+}
+
+void PostoptTreeViewFrame::viewDataLoaded()
+{
+    setLoading(false);
     setupView();
+    if (!mValueFormatModel)
+        return;
+    mValueFormatModel->setValueFilter(mViewConfig->currentValueFilter());
+    ui->treeView->expandAll();
 }
 
 ViewHelper::ViewDataType PostoptTreeViewFrame::type() const
@@ -121,12 +143,28 @@ bool PostoptTreeViewFrame::hasData() const
 
 void PostoptTreeViewFrame::evaluateFilters()
 {
-    mModelInstance->loadViewData(mViewConfig);
-    setupView();
-    if (!mValueFormatModel)
+    requestViewData();
+}
+
+void PostoptTreeViewFrame::applyContributionFilter()
+{
+    ContributionFilter filter;
+    filter.TopK = ui->topKBox->value();
+    filter.Threshold = ui->thresholdEdit->text().toDouble();
+    if (filter == mViewConfig->currentContributionFilter())
         return;
-    mValueFormatModel->setValueFilter(mViewConfig->currentValueFilter());
-    ui->treeView->expandAll();
+    mViewConfig->setCurrentContributionFilter(filter);
+    evaluateFilters();
+}
+
+void PostoptTreeViewFrame::showContributionFilter()
+{
+    QSignalBlocker topKBlocker(ui->topKBox);
+    QSignalBlocker thresholdBlocker(ui->thresholdEdit);
+    const auto& filter = mViewConfig->currentContributionFilter();
+    ui->topKBox->setValue(filter.TopK);
+    ui->thresholdEdit->setText(filter.Threshold > 0.0 ? QString::number(filter.Threshold)
+                                                      : QString());
 }
 
 void PostoptTreeViewFrame::setupView()
@@ -58,6 +58,8 @@ public:
 
     void setupView(const QSharedPointer<AbstractModelInstance>& modelInstance) override;
 
+    void viewDataLoaded() override;
+
     ViewHelper::ViewDataType type() const override;
 
     void zoomIn() override;
@@ -74,9 +76,14 @@ signals:
 public slots:
     void evaluateFilters() override;
 
+private slots:
+    void applyContributionFilter();
+
 private:
     void setupView();
 
+    void showContributionFilter();
+
 protected:
     Ui::PostoptTreeViewFrame* ui;
     PostoptTreeModel *mBaseModel;
@@ -0,0 +1,164 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "primalresidual.h"
+#include "datamatrix.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Rows of one parallel task.
+///
+struct ResidualBlock
+{
+    int First = 0;
+    int Last = -1;
+};
+
+static const int ResidualRowsPerTask = 1024;
+
+///
+/// \brief Result of a single row, where a negative residual marks a
+///        skipped nonlinear row.
+///
+struct RowResidual
+{
+    double Residual = 0.0;
+    double RelativeResidual = 0.0;
+    double Violation = 0.0;
+};
+
+double PrimalResidual::violation(char equationType, double level, double rhs)
+{
+    double violation = 0.0;
+    switch (equationType) {
+    case 'E':
+        violation = std::abs(level - rhs);
+        break;
+    case 'G':
+        violation = rhs - level;
+        break;
+    case 'L':
+        violation = level - rhs;
+        break;
+    default:
+        return 0.0;
+    }
+    if (std::isnan(violation))
+        return std::numeric_limits<double>::infinity();
+    return std::max(0.0, violation);
+}
+
+QVector<ResidualSummary> PrimalResidual::run(DataMatrix &matrix,
+                                             const QVector<double> &levels,
+                                             const QVector<double> &rowLevels,
+                                             const QVector<double> &rhs,
+                                             const QByteArray &equationTypes,
+                                             const QVector<int> &rowSymbols,
+                                             int symbolCount)
+{
+    QVector<ResidualSummary> summaries(symbolCount);
+    for (int s=0; s<symbolCount; ++s)
+        summaries[s].Symbol = s;
+    const int rows = std::min({ matrix.rowCount(), int(rowLevels.size()),
+                                int(rhs.size()), int(rowSymbols.size()) });
+    const int columns = std::min(matrix.columnCount(), int(levels.size()));
+
+    QVector<RowResidual> residuals(rows);
+    RowResidual *residual = residuals.data();
+    const double *x = levels.constData();
+    const double *rowLevel = rowLevels.constData();
+    const double *b = rhs.constData();
+    QVector<ResidualBlock> blocks;
+    for (int first=0; first<rows; first+=ResidualRowsPerTask) {
+        ResidualBlock block;
+        block.First = first;
+        block.Last = std::min(first+ResidualRowsPerTask, rows)-1;
+        blocks.append(block);
+    }
+    QtConcurrent::blockingMap(blocks, [&matrix, &equationTypes, residual, x, rowLevel,
+                                       b, columns](const ResidualBlock &block) {
+        for (int r=block.First; r<=block.Last; ++r) {
+            auto row = matrix.row(r);
+            const int *index = row->colIdx();
+            const double *a = row->inputData();
+            const auto &nlFlags = row->nlFlags();
+            double activity = 0.0;
+            double scale = std::max(1.0, std::abs(rowLevel[r]));
+            bool isLinear = true;
+            for (int e=0; e<row->entries(); ++e) {
+                if (nlFlags.test(e) || index[e] >= columns) {
+                    isLinear = false;
+                    break;
+                }
+                const double term = a[e] * x[index[e]];
+                activity += term;
+                scale = std::max(scale, std::abs(term));
+            }
+            if (!isLinear) {
+                residual[r].Residual = -1.0;
+                continue;
+            }
+            double difference = std::abs(activity - rowLevel[r]);
+            if (!std::isfinite(difference))
+                difference = std::numeric_limits<double>::infinity();
+            residual[r].Residual = difference;
+            residual[r].RelativeResidual = difference / scale;
+            const char type = r < equationTypes.size() ? equationTypes.at(r) : 'N';
+            residual[r].Violation = violation(type, rowLevel[r], b[r]);
+        }
+    });
+
+    for (int r=0; r<rows; ++r) {
+        const int symbol = rowSymbols.at(r);
+        if (symbol < 0 || symbol >= symbolCount)
+            continue;
+        auto& summary = summaries[symbol];
+        const auto& row = residual[r];
+        if (row.Residual < 0.0) {
+            ++summary.NonlinearRows;
+            continue;
+        }
+        ++summary.Rows;
+        if (summary.ResidualRow < 0 || row.Residual > summary.MaxResidual) {
+            summary.MaxResidual = row.Residual;
+            summary.ResidualRow = r;
+        }
+        summary.MaxRelativeResidual = std::max(summary.MaxRelativeResidual, row.RelativeResidual);
+        if (row.Violation > Tolerance * std::max(1.0, std::abs(b[r])))
+            ++summary.Violations;
+        if (row.Violation > summary.MaxViolation) {
+            summary.MaxViolation = row.Violation;
+            summary.ViolationRow = r;
+        }
+    }
+    return summaries;
+}
+
+}
+}
+}
@@ -0,0 +1,125 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef PRIMALRESIDUAL_H
+#define PRIMALRESIDUAL_H
+
+#include <QByteArray>
+#include <QVector>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class DataMatrix;
+
+///
+/// \brief Residuals and bound violations of the rows of one equation symbol.
+///
+struct ResidualSummary
+{
+    ///
+    /// \brief Logical index of the equation symbol.
+    ///
+    int Symbol = -1;
+
+    ///
+    /// \brief Number of checked linear rows.
+    ///
+    int Rows = 0;
+
+    ///
+    /// \brief Number of skipped nonlinear rows.
+    ///
+    int NonlinearRows = 0;
+
+    ///
+    /// \brief Number of rows which violate the right-hand side by more
+    ///        than PrimalResidual::Tolerance.
+    ///
+    int Violations = 0;
+
+    ///
+    /// \brief Largest |A_i x - level_i| and its row.
+    ///
+    double MaxResidual = 0.0;
+    int ResidualRow = -1;
+
+    ///
+    /// \brief Largest residual relative to the largest term |a_ij x_j| or
+    ///        |level_i| of its row, at least 1.
+    ///
+    double MaxRelativeResidual = 0.0;
+
+    ///
+    /// \brief Largest violation of the right-hand side by the row level
+    ///        and its row.
+    ///
+    double MaxViolation = 0.0;
+    int ViolationRow = -1;
+};
+
+///
+/// \brief Verification of the solution levels of the linear rows.
+///
+/// The activity A x of all linear rows is computed by a parallel sparse
+/// matrix-vector product over row blocks of the Jacobian and compared
+/// against the row levels reported by the solver. The row levels are in
+/// turn checked against the right-hand side of their equation type. Large
+/// residuals usually mean that the solver worked on a badly scaled model.
+///
+class PrimalResidual final
+{
+public:
+    ///
+    /// \brief Relative feasibility tolerance of the violations.
+    ///
+    static constexpr double Tolerance = 1e-6;
+
+    ///
+    /// \brief Check all linear rows.
+    /// \param levels Variable levels, i.e. x.
+    /// \param rowLevels Equation levels.
+    /// \param rhs Right-hand side per row.
+    /// \param equationTypes GAMS equation type per row, i.e. <c>'E'</c>,
+    ///        <c>'G'</c>, <c>'L'</c> or <c>'N'</c>. Rows of any other type
+    ///        aren't checked for violations.
+    /// \param rowSymbols Logical equation symbol index of each row.
+    /// \return One summary per equation symbol.
+    ///
+    static QVector<ResidualSummary> run(DataMatrix &matrix,
+                                        const QVector<double> &levels,
+                                        const QVector<double> &rowLevels,
+                                        const QVector<double> &rhs,
+                                        const QByteArray &equationTypes,
+                                        const QVector<int> &rowSymbols,
+                                        int symbolCount);
+
+    ///
+    /// \brief Violation of <c>rhs</c> by the row <c>level</c>, which is 0
+    ///        if the row is satisfied.
+    ///
+    static double violation(char equationType, double level, double rhs);
+};
+
+}
+}
+}
+
+#endif // PRIMALRESIDUAL_H
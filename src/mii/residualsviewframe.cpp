@@ -0,0 +1,477 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "residualsviewframe.h"
+#include "abstractmodelinstance.h"
+#include "numerics.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QSortFilterProxyModel>
+#include <QTabWidget>
+#include <QTableView>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <utility>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+ResidualModel::ResidualModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+
+}
+
+void ResidualModel::setSummaries(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                 const QVector<ResidualSummary> &summaries)
+{
+    beginResetModel();
+    mModelInstance = modelInstance;
+    mSummaries = summaries;
+    endResetModel();
+}
+
+QVariant ResidualModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= mSummaries.size())
+        return QVariant();
+    const auto& summary = mSummaries.at(index.row());
+    if (role == Qt::TextAlignmentRole) {
+        return index.column() == 0 || index.column() == 5 || index.column() == 8
+                ? QVariant() : QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role == Qt::UserRole) {
+        switch (index.column()) {
+        case 0:
+            return summary.Symbol;
+        case 1:
+            return summary.Rows;
+        case 2:
+            return summary.NonlinearRows;
+        case 3:
+            return summary.MaxResidual;
+        case 4:
+            return summary.MaxRelativeResidual;
+        case 5:
+            return summary.ResidualRow;
+        case 6:
+            return summary.Violations;
+        case 7:
+            return summary.MaxViolation;
+        default:
+            return summary.ViolationRow;
+        }
+    }
+    if (role != Qt::DisplayRole)
+        return QVariant();
+    const bool isChecked = summary.Rows > 0;
+    switch (index.column()) {
+    case 0:
+    {
+        const auto& equations = mModelInstance->equations();
+        return summary.Symbol < equations.size() ? equations.at(summary.Symbol)->name()
+                                                 : QString::number(summary.Symbol);
+    }
+    case 1:
+        return summary.Rows;
+    case 2:
+        return summary.NonlinearRows;
+    case 3:
+        return isChecked ? DoubleFormatter::format(summary.MaxResidual, DoubleFormatter::g, 6, true)
+                         : QString();
+    case 4:
+        return isChecked ? DoubleFormatter::format(summary.MaxRelativeResidual, DoubleFormatter::g, 6, true)
+                         : QString();
+    case 5:
+        return isChecked ? rowText(summary.ResidualRow) : QString();
+    case 6:
+        return summary.Violations;
+    case 7:
+        return isChecked ? DoubleFormatter::format(summary.MaxViolation, DoubleFormatter::g, 6, true)
+                         : QString();
+    default:
+        return summary.ViolationRow < 0 ? QString() : rowText(summary.ViolationRow);
+    }
+}
+
+QVariant ResidualModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
+        return mHeaderData.at(section);
+    }
+    return QVariant();
+}
+
+int ResidualModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mHeaderData.size();
+}
+
+int ResidualModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mSummaries.size();
+}
+
+QString ResidualModel::rowText(int row) const
+{
+    auto symbol = mModelInstance->equation(row);
+    if (!symbol)
+        return QString::number(row);
+    if (symbol->isScalar())
+        return symbol->name();
+    auto labels = std::as_const(symbol->sectionLabels()).value(row);
+    return QString("%1(%2)").arg(symbol->name(), labels.join(","));
+}
+
+DualResidualModel::DualResidualModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+
+}
+
+void DualResidualModel::setSummaries(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                     const QVector<DualSummary> &summaries)
+{
+    beginResetModel();
+    mModelInstance = modelInstance;
+    mSummaries = summaries;
+    endResetModel();
+}
+
+QVariant DualResidualModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= mSummaries.size())
+        return QVariant();
+    const auto& summary = mSummaries.at(index.row());
+    if (role == Qt::TextAlignmentRole) {
+        return index.column() == 0 || index.column() == 6
+                ? QVariant() : QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role == Qt::UserRole) {
+        switch (index.column()) {
+        case 0:
+            return summary.Symbol;
+        case 1:
+            return summary.Columns;
+        case 2:
+            return summary.SkippedColumns;
+        case 3:
+            return summary.Mismatches;
+        case 4:
+            return summary.MaxMismatch;
+        case 5:
+            return summary.MaxRelativeMismatch;
+        case 6:
+            return summary.MismatchColumn;
+        case 7:
+            return summary.ComputedMarginal;
+        default:
+            return summary.ReportedMarginal;
+        }
+    }
+    if (role != Qt::DisplayRole)
+        return QVariant();
+    const bool isChecked = summary.Columns > 0;
+    switch (index.column()) {
+    case 0:
+    {
+        const auto& variables = mModelInstance->variables();
+        return summary.Symbol < variables.size() ? variables.at(summary.Symbol)->name()
+                                                 : QString::number(summary.Symbol);
+    }
+    case 1:
+        return summary.Columns;
+    case 2:
+        return summary.SkippedColumns;
+    case 3:
+        return summary.Mismatches;
+    case 4:
+        return isChecked ? DoubleFormatter::format(summary.MaxMismatch, DoubleFormatter::g, 6, true)
+                         : QString();
+    case 5:
+        return isChecked ? DoubleFormatter::format(summary.MaxRelativeMismatch, DoubleFormatter::g, 6, true)
+                         : QString();
+    case 6:
+        return isChecked ? columnText(summary.MismatchColumn) : QString();
+    case 7:
+        return isChecked ? DoubleFormatter::format(summary.ComputedMarginal, DoubleFormatter::g, 6, true)
+                         : QString();
+    default:
+        return isChecked ? DoubleFormatter::format(summary.ReportedMarginal, DoubleFormatter::g, 6, true)
+                         : QString();
+    }
+}
+
+QVariant DualResidualModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
+        return mHeaderData.at(section);
+    }
+    return QVariant();
+}
+
+int DualResidualModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mHeaderData.size();
+}
+
+int DualResidualModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mSummaries.size();
+}
+
+QString DualResidualModel::columnText(int column) const
+{
+    auto symbol = mModelInstance->variable(column);
+    if (!symbol)
+        return QString::number(column);
+    if (symbol->isScalar())
+        return symbol->name();
+    auto labels = std::as_const(symbol->sectionLabels()).value(column);
+    return QString("%1(%2)").arg(symbol->name(), labels.join(","));
+}
+
+ResidualsViewFrame::ResidualsViewFrame(QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::defaultConfiguration());
+    setupUi();
+}
+
+ResidualsViewFrame::ResidualsViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                       const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                                       QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mModelInstance = modelInstance;
+    mViewConfig = viewConfig;
+    setupUi();
+}
+
+ResidualsViewFrame::~ResidualsViewFrame()
+{
+    mResidualWatcher.waitForFinished();
+}
+
+AbstractViewFrame *ResidualsViewFrame::clone(int viewId)
+{
+    auto viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
+                                                                                                         mModelInstance));
+    viewConfig->setViewId(viewId);
+    auto frame = new ResidualsViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    if (mResidualWatcher.isRunning()) {
+        frame->setupView(mModelInstance);
+    } else {
+        frame->mIsLoaded = mIsLoaded;
+        frame->setSummaries(mSummaries, mDualSummaries);
+    }
+    return frame;
+}
+
+void ResidualsViewFrame::setShowAbsoluteValues(bool absoluteValues)
+{// residuals and violations are always absolute
+    Q_UNUSED(absoluteValues);
+}
+
+void ResidualsViewFrame::zoomIn()
+{
+    QFont font = mResidualView->font();
+    font.setPointSize(font.pointSize() + ViewHelper::ZoomFactor);
+    mResidualView->setFont(font);
+    mDualView->setFont(font);
+}
+
+void ResidualsViewFrame::zoomOut()
+{
+    QFont font = mResidualView->font();
+    if (font.pointSize() <= ViewHelper::ZoomFactor)
+        return;
+    font.setPointSize(font.pointSize() - ViewHelper::ZoomFactor);
+    mResidualView->setFont(font);
+    mDualView->setFont(font);
+}
+
+void ResidualsViewFrame::resetZoom()
+{
+    mResidualView->setFont(font());
+    mDualView->setFont(font());
+}
+
+SearchResult &ResidualsViewFrame::search(const QString &term, bool isRegEx)
+{
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = isRegEx;
+    mViewConfig->searchResult().Entries.clear();
+    return mViewConfig->searchResult();
+}
+
+void ResidualsViewFrame::setSearchSelection(const SearchResult::SearchEntry &result)
+{
+    Q_UNUSED(result);
+}
+
+void ResidualsViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &modelInstance)
+{
+    mModelInstance = modelInstance;
+    mIsLoaded = !modelInstance->useOutput();
+    setSummaries(QVector<ResidualSummary>(), QVector<DualSummary>());
+    if (mIsLoaded)
+        return;
+    mInfoLabel->setText("Checking the solution...");
+    auto loadResiduals = [modelInstance]{
+        Result result;
+        result.Primal = modelInstance->primalResiduals();
+        result.Dual = modelInstance->dualResiduals();
+        return result;
+    };
+    mResidualWatcher.setFuture(QtConcurrent::run(loadResiduals));
+}
+
+bool ResidualsViewFrame::hasData() const
+{
+    return mResidualWatcher.isRunning() || (mIsLoaded && mModelInstance->equationRowCount());
+}
+
+void ResidualsViewFrame::residualsLoaded()
+{
+    mIsLoaded = true;
+    auto result = mResidualWatcher.result();
+    setSummaries(result.Primal, result.Dual);
+}
+
+void ResidualsViewFrame::setupUi()
+{
+    mInfoLabel = new QLabel(this);
+    auto controls = new QHBoxLayout;
+    controls->addWidget(mInfoLabel);
+    controls->addStretch();
+
+    mResidualModel = new ResidualModel(this);
+    mResidualView = newTableView(mResidualModel, 4);
+    mResidualView->setToolTip(QString("Residual |A x - level| of the linear rows and violation of the "
+                                      "right-hand side by the level, tolerance %1")
+                              .arg(PrimalResidual::Tolerance));
+    mDualModel = new DualResidualModel(this);
+    mDualView = newTableView(mDualModel, 5);
+    mDualView->setToolTip(QString("Mismatch |c - A^T y - marginal| of the variable marginals and the "
+                                  "equation marginals y, tolerance %1")
+                          .arg(DualResidual::Tolerance));
+    mTabWidget = new QTabWidget(this);
+    mTabWidget->addTab(mResidualView, "Primal");
+    mTabWidget->addTab(mDualView, "Dual");
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(controls);
+    layout->addWidget(mTabWidget);
+    connect(&mResidualWatcher, &QFutureWatcher<Result>::finished,
+            this, &ResidualsViewFrame::residualsLoaded);
+}
+
+QTableView *ResidualsViewFrame::newTableView(QAbstractItemModel *model, int sortColumn)
+{
+    auto proxyModel = new QSortFilterProxyModel(this);
+    proxyModel->setSourceModel(model);
+    proxyModel->setSortRole(Qt::UserRole);
+    auto view = new QTableView(this);
+    view->setModel(proxyModel);
+    view->setSortingEnabled(true);
+    view->sortByColumn(sortColumn, Qt::DescendingOrder);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->verticalHeader()->setVisible(false);
+    view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view->horizontalHeader()->setStretchLastSection(true);
+    return view;
+}
+
+void ResidualsViewFrame::setSummaries(const QVector<ResidualSummary> &summaries,
+                                      const QVector<DualSummary> &dualSummaries)
+{
+    mSummaries.clear();
+    for (const auto& summary : summaries) {
+        if (summary.Rows || summary.NonlinearRows)
+            mSummaries.append(summary);
+    }
+    mDualSummaries.clear();
+    for (const auto& summary : dualSummaries) {
+        if (summary.Columns || summary.SkippedColumns)
+            mDualSummaries.append(summary);
+    }
+    mResidualModel->setSummaries(mModelInstance, mSummaries);
+    mResidualView->resizeColumnsToContents();
+    mDualModel->setSummaries(mModelInstance, mDualSummaries);
+    mDualView->resizeColumnsToContents();
+    if (!mIsLoaded) {
+        mInfoLabel->clear();
+        return;
+    }
+    if (!mModelInstance->useOutput()) {
+        mInfoLabel->setText("Use the output data to check the residuals of the solution.");
+        return;
+    }
+    mInfoLabel->setText(primalText() + "; " + dualText());
+}
+
+QString ResidualsViewFrame::primalText() const
+{
+    int rows = 0, violations = 0;
+    auto worst = mSummaries.cend();
+    for (auto summary=mSummaries.cbegin(); summary!=mSummaries.cend(); ++summary) {
+        rows += summary->Rows;
+        violations += summary->Violations;
+        if (summary->Rows && (worst == mSummaries.cend() || summary->MaxResidual > worst->MaxResidual))
+            worst = summary;
+    }
+    if (worst == mSummaries.cend())
+        return "No linear rows to check";
+    return QString("%1 linear rows checked, %2 violated, largest residual %3")
+            .arg(rows).arg(violations)
+            .arg(DoubleFormatter::format(worst->MaxResidual, DoubleFormatter::g, 6, true));
+}
+
+QString ResidualsViewFrame::dualText() const
+{
+    int columns = 0, mismatches = 0;
+    auto worst = mDualSummaries.cend();
+    for (auto summary=mDualSummaries.cbegin(); summary!=mDualSummaries.cend(); ++summary) {
+        columns += summary->Columns;
+        mismatches += summary->Mismatches;
+        if (summary->Columns && (worst == mDualSummaries.cend() || summary->MaxMismatch > worst->MaxMismatch))
+            worst = summary;
+    }
+    if (worst == mDualSummaries.cend())
+        return "no columns to check";
+    return QString("%1 columns checked, %2 reduced cost mismatches, largest %3")
+            .arg(columns).arg(mismatches)
+            .arg(DoubleFormatter::format(worst->MaxMismatch, DoubleFormatter::g, 6, true));
+}
+
+}
+}
+}
@@ -0,0 +1,185 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef RESIDUALSVIEWFRAME_H
+#define RESIDUALSVIEWFRAME_H
+
+#include "abstractviewframe.h"
+#include "dualresidual.h"
+#include "primalresidual.h"
+
+#include <QAbstractTableModel>
+#include <QFutureWatcher>
+
+class QLabel;
+class QSortFilterProxyModel;
+class QTabWidget;
+class QTableView;
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief One row per equation symbol with a ResidualSummary.
+///
+class ResidualModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    ResidualModel(QObject *parent = nullptr);
+
+    void setSummaries(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                      const QVector<ResidualSummary> &summaries);
+
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+private:
+    QString rowText(int row) const;
+
+private:
+    const QStringList mHeaderData { "Equation", "Rows", "Nonlinear", "Max residual", "Relative",
+                                    "Worst row", "Violations", "Max violation", "Worst violated row" };
+    QSharedPointer<AbstractModelInstance> mModelInstance;
+    QVector<ResidualSummary> mSummaries;
+};
+
+///
+/// \brief One row per variable symbol with a DualSummary.
+///
+class DualResidualModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    DualResidualModel(QObject *parent = nullptr);
+
+    void setSummaries(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                      const QVector<DualSummary> &summaries);
+
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+private:
+    QString columnText(int column) const;
+
+private:
+    const QStringList mHeaderData { "Variable", "Columns", "Skipped", "Mismatches", "Max mismatch",
+                                    "Relative", "Worst column", "c - A^T y", "Marginal" };
+    QSharedPointer<AbstractModelInstance> mModelInstance;
+    QVector<DualSummary> mSummaries;
+};
+
+///
+/// \brief Primal residuals and reduced cost mismatches of the solution,
+///        computed by PrimalResidual and DualResidual on a worker thread.
+///
+class ResidualsViewFrame final : public AbstractViewFrame
+{
+    Q_OBJECT
+
+public:
+    ResidualsViewFrame(QWidget *parent = nullptr,
+                       Qt::WindowFlags f = Qt::WindowFlags());
+
+    ResidualsViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                       const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                       QWidget *parent = nullptr,
+                       Qt::WindowFlags f = Qt::WindowFlags());
+
+    ~ResidualsViewFrame() override;
+
+    AbstractViewFrame* clone(int viewId) override;
+
+    void setShowAbsoluteValues(bool absoluteValues) override;
+
+    inline ViewHelper::ViewDataType type() const override
+    {
+        return ViewHelper::ViewDataType::Residuals;
+    }
+
+    void zoomIn() override;
+
+    void zoomOut() override;
+
+    void resetZoom() override;
+
+    SearchResult& search(const QString &term, bool isRegEx) override;
+
+    void setSearchSelection(const SearchResult::SearchEntry &result) override;
+
+    void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
+
+    bool hasData() const override;
+
+private slots:
+    void residualsLoaded();
+
+private:
+    struct Result
+    {
+        QVector<ResidualSummary> Primal;
+        QVector<DualSummary> Dual;
+    };
+
+    void setupUi();
+
+    QTableView* newTableView(QAbstractItemModel *model, int sortColumn);
+
+    void setSummaries(const QVector<ResidualSummary> &summaries,
+                      const QVector<DualSummary> &dualSummaries);
+
+    QString primalText() const;
+
+    QString dualText() const;
+
+private:
+    QLabel *mInfoLabel;
+    QTabWidget *mTabWidget;
+    QTableView *mResidualView;
+    QTableView *mDualView;
+    ResidualModel *mResidualModel;
+    DualResidualModel *mDualModel;
+    QVector<ResidualSummary> mSummaries;
+    QVector<DualSummary> mDualSummaries;
+    bool mIsLoaded = false;
+    QFutureWatcher<Result> mResidualWatcher;
+};
+
+}
+}
+}
+
+#endif // RESIDUALSVIEWFRAME_H
@@ -0,0 +1,348 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "scalingadvisor.h"
+#include "datamatrix.h"
+#include "symbol.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief log2 |a| of all nonzero coefficients in compressed row and
+///        compressed column form.
+///
+struct LogMatrix
+{
+    int Rows = 0;
+    int Columns = 0;
+
+    QVector<qint64> RowStart;
+    QVector<int> ColumnIndex;
+    QVector<float> RowValues;
+
+    QVector<qint64> ColumnStart;
+    QVector<int> RowIndex;
+    QVector<float> ColumnValues;
+
+    qint64 nonZeros() const
+    {
+        return RowStart.isEmpty() ? 0 : RowStart.constLast();
+    }
+};
+
+struct SectionBlock
+{
+    int First = 0;
+    int Last = -1;
+    double Minimum = std::numeric_limits<double>::max();
+    double Maximum = std::numeric_limits<double>::lowest();
+};
+
+static const int SectionsPerBlock = 1024;
+
+static QVector<SectionBlock> blocks(int sections)
+{
+    QVector<SectionBlock> blocks;
+    for (int first=0; first<sections; first+=SectionsPerBlock) {
+        SectionBlock block;
+        block.First = first;
+        block.Last = std::min(first+SectionsPerBlock, sections)-1;
+        blocks.append(block);
+    }
+    return blocks;
+}
+
+static void buildLogMatrix(DataMatrix &matrix, bool useOutput, LogMatrix &log)
+{
+    log.Rows = matrix.rowCount();
+    log.Columns = matrix.columnCount();
+    log.RowStart.fill(0, log.Rows+1);
+    auto rowBlocks = blocks(log.Rows);
+    qint64 *rowStart = log.RowStart.data();
+    auto values = matrix.values(useOutput);
+    QtConcurrent::blockingMap(rowBlocks, [&matrix, &values, rowStart](SectionBlock &block) {
+        for (int r=block.First; r<=block.Last; ++r) {
+            auto row = matrix.row(r);
+            auto data = values.row(r);
+            if (!data)
+                continue;
+            qint64 count = 0;
+            for (int e=0; e<row->entries(); ++e) {
+                const double value = std::fabs(data[e]);
+                count += value > 0.0 && std::isfinite(value);
+            }
+            rowStart[r+1] = count;
+        }
+    });
+    for (int r=0; r<log.Rows; ++r)
+        rowStart[r+1] += rowStart[r];
+    log.ColumnIndex.resize(log.nonZeros());
+    log.RowValues.resize(log.nonZeros());
+    int *columnIndex = log.ColumnIndex.data();
+    float *rowValues = log.RowValues.data();
+    const int columns = log.Columns;
+    QtConcurrent::blockingMap(rowBlocks, [&matrix, &values, columns, rowStart,
+                                          columnIndex, rowValues](SectionBlock &block) {
+        for (int r=block.First; r<=block.Last; ++r) {
+            auto row = matrix.row(r);
+            auto data = values.row(r);
+            if (!data)
+                continue;
+            qint64 index = rowStart[r];
+            const int *colIdx = row->colIdx();
+            for (int e=0; e<row->entries(); ++e) {
+                const double value = std::fabs(data[e]);
+                if (value > 0.0 && std::isfinite(value) && colIdx[e] < columns) {
+                    columnIndex[index] = colIdx[e];
+                    rowValues[index++] = float(std::log2(value));
+                }
+            }
+            for (; index<rowStart[r+1]; ++index) {
+                columnIndex[index] = 0;
+                rowValues[index] = std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+    });
+
+    log.ColumnStart.fill(0, log.Columns+1);
+    qint64 *columnStart = log.ColumnStart.data();
+    for (qint64 i=0; i<log.nonZeros(); ++i)
+        if (!std::isnan(rowValues[i]))
+            ++columnStart[columnIndex[i]+1];
+    for (int c=0; c<log.Columns; ++c)
+        columnStart[c+1] += columnStart[c];
+    log.RowIndex.resize(log.ColumnStart.constLast());
+    log.ColumnValues.resize(log.ColumnStart.constLast());
+    QVector<qint64> next(log.ColumnStart.begin(), log.ColumnStart.end()-1);
+    for (int r=0; r<log.Rows; ++r) {
+        for (qint64 i=rowStart[r]; i<rowStart[r+1]; ++i) {
+            if (std::isnan(rowValues[i]))
+                continue;
+            const qint64 index = next[columnIndex[i]]++;
+            log.RowIndex[index] = r;
+            log.ColumnValues[index] = rowValues[i];
+        }
+    }
+}
+
+///
+/// \brief Scale every section of a compressed matrix by the geometric mean
+///        of its largest and smallest coefficient.
+/// \param start Section start offsets of the compressed matrix.
+/// \param other Scales of the other dimension, read only.
+/// \param scales Scales of the sections, written.
+///
+static void scalingPass(const QVector<qint64> &start,
+                        const QVector<int> &index,
+                        const QVector<float> &values,
+                        const QVector<double> &other,
+                        QVector<double> &scales)
+{
+    auto sectionBlocks = blocks(scales.size());
+    const qint64 *starts = start.constData();
+    const int *indices = index.constData();
+    const float *logs = values.constData();
+    const double *otherScales = other.constData();
+    double *result = scales.data();
+    QtConcurrent::blockingMap(sectionBlocks, [starts, indices, logs,
+                                              otherScales, result](SectionBlock &block) {
+        for (int s=block.First; s<=block.Last; ++s) {
+            double minimum = std::numeric_limits<double>::max();
+            double maximum = std::numeric_limits<double>::lowest();
+            for (qint64 i=starts[s]; i<starts[s+1]; ++i) {
+                if (std::isnan(logs[i]))
+                    continue;
+                const double value = logs[i] + otherScales[indices[i]];
+                minimum = std::min(minimum, value);
+                maximum = std::max(maximum, value);
+            }
+            result[s] = minimum <= maximum ? -(minimum + maximum) / 2.0 : 0.0;
+        }
+    });
+}
+
+///
+/// \brief log2(max/min) of the scaled coefficients.
+///
+static double spread(const LogMatrix &log,
+                     const QVector<double> &rowScales,
+                     const QVector<double> &columnScales)
+{
+    auto rowBlocks = blocks(log.Rows);
+    const qint64 *starts = log.RowStart.constData();
+    const int *indices = log.ColumnIndex.constData();
+    const float *logs = log.RowValues.constData();
+    const double *rows = rowScales.constData();
+    const double *columns = columnScales.constData();
+    QtConcurrent::blockingMap(rowBlocks, [starts, indices, logs, rows, columns](SectionBlock &block) {
+        for (int r=block.First; r<=block.Last; ++r) {
+            for (qint64 i=starts[r]; i<starts[r+1]; ++i) {
+                if (std::isnan(logs[i]))
+                    continue;
+                const double value = logs[i] + rows[r] + columns[indices[i]];
+                block.Minimum = std::min(block.Minimum, value);
+                block.Maximum = std::max(block.Maximum, value);
+            }
+        }
+    });
+    double minimum = std::numeric_limits<double>::max();
+    double maximum = std::numeric_limits<double>::lowest();
+    for (const auto& block : std::as_const(rowBlocks)) {
+        minimum = std::min(minimum, block.Minimum);
+        maximum = std::max(maximum, block.Maximum);
+    }
+    return minimum <= maximum ? maximum - minimum : 0.0;
+}
+
+static double validScale(const QVector<double> &scales, int index)
+{
+    if (index >= scales.size())
+        return 1.0;
+    const double scale = scales.at(index);
+    return scale > 0.0 && std::isfinite(scale) ? scale : 1.0;
+}
+
+static QVector<double> logScales(const QVector<double> &scales, int count, double sign)
+{
+    QVector<double> logs(count, 0.0);
+    for (int i=0; i<count; ++i)
+        logs[i] = sign * std::log2(validScale(scales, i));
+    return logs;
+}
+
+static double ratio(double spread)
+{
+    return std::exp2(spread);
+}
+
+QSharedPointer<ScalingAdvice> ScalingAdvisor::run(DataMatrix &matrix,
+                                                  bool useOutput,
+                                                  const QVector<double> &equationScales,
+                                                  const QVector<double> &variableScales,
+                                                  const Options &options)
+{
+    auto advice = QSharedPointer<ScalingAdvice>(new ScalingAdvice);
+    LogMatrix log;
+    buildLogMatrix(matrix, useOutput, log);
+    advice->NonZeros = log.ColumnStart.constLast();
+    advice->CurrentEquationScales.resize(log.Rows);
+    for (int r=0; r<log.Rows; ++r)
+        advice->CurrentEquationScales[r] = validScale(equationScales, r);
+    advice->CurrentVariableScales.resize(log.Columns);
+    for (int c=0; c<log.Columns; ++c)
+        advice->CurrentVariableScales[c] = validScale(variableScales, c);
+    advice->EquationScales = advice->CurrentEquationScales;
+    advice->VariableScales = advice->CurrentVariableScales;
+    if (advice->isEmpty())
+        return advice;
+
+    QVector<double> rowScales(log.Rows, 0.0);
+    QVector<double> columnScales(log.Columns, 0.0);
+    double best = spread(log, rowScales, columnScales);
+    advice->UnscaledRatio = ratio(best);
+    advice->CurrentRatio = ratio(spread(log,
+                                       logScales(equationScales, log.Rows, -1.0),
+                                       logScales(variableScales, log.Columns, 1.0)));
+
+    QVector<double> bestRows = rowScales;
+    QVector<double> bestColumns = columnScales;
+    for (int pass=0; pass<options.MaxPasses; ++pass) {
+        scalingPass(log.RowStart, log.ColumnIndex, log.RowValues, columnScales, rowScales);
+        scalingPass(log.ColumnStart, log.RowIndex, log.ColumnValues, rowScales, columnScales);
+        const double current = spread(log, rowScales, columnScales);
+        if (best - current < options.Tolerance)
+            break;
+        best = current;
+        bestRows = rowScales;
+        bestColumns = columnScales;
+        advice->Passes = pass+1;
+    }
+
+    for (int r=0; r<log.Rows; ++r) {
+        advice->EquationScales[r] = round(std::exp2(-bestRows.at(r)), options.Round);
+        bestRows[r] = -std::log2(advice->EquationScales.at(r));
+    }
+    for (int c=0; c<log.Columns; ++c) {
+        advice->VariableScales[c] = round(std::exp2(bestColumns.at(c)), options.Round);
+        bestColumns[c] = std::log2(advice->VariableScales.at(c));
+    }
+    advice->SuggestedRatio = ratio(spread(log, bestRows, bestColumns));
+    return advice;
+}
+
+double ScalingAdvisor::round(double scale, Rounding rounding)
+{
+    if (!(scale > 0.0) || !std::isfinite(scale))
+        return 1.0;
+    switch (rounding) {
+    case PowerOfTwo:
+        return std::exp2(std::round(std::log2(scale)));
+    case PowerOfTen:
+        return std::pow(10.0, std::round(std::log10(scale)));
+    default:
+        return scale;
+    }
+}
+
+QVector<ScalingAdvisor::SymbolScale> ScalingAdvisor::symbolScales(const QVector<Symbol*> &symbols,
+                                                                  const QVector<double> &current,
+                                                                  const QVector<double> &suggested,
+                                                                  Rounding rounding)
+{
+    QVector<SymbolScale> scales;
+    scales.reserve(symbols.size());
+    for (auto symbol : symbols) {
+        SymbolScale scale;
+        scale.Sym = symbol;
+        double currentLog = 0.0;
+        double suggestedLog = 0.0;
+        double minimum = std::numeric_limits<double>::max();
+        double maximum = std::numeric_limits<double>::lowest();
+        int count = 0;
+        const int last = std::min(symbol->lastSection(), int(suggested.size())-1);
+        for (int s=symbol->firstSection(); s>=0 && s<=last; ++s, ++count) {
+            currentLog += std::log2(validScale(current, s));
+            const double value = validScale(suggested, s);
+            suggestedLog += std::log2(value);
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+        }
+        if (count) {
+            scale.Current = std::exp2(currentLog / count);
+            scale.Suggested = round(std::exp2(suggestedLog / count), rounding);
+            scale.Minimum = minimum;
+            scale.Maximum = maximum;
+        }
+        scales.append(scale);
+    }
+    return scales;
+}
+
+}
+}
+}
@@ -0,0 +1,156 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef SCALINGADVISOR_H
+#define SCALINGADVISOR_H
+
+#include <QSharedPointer>
+#include <QVector>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class DataMatrix;
+class Symbol;
+
+///
+/// \brief Suggested scale factors of all equations and variables.
+///
+/// The scales follow the GAMS <c>.scale</c> semantics: an equation is
+/// divided by its scale and a variable is multiplied by its scale, i.e.
+/// a scaled coefficient is <c>a_ij * varScale_j / equScale_i</c>.
+///
+struct ScalingAdvice
+{
+    ///
+    /// \brief Number of geometric mean passes.
+    ///
+    int Passes = 0;
+
+    qint64 NonZeros = 0;
+
+    ///
+    /// \brief Ratio max |a| / min |a| of the unscaled Jacobian.
+    ///
+    double UnscaledRatio = 1.0;
+
+    ///
+    /// \brief Ratio max |a| / min |a| with the current <c>.scale</c> values.
+    ///
+    double CurrentRatio = 1.0;
+
+    ///
+    /// \brief Ratio max |a| / min |a| with the suggested scales.
+    ///
+    double SuggestedRatio = 1.0;
+
+    QVector<double> CurrentEquationScales;
+    QVector<double> CurrentVariableScales;
+    QVector<double> EquationScales;
+    QVector<double> VariableScales;
+
+    bool isEmpty() const
+    {
+        return !NonZeros;
+    }
+};
+
+///
+/// \brief Iterative geometric mean scaling of the Jacobian.
+///
+/// Every pass first scales each row by the geometric mean of its
+/// largest and smallest scaled coefficient, then each column in the same
+/// way. The passes work on log2 |a|: the rows use the row-sparse data and
+/// the columns a transposed copy built by the advisor. Both are split
+/// into blocks that run in parallel. The passes stop when the max/min
+/// ratio doesn't improve anymore.
+///
+class ScalingAdvisor final
+{
+public:
+    enum Rounding
+    {
+        NoRounding,
+        PowerOfTwo,
+        PowerOfTen
+    };
+
+    struct Options
+    {
+        int MaxPasses = 10;
+
+        ///
+        /// \brief Minimum improvement of log2(max/min) per pass.
+        ///
+        double Tolerance = 1e-3;
+
+        Rounding Round = PowerOfTwo;
+    };
+
+    struct SymbolScale
+    {
+        Symbol *Sym = nullptr;
+
+        ///
+        /// \brief Geometric mean of the current scales of all entries.
+        ///
+        double Current = 1.0;
+
+        ///
+        /// \brief Geometric mean of the suggested scales of all entries.
+        ///
+        double Suggested = 1.0;
+
+        double Minimum = 1.0;
+        double Maximum = 1.0;
+    };
+
+    ///
+    /// \brief Compute the suggested scales for <c>matrix</c>.
+    /// \param useOutput Use the output (evaluated) coefficients if available.
+    /// \param equationScales Current equation scales, may be empty.
+    /// \param variableScales Current variable scales, may be empty.
+    ///
+    static QSharedPointer<ScalingAdvice> run(DataMatrix &matrix,
+                                             bool useOutput,
+                                             const QVector<double> &equationScales,
+                                             const QVector<double> &variableScales,
+                                             const Options &options);
+
+    ///
+    /// \brief Round <c>scale</c> to the nearest power of two or ten.
+    ///
+    static double round(double scale, Rounding rounding);
+
+    ///
+    /// \brief One suggestion per symbol, for a single <c>x.scale</c>
+    ///        assignment instead of one per entry.
+    ///
+    static QVector<SymbolScale> symbolScales(const QVector<Symbol*> &symbols,
+                                             const QVector<double> &current,
+                                             const QVector<double> &suggested,
+                                             Rounding rounding);
+};
+
+}
+}
+}
+
+#endif // SCALINGADVISOR_H
@@ -0,0 +1,335 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "scalingadvisorviewframe.h"
+#include "abstractmodelinstance.h"
+#include "numerics.h"
+
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QSortFilterProxyModel>
+#include <QTabWidget>
+#include <QTableView>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+ScalingAdviceModel::ScalingAdviceModel(Mode mode, QObject *parent)
+    : QAbstractTableModel(parent)
+    , mMode(mode)
+{
+
+}
+
+void ScalingAdviceModel::setAdvice(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                   const QSharedPointer<ScalingAdvice> &advice,
+                                   ScalingAdvisor::Rounding rounding)
+{
+    beginResetModel();
+    mModelInstance = modelInstance;
+    mAdvice = advice;
+    mSymbolScales.clear();
+    if (mMode == SymbolMode && mAdvice && !mAdvice->isEmpty()) {
+        mSymbolScales = ScalingAdvisor::symbolScales(mModelInstance->equations(),
+                                                     mAdvice->CurrentEquationScales,
+                                                     mAdvice->EquationScales,
+                                                     rounding);
+        mSymbolScales.append(ScalingAdvisor::symbolScales(mModelInstance->variables(),
+                                                          mAdvice->CurrentVariableScales,
+                                                          mAdvice->VariableScales,
+                                                          rounding));
+    }
+    endResetModel();
+}
+
+QVariant ScalingAdviceModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+    if (role != Qt::DisplayRole && role != Qt::UserRole && role != Qt::TextAlignmentRole)
+        return QVariant();
+    if (mMode == SymbolMode)
+        return symbolData(index.row(), index.column(), role);
+    return entryData(index.row(), index.column(), role);
+}
+
+QVariant ScalingAdviceModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
+        return mMode == SymbolMode ? mSymbolHeaderData.at(section) : mEntryHeaderData.at(section);
+    }
+    return QVariant();
+}
+
+int ScalingAdviceModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return mMode == SymbolMode ? mSymbolHeaderData.size() : mEntryHeaderData.size();
+}
+
+int ScalingAdviceModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    if (!mAdvice || mAdvice->isEmpty())
+        return 0;
+    if (mMode == SymbolMode)
+        return mSymbolScales.size();
+    return mAdvice->EquationScales.size() + mAdvice->VariableScales.size();
+}
+
+QVariant ScalingAdviceModel::symbolData(int row, int column, int role) const
+{
+    if (row >= mSymbolScales.size())
+        return QVariant();
+    const auto& scale = mSymbolScales.at(row);
+    if (role == Qt::TextAlignmentRole)
+        return column < 2 ? QVariant() : QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    switch (column) {
+    case 0:
+        return scale.Sym->name();
+    case 1:
+        return scale.Sym->isEquation() ? ViewHelper::EquationHeaderText : ViewHelper::VariableHeaderText;
+    case 2:
+        return scale.Sym->entries();
+    default:
+        break;
+    }
+    double value = column == 3 ? scale.Current :
+                   column == 4 ? scale.Suggested :
+                   column == 5 ? scale.Minimum : scale.Maximum;
+    if (role == Qt::UserRole)
+        return value;
+    return DoubleFormatter::format(value, DoubleFormatter::g, 6, true);
+}
+
+QVariant ScalingAdviceModel::entryData(int row, int column, int role) const
+{
+    const int equations = mAdvice->EquationScales.size();
+    const bool isEquation = row < equations;
+    const int section = isEquation ? row : row - equations;
+    if (role == Qt::TextAlignmentRole)
+        return column < 2 ? QVariant() : QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    switch (column) {
+    case 0: {
+        auto symbol = isEquation ? mModelInstance->equation(section)
+                                 : mModelInstance->variable(section);
+        if (!symbol)
+            return QVariant();
+        if (symbol->isScalar())
+            return symbol->name();
+        auto labels = std::as_const(symbol->sectionLabels()).value(section);
+        return QString("%1(%2)").arg(symbol->name(), labels.join(","));
+    }
+    case 1:
+        return isEquation ? ViewHelper::EquationHeaderText : ViewHelper::VariableHeaderText;
+    default:
+        break;
+    }
+    double value = isEquation ? (column == 2 ? mAdvice->CurrentEquationScales.at(section)
+                                             : mAdvice->EquationScales.at(section))
+                              : (column == 2 ? mAdvice->CurrentVariableScales.at(section)
+                                             : mAdvice->VariableScales.at(section));
+    if (role == Qt::UserRole)
+        return value;
+    return DoubleFormatter::format(value, DoubleFormatter::g, 6, true);
+}
+
+ScalingAdvisorViewFrame::ScalingAdvisorViewFrame(QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::defaultConfiguration());
+    setupUi();
+}
+
+ScalingAdvisorViewFrame::ScalingAdvisorViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                                 const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                                                 QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mModelInstance = modelInstance;
+    mViewConfig = viewConfig;
+    setupUi();
+}
+
+ScalingAdvisorViewFrame::~ScalingAdvisorViewFrame()
+{
+    mAdviceWatcher.waitForFinished();
+}
+
+AbstractViewFrame *ScalingAdvisorViewFrame::clone(int viewId)
+{
+    auto viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
+                                                                                                         mModelInstance));
+    viewConfig->setViewId(viewId);
+    auto frame = new ScalingAdvisorViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    frame->mRoundingBox->blockSignals(true);
+    frame->mRoundingBox->setCurrentIndex(mRoundingBox->currentIndex());
+    frame->mRoundingBox->blockSignals(false);
+    if (mAdviceWatcher.isRunning())
+        frame->setupView(mModelInstance);
+    else
+        frame->setAdvice(mAdvice);
+    return frame;
+}
+
+void ScalingAdvisorViewFrame::setShowAbsoluteValues(bool absoluteValues)
+{// scales are always positive
+    Q_UNUSED(absoluteValues);
+}
+
+void ScalingAdvisorViewFrame::zoomIn()
+{
+    for (auto view : { mSymbolView, mEntryView }) {
+        QFont font = view->font();
+        font.setPointSize(font.pointSize() + ViewHelper::ZoomFactor);
+        view->setFont(font);
+    }
+}
+
+void ScalingAdvisorViewFrame::zoomOut()
+{
+    for (auto view : { mSymbolView, mEntryView }) {
+        QFont font = view->font();
+        if (font.pointSize() <= ViewHelper::ZoomFactor)
+            continue;
+        font.setPointSize(font.pointSize() - ViewHelper::ZoomFactor);
+        view->setFont(font);
+    }
+}
+
+void ScalingAdvisorViewFrame::resetZoom()
+{
+    mSymbolView->setFont(font());
+    mEntryView->setFont(font());
+}
+
+SearchResult &ScalingAdvisorViewFrame::search(const QString &term, bool isRegEx)
+{
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = isRegEx;
+    mViewConfig->searchResult().Entries.clear();
+    return mViewConfig->searchResult();
+}
+
+void ScalingAdvisorViewFrame::setSearchSelection(const SearchResult::SearchEntry &result)
+{
+    Q_UNUSED(result);
+}
+
+void ScalingAdvisorViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &modelInstance)
+{
+    mModelInstance = modelInstance;
+    setAdvice(QSharedPointer<ScalingAdvice>());
+    mInfoLabel->setText("Computing scales...");
+    auto rounding = this->rounding();
+    auto loadAdvice = [modelInstance, rounding]{
+        return modelInstance->scalingAdvice(rounding);
+    };
+    mAdviceWatcher.setFuture(QtConcurrent::run(loadAdvice));
+}
+
+bool ScalingAdvisorViewFrame::hasData() const
+{
+    return mAdviceWatcher.isRunning() || (mAdvice && !mAdvice->isEmpty());
+}
+
+void ScalingAdvisorViewFrame::adviceLoaded()
+{
+    setAdvice(mAdviceWatcher.result());
+}
+
+void ScalingAdvisorViewFrame::setupUi()
+{
+    mRoundingBox = new QComboBox(this);
+    mRoundingBox->addItem("Power of 2", ScalingAdvisor::PowerOfTwo);
+    mRoundingBox->addItem("Power of 10", ScalingAdvisor::PowerOfTen);
+    mRoundingBox->addItem("None", ScalingAdvisor::NoRounding);
+    mRoundingBox->setToolTip("Rounding of the suggested scales, powers of 2 don't introduce rounding errors");
+    mInfoLabel = new QLabel(this);
+    auto controls = new QHBoxLayout;
+    controls->addWidget(new QLabel("Rounding", this));
+    controls->addWidget(mRoundingBox);
+    controls->addStretch();
+    controls->addWidget(mInfoLabel);
+
+    mSymbolModel = new ScalingAdviceModel(ScalingAdviceModel::SymbolMode, this);
+    auto symbolProxy = new QSortFilterProxyModel(this);
+    symbolProxy->setSourceModel(mSymbolModel);
+    symbolProxy->setSortRole(Qt::UserRole);
+    mSymbolView = new QTableView(this);
+    mSymbolView->setModel(symbolProxy);
+    mSymbolView->setSortingEnabled(true);
+    mSymbolView->sortByColumn(-1, Qt::AscendingOrder);
+    mEntryModel = new ScalingAdviceModel(ScalingAdviceModel::EntryMode, this);
+    mEntryView = new QTableView(this);
+    mEntryView->setModel(mEntryModel);
+    for (auto view : { mSymbolView, mEntryView }) {
+        view->setSelectionBehavior(QAbstractItemView::SelectRows);
+        view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        view->verticalHeader()->setVisible(false);
+        view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+        view->horizontalHeader()->setStretchLastSection(true);
+    }
+    auto tabs = new QTabWidget(this);
+    tabs->addTab(mSymbolView, "Symbols");
+    tabs->addTab(mEntryView, "Entries");
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(controls);
+    layout->addWidget(tabs);
+    connect(mRoundingBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this]{
+        if (mModelInstance)
+            setupView(mModelInstance);
+    });
+    connect(&mAdviceWatcher, &QFutureWatcher<QSharedPointer<ScalingAdvice>>::finished,
+            this, &ScalingAdvisorViewFrame::adviceLoaded);
+}
+
+void ScalingAdvisorViewFrame::setAdvice(const QSharedPointer<ScalingAdvice> &advice)
+{
+    mAdvice = advice;
+    mSymbolModel->setAdvice(mModelInstance, mAdvice, rounding());
+    mEntryModel->setAdvice(mModelInstance, mAdvice, rounding());
+    mSymbolView->resizeColumnsToContents();
+    if (!mAdvice || mAdvice->isEmpty()) {
+        mInfoLabel->setText(mAdvice ? "No Jacobian data available." : QString());
+        return;
+    }
+    mInfoLabel->setText(QString("max/min ratio: unscaled %1, current %2, suggested %3 (%4 passes)")
+                        .arg(DoubleFormatter::format(mAdvice->UnscaledRatio, DoubleFormatter::g, 6, true),
+                             DoubleFormatter::format(mAdvice->CurrentRatio, DoubleFormatter::g, 6, true),
+                             DoubleFormatter::format(mAdvice->SuggestedRatio, DoubleFormatter::g, 6, true))
+                        .arg(mAdvice->Passes));
+}
+
+ScalingAdvisor::Rounding ScalingAdvisorViewFrame::rounding() const
+{
+    return (ScalingAdvisor::Rounding)mRoundingBox->currentData().toInt();
+}
+
+}
+}
+}
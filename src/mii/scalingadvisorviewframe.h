@@ -0,0 +1,150 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef SCALINGADVISORVIEWFRAME_H
+#define SCALINGADVISORVIEWFRAME_H
+
+#include "abstractviewframe.h"
+#include "scalingadvisor.h"
+
+#include <QAbstractTableModel>
+#include <QFutureWatcher>
+
+class QComboBox;
+class QLabel;
+class QTableView;
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Suggested scales of a ScalingAdvice, either one row per
+///        symbol or one row per equation and variable entry.
+///
+class ScalingAdviceModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Mode
+    {
+        SymbolMode,
+        EntryMode
+    };
+
+    ScalingAdviceModel(Mode mode, QObject *parent = nullptr);
+
+    void setAdvice(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                   const QSharedPointer<ScalingAdvice> &advice,
+                   ScalingAdvisor::Rounding rounding);
+
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+private:
+    QVariant symbolData(int row, int column, int role) const;
+
+    QVariant entryData(int row, int column, int role) const;
+
+private:
+    const QStringList mSymbolHeaderData { "Name", "Type", "Entries", "Current", "Suggested",
+                                          "Minimum", "Maximum" };
+    const QStringList mEntryHeaderData { "Name", "Type", "Current", "Suggested" };
+    Mode mMode;
+    QSharedPointer<AbstractModelInstance> mModelInstance;
+    QSharedPointer<ScalingAdvice> mAdvice;
+    QVector<ScalingAdvisor::SymbolScale> mSymbolScales;
+};
+
+///
+/// \brief Suggested <c>.scale</c> values for all equations and variables,
+///        computed by the ScalingAdvisor on a worker thread.
+///
+class ScalingAdvisorViewFrame final : public AbstractViewFrame
+{
+    Q_OBJECT
+
+public:
+    ScalingAdvisorViewFrame(QWidget *parent = nullptr,
+                            Qt::WindowFlags f = Qt::WindowFlags());
+
+    ScalingAdvisorViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                            const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                            QWidget *parent = nullptr,
+                            Qt::WindowFlags f = Qt::WindowFlags());
+
+    ~ScalingAdvisorViewFrame() override;
+
+    AbstractViewFrame* clone(int viewId) override;
+
+    void setShowAbsoluteValues(bool absoluteValues) override;
+
+    inline ViewHelper::ViewDataType type() const override
+    {
+        return ViewHelper::ViewDataType::ScalingAdvisor;
+    }
+
+    void zoomIn() override;
+
+    void zoomOut() override;
+
+    void resetZoom() override;
+
+    SearchResult& search(const QString &term, bool isRegEx) override;
+
+    void setSearchSelection(const SearchResult::SearchEntry &result) override;
+
+    void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
+
+    bool hasData() const override;
+
+private slots:
+    void adviceLoaded();
+
+private:
+    void setupUi();
+
+    void setAdvice(const QSharedPointer<ScalingAdvice> &advice);
+
+    ScalingAdvisor::Rounding rounding() const;
+
+private:
+    QComboBox *mRoundingBox;
+    QLabel *mInfoLabel;
+    QTableView *mSymbolView;
+    QTableView *mEntryView;
+    ScalingAdviceModel *mSymbolModel;
+    ScalingAdviceModel *mEntryModel;
+    QSharedPointer<ScalingAdvice> mAdvice;
+    QFutureWatcher<QSharedPointer<ScalingAdvice>> mAdviceWatcher;
+};
+
+}
+}
+}
+
+#endif // SCALINGADVISORVIEWFRAME_H
@@ -24,29 +24,50 @@
 
 #include <QAbstractItemModel>
 #include <QRegularExpression>
+#include <QtConcurrent>
 
 #include <QDebug>
 
+#include <algorithm>
+#include <utility>
+
 namespace gams {
 namespace studio {
 namespace mii {
 
+static bool hasStaticHeader(ViewHelper::ViewDataType type)
+{
+    switch (type) {
+    case ViewHelper::ViewDataType::BP_Overview:
+    case ViewHelper::ViewDataType::BP_Count:
+    case ViewHelper::ViewDataType::BP_Average:
+    case ViewHelper::ViewDataType::BP_Scaling:
+        return true;
+    default:
+        return false;
+    }
+}
+
 Search::Search(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
                QAbstractItemModel *dataModel,
                const QString &term,
                bool isRegEx)
     : mViewConfig(viewConfig)
     , mDataModel(dataModel)
+    , mTerm(term)
+    , mIsRegEx(isRegEx)
 {
     mViewConfig->searchResult().Term = term;
     mViewConfig->searchResult().IsRegEx = isRegEx;
+    mViewConfig->searchResult().IsCoefficientRange = false;
+    mViewConfig->searchResult().CoefficientCount = 0;
     if (isRegEx) {
         QRegularExpression regex(term);
         compare = [regex](const QString &text) {
             return regex.match(text).hasMatch();
         };
     } else {
-        compare = [&term](const QString &text) {
+        compare = [term](const QString &text) {
             return text.contains(term, Qt::CaseInsensitive);
         };
     }
@@ -56,18 +77,12 @@ void Search::run()
 {
     if (!mDataModel)
         return;
-    switch (mViewConfig->viewType()) {
-    case ViewHelper::ViewDataType::BP_Overview:
-    case ViewHelper::ViewDataType::BP_Count:
-    case ViewHelper::ViewDataType::BP_Average:
-    case ViewHelper::ViewDataType::BP_Scaling:
+    if (hasStaticHeader(mViewConfig->viewType())) {
         searchStaticHeader(Qt::Horizontal);
         searchStaticHeader(Qt::Vertical);
-        break;
-    default:
+    } else {
         searchHeaderHierarchy(Qt::Horizontal);
         searchHeaderHierarchy(Qt::Vertical);
-        break;
     }
 }
 
@@ -91,6 +106,17 @@ void Search::searchHeaderHierarchy(Qt::Orientation orientation)
     bool ok = false;
     int sections = orientation == Qt::Horizontal ? mDataModel->columnCount() :
                                                    mDataModel->rowCount();
+    const auto& index = mViewConfig->modelInstance()->searchIndex(orientation == Qt::Horizontal ? Symbol::Variable
+                                                                                                : Symbol::Equation);
+    if (!index.isEmpty()) {
+        auto matches = mIsRegEx ? index.find(QRegularExpression(mTerm)) : index.find(mTerm);
+        for (int section=0; section<sections; ++section) {
+            int realSection = mDataModel->headerData(section, orientation).toInt(&ok);
+            if (ok && realSection >= 0 && realSection < matches.size() && matches.testBit(realSection))
+                mViewConfig->searchResult().Entries.append(SearchResult::SearchEntry{section, orientation});
+        }
+        return;
+    }
     for (int section=0; section<sections; ++section) {
         int realSection = mDataModel->headerData(section, orientation).toInt(&ok);
         if (!ok) continue;
@@ -115,6 +141,294 @@ void Search::searchHeaderHierarchy(int logicalIndex, int sectionIndex, Qt::Orien
     }
 }
 
+RegExSearch::RegExSearch(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                         QAbstractItemModel *dataModel,
+                         const QString &term,
+                         QObject *parent)
+    : QObject(parent)
+    , mViewConfig(viewConfig)
+    , mDataModel(dataModel)
+    , mRegex(term)
+{
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = true;
+    mViewConfig->searchResult().IsCoefficientRange = false;
+    mViewConfig->searchResult().CoefficientCount = 0;
+    mViewConfig->searchResult().Entries.clear();
+    mRegex.optimize();
+    connect(&mWatcher, &QFutureWatcher<void>::finished,
+            this, &RegExSearch::searchFinished);
+}
+
+RegExSearch::~RegExSearch()
+{
+    cancel();
+    mWatcher.waitForFinished();
+}
+
+void RegExSearch::start()
+{
+    if (isRunning())
+        return;
+    if (!mDataModel || !mRegex.isValid() || mRegex.pattern().isEmpty()) {
+        emit finished(false);
+        return;
+    }
+    mCanceled = false;
+    mModelInstance = mViewConfig->modelInstance();
+    mStaticHeader = hasStaticHeader(mViewConfig->viewType());
+    mChunks.clear();
+    prepare(Qt::Horizontal);
+    prepare(Qt::Vertical);
+    mWatcher.setFuture(QtConcurrent::run([this]{
+        matchIndex(Qt::Horizontal);
+        matchIndex(Qt::Vertical);
+        QtConcurrent::blockingMap(mChunks, [this](const Chunk &chunk) {
+            searchChunk(chunk);
+        });
+    }));
+}
+
+void RegExSearch::cancel()
+{
+    mCanceled = true;
+    mWatcher.cancel();
+}
+
+bool RegExSearch::isRunning() const
+{
+    return mWatcher.isRunning();
+}
+
+const SearchResult &RegExSearch::result() const
+{
+    return mViewConfig->searchResult();
+}
+
+QList<SearchResult::SearchEntry> RegExSearch::indexEntries(const QBitArray &matches,
+                                                           const QVector<int> &sections,
+                                                           int first, int last,
+                                                           Qt::Orientation orientation)
+{
+    QList<SearchResult::SearchEntry> entries;
+    for (int section=std::max(0, first); section<=last && section<sections.size(); ++section) {
+        int realSection = sections.at(section);
+        if (realSection >= 0 && realSection < matches.size() && matches.testBit(realSection))
+            entries.append(SearchResult::SearchEntry{section, orientation});
+    }
+    return entries;
+}
+
+void RegExSearch::searchFinished()
+{
+    auto& entries = mViewConfig->searchResult().Entries;
+    std::sort(entries.begin(), entries.end(),
+              [](const SearchResult::SearchEntry &a, const SearchResult::SearchEntry &b) {
+        return a.Orientation != b.Orientation ? a.Orientation == Qt::Horizontal
+                                              : a.Index < b.Index;
+    });
+    emit finished(mCanceled);
+}
+
+void RegExSearch::prepare(Qt::Orientation orientation)
+{// the model is not thread-safe, thus the header data is collected up front
+    bool ok = false;
+    int sections = orientation == Qt::Horizontal ? mDataModel->columnCount()
+                                                 : mDataModel->rowCount();
+    auto& realSections = mSections[orientation == Qt::Horizontal ? 0 : 1];
+    auto& labels = mLabels[orientation == Qt::Horizontal ? 0 : 1];
+    realSections.clear();
+    labels.clear();
+    if (mStaticHeader) {
+        labels.reserve(sections);
+        for (int section=0; section<sections; ++section)
+            labels.append(mDataModel->headerData(section, orientation, ViewHelper::SectionLabelRole).toStringList());
+    } else {
+        realSections.reserve(sections);
+        for (int section=0; section<sections; ++section) {
+            int realSection = mDataModel->headerData(section, orientation).toInt(&ok);
+            realSections.append(ok ? realSection : -1);
+        }
+    }
+    for (int first=0; first<sections; first+=ChunkSize)
+        mChunks.append(Chunk{orientation, first, std::min(first+ChunkSize, sections)-1});
+}
+
+void RegExSearch::matchIndex(Qt::Orientation orientation)
+{
+    auto& matches = mMatches[orientation == Qt::Horizontal ? 0 : 1];
+    matches.clear();
+    if (mStaticHeader || mCanceled)
+        return;
+    const auto& index = mModelInstance->searchIndex(orientation == Qt::Horizontal ? Symbol::Variable
+                                                                                  : Symbol::Equation);
+    if (!index.isEmpty())
+        matches = index.find(mRegex);
+}
+
+void RegExSearch::searchChunk(const Chunk &chunk)
+{
+    const auto regex = mRegex;
+    const int orientation = chunk.Orientation == Qt::Horizontal ? 0 : 1;
+    if (!mStaticHeader && !mMatches[orientation].isEmpty()) {
+        auto entries = indexEntries(mMatches[orientation], mSections[orientation],
+                                    chunk.First, chunk.Last, chunk.Orientation);
+        if (entries.isEmpty() || mCanceled)
+            return;
+        QMetaObject::invokeMethod(this, [this, entries]{ appendEntries(entries); },
+                                  Qt::QueuedConnection);
+        return;
+    }
+    QList<SearchResult::SearchEntry> entries;
+    Symbol *symbol = nullptr;
+    bool nameMatch = false;
+    auto match = [&regex](const QStringList &labels) {
+        for (const auto& label : labels) {
+            if (regex.match(label).hasMatch())
+                return true;
+        }
+        return false;
+    };
+    for (int section=chunk.First; section<=chunk.Last && !mCanceled; ++section) {
+        if (mStaticHeader) {
+            if (match(mLabels[orientation].at(section)))
+                entries.append(SearchResult::SearchEntry{section, chunk.Orientation});
+            continue;
+        }
+        int realSection = mSections[orientation].at(section);
+        if (realSection < 0)
+            continue;
+        auto sym = chunk.Orientation == Qt::Horizontal ? mModelInstance->variable(realSection)
+                                                       : mModelInstance->equation(realSection);
+        if (!sym)
+            continue;
+        if (sym != symbol) {
+            symbol = sym;
+            nameMatch = regex.match(sym->name()).hasMatch();
+        }
+        if (nameMatch || match(std::as_const(sym->sectionLabels()).value(realSection)))
+            entries.append(SearchResult::SearchEntry{section, chunk.Orientation});
+    }
+    if (entries.isEmpty() || mCanceled)
+        return;
+    QMetaObject::invokeMethod(this, [this, entries]{ appendEntries(entries); },
+                              Qt::QueuedConnection);
+}
+
+void RegExSearch::appendEntries(const QList<SearchResult::SearchEntry> &entries)
+{
+    if (mCanceled)
+        return;
+    mViewConfig->searchResult().Entries.append(entries);
+    emit entriesFound(entries);
+}
+
+CoefficientRangeSearch::CoefficientRangeSearch(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                                               QAbstractItemModel *dataModel,
+                                               const QString &term,
+                                               QObject *parent)
+    : QObject(parent)
+    , mViewConfig(viewConfig)
+    , mDataModel(dataModel)
+    , mTerm(term)
+{
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = false;
+    mViewConfig->searchResult().IsCoefficientRange = true;
+    mViewConfig->searchResult().CoefficientCount = 0;
+    mViewConfig->searchResult().Entries.clear();
+    connect(&mWatcher, &QFutureWatcher<QVector<CoefficientHit>>::finished,
+            this, &CoefficientRangeSearch::searchFinished);
+}
+
+CoefficientRangeSearch::~CoefficientRangeSearch()
+{
+    cancel();
+    mWatcher.waitForFinished();
+}
+
+void CoefficientRangeSearch::start()
+{
+    if (isRunning())
+        return;
+    CoefficientSearch::Range range;
+    if (!mDataModel || hasStaticHeader(mViewConfig->viewType()) ||
+        !CoefficientSearch::parse(mTerm, range)) {
+        emit finished(false);
+        return;
+    }
+    mToken = CancellationToken();
+    auto modelInstance = mViewConfig->modelInstance();
+    // the model is not thread-safe, thus the sections are mapped up front
+    mRows = logicalSections(mDataModel, Qt::Vertical, modelInstance->equationRowCount());
+    mColumns = logicalSections(mDataModel, Qt::Horizontal, modelInstance->variableRowCount());
+    auto rows = shownSections(mRows);
+    auto columns = shownSections(mColumns);
+    auto token = mToken;
+    mWatcher.setFuture(QtConcurrent::run([this, modelInstance, range, rows, columns, token]{
+        return modelInstance->findCoefficients(range, rows, columns,
+                                               CoefficientSearch::MaxHits, &mTotal, token);
+    }));
+}
+
+void CoefficientRangeSearch::cancel()
+{
+    mToken.cancel();
+}
+
+bool CoefficientRangeSearch::isRunning() const
+{
+    return mWatcher.isRunning();
+}
+
+const SearchResult &CoefficientRangeSearch::result() const
+{
+    return mViewConfig->searchResult();
+}
+
+QVector<int> CoefficientRangeSearch::logicalSections(QAbstractItemModel *model,
+                                                     Qt::Orientation orientation,
+                                                     int sectionCount)
+{
+    bool ok = false;
+    QVector<int> logical(sectionCount, -1);
+    int sections = orientation == Qt::Horizontal ? model->columnCount()
+                                                 : model->rowCount();
+    for (int section=0; section<sections; ++section) {
+        int realSection = model->headerData(section, orientation).toInt(&ok);
+        if (ok && realSection >= 0 && realSection < sectionCount && logical.at(realSection) < 0)
+            logical[realSection] = section;
+    }
+    return logical;
+}
+
+void CoefficientRangeSearch::searchFinished()
+{
+    if (mToken.isCancelled()) {
+        emit finished(true);
+        return;
+    }
+    auto& result = mViewConfig->searchResult();
+    result.CoefficientCount = mTotal;
+    const auto hits = mWatcher.result();
+    for (const auto& hit : hits) {
+        int row = hit.Row < mRows.size() ? mRows.at(hit.Row) : -1;
+        int column = hit.Column < mColumns.size() ? mColumns.at(hit.Column) : -1;
+        if (row < 0 || column < 0)
+            continue;
+        result.Entries.append(SearchResult::SearchEntry{row, Qt::Vertical, column, hit.Value});
+    }
+    emit finished(false);
+}
+
+QBitArray CoefficientRangeSearch::shownSections(const QVector<int> &logical)
+{
+    QBitArray sections(logical.size());
+    for (int i=0; i<logical.size(); ++i)
+        sections.setBit(i, logical.at(i) >= 0);
+    return sections;
+}
+
 }
 }
 }
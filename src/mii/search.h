@@ -20,9 +20,19 @@
 #ifndef SEARCH_H
 #define SEARCH_H
 
-#include <functional>
+#include "coefficientsearch.h"
+#include "common.h"
+
+#include <QBitArray>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QRegularExpression>
 #include <QSharedPointer>
 #include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <functional>
 
 class QAbstractItemModel;
 
@@ -32,7 +42,6 @@ namespace mii {
 
 class AbstractModelInstance;
 class AbstractViewConfiguration;
-struct SearchResult;
 
 class Search
 {
@@ -53,9 +62,177 @@ private:
 private:
     QSharedPointer<AbstractViewConfiguration> mViewConfig;
     QAbstractItemModel *mDataModel;
+    QString mTerm;
+    bool mIsRegEx;
     std::function<bool(const QString&)> compare;
 };
 
+///
+/// \brief Regular expression header search on the worker pool.
+///
+/// Symbol headers are matched against the SearchIndex of the model
+/// instance, i.e. every distinct name and label is matched once. The
+/// header sections are split into chunks, which are resolved in
+/// parallel. Found entries are appended to the search result of the
+/// view and reported by entriesFound() while the search is running.
+///
+class RegExSearch final : public QObject
+{
+    Q_OBJECT
+
+public:
+    RegExSearch(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                QAbstractItemModel *dataModel,
+                const QString &term,
+                QObject *parent = nullptr);
+
+    ~RegExSearch() override;
+
+    void start();
+
+    void cancel();
+
+    bool isRunning() const;
+
+    ///
+    /// \brief Search result of the view, which is complete after finished().
+    ///
+    const SearchResult& result() const;
+
+    ///
+    /// \brief Entries of the logical sections <c>first</c> to <c>last</c>,
+    ///        whose section index is set in <c>matches</c>.
+    /// \param sections Section index of every logical section, or -1.
+    ///
+    static QList<SearchResult::SearchEntry> indexEntries(const QBitArray &matches,
+                                                         const QVector<int> &sections,
+                                                         int first, int last,
+                                                         Qt::Orientation orientation);
+
+signals:
+    void entriesFound(const QList<gams::studio::mii::SearchResult::SearchEntry> &entries);
+
+    ///
+    /// \brief Search finished or was canceled. The search result of the
+    ///        view is sorted by orientation and index.
+    ///
+    void finished(bool canceled);
+
+private slots:
+    void searchFinished();
+
+private:
+    struct Chunk
+    {
+        Qt::Orientation Orientation = Qt::Horizontal;
+        int First = 0;
+        int Last = -1;
+    };
+
+    void prepare(Qt::Orientation orientation);
+
+    void matchIndex(Qt::Orientation orientation);
+
+    void searchChunk(const Chunk &chunk);
+
+    void appendEntries(const QList<SearchResult::SearchEntry> &entries);
+
+private:
+    static constexpr int ChunkSize = 2048;
+
+    QSharedPointer<AbstractViewConfiguration> mViewConfig;
+    QAbstractItemModel *mDataModel;
+    QSharedPointer<AbstractModelInstance> mModelInstance;
+    QRegularExpression mRegex;
+    bool mStaticHeader = false;
+
+    ///
+    /// \brief Section index of every logical section, or -1.
+    ///
+    QVector<int> mSections[2];
+
+    ///
+    /// \brief Section labels of static headers, e.g. of the block pictures.
+    ///
+    QVector<QStringList> mLabels[2];
+
+    ///
+    /// \brief Matching section indices, which are empty if the model
+    ///        instance has no SearchIndex.
+    ///
+    QBitArray mMatches[2];
+
+    QVector<Chunk> mChunks;
+    QFutureWatcher<void> mWatcher;
+    std::atomic<bool> mCanceled {false};
+};
+
+///
+/// \brief Coefficient search by magnitude on the worker pool.
+///
+/// Only the sections shown by the view are scanned, so the hit cap and
+/// the reported count refer to the view. The hits are mapped to logical
+/// sections when the scan finished.
+///
+class CoefficientRangeSearch final : public QObject
+{
+    Q_OBJECT
+
+public:
+    ///
+    /// \param term Range like <c>"< 1e-9 > 1e9"</c>, see CoefficientSearch::parse.
+    ///
+    CoefficientRangeSearch(const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                           QAbstractItemModel *dataModel,
+                           const QString &term,
+                           QObject *parent = nullptr);
+
+    ~CoefficientRangeSearch() override;
+
+    void start();
+
+    ///
+    /// \brief Drop the result of a running scan.
+    ///
+    void cancel();
+
+    bool isRunning() const;
+
+    ///
+    /// \brief Search result of the view, which is complete after finished().
+    ///
+    const SearchResult& result() const;
+
+signals:
+    ///
+    /// \brief Search finished or was canceled.
+    ///
+    void finished(bool canceled);
+
+private slots:
+    void searchFinished();
+
+private:
+    ///
+    /// \brief Logical section of every section index, or -1.
+    ///
+    static QVector<int> logicalSections(QAbstractItemModel *model,
+                                        Qt::Orientation orientation,
+                                        int sectionCount);
+
+    static QBitArray shownSections(const QVector<int> &logical);
+
+private:
+    QSharedPointer<AbstractViewConfiguration> mViewConfig;
+    QAbstractItemModel *mDataModel;
+    QString mTerm;
+    QVector<int> mRows;
+    QVector<int> mColumns;
+    qint64 mTotal = 0;
+    QFutureWatcher<QVector<CoefficientHit>> mWatcher;
+    CancellationToken mToken;
+};
+
 }
 }
 }
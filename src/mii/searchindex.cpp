@@ -0,0 +1,168 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "searchindex.h"
+#include "symbol.h"
+
+#include <QRegularExpression>
+
+#include <algorithm>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+void SearchIndex::build(const QVector<Symbol*> &symbols, int sectionCount)
+{
+    clear();
+    mSectionCount = sectionCount;
+    QHash<QString, int> names;
+    QHash<QString, int> labels;
+    for (auto symbol : symbols) {
+        auto& name = mEntries[appendText(symbol->name(), names)];
+        name.FirstSection = symbol->firstSection();
+        name.LastSection = symbol->lastSection();
+        for (auto iter=symbol->sectionLabels().constBegin(); iter!=symbol->sectionLabels().constEnd(); ++iter) {
+            for (const auto& label : iter.value()) {
+                mEntries[appendText(label, labels)].Sections.append(iter.key());
+            }
+        }
+    }
+    for (int id=0; id<mEntries.size(); ++id) {
+        auto& sections = mEntries[id].Sections;
+        std::sort(sections.begin(), sections.end());
+        sections.erase(std::unique(sections.begin(), sections.end()), sections.end());
+        sections.squeeze();
+        for (int i=0; i+3<=mEntries.at(id).LowerText.size(); ++i) {
+            auto& ids = mTrigrams[trigram(mEntries.at(id).LowerText.constData()+i)];
+            if (ids.isEmpty() || ids.constLast() != id)
+                ids.append(id);
+        }
+    }
+}
+
+void SearchIndex::clear()
+{
+    mSectionCount = 0;
+    mEntries.clear();
+    mTrigrams.clear();
+}
+
+bool SearchIndex::isEmpty() const
+{
+    return mEntries.isEmpty();
+}
+
+int SearchIndex::sectionCount() const
+{
+    return mSectionCount;
+}
+
+int SearchIndex::textCount() const
+{
+    return mEntries.size();
+}
+
+QBitArray SearchIndex::find(const QString &term) const
+{
+    QBitArray sections(mSectionCount);
+    auto lowerTerm = term.toLower();
+    if (lowerTerm.size() < 3) {
+        for (const auto& entry : mEntries) {
+            if (entry.LowerText.contains(lowerTerm))
+                mark(entry, sections);
+        }
+        return sections;
+    }
+    for (int id : candidates(lowerTerm)) {
+        if (mEntries.at(id).LowerText.contains(lowerTerm))
+            mark(mEntries.at(id), sections);
+    }
+    return sections;
+}
+
+QBitArray SearchIndex::find(const QRegularExpression &regex) const
+{
+    QBitArray sections(mSectionCount);
+    for (const auto& entry : mEntries) {
+        if (regex.match(entry.Text).hasMatch())
+            mark(entry, sections);
+    }
+    return sections;
+}
+
+int SearchIndex::appendText(const QString &text, QHash<QString, int> &ids)
+{
+    auto iter = ids.constFind(text);
+    if (iter != ids.constEnd())
+        return iter.value();
+    Entry entry;
+    entry.Text = text;
+    entry.LowerText = text.toLower();
+    mEntries.append(entry);
+    ids.insert(text, mEntries.size()-1);
+    return mEntries.size()-1;
+}
+
+QVector<int> SearchIndex::candidates(const QString &term) const
+{
+    QVector<const QVector<int>*> postings;
+    for (int i=0; i+3<=term.size(); ++i) {
+        auto iter = mTrigrams.constFind(trigram(term.constData()+i));
+        if (iter == mTrigrams.constEnd())
+            return QVector<int>();
+        postings.append(&iter.value());
+    }
+    std::sort(postings.begin(), postings.end(), [](const QVector<int>* a, const QVector<int>* b) {
+        return a->size() < b->size();
+    });
+    QVector<int> result = *postings.constFirst();
+    QVector<int> intersection;
+    for (int p=1; p<postings.size() && !result.isEmpty(); ++p) {
+        intersection.clear();
+        std::set_intersection(result.cbegin(), result.cend(),
+                              postings.at(p)->cbegin(), postings.at(p)->cend(),
+                              std::back_inserter(intersection));
+        result.swap(intersection);
+    }
+    return result;
+}
+
+void SearchIndex::mark(const Entry &entry, QBitArray &sections) const
+{
+    if (entry.FirstSection >= 0 && entry.FirstSection < mSectionCount &&
+        entry.LastSection >= entry.FirstSection) {
+        sections.fill(true, entry.FirstSection, std::min(entry.LastSection+1, mSectionCount));
+    }
+    for (int section : entry.Sections) {
+        if (section >= 0 && section < mSectionCount)
+            sections.setBit(section);
+    }
+}
+
+quint64 SearchIndex::trigram(const QChar *text)
+{
+    return (quint64(text[0].unicode()) << 32) |
+           (quint64(text[1].unicode()) << 16) |
+            quint64(text[2].unicode());
+}
+
+}
+}
+}
@@ -0,0 +1,105 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class QRegularExpression;
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class Symbol;
+
+///
+/// \brief Trigram index over the symbol names and distinct labels of
+///        all equations or all variables.
+///
+/// Every distinct text maps to the sections it occurs in. Substring
+/// queries only verify the texts sharing all trigrams of the term, so
+/// searching is independent of the number of sections.
+///
+class SearchIndex final
+{
+public:
+    SearchIndex() = default;
+
+    ///
+    /// \brief Build the index from <c>symbols</c>.
+    /// \param sectionCount Total number of sections (rows or columns).
+    ///
+    void build(const QVector<Symbol*> &symbols, int sectionCount);
+
+    void clear();
+
+    bool isEmpty() const;
+
+    int sectionCount() const;
+
+    ///
+    /// \brief Number of distinct symbol names and labels.
+    ///
+    int textCount() const;
+
+    ///
+    /// \brief Sections with a symbol name or label containing <c>term</c>,
+    ///        case insensitive.
+    ///
+    QBitArray find(const QString &term) const;
+
+    ///
+    /// \brief Sections with a symbol name or label matching <c>regex</c>.
+    ///
+    QBitArray find(const QRegularExpression &regex) const;
+
+private:
+    struct Entry
+    {
+        QString Text;
+        QString LowerText;
+        int FirstSection = -1;
+        int LastSection = -1;
+        QVector<int> Sections;
+    };
+
+    int appendText(const QString &text, QHash<QString, int> &ids);
+
+    QVector<int> candidates(const QString &term) const;
+
+    void mark(const Entry &entry, QBitArray &sections) const;
+
+    static quint64 trigram(const QChar *text);
+
+private:
+    int mSectionCount = 0;
+    QVector<Entry> mEntries;
+    QHash<quint64, QVector<int>> mTrigrams;
+};
+
+}
+}
+}
+
+#endif // SEARCHINDEX_H
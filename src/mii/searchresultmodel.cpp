@@ -42,11 +42,19 @@ QVariant SearchResultModel::data(const QModelIndex &index, int role) const
         return QVariant();
     if (index.row() >= mData.Entries.size())
         return QVariant();
+    const auto& entry = mData.Entries[index.row()];
     if (index.column() == 0) {
-        return mData.Entries[index.row()].Index;
+        if (entry.isCoefficient())
+            return QString("%1, %2").arg(entry.Index).arg(entry.Column);
+        return entry.Index;
     }
     if (index.column() == 1) {
-        return mData.Entries[index.row()].Orientation == Qt::Horizontal? "Horizontal" : "Vertical";
+        if (entry.isCoefficient())
+            return "Coefficient";
+        return entry.Orientation == Qt::Horizontal? "Horizontal" : "Vertical";
+    }
+    if (index.column() == 2 && entry.isCoefficient()) {
+        return entry.Value;
     }
     return QVariant();
 }
@@ -58,6 +66,15 @@ void SearchResultModel::updateData(const SearchResult &data)
     endResetModel();
 }
 
+void SearchResultModel::appendEntries(const QList<SearchResult::SearchEntry> &entries)
+{
+    if (entries.isEmpty())
+        return;
+    beginInsertRows(QModelIndex(), mData.Entries.size(), mData.Entries.size()+entries.size()-1);
+    mData.Entries.append(entries);
+    endInsertRows();
+}
+
 SearchResult::SearchEntry SearchResultModel::entry(int index)
 {
     if (index >= mData.Entries.size())
@@ -41,6 +41,8 @@ public:
 
     void updateData(const SearchResult &data);
 
+    void appendEntries(const QList<SearchResult::SearchEntry> &entries);
+
     SearchResult::SearchEntry entry(int index);
 
     QVariant headerData(int section, Qt::Orientation orientation,
@@ -51,7 +53,7 @@ public:
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
 
 private:
-    const QStringList mHeaderData { "Index", "Orientation"};
+    const QStringList mHeaderData { "Index", "Orientation", "Value" };
     SearchResult mData;
 };
 
@@ -245,12 +245,26 @@ void AbstractSectionTreeItem::setType(const QString &text)
         mType = ViewHelper::ViewDataType::BP_Count;
     else if (text == ViewHelper::BPAverage)
         mType = ViewHelper::ViewDataType::BP_Average;
+    else if (text == ViewHelper::BPSparsity)
+        mType = ViewHelper::ViewDataType::BP_Sparsity;
     else if (text == ViewHelper::Postopt)
         mType = ViewHelper::ViewDataType::Postopt;
+    else if (text == ViewHelper::ScalingAdvisor)
+        mType = ViewHelper::ViewDataType::ScalingAdvisor;
+    else if (text == ViewHelper::Histogram)
+        mType = ViewHelper::ViewDataType::Histogram;
+    else if (text == ViewHelper::Diagnostics)
+        mType = ViewHelper::ViewDataType::Diagnostics;
+    else if (text == ViewHelper::Components)
+        mType = ViewHelper::ViewDataType::Components;
+    else if (text == ViewHelper::Residuals)
+        mType = ViewHelper::ViewDataType::Residuals;
     else if (text == ViewHelper::SymbolView)
         mType = ViewHelper::ViewDataType::Symbols;
     else if (text == ViewHelper::Blockpic)
         mType = ViewHelper::ViewDataType::BlockpicGroup;
+    else if (text == ViewHelper::Analysis)
+        mType = ViewHelper::ViewDataType::AnalysisGroup;
     else
         mType = ViewHelper::ViewDataType::Unknown;
 }
@@ -268,6 +282,7 @@ void AbstractSectionTreeItem::setCustom(bool custom)
 bool AbstractSectionTreeItem::isGroup() const
 {
     switch (mType) {
+    case ViewHelper::ViewDataType::AnalysisGroup:
     case ViewHelper::ViewDataType::BlockpicGroup:
     case ViewHelper::ViewDataType::SymbolsGroup:
     case ViewHelper::ViewDataType::CustomGroup:
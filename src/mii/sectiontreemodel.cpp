@@ -85,6 +85,19 @@ void SectionTreeModel::appendCustomView(const QString &text,
         item->setCustom(true);
         customSymbolView->append(item);
         customSymbolView->setActive(active);
+    } else if (ViewHelper::isAnalysis(widget->type())) {
+        auto customAnalysis = customRoot->find(ViewHelper::ViewDataType::AnalysisGroup);
+        if (!customAnalysis) {
+            customAnalysis = new SectionGroupTreeItem(ViewHelper::Analysis, customRoot);
+            customAnalysis->setType(ViewHelper::ViewDataType::AnalysisGroup);
+            customAnalysis->setCustom(true);
+            customRoot->append(customAnalysis);
+        }
+        auto item = new SectionTreeItem(text, widget, customAnalysis);
+        item->setType(widget->type());
+        item->setCustom(true);
+        customAnalysis->append(item);
+        customAnalysis->setActive(active);
     } else {
         auto customBlockpic = customRoot->find(ViewHelper::ViewDataType::BlockpicGroup);
         if (!customBlockpic) {
@@ -224,6 +237,7 @@ bool SectionTreeModel::removeRows(int row, int count, const QModelIndex &parent)
     if (parentItem != customRoot && !parentItem->childCount() &&
         (parentItem->type() == ViewHelper::ViewDataType::BlockpicGroup ||
          parentItem->type() == ViewHelper::ViewDataType::PostoptGroup  ||
+         parentItem->type() == ViewHelper::ViewDataType::AnalysisGroup ||
          parentItem->type() == ViewHelper::ViewDataType::SymbolsGroup)) {
         customRoot->remove(parentItem);
     }
@@ -321,6 +335,8 @@ void SectionTreeModel::loadViewTreeData(AbstractSectionTreeItem *root, QStackedW
     auto blockpicItem = new SectionGroupTreeItem(ViewHelper::Blockpic, predefinedRoot);
     blockpicItem->setType(ViewHelper::ViewDataType::BlockpicGroup);
     predefinedRoot->append(blockpicItem);
+    auto analysisItem = new SectionGroupTreeItem(ViewHelper::Analysis, predefinedRoot);
+    analysisItem->setType(ViewHelper::ViewDataType::AnalysisGroup);
     for (int i=0; i<ViewHelper::PredefinedViewTexts.size(); ++i) {
         if (ViewHelper::PredefinedViewTexts.at(i) == ViewHelper::BPScaling) {
             auto widget = stackedWidget->widget((int)ViewHelper::ViewDataType::BP_Scaling);
@@ -350,6 +366,13 @@ void SectionTreeModel::loadViewTreeData(AbstractSectionTreeItem *root, QStackedW
                                             blockpicItem);
             item->setType(ViewHelper::PredefinedViewTexts.at(i));
             blockpicItem->append(item);
+        } else if (ViewHelper::PredefinedViewTexts.at(i) == ViewHelper::BPSparsity) {
+            auto widget = stackedWidget->widget((int)ViewHelper::ViewDataType::BP_Sparsity);
+            auto item = new SectionTreeItem(ViewHelper::PredefinedViewTexts.at(i),
+                                            static_cast<AbstractViewFrame*>(widget->children().last()),
+                                            blockpicItem);
+            item->setType(ViewHelper::PredefinedViewTexts.at(i));
+            blockpicItem->append(item);
         } else if (ViewHelper::PredefinedViewTexts.at(i) == ViewHelper::Postopt) {
             auto widget = stackedWidget->widget((int)ViewHelper::ViewDataType::Postopt);
             auto item = new SectionTreeItem(ViewHelper::PredefinedViewTexts.at(i),
@@ -357,8 +380,44 @@ void SectionTreeModel::loadViewTreeData(AbstractSectionTreeItem *root, QStackedW
                                             predefinedRoot);
             item->setType(ViewHelper::PredefinedViewTexts.at(i));
             predefinedRoot->append(item);
+        } else if (ViewHelper::PredefinedViewTexts.at(i) == ViewHelper::ScalingAdvisor) {
+            auto widget = stackedWidget->widget((int)ViewHelper::ViewDataType::ScalingAdvisor);
+            auto item = new SectionTreeItem(ViewHelper::PredefinedViewTexts.at(i),
+                                            static_cast<AbstractViewFrame*>(widget->children().last()),
+                                            analysisItem);
+            item->setType(ViewHelper::PredefinedViewTexts.at(i));
+            analysisItem->append(item);
+        } else if (ViewHelper::PredefinedViewTexts.at(i) == ViewHelper::Histogram) {
+            auto widget = stackedWidget->widget((int)ViewHelper::ViewDataType::Histogram);
+            auto item = new SectionTreeItem(ViewHelper::PredefinedViewTexts.at(i),
+                                            static_cast<AbstractViewFrame*>(widget->children().last()),
+                                            analysisItem);
+            item->setType(ViewHelper::PredefinedViewTexts.at(i));
+            analysisItem->append(item);
+        } else if (ViewHelper::PredefinedViewTexts.at(i) == ViewHelper::Diagnostics) {
+            auto widget = stackedWidget->widget((int)ViewHelper::ViewDataType::Diagnostics);
+            auto item = new SectionTreeItem(ViewHelper::PredefinedViewTexts.at(i),
+                                            static_cast<AbstractViewFrame*>(widget->children().last()),
+                                            analysisItem);
+            item->setType(ViewHelper::PredefinedViewTexts.at(i));
+            analysisItem->append(item);
+        } else if (ViewHelper::PredefinedViewTexts.at(i) == ViewHelper::Components) {
+            auto widget = stackedWidget->widget((int)ViewHelper::ViewDataType::Components);
+            auto item = new SectionTreeItem(ViewHelper::PredefinedViewTexts.at(i),
+                                            static_cast<AbstractViewFrame*>(widget->children().last()),
+                                            analysisItem);
+            item->setType(ViewHelper::PredefinedViewTexts.at(i));
+            analysisItem->append(item);
+        } else if (ViewHelper::PredefinedViewTexts.at(i) == ViewHelper::Residuals) {
+            auto widget = stackedWidget->widget((int)ViewHelper::ViewDataType::Residuals);
+            auto item = new SectionTreeItem(ViewHelper::PredefinedViewTexts.at(i),
+                                            static_cast<AbstractViewFrame*>(widget->children().last()),
+                                            analysisItem);
+            item->setType(ViewHelper::PredefinedViewTexts.at(i));
+            analysisItem->append(item);
         }
     }
+    predefinedRoot->append(analysisItem);
     auto customRoot = new SectionGroupTreeItem(ViewHelper::CustomViews, root);
     customRoot->setType(ViewHelper::ViewDataType::CustomGroup);
     customRoot->setCustom(true);
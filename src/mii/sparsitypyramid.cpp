@@ -0,0 +1,317 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "sparsitypyramid.h"
+#include "datamatrix.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+QSharedPointer<SparsityPyramid> SparsityPyramid::build(DataMatrix &matrix,
+                                                       bool useOutput,
+                                                       qint64 maxBaseCells)
+{
+    auto pyramid = QSharedPointer<SparsityPyramid>(new SparsityPyramid);
+    pyramid->mRowCount = matrix.rowCount();
+    pyramid->mColumnCount = matrix.columnCount();
+    pyramid->mUseOutput = useOutput;
+    pyramid->mMatrix = &matrix;
+    pyramid->mOverlay = useOutput ? matrix.nlOverlay() : nullptr;
+    if (pyramid->isEmpty())
+        return pyramid;
+    pyramid->buildBaseLevel(matrix, std::max(qint64(1), maxBaseCells));
+    while (pyramid->mLevels.constLast().Rows > 1 || pyramid->mLevels.constLast().Columns > 1) {
+        pyramid->buildLevel(pyramid->mLevels.constLast());
+    }
+    return pyramid;
+}
+
+int SparsityPyramid::rowCount() const
+{
+    return mRowCount;
+}
+
+int SparsityPyramid::columnCount() const
+{
+    return mColumnCount;
+}
+
+qint64 SparsityPyramid::nonZeros() const
+{
+    return mNonZeros;
+}
+
+double SparsityPyramid::minimumAbs() const
+{
+    return mMinimumAbs;
+}
+
+double SparsityPyramid::maximumAbs() const
+{
+    return mMaximumAbs;
+}
+
+bool SparsityPyramid::usesOutput() const
+{
+    return mUseOutput;
+}
+
+bool SparsityPyramid::isEmpty() const
+{
+    return mRowCount <= 0 || mColumnCount <= 0;
+}
+
+int SparsityPyramid::levelCount() const
+{
+    return mLevels.size();
+}
+
+const SparsityPyramid::Level &SparsityPyramid::level(int index) const
+{
+    return mLevels.at(index);
+}
+
+bool SparsityPyramid::hasExactLevel() const
+{
+    return !mLevels.isEmpty() && (mLevels.constFirst().RowBucket > 1 ||
+                                  mLevels.constFirst().ColumnBucket > 1);
+}
+
+int SparsityPyramid::levelFor(double rowsPerPixel, double columnsPerPixel) const
+{
+    if (hasExactLevel() && (mLevels.constFirst().RowBucket > rowsPerPixel ||
+                            mLevels.constFirst().ColumnBucket > columnsPerPixel))
+        return ExactLevel;
+    int result = 0;
+    for (int l=1; l<mLevels.size(); ++l) {
+        if (mLevels.at(l).RowBucket > rowsPerPixel || mLevels.at(l).ColumnBucket > columnsPerPixel)
+            break;
+        result = l;
+    }
+    return result;
+}
+
+void SparsityPyramid::aggregate(int level, int firstRow, int lastRow,
+                                int firstColumn, int lastColumn,
+                                quint32 &count, double &maxAbs) const
+{
+    count = 0;
+    maxAbs = 0.0;
+    if (level == ExactLevel && hasExactLevel()) {
+        MatrixValues values(*mMatrix, mOverlay);
+        const int minColumn = std::max(0, firstColumn);
+        const int maxColumn = std::min(lastColumn, mColumnCount-1);
+        quint64 sum = 0;
+        for (int r=std::max(0, firstRow); r<=std::min(lastRow, mRowCount-1); ++r) {
+            auto row = mMatrix->row(r);
+            if (!row || !row->colIdx())
+                continue;
+            auto data = values.row(r);
+            for (int e=0; e<row->entries(); ++e) {
+                const int column = row->colIdx()[e];
+                if (column < minColumn || column > maxColumn)
+                    continue;
+                ++sum;
+                maxAbs = std::max(maxAbs, std::abs(data[e]));
+            }
+        }
+        count = (quint32)std::min<quint64>(sum, std::numeric_limits<quint32>::max());
+        return;
+    }
+    if (level < 0 || level >= mLevels.size())
+        return;
+    const auto& data = mLevels.at(level);
+    int r0 = std::max(0, firstRow / data.RowBucket);
+    int r1 = std::min(data.Rows-1, lastRow / data.RowBucket);
+    int c0 = std::max(0, firstColumn / data.ColumnBucket);
+    int c1 = std::min(data.Columns-1, lastColumn / data.ColumnBucket);
+    quint64 sum = 0;
+    for (int r=r0; r<=r1; ++r) {
+        for (int c=c0; c<=c1; ++c) {
+            int index = data.index(r, c);
+            sum += data.Count[index];
+            maxAbs = std::max(maxAbs, data.MaxAbs[index]);
+        }
+    }
+    count = (quint32)std::min<quint64>(sum, std::numeric_limits<quint32>::max());
+}
+
+quint32 SparsityPyramid::rasterize(const QVector<QPair<int, int>> &rows,
+                                   const QVector<QPair<int, int>> &columns,
+                                   QVector<quint32> &counts,
+                                   QVector<double> &maxAbs) const
+{
+    const int width = columns.size();
+    counts.fill(0, rows.size() * width);
+    maxAbs.fill(0.0, rows.size() * width);
+    if (!hasExactLevel() || rows.isEmpty() || columns.isEmpty())
+        return 0;
+    // Every task owns one line of pixels, so no synchronization is needed.
+    QVector<int> lines(rows.size());
+    std::iota(lines.begin(), lines.end(), 0);
+    auto countValues = counts.data();
+    auto maxAbsValues = maxAbs.data();
+    const int firstColumn = std::max(0, columns.constFirst().first);
+    const int lastColumn = std::min(columns.constLast().second, mColumnCount-1);
+    MatrixValues values(*mMatrix, mOverlay);
+    auto fillLine = [&](int y) {
+        auto count = countValues + y * width;
+        auto lineMaxAbs = maxAbsValues + y * width;
+        int lastRow = std::min(rows.at(y).second, mRowCount-1);
+        for (int r=std::max(0, rows.at(y).first); r<=lastRow; ++r) {
+            auto row = mMatrix->row(r);
+            if (!row || !row->colIdx())
+                continue;
+            auto data = values.row(r);
+            const int *colIdx = row->colIdx();
+            for (int e=0; e<row->entries(); ++e) {
+                const int column = colIdx[e];
+                if (column < firstColumn || column > lastColumn)
+                    continue;
+                // first pixel ending at the column, which can span several
+                // pixels when zoomed in
+                int x = int(std::lower_bound(columns.cbegin(), columns.cend(), column,
+                                             [](const QPair<int, int> &pixel, int column) {
+                    return pixel.second < column;
+                }) - columns.cbegin());
+                const double value = std::abs(data[e]);
+                for (int px=x; px<width && columns.at(px).first<=column; ++px) {
+                    ++count[px];
+                    lineMaxAbs[px] = std::max(lineMaxAbs[px], value);
+                }
+            }
+        }
+    };
+    QtConcurrent::blockingMap(lines, fillLine);
+    return counts.isEmpty() ? 0 : *std::max_element(counts.cbegin(), counts.cend());
+}
+
+void SparsityPyramid::buildBaseLevel(DataMatrix &matrix, qint64 maxBaseCells)
+{
+    // split the cells between rows and columns, so that a dimension
+    // smaller than the square root of the budget keeps its full resolution
+    qint64 rowResolution = mRowCount;
+    qint64 columnResolution = mColumnCount;
+    if (qint64(mRowCount) * mColumnCount > maxBaseCells) {
+        qint64 side = std::max(qint64(1), (qint64)std::sqrt((double)maxBaseCells));
+        columnResolution = std::min<qint64>(mColumnCount, std::max(side, maxBaseCells / mRowCount));
+        rowResolution = std::min<qint64>(mRowCount, std::max(qint64(1), maxBaseCells / columnResolution));
+    }
+    Level base;
+    base.RowBucket = (int)((mRowCount + rowResolution - 1) / rowResolution);
+    base.ColumnBucket = (int)((mColumnCount + columnResolution - 1) / columnResolution);
+    base.Rows = (mRowCount + base.RowBucket - 1) / base.RowBucket;
+    base.Columns = (mColumnCount + base.ColumnBucket - 1) / base.ColumnBucket;
+    base.Count.fill(0, base.Rows * base.Columns);
+    base.MaxAbs.fill(0.0, base.Rows * base.Columns);
+
+    // Every task owns one row of buckets, so no synchronization is needed.
+    QVector<int> bucketRows(base.Rows);
+    std::iota(bucketRows.begin(), bucketRows.end(), 0);
+    QVector<qint64> nonZeros(base.Rows, 0);
+    QVector<double> minimums(base.Rows, std::numeric_limits<double>::max());
+    QVector<double> maximums(base.Rows, 0.0);
+    auto counts = base.Count.data();
+    auto maxAbsValues = base.MaxAbs.data();
+    auto nonZeroCounts = nonZeros.data();
+    auto minimumValues = minimums.data();
+    auto maximumValues = maximums.data();
+    MatrixValues matrixValues(matrix, mOverlay);
+    auto fillBucketRow = [&](int bucketRow) {
+        int first = bucketRow * base.RowBucket;
+        int last = std::min(mRowCount, first + base.RowBucket);
+        auto count = counts + bucketRow * base.Columns;
+        auto maxAbs = maxAbsValues + bucketRow * base.Columns;
+        for (int r=first; r<last; ++r) {
+            auto row = matrix.row(r);
+            if (!row || !row->colIdx())
+                continue;
+            auto values = matrixValues.row(r);
+            for (int e=0; e<row->entries(); ++e) {
+                int column = row->colIdx()[e] / base.ColumnBucket;
+                if (column < 0 || column >= base.Columns)
+                    continue;
+                double value = std::abs(values[e]);
+                ++count[column];
+                maxAbs[column] = std::max(maxAbs[column], value);
+                ++nonZeroCounts[bucketRow];
+                if (value > 0.0)
+                    minimumValues[bucketRow] = std::min(minimumValues[bucketRow], value);
+                maximumValues[bucketRow] = std::max(maximumValues[bucketRow], value);
+            }
+        }
+    };
+    QtConcurrent::blockingMap(bucketRows, fillBucketRow);
+
+    mNonZeros = std::accumulate(nonZeros.cbegin(), nonZeros.cend(), qint64(0));
+    mMinimumAbs = *std::min_element(minimums.cbegin(), minimums.cend());
+    mMaximumAbs = *std::max_element(maximums.cbegin(), maximums.cend());
+    if (mMinimumAbs > mMaximumAbs)
+        mMinimumAbs = mMaximumAbs;
+    base.MaxCount = base.Count.isEmpty() ? 0 : *std::max_element(base.Count.cbegin(), base.Count.cend());
+    mLevels.append(std::move(base));
+}
+
+void SparsityPyramid::buildLevel(const Level &previous)
+{
+    Level next;
+    next.RowBucket = previous.RowBucket * 2;
+    next.ColumnBucket = previous.ColumnBucket * 2;
+    next.Rows = (previous.Rows + 1) / 2;
+    next.Columns = (previous.Columns + 1) / 2;
+    next.Count.fill(0, next.Rows * next.Columns);
+    next.MaxAbs.fill(0.0, next.Rows * next.Columns);
+
+    QVector<int> rows(next.Rows);
+    std::iota(rows.begin(), rows.end(), 0);
+    auto counts = next.Count.data();
+    auto maxAbsValues = next.MaxAbs.data();
+    auto reduceRow = [&](int row) {
+        for (int c=0; c<next.Columns; ++c) {
+            quint64 count = 0;
+            double maxAbs = 0.0;
+            for (int r=row*2; r<std::min(previous.Rows, row*2+2); ++r) {
+                for (int pc=c*2; pc<std::min(previous.Columns, c*2+2); ++pc) {
+                    int index = previous.index(r, pc);
+                    count += previous.Count[index];
+                    maxAbs = std::max(maxAbs, previous.MaxAbs[index]);
+                }
+            }
+            int index = next.index(row, c);
+            counts[index] = (quint32)std::min<quint64>(count, std::numeric_limits<quint32>::max());
+            maxAbsValues[index] = maxAbs;
+        }
+    };
+    QtConcurrent::blockingMap(rows, reduceRow);
+
+    next.MaxCount = *std::max_element(next.Count.cbegin(), next.Count.cend());
+    mLevels.append(std::move(next));
+}
+
+}
+}
+}
@@ -0,0 +1,166 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef SPARSITYPYRAMID_H
+#define SPARSITYPYRAMID_H
+
+#include <QPair>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <memory>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class DataMatrix;
+struct NlOverlay;
+
+///
+/// \brief Multi-resolution sparsity pattern of the full Jacobian.
+///
+/// Level 0 aggregates the matrix into at most <c>maxBaseCells</c> buckets,
+/// split between rows and columns by the shape of the matrix. Every
+/// following level halves the resolution of the previous one until a
+/// single bucket remains. Each bucket stores the number of nonzeros and
+/// the maximum absolute coefficient, so a raster of any region can be
+/// drawn with a constant number of bucket reads per pixel.
+///
+/// If level 0 is coarser than the matrix, zoom levels below the level 0
+/// buckets are served as ExactLevel straight from the CSR rows of the
+/// matrix, so the exact pattern isn't copied.
+///
+class SparsityPyramid final
+{
+public:
+    static const int DefaultBaseCells = 2048 * 2048;
+
+    ///
+    /// \brief Level index of the exact pattern, see levelFor().
+    ///
+    static const int ExactLevel = -1;
+
+    struct Level
+    {
+        int RowBucket = 1;
+        int ColumnBucket = 1;
+        int Rows = 0;
+        int Columns = 0;
+        quint32 MaxCount = 0;
+        QVector<quint32> Count;
+        QVector<double> MaxAbs;
+
+        inline int index(int row, int column) const
+        {
+            return row * Columns + column;
+        }
+    };
+
+    SparsityPyramid() = default;
+
+    ///
+    /// \brief Build the pyramid from the CSR rows of <c>matrix</c>.
+    /// \param useOutput Use the output (evaluated) coefficients if available.
+    /// \remark Level 0 and every reduction step run in parallel. The
+    ///         ExactLevel reads the rows of <c>matrix</c>, which must
+    ///         outlive the pyramid.
+    ///
+    static QSharedPointer<SparsityPyramid> build(DataMatrix &matrix,
+                                                 bool useOutput,
+                                                 qint64 maxBaseCells = DefaultBaseCells);
+
+    int rowCount() const;
+
+    int columnCount() const;
+
+    qint64 nonZeros() const;
+
+    double minimumAbs() const;
+
+    double maximumAbs() const;
+
+    bool usesOutput() const;
+
+    bool isEmpty() const;
+
+    int levelCount() const;
+
+    const Level& level(int index) const;
+
+    ///
+    /// \brief <c>true</c> if ExactLevel is finer than level 0.
+    ///
+    bool hasExactLevel() const;
+
+    ///
+    /// \brief Finest level whose buckets are not smaller than the given
+    ///        matrix rows and columns per pixel, or ExactLevel if the
+    ///        level 0 buckets are larger than a pixel.
+    ///
+    int levelFor(double rowsPerPixel, double columnsPerPixel) const;
+
+    ///
+    /// \brief Aggregate the buckets of <c>level</c> covering the matrix
+    ///        rows [firstRow, lastRow] and columns [firstColumn, lastColumn].
+    ///
+    void aggregate(int level, int firstRow, int lastRow,
+                   int firstColumn, int lastColumn,
+                   quint32 &count, double &maxAbs) const;
+
+    ///
+    /// \brief Aggregate the exact pattern into a raster, where pixel
+    ///        (x, y) covers the matrix rows <c>rows[y]</c> and columns
+    ///        <c>columns[x]</c>. Both range lists must be ascending.
+    /// \return The largest count of a pixel.
+    /// \remark Each pixel line scans the matrix rows it covers, whose
+    ///         entries need no particular order.
+    ///
+    quint32 rasterize(const QVector<QPair<int, int>> &rows,
+                      const QVector<QPair<int, int>> &columns,
+                      QVector<quint32> &counts,
+                      QVector<double> &maxAbs) const;
+
+private:
+    void buildBaseLevel(DataMatrix &matrix, qint64 maxBaseCells);
+
+    void buildLevel(const Level &previous);
+
+private:
+    int mRowCount = 0;
+    int mColumnCount = 0;
+    qint64 mNonZeros = 0;
+    double mMinimumAbs = 0.0;
+    double mMaximumAbs = 0.0;
+    bool mUseOutput = false;
+    QVector<Level> mLevels;
+
+    ///
+    /// \brief Matrix of the ExactLevel and the NL overlay of the output
+    ///        coefficients the levels were built with.
+    ///
+    DataMatrix *mMatrix = nullptr;
+    std::shared_ptr<const NlOverlay> mOverlay;
+};
+
+}
+}
+}
+
+#endif // SPARSITYPYRAMID_H
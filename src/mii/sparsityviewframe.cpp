@@ -0,0 +1,454 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "sparsityviewframe.h"
+#include "sparsitypyramid.h"
+#include "abstractmodelinstance.h"
+#include "numerics.h"
+
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHelpEvent>
+#include <QLabel>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <QVBoxLayout>
+#include <QWheelEvent>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+SparsityPlot::SparsityPlot(QWidget *parent)
+    : QWidget(parent)
+{
+    setMouseTracking(true);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+const QSharedPointer<SparsityPyramid> &SparsityPlot::pyramid() const
+{
+    return mPyramid;
+}
+
+void SparsityPlot::setPyramid(const QSharedPointer<SparsityPyramid> &pyramid)
+{
+    mPyramid = pyramid;
+    mZoom = 1.0;
+    mCenter = mPyramid ? QPointF(mPyramid->columnCount() / 2.0, mPyramid->rowCount() / 2.0)
+                       : QPointF();
+    mDirty = true;
+    update();
+}
+
+SparsityPlot::Mode SparsityPlot::mode() const
+{
+    return mMode;
+}
+
+void SparsityPlot::setMode(Mode mode)
+{
+    if (mMode == mode)
+        return;
+    mMode = mode;
+    mDirty = true;
+    update();
+}
+
+void SparsityPlot::setPlaceholderText(const QString &text)
+{
+    mPlaceholder = text;
+    update();
+}
+
+void SparsityPlot::zoomIn()
+{
+    setZoom(mZoom * ViewHelper::ZoomFactor, rect().center());
+}
+
+void SparsityPlot::zoomOut()
+{
+    setZoom(mZoom / ViewHelper::ZoomFactor, rect().center());
+}
+
+void SparsityPlot::resetZoom()
+{
+    setZoom(1.0, rect().center());
+}
+
+QRectF SparsityPlot::visibleArea() const
+{
+    if (!mPyramid || mPyramid->isEmpty())
+        return QRectF();
+    double width = mPyramid->columnCount() / mZoom;
+    double height = mPyramid->rowCount() / mZoom;
+    return QRectF(mCenter.x() - width / 2.0, mCenter.y() - height / 2.0, width, height);
+}
+
+bool SparsityPlot::event(QEvent *event)
+{
+    if (event->type() != QEvent::ToolTip)
+        return QWidget::event(event);
+    auto helpEvent = static_cast<QHelpEvent*>(event);
+    auto section = pixelSection(helpEvent->pos());
+    if (section.isEmpty()) {
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+    auto area = visibleArea();
+    int level = mPyramid->levelFor(area.height() / height(), area.width() / width());
+    quint32 count = 0;
+    double maxAbs = 0.0;
+    mPyramid->aggregate(level, section.top(), section.bottom(),
+                        section.left(), section.right(), count, maxAbs);
+    auto text = QString("%1: %2 - %3\n%4: %5 - %6\nNonzeros: %7\nMax |a|: %8")
+            .arg(ViewHelper::EquationHeaderText).arg(section.top()).arg(section.bottom())
+            .arg(ViewHelper::VariableHeaderText).arg(section.left()).arg(section.right())
+            .arg(count)
+            .arg(DoubleFormatter::format(maxAbs, DoubleFormatter::g, 6, true));
+    QToolTip::showText(helpEvent->globalPos(), text, this);
+    return true;
+}
+
+void SparsityPlot::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::white);
+    if (!mPyramid || mPyramid->isEmpty()) {
+        painter.drawText(rect(), Qt::AlignCenter, mPlaceholder);
+        return;
+    }
+    if (mDirty)
+        renderImage();
+    painter.drawImage(0, 0, mImage);
+}
+
+void SparsityPlot::resizeEvent(QResizeEvent *event)
+{
+    mDirty = true;
+    QWidget::resizeEvent(event);
+}
+
+void SparsityPlot::wheelEvent(QWheelEvent *event)
+{
+    double steps = event->angleDelta().y() / 120.0;
+    if (steps == 0.0)
+        return;
+    setZoom(mZoom * std::pow(WheelZoomFactor, steps), event->position());
+    event->accept();
+}
+
+void SparsityPlot::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        mPanning = true;
+        mLastPos = event->pos();
+        setCursor(Qt::ClosedHandCursor);
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void SparsityPlot::mouseMoveEvent(QMouseEvent *event)
+{
+    if (mPanning && mPyramid && width() > 0 && height() > 0) {
+        auto area = visibleArea();
+        auto delta = event->pos() - mLastPos;
+        mLastPos = event->pos();
+        mCenter -= QPointF(delta.x() * area.width() / width(),
+                           delta.y() * area.height() / height());
+        clampCenter();
+        mDirty = true;
+        update();
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void SparsityPlot::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        mPanning = false;
+        unsetCursor();
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void SparsityPlot::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    resetZoom();
+    QWidget::mouseDoubleClickEvent(event);
+}
+
+void SparsityPlot::setZoom(double zoom, const QPointF &anchor)
+{
+    if (!mPyramid || mPyramid->isEmpty() || width() <= 0 || height() <= 0)
+        return;
+    double maxZoom = std::max(1.0, (double)std::max(mPyramid->rowCount(), mPyramid->columnCount()));
+    zoom = std::clamp(zoom, 1.0, maxZoom);
+    if (zoom == mZoom)
+        return;
+    // keep the matrix position below the anchor fixed
+    double fx = anchor.x() / width() - 0.5;
+    double fy = anchor.y() / height() - 0.5;
+    auto area = visibleArea();
+    QPointF position(mCenter.x() + fx * area.width(), mCenter.y() + fy * area.height());
+    mZoom = zoom;
+    area = visibleArea();
+    mCenter = QPointF(position.x() - fx * area.width(), position.y() - fy * area.height());
+    clampCenter();
+    mDirty = true;
+    update();
+}
+
+void SparsityPlot::clampCenter()
+{
+    auto area = visibleArea();
+    double halfWidth = area.width() / 2.0;
+    double halfHeight = area.height() / 2.0;
+    mCenter.setX(std::clamp(mCenter.x(), halfWidth, mPyramid->columnCount() - halfWidth));
+    mCenter.setY(std::clamp(mCenter.y(), halfHeight, mPyramid->rowCount() - halfHeight));
+}
+
+QRect SparsityPlot::pixelSection(const QPoint &pos) const
+{
+    if (!mPyramid || mPyramid->isEmpty() || !rect().contains(pos))
+        return QRect();
+    auto area = visibleArea();
+    double columnsPerPixel = area.width() / width();
+    double rowsPerPixel = area.height() / height();
+    int firstColumn = (int)(area.left() + pos.x() * columnsPerPixel);
+    int lastColumn = std::max(firstColumn, (int)std::ceil(area.left() + (pos.x()+1) * columnsPerPixel) - 1);
+    int firstRow = (int)(area.top() + pos.y() * rowsPerPixel);
+    int lastRow = std::max(firstRow, (int)std::ceil(area.top() + (pos.y()+1) * rowsPerPixel) - 1);
+    return QRect(QPoint(firstColumn, firstRow),
+                 QPoint(std::min(lastColumn, mPyramid->columnCount()-1),
+                        std::min(lastRow, mPyramid->rowCount()-1)));
+}
+
+QRgb SparsityPlot::color(quint32 count, double maxAbs, quint32 maxCount) const
+{
+    if (!count)
+        return qRgb(255, 255, 255);
+    if (mMode == Density) {
+        double t = maxCount > 1 ? std::log1p((double)count) / std::log1p((double)maxCount) : 1.0;
+        t = std::clamp(t, 0.0, 1.0);
+        int shade = (int)(210.0 * (1.0 - t));
+        return qRgb(shade, shade, 45 + (int)(210.0 * (1.0 - t) * 0.8));
+    }
+    if (maxAbs <= 0.0)
+        return qRgb(190, 190, 190);
+    double minimum = std::log10(mPyramid->minimumAbs());
+    double maximum = std::log10(mPyramid->maximumAbs());
+    double t = maximum > minimum ? (std::log10(maxAbs) - minimum) / (maximum - minimum) : 1.0;
+    t = std::clamp(t, 0.0, 1.0);
+    return QColor::fromHsvF((1.0 - t) * 0.66, 1.0, 0.9).rgb();
+}
+
+void SparsityPlot::renderImage()
+{
+    mDirty = false;
+    int w = width();
+    int h = height();
+    if (w <= 0 || h <= 0)
+        return;
+    if (mImage.size() != size())
+        mImage = QImage(size(), QImage::Format_RGB32);
+    auto area = visibleArea();
+    int level = mPyramid->levelFor(area.height() / h, area.width() / w);
+
+    // matrix sections covered by each pixel column and row
+    QVector<QPair<int, int>> columns(w);
+    for (int x=0; x<w; ++x) {
+        auto section = pixelSection(QPoint(x, 0));
+        columns[x] = qMakePair(section.left(), section.right());
+    }
+    QVector<QPair<int, int>> rows(h);
+    for (int y=0; y<h; ++y) {
+        auto section = pixelSection(QPoint(0, y));
+        rows[y] = qMakePair(section.top(), section.bottom());
+    }
+
+    if (level == SparsityPyramid::ExactLevel) {
+        // zoomed in below the base buckets, draw the exact pattern
+        QVector<quint32> counts;
+        QVector<double> maxAbs;
+        quint32 maxCount = mPyramid->rasterize(rows, columns, counts, maxAbs);
+        for (int y=0; y<h; ++y) {
+            auto line = reinterpret_cast<QRgb*>(mImage.scanLine(y));
+            for (int x=0; x<w; ++x)
+                line[x] = color(counts.at(y*w + x), maxAbs.at(y*w + x), maxCount);
+        }
+        return;
+    }
+
+    quint32 maxCount = mPyramid->level(level).MaxCount;
+    quint32 count = 0;
+    double maxAbs = 0.0;
+    for (int y=0; y<h; ++y) {
+        auto line = reinterpret_cast<QRgb*>(mImage.scanLine(y));
+        for (int x=0; x<w; ++x) {
+            mPyramid->aggregate(level, rows[y].first, rows[y].second,
+                                columns[x].first, columns[x].second, count, maxAbs);
+            line[x] = color(count, maxAbs, maxCount);
+        }
+    }
+}
+
+SparsityViewFrame::SparsityViewFrame(QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mViewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::defaultConfiguration());
+    setupUi();
+}
+
+SparsityViewFrame::SparsityViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                                     const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                                     QWidget *parent, Qt::WindowFlags f)
+    : AbstractViewFrame(parent, f)
+{
+    mModelInstance = modelInstance;
+    mViewConfig = viewConfig;
+    setupUi();
+}
+
+SparsityViewFrame::~SparsityViewFrame()
+{
+    mPyramidWatcher.waitForFinished();
+}
+
+AbstractViewFrame *SparsityViewFrame::clone(int viewId)
+{
+    auto viewConfig = QSharedPointer<AbstractViewConfiguration>(ViewConfigurationProvider::configuration(type(),
+                                                                                                         mModelInstance));
+    viewConfig->setViewId(viewId);
+    auto frame = new SparsityViewFrame(mModelInstance, viewConfig, parentWidget(), windowFlags());
+    frame->mModeBox->setCurrentIndex(mModeBox->currentIndex());
+    if (mPyramidWatcher.isRunning()) {
+        frame->setupView(mModelInstance);
+    } else {
+        frame->mPlot->setPyramid(mPlot->pyramid());
+        frame->updateInfo();
+    }
+    return frame;
+}
+
+void SparsityViewFrame::setShowAbsoluteValues(bool absoluteValues)
+{// the raster always shows absolute values
+    Q_UNUSED(absoluteValues);
+}
+
+void SparsityViewFrame::zoomIn()
+{
+    mPlot->zoomIn();
+}
+
+void SparsityViewFrame::zoomOut()
+{
+    mPlot->zoomOut();
+}
+
+void SparsityViewFrame::resetZoom()
+{
+    mPlot->resetZoom();
+}
+
+SearchResult &SparsityViewFrame::search(const QString &term, bool isRegEx)
+{
+    mViewConfig->searchResult().Term = term;
+    mViewConfig->searchResult().IsRegEx = isRegEx;
+    mViewConfig->searchResult().Entries.clear();
+    return mViewConfig->searchResult();
+}
+
+void SparsityViewFrame::setSearchSelection(const SearchResult::SearchEntry &result)
+{
+    Q_UNUSED(result);
+}
+
+void SparsityViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &modelInstance)
+{
+    mModelInstance = modelInstance;
+    mPlot->setPyramid(QSharedPointer<SparsityPyramid>());
+    mPlot->setPlaceholderText("Loading sparsity pattern...");
+    mInfoLabel->clear();
+    auto loadPyramid = [modelInstance]{
+        return modelInstance->sparsityPyramid();
+    };
+    mPyramidWatcher.setFuture(QtConcurrent::run(loadPyramid));
+}
+
+bool SparsityViewFrame::hasData() const
+{
+    return mPyramidWatcher.isRunning() ||
+            (mPlot->pyramid() && !mPlot->pyramid()->isEmpty());
+}
+
+void SparsityViewFrame::pyramidLoaded()
+{
+    mPlot->setPlaceholderText("No Jacobian data available.");
+    mPlot->setPyramid(mPyramidWatcher.result());
+    updateInfo();
+}
+
+void SparsityViewFrame::setupUi()
+{
+    mPlot = new SparsityPlot(this);
+    mModeBox = new QComboBox(this);
+    mModeBox->addItem("Density", SparsityPlot::Density);
+    mModeBox->addItem("Magnitude", SparsityPlot::Magnitude);
+    mModeBox->setToolTip("Color by the number of nonzeros or by the maximum absolute coefficient per pixel");
+    mInfoLabel = new QLabel(this);
+    auto controls = new QHBoxLayout;
+    controls->addWidget(new QLabel("Color by", this));
+    controls->addWidget(mModeBox);
+    controls->addStretch();
+    controls->addWidget(mInfoLabel);
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(controls);
+    layout->addWidget(mPlot);
+    connect(mModeBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this]{ mPlot->setMode((SparsityPlot::Mode)mModeBox->currentData().toInt()); });
+    connect(&mPyramidWatcher, &QFutureWatcher<QSharedPointer<SparsityPyramid>>::finished,
+            this, &SparsityViewFrame::pyramidLoaded);
+}
+
+void SparsityViewFrame::updateInfo()
+{
+    auto pyramid = mPlot->pyramid();
+    if (!pyramid || pyramid->isEmpty()) {
+        mInfoLabel->clear();
+        return;
+    }
+    mInfoLabel->setText(QString("%1 x %2, %3 nonzeros, |a| in [%4, %5]")
+                        .arg(pyramid->rowCount()).arg(pyramid->columnCount())
+                        .arg(pyramid->nonZeros())
+                        .arg(DoubleFormatter::format(pyramid->minimumAbs(), DoubleFormatter::g, 6, true),
+                             DoubleFormatter::format(pyramid->maximumAbs(), DoubleFormatter::g, 6, true)));
+}
+
+}
+}
+}
@@ -0,0 +1,179 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef SPARSITYVIEWFRAME_H
+#define SPARSITYVIEWFRAME_H
+
+#include "abstractviewframe.h"
+
+#include <QFutureWatcher>
+#include <QImage>
+
+class QComboBox;
+class QLabel;
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class SparsityPyramid;
+
+///
+/// \brief Raster of the full Jacobian, drawn from a SparsityPyramid.
+///
+/// Every pixel reads a constant number of pyramid buckets, so zooming
+/// and panning only depend on the widget size and not on the number of
+/// nonzeros. Zoomed in below the base buckets the plot is drawn from the
+/// exact pattern, which only touches the rows in view.
+///
+class SparsityPlot final : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum Mode
+    {
+        Density,
+        Magnitude
+    };
+
+    SparsityPlot(QWidget *parent = nullptr);
+
+    const QSharedPointer<SparsityPyramid>& pyramid() const;
+
+    void setPyramid(const QSharedPointer<SparsityPyramid> &pyramid);
+
+    Mode mode() const;
+
+    void setMode(Mode mode);
+
+    void setPlaceholderText(const QString &text);
+
+    void zoomIn();
+
+    void zoomOut();
+
+    void resetZoom();
+
+    ///
+    /// \brief Visible part of the matrix, where x are columns (variables)
+    ///        and y are rows (equations).
+    ///
+    QRectF visibleArea() const;
+
+protected:
+    bool event(QEvent *event) override;
+
+    void paintEvent(QPaintEvent *event) override;
+
+    void resizeEvent(QResizeEvent *event) override;
+
+    void wheelEvent(QWheelEvent *event) override;
+
+    void mousePressEvent(QMouseEvent *event) override;
+
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    void setZoom(double zoom, const QPointF &anchor);
+
+    void clampCenter();
+
+    QRect pixelSection(const QPoint &pos) const;
+
+    QRgb color(quint32 count, double maxAbs, quint32 maxCount) const;
+
+    void renderImage();
+
+private:
+    static constexpr double WheelZoomFactor = 1.25;
+
+    QSharedPointer<SparsityPyramid> mPyramid;
+    Mode mMode = Density;
+    double mZoom = 1.0;
+    QPointF mCenter;
+    QPoint mLastPos;
+    bool mPanning = false;
+    QImage mImage;
+    bool mDirty = true;
+    QString mPlaceholder;
+};
+
+class SparsityViewFrame final : public AbstractViewFrame
+{
+    Q_OBJECT
+
+public:
+    SparsityViewFrame(QWidget *parent = nullptr,
+                      Qt::WindowFlags f = Qt::WindowFlags());
+
+    SparsityViewFrame(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                      const QSharedPointer<AbstractViewConfiguration> &viewConfig,
+                      QWidget *parent = nullptr,
+                      Qt::WindowFlags f = Qt::WindowFlags());
+
+    ~SparsityViewFrame() override;
+
+    AbstractViewFrame* clone(int viewId) override;
+
+    void setShowAbsoluteValues(bool absoluteValues) override;
+
+    inline ViewHelper::ViewDataType type() const override
+    {
+        return ViewHelper::ViewDataType::BP_Sparsity;
+    }
+
+    void zoomIn() override;
+
+    void zoomOut() override;
+
+    void resetZoom() override;
+
+    SearchResult& search(const QString &term, bool isRegEx) override;
+
+    void setSearchSelection(const SearchResult::SearchEntry &result) override;
+
+    void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
+
+    bool hasData() const override;
+
+private slots:
+    void pyramidLoaded();
+
+private:
+    void setupUi();
+
+    void updateInfo();
+
+private:
+    SparsityPlot *mPlot;
+    QComboBox *mModeBox;
+    QLabel *mInfoLabel;
+    QFutureWatcher<QSharedPointer<SparsityPyramid>> mPyramidWatcher;
+};
+
+}
+}
+}
+
+#endif // SPARSITYVIEWFRAME_H
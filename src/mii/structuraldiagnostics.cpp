@@ -0,0 +1,333 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "structuraldiagnostics.h"
+#include "datamatrix.h"
+
+#include <QHash>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+///
+/// \brief Sections of one parallel task and the findings of these sections.
+///
+struct DiagnosticsBlock
+{
+    int First = 0;
+    int Last = -1;
+    QVector<StructuralFinding> Findings;
+};
+
+static const int SectionsPerTask = 1024;
+
+static QVector<DiagnosticsBlock> diagnosticsBlocks(int sections)
+{
+    QVector<DiagnosticsBlock> blocks;
+    for (int first=0; first<sections; first+=SectionsPerTask) {
+        DiagnosticsBlock block;
+        block.First = first;
+        block.Last = std::min(first+SectionsPerTask, sections)-1;
+        blocks.append(block);
+    }
+    return blocks;
+}
+
+///
+/// \brief Signature of one row or column.
+///
+struct SectionSignature
+{
+    ///
+    /// \brief Hash of the pattern and the normalized coefficients, where 0
+    ///        means the section isn't checked for duplicates.
+    ///
+    quint64 Hash = 0;
+
+    ///
+    /// \brief First nonzero coefficient, which normalizes the section.
+    ///
+    double Pivot = 0.0;
+};
+
+static inline void mixHash(quint64 &hash, quint64 value)
+{// splitmix64 finalizer of the combined value
+    value += hash + 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    hash = value ^ (value >> 31);
+}
+
+static SectionSignature signature(const int *index, const double *values, int size)
+{
+    SectionSignature signature;
+    if (size < 2)
+        return signature;
+    for (int i=0; i<size && signature.Pivot == 0.0; ++i)
+        signature.Pivot = values[i];
+    if (signature.Pivot == 0.0 || !std::isfinite(signature.Pivot))
+        return signature;
+    quint64 hash = quint64(size);
+    for (int i=0; i<size; ++i) {
+        double value = values[i] / signature.Pivot;
+        if (!std::isfinite(value))
+            return signature;
+        if (value == 0.0)
+            value = 0.0; // no -0.0
+        quint64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        mixHash(hash, quint64(index[i]));
+        // round away the last 20 bits of the mantissa, which may differ
+        // after the normalization of parallel sections
+        mixHash(hash, (bits + (quint64(1) << 19)) >> 20);
+    }
+    signature.Hash = hash ? hash : 1;
+    return signature;
+}
+
+static bool isParallel(const int *indexA, const double *valuesA, double pivotA,
+                       const int *indexB, const double *valuesB, double pivotB, int size)
+{
+    for (int i=0; i<size; ++i) {
+        if (indexA[i] != indexB[i])
+            return false;
+        const double a = valuesA[i] / pivotA;
+        const double b = valuesB[i] / pivotB;
+        if (std::abs(a - b) > StructuralDiagnostics::Tolerance * std::max(std::abs(a), std::abs(b)))
+            return false;
+    }
+    return true;
+}
+
+///
+/// \brief Compressed column copy of the matrix.
+///
+struct ColumnMatrix
+{
+    QVector<qint64> Start;
+    QVector<int> RowIndex;
+    QVector<double> Values;
+    QVector<char> IsNonlinear;
+};
+
+static void buildColumnMatrix(DataMatrix &matrix, bool useOutput, ColumnMatrix &columns)
+{
+    const int columnCount = matrix.columnCount();
+    columns.Start.fill(0, columnCount+1);
+    columns.IsNonlinear.fill(0, columnCount);
+    for (int r=0; r<matrix.rowCount(); ++r) {
+        auto row = matrix.row(r);
+        for (int e=0; e<row->entries(); ++e) {
+            if (row->colIdx()[e] < columnCount)
+                ++columns.Start[row->colIdx()[e]+1];
+        }
+    }
+    for (int c=0; c<columnCount; ++c)
+        columns.Start[c+1] += columns.Start[c];
+    columns.RowIndex.resize(columns.Start.constLast());
+    columns.Values.resize(columns.Start.constLast());
+    QVector<qint64> next(columns.Start);
+    auto values = matrix.values(useOutput);
+    for (int r=0; r<matrix.rowCount(); ++r) {
+        auto row = matrix.row(r);
+        auto data = values.row(r);
+        for (int e=0; e<row->entries(); ++e) {
+            const int column = row->colIdx()[e];
+            if (column >= columnCount)
+                continue;
+            const qint64 index = next[column]++;
+            columns.RowIndex[index] = r;
+            columns.Values[index] = data ? data[e] : 0.0;
+            if (row->isNonlinear(e))
+                columns.IsNonlinear[column] = 1;
+        }
+    }
+}
+
+QVector<StructuralFinding> StructuralDiagnostics::run(DataMatrix &matrix,
+                                                      bool useOutput,
+                                                      const QByteArray &equationTypes,
+                                                      const QVector<double> &lower,
+                                                      const QVector<double> &upper)
+{
+    QVector<StructuralFinding> findings;
+    const int rows = matrix.rowCount();
+    const int columns = matrix.columnCount();
+
+    QVector<SectionSignature> rowSignatures(rows);
+    SectionSignature *rowSignature = rowSignatures.data();
+    auto rowBlocks = diagnosticsBlocks(rows);
+    QtConcurrent::blockingMap(rowBlocks, [&matrix, &equationTypes, rowSignature](DiagnosticsBlock &block) {
+        for (int r=block.First; r<=block.Last; ++r) {
+            auto row = matrix.row(r);
+            const bool isFree = r < equationTypes.size() && equationTypes.at(r) == 'N';
+            StructuralFinding finding;
+            finding.Section = r;
+            if (!row->entries()) {
+                finding.Type = StructuralFinding::EmptyRow;
+                block.Findings.append(finding);
+            } else if (row->entries() == 1 && !isFree) {
+                finding.Type = StructuralFinding::SingletonRow;
+                block.Findings.append(finding);
+            }
+            if (isFree) {
+                finding.Type = StructuralFinding::FreeRow;
+                block.Findings.append(finding);
+            }
+            if (!row->inputData() || row->nlFlags().any())
+                continue;
+            // linear rows have no NL overlay, so input and output data match
+            rowSignature[r] = signature(row->colIdx(), row->inputData(), row->entries());
+        }
+    });
+
+    ColumnMatrix columnMatrix;
+    buildColumnMatrix(matrix, useOutput, columnMatrix);
+    QVector<SectionSignature> columnSignatures(columns);
+    SectionSignature *columnSignature = columnSignatures.data();
+    const qint64 *start = columnMatrix.Start.constData();
+    const int *rowIndex = columnMatrix.RowIndex.constData();
+    const double *values = columnMatrix.Values.constData();
+    const char *isNonlinear = columnMatrix.IsNonlinear.constData();
+    const bool hasBounds = lower.size() >= columns && upper.size() >= columns;
+    const double *lowerBound = lower.constData();
+    const double *upperBound = upper.constData();
+    auto columnBlocks = diagnosticsBlocks(columns);
+    QtConcurrent::blockingMap(columnBlocks, [start, rowIndex, values, isNonlinear, hasBounds,
+                                             lowerBound, upperBound, columnSignature](DiagnosticsBlock &block) {
+        for (int c=block.First; c<=block.Last; ++c) {
+            StructuralFinding finding;
+            finding.Section = c;
+            const int size = int(start[c+1] - start[c]);
+            if (!size) {
+                finding.Type = StructuralFinding::EmptyColumn;
+                block.Findings.append(finding);
+            }
+            if (hasBounds && lowerBound[c] == upperBound[c]) {
+                finding.Type = StructuralFinding::FixedVariable;
+                block.Findings.append(finding);
+            }
+            if (!isNonlinear[c])
+                columnSignature[c] = signature(rowIndex+start[c], values+start[c], size);
+        }
+    });
+
+    for (const auto& block : std::as_const(rowBlocks))
+        findings.append(block.Findings);
+    for (const auto& block : std::as_const(columnBlocks))
+        findings.append(block.Findings);
+
+    QHash<quint64, int> firstRows;
+    for (int r=0; r<rows; ++r) {
+        if (!rowSignature[r].Hash)
+            continue;
+        auto first = firstRows.constFind(rowSignature[r].Hash);
+        if (first == firstRows.constEnd()) {
+            firstRows.insert(rowSignature[r].Hash, r);
+            continue;
+        }
+        auto row = matrix.row(r);
+        auto original = matrix.row(first.value());
+        if (row->entries() != original->entries() ||
+                !isParallel(row->colIdx(), row->inputData(), rowSignature[r].Pivot,
+                            original->colIdx(), original->inputData(),
+                            rowSignature[first.value()].Pivot, row->entries()))
+            continue;
+        StructuralFinding finding;
+        finding.Type = StructuralFinding::DuplicateRow;
+        finding.Section = r;
+        finding.Original = first.value();
+        finding.Factor = rowSignature[r].Pivot / rowSignature[first.value()].Pivot;
+        findings.append(finding);
+    }
+
+    QHash<quint64, int> firstColumns;
+    for (int c=0; c<columns; ++c) {
+        if (!columnSignature[c].Hash)
+            continue;
+        auto first = firstColumns.constFind(columnSignature[c].Hash);
+        if (first == firstColumns.constEnd()) {
+            firstColumns.insert(columnSignature[c].Hash, c);
+            continue;
+        }
+        const int o = first.value();
+        const int size = int(start[c+1] - start[c]);
+        if (size != int(start[o+1] - start[o]) ||
+                !isParallel(rowIndex+start[c], values+start[c], columnSignature[c].Pivot,
+                            rowIndex+start[o], values+start[o], columnSignature[o].Pivot, size))
+            continue;
+        StructuralFinding finding;
+        finding.Type = StructuralFinding::DuplicateColumn;
+        finding.Section = c;
+        finding.Original = o;
+        finding.Factor = columnSignature[c].Pivot / columnSignature[o].Pivot;
+        findings.append(finding);
+    }
+
+    // the view shows the entries without going back to the Jacobian
+    for (auto& finding : findings) {
+        if (finding.isRow()) {
+            auto row = matrix.row(finding.Section);
+            finding.Entries.resize(row->entries());
+            std::copy(row->colIdx(), row->colIdx()+row->entries(), finding.Entries.begin());
+        } else {
+            const qint64 first = start[finding.Section];
+            finding.Entries.resize(int(start[finding.Section+1] - first));
+            std::copy(rowIndex+first, rowIndex+start[finding.Section+1], finding.Entries.begin());
+        }
+    }
+
+    std::stable_sort(findings.begin(), findings.end(),
+                     [](const StructuralFinding &a, const StructuralFinding &b) {
+        return a.Type < b.Type;
+    });
+    return findings;
+}
+
+QString StructuralDiagnostics::kindText(StructuralFinding::Kind kind)
+{
+    switch (kind) {
+    case StructuralFinding::EmptyRow:
+        return "Empty row";
+    case StructuralFinding::EmptyColumn:
+        return "Empty column";
+    case StructuralFinding::SingletonRow:
+        return "Singleton row";
+    case StructuralFinding::FixedVariable:
+        return "Fixed variable";
+    case StructuralFinding::FreeRow:
+        return "Free row";
+    case StructuralFinding::DuplicateRow:
+        return "Duplicate row";
+    case StructuralFinding::DuplicateColumn:
+        return "Duplicate column";
+    }
+    return QString();
+}
+
+}
+}
+}
@@ -0,0 +1,124 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef STRUCTURALDIAGNOSTICS_H
+#define STRUCTURALDIAGNOSTICS_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class DataMatrix;
+
+struct StructuralFinding
+{
+    enum Kind : std::uint8_t
+    {
+        EmptyRow,
+        EmptyColumn,
+        SingletonRow,
+        FixedVariable,
+        FreeRow,
+        DuplicateRow,
+        DuplicateColumn
+    };
+
+    static constexpr int KindCount = DuplicateColumn + 1;
+
+    Kind Type = EmptyRow;
+
+    ///
+    /// \brief Equation section of row findings or variable section of
+    ///        column findings.
+    ///
+    int Section = -1;
+
+    ///
+    /// \brief First section with the same normalized signature, only set
+    ///        for duplicates.
+    ///
+    int Original = -1;
+
+    ///
+    /// \brief Section is Factor times Original, where 1 marks an exact
+    ///        duplicate and any other value a parallel row or column.
+    ///
+    double Factor = 1.0;
+
+    ///
+    /// \brief Variable sections of the entries of a row finding or equation
+    ///        sections of the entries of a column finding.
+    ///
+    QVector<int> Entries;
+
+    bool isRow() const
+    {
+        return Type == EmptyRow || Type == SingletonRow ||
+               Type == FreeRow || Type == DuplicateRow;
+    }
+};
+
+///
+/// \brief GAMSCHK like structural checks of the Jacobian.
+///
+/// Finds empty rows and columns, singleton rows, fixed variables, free
+/// rows and duplicate or parallel rows and columns. Rows and columns are
+/// checked in parallel blocks. Duplicates are found by hashing the
+/// sparsity pattern together with the coefficients normalized by the
+/// first coefficient, where candidates with equal hashes are compared
+/// exactly (within a relative tolerance) against the first section of
+/// their hash. Rows and columns with nonlinear entries or less than two
+/// entries aren't checked for duplicates.
+///
+class StructuralDiagnostics final
+{
+public:
+    ///
+    /// \brief Relative tolerance of the normalized coefficients of duplicates.
+    ///
+    static constexpr double Tolerance = 1e-9;
+
+    ///
+    /// \brief Run all checks.
+    /// \param useOutput Use the output (evaluated) coefficients if available.
+    /// \param equationTypes GAMS equation type per row, e.g. <c>'N'</c>.
+    /// \param lower Variable lower bounds, may be empty.
+    /// \param upper Variable upper bounds, may be empty.
+    /// \return Findings ordered by kind and section.
+    ///
+    static QVector<StructuralFinding> run(DataMatrix &matrix,
+                                          bool useOutput,
+                                          const QByteArray &equationTypes,
+                                          const QVector<double> &lower,
+                                          const QVector<double> &upper);
+
+    static QString kindText(StructuralFinding::Kind kind);
+};
+
+}
+}
+}
+
+#endif // STRUCTURALDIAGNOSTICS_H
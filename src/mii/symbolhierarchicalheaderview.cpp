@@ -21,7 +21,9 @@
 #include "abstractmodelinstance.h"
 #include "viewconfigurationprovider.h"
 
+#include <QCache>
 #include <QPainter>
+#include <QPixmap>
 #include <QPointer>
 #include <QMenu>
 #include <QMouseEvent>
@@ -36,14 +38,60 @@ namespace mii {
 class SymbolHierarchicalHeaderView::HierarchicalHeaderView_private
 {
 public:
+    ///
+    /// \brief Texts of all cells of a header section, where the first text
+    ///        is the symbol name followed by the labels of each dimension.
+    ///
+    struct SectionLayout
+    {
+        int SectionIndex = -1;
+        QStringList Texts;
+
+        ///
+        /// \brief Cell repeats the text of the previous section and is
+        ///        only labeled if it is the first visible section.
+        ///
+        QVector<bool> Repeated;
+    };
+
+    ///
+    /// \brief Rendered section and the state it was rendered for.
+    ///
+    struct SectionPixmap
+    {
+        QPixmap Pixmap;
+        QSize Size;
+        QStyle::State State;
+        int Position = 0;
+        int SelectedPosition = 0;
+        bool FirstVisible = false;
+    };
+
+    static const int LayoutCacheSize = 8192;
+    static const int PixmapCacheSize = 16384; // KiB
+
     HierarchicalHeaderView_private(const SymbolHierarchicalHeaderView *headerView)
         : mHeaderView(headerView)
         , mTextFlags(Qt::TextSingleLine | Qt::TextDontClip | Qt::TextIncludeTrailingSpaces)
+    {
+        mLayouts.setMaxCost(LayoutCacheSize);
+        mPixmaps.setMaxCost(PixmapCacheSize);
+        updateCellSizes();
+    }
+
+    void updateCellSizes()
     {
         mSymbolCellSize = symbolTextSize();
         mLabelCellSize = labelTextSize();
     }
 
+    void invalidate()
+    {
+        mLayouts.clear();
+        mPixmaps.clear();
+        mMaximumSymbolDimension = -1;
+    }
+
     int sectionIndex(int logicalIndex) const
     {
         bool ok = false;
@@ -52,21 +100,78 @@ public:
         return !ok ? -1 : index;
     }
 
-    int horizontalSectionDimension(int sectionIndex)
+    const SectionLayout* layout(int logicalIndex)
     {
-        return symbol(sectionIndex)->dimension();
+        if (auto layout = mLayouts.object(logicalIndex))
+            return layout;
+        auto layout = new SectionLayout;
+        layout->SectionIndex = sectionIndex(logicalIndex);
+        auto currentSym = layout->SectionIndex < 0 ? nullptr : symbol(layout->SectionIndex);
+        if (currentSym) {
+            int prevSectionIdx = logicalIndex > 0 ? sectionIndex(logicalIndex-1) : -1;
+            bool continued = logicalIndex > 0 && currentSym->contains(prevSectionIdx);
+            layout->Texts.append(currentSym->name());
+            layout->Repeated.append(continued);
+            for (int d=0; d<currentSym->dimension(); ++d) {
+                layout->Texts.append(currentSym->label(layout->SectionIndex, d));
+                layout->Repeated.append(continued &&
+                                        layout->Texts.at(d+1) == currentSym->label(prevSectionIdx, d) &&
+                                        (d == 0 || layout->Texts.at(d) == currentSym->label(prevSectionIdx, d-1)));
+            }
+        }
+        mLayouts.insert(logicalIndex, layout);
+        return layout;
     }
 
-    int verticalSectionDimension(int sectionIndex)
+    void paintSection(QPainter *painter,
+                      const QRect &rect,
+                      const QStyleOptionHeader &option,
+                      int logicalIndex,
+                      const SectionLayout *layout)
     {
-        return symbol(sectionIndex)->dimension();
+        bool firstVisible = mHeaderView->sectionViewportPosition(logicalIndex) <= 0;
+        auto cached = mPixmaps.object(logicalIndex);
+        if (!cached || cached->Size != rect.size() || cached->State != option.state ||
+                cached->Position != option.position ||
+                cached->SelectedPosition != option.selectedPosition ||
+                cached->FirstVisible != firstVisible) {
+            auto ratio = mHeaderView->devicePixelRatioF();
+            cached = new SectionPixmap;
+            cached->Pixmap = QPixmap(rect.size() * ratio);
+            cached->Pixmap.setDevicePixelRatio(ratio);
+            cached->Pixmap.fill(Qt::transparent);
+            cached->Size = rect.size();
+            cached->State = option.state;
+            cached->Position = option.position;
+            cached->SelectedPosition = option.selectedPosition;
+            cached->FirstVisible = firstVisible;
+            QPainter pixmapPainter(&cached->Pixmap);
+            pixmapPainter.setFont(painter->font());
+            QRect pixmapRect(QPoint(0, 0), rect.size());
+            if (mHeaderView->orientation() == Qt::Horizontal)
+                paintHorizontalSection(&pixmapPainter, pixmapRect, option, layout, firstVisible);
+            else
+                paintVerticalSection(&pixmapPainter, pixmapRect, option, layout, firstVisible);
+            pixmapPainter.end();
+            int cost = std::max(1, (int)(cached->Pixmap.width() * cached->Pixmap.height() *
+                                         cached->Pixmap.depth() / 8 / 1024));
+            if (!mPixmaps.insert(logicalIndex, cached, cost)) {
+                // larger than the whole cache, just paint it directly
+                if (mHeaderView->orientation() == Qt::Horizontal)
+                    paintHorizontalSection(painter, rect, option, layout, firstVisible);
+                else
+                    paintVerticalSection(painter, rect, option, layout, firstVisible);
+                return;
+            }
+        }
+        painter->drawPixmap(rect.topLeft(), cached->Pixmap);
     }
 
     void paintHorizontalSection(QPainter *painter,
                                 const QRect &rect,
                                 const QStyleOptionHeader &option,
-                                int logicalIndex,
-                                int sectionIndex)
+                                const SectionLayout *layout,
+                                bool firstVisible)
     {
         int currentTop = rect.y();
         QPointF oldBrushOrigin(painter->brushOrigin());
@@ -78,13 +183,11 @@ public:
             styleOption.state &= (~state);
         }
 
-        paintHorizontalCell(painter, rect, styleOption, currentTop, label(sectionIndex, -1),
-                            logicalIndex, sectionIndex, -1, true);
-        for (int d=0; d<horizontalSectionDimension(sectionIndex); ++d) {
-            paintHorizontalCell(painter, rect, styleOption, currentTop, label(sectionIndex, d),
-                                logicalIndex, sectionIndex, d, false);
+        for (int i=0; i<layout->Texts.size(); ++i) {
+            paintHorizontalCell(painter, rect, styleOption, currentTop,
+                                cellText(layout, i, firstVisible));
         }
-        paintHorizontalCellSpacing(painter, rect, styleOption, currentTop, sectionIndex);
+        paintHorizontalCellSpacing(painter, rect, styleOption, currentTop, layout);
 
         painter->setBrushOrigin(oldBrushOrigin);
     }
@@ -93,18 +196,13 @@ public:
                              const QRect &rect,
                              const QStyleOptionHeader &option,
                              int &currentTop,
-                             const QString &text,
-                             int logicalIndex,
-                             int sectionIndex,
-                             int dimension,
-                             bool isSymbol)
+                             const QString &text)
     {
         QStyleOptionHeader styleOption(option);
         painter->save();
         QSize size = labelCellSize(styleOption);
         styleOption.rect = QRect(rect.x(), currentTop, rect.width(), size.height());
-        auto currentSym = symbol(sectionIndex);
-        styleOption.text = horizontalCellText(logicalIndex, sectionIndex, dimension, isSymbol, currentSym, text);
+        styleOption.text = text;
         mHeaderView->style()->drawControl(QStyle::CE_HeaderSection, &styleOption, painter, mHeaderView);
         mHeaderView->style()->drawControl(QStyle::CE_HeaderLabel, &styleOption, painter, mHeaderView);
         currentTop += size.height();
@@ -115,11 +213,11 @@ public:
                                     const QRect &rect,
                                     const QStyleOptionHeader &option,
                                     int &currentTop,
-                                    int sectionIndex)
+                                    const SectionLayout *layout)
     {
         QStyleOptionHeader styleOption(option);
         painter->save();
-        if (horizontalSectionDimension(sectionIndex) < maximumSymbolDimension()) {
+        if (layout->Texts.size()-1 < maximumSymbolDimension()) {
             styleOption.rect = QRect(rect.x(), currentTop, rect.width(), rect.height());
             mHeaderView->style()->drawControl(QStyle::CE_HeaderSection, &styleOption, painter, mHeaderView);
         }
@@ -129,8 +227,8 @@ public:
     void paintVerticalSection(QPainter *painter,
                               const QRect &rect,
                               const QStyleOptionHeader &option,
-                              int logicalIndex,
-                              int sectionIndex)
+                              const SectionLayout *layout,
+                              bool firstVisible)
     {
         int currentLeft = rect.x();
         QPointF oldBrushOrigin(painter->brushOrigin());
@@ -142,13 +240,11 @@ public:
             styleOption.state &= (~state);
         }
 
-        paintVerticalCell(painter, rect, styleOption, currentLeft, label(sectionIndex, -1),
-                          logicalIndex, sectionIndex, -1, true);
-        for (int d=0; d<verticalSectionDimension(sectionIndex); ++d) {
-            paintVerticalCell(painter, rect, styleOption, currentLeft, label(sectionIndex, d),
-                              logicalIndex, sectionIndex, d, false);
+        for (int i=0; i<layout->Texts.size(); ++i) {
+            paintVerticalCell(painter, rect, styleOption, currentLeft,
+                              cellText(layout, i, firstVisible), i == 0);
         }
-        paintVerticalCellSpacing(painter, rect, styleOption, currentLeft, sectionIndex);
+        paintVerticalCellSpacing(painter, rect, styleOption, currentLeft, layout);
 
         painter->setBrushOrigin(oldBrushOrigin);
     }
@@ -158,17 +254,13 @@ public:
                            const QStyleOptionHeader &option,
                            int &currentLeft,
                            const QString &text,
-                           int logicalIndex,
-                           int sectionIndex,
-                           int dimension,
                            bool isSymbol)
     {
         QStyleOptionHeader styleOption(option);
         painter->save();
         QSize size = isSymbol ? mSymbolCellSize : mLabelCellSize;
         styleOption.rect = QRect(currentLeft, rect.y(), size.width(), rect.height());
-        auto currentSym = symbol(sectionIndex);
-        styleOption.text = verticalCellText(logicalIndex, sectionIndex, dimension, isSymbol, currentSym, text);
+        styleOption.text = text;
         mHeaderView->style()->drawControl(QStyle::CE_HeaderSection, &styleOption, painter, mHeaderView);
         mHeaderView->style()->drawControl(QStyle::CE_HeaderLabel, &styleOption, painter, mHeaderView);
         currentLeft += size.width();
@@ -179,63 +271,22 @@ public:
                                   const QRect &rect,
                                   const QStyleOptionHeader &option,
                                   int &currentLeft,
-                                  int sectionIndex)
+                                  const SectionLayout *layout)
     {
         QStyleOptionHeader styleOption(option);
         painter->save();
-        if (verticalSectionDimension(sectionIndex) < maximumSymbolDimension()) {
+        if (layout->Texts.size()-1 < maximumSymbolDimension()) {
             styleOption.rect = QRect(currentLeft, rect.y(), rect.width(), rect.height());
             mHeaderView->style()->drawControl(QStyle::CE_HeaderSection, &styleOption, painter, mHeaderView);
         }
         painter->restore();
     }
 
-    QString horizontalCellText(int logicalIndex, int sectionIndex, int dimension,
-                               bool isSymbol, const Symbol *symbol,
-                               const QString &text)
-    {
-        if (isSymbol && logicalIndex > 0) {
-            if (mHeaderView->sectionViewportPosition(logicalIndex) <= 0)
-                return text;
-            int prevSectionIdx = this->sectionIndex(logicalIndex-1);
-            if (symbol && symbol->contains(prevSectionIdx))
-                return QString();
-        } else if (logicalIndex > 0) {
-            if (mHeaderView->sectionViewportPosition(logicalIndex) <= 0)
-                return text;
-            int prevSectionIdx = this->sectionIndex(logicalIndex-1);
-            if (symbol && symbol->contains(prevSectionIdx) &&
-                    symbol->label(sectionIndex, dimension) == symbol->label(prevSectionIdx, dimension) &&
-                        (dimension == 0 ||
-                            symbol->label(sectionIndex, dimension-1) == symbol->label(prevSectionIdx, dimension-1))) {
-                    return QString();
-            }
-        }
-        return text;
-    }
-
-    QString verticalCellText(int logicalIndex, int sectionIndex, int dimension,
-                             bool isSymbol, const Symbol *symbol,
-                             const QString &text)
+    QString cellText(const SectionLayout *layout, int cell, bool firstVisible) const
     {
-        if (isSymbol && logicalIndex > 0) {
-            if (mHeaderView->sectionViewportPosition(logicalIndex) <= 0)
-                return text;
-            int prevSectionIdx = this->sectionIndex(logicalIndex-1);
-            if (symbol && symbol->contains(prevSectionIdx))
-                return QString();
-        } else if (logicalIndex > 0) {
-            if (mHeaderView->sectionViewportPosition(logicalIndex) <= 0)
-                return text;
-            int prevSectionIdx = this->sectionIndex(logicalIndex-1);
-            if (symbol && symbol->contains(prevSectionIdx) &&
-                    symbol->label(sectionIndex, dimension) == symbol->label(prevSectionIdx, dimension) &&
-                        (dimension == 0 ||
-                            symbol->label(sectionIndex, dimension-1) == symbol->label(prevSectionIdx, dimension-1))) {
-                    return QString();
-            }
-        }
-        return text;
+        if (layout->Repeated.at(cell) && !firstVisible)
+            return QString();
+        return layout->Texts.at(cell);
     }
 
     QSize labelCellSize(const QStyleOptionHeader& styleOption) const
@@ -252,7 +303,10 @@ public:
 
     int maximumSymbolDimension()
     {
-        return mHeaderView->model()->headerData(0, mHeaderView->orientation(), ViewHelper::DimensionRole).toInt();
+        if (mMaximumSymbolDimension < 0)
+            mMaximumSymbolDimension = mHeaderView->model()->headerData(0, mHeaderView->orientation(),
+                                                                       ViewHelper::DimensionRole).toInt();
+        return mMaximumSymbolDimension;
     }
 
     Symbol* symbol(int sectionIndex) const
@@ -262,24 +316,6 @@ public:
         return mHeaderView->modelInstance()->variable(sectionIndex);
     }
 
-    QString label(int sectionIndex, int dimension)
-    {
-        if (mHeaderView->orientation() == Qt::Horizontal) {
-            auto var = mHeaderView->modelInstance()->variable(sectionIndex);
-            if (!var)
-                return QString();
-            if (dimension < 0)
-                return var->name();
-            return var->label(sectionIndex, dimension);
-        }
-        auto eqn = mHeaderView->modelInstance()->equation(sectionIndex);
-        if (!eqn)
-            return QString();
-        if (dimension < 0)
-            return eqn->name();
-        return eqn->label(sectionIndex, dimension);
-    }
-
 private:
     QSize symbolTextSize() const
     {
@@ -316,6 +352,18 @@ private:
 
     QSize mSymbolCellSize;
     QSize mLabelCellSize;
+
+    int mMaximumSymbolDimension = -1;
+
+    ///
+    /// \brief Section layouts, where the key is the logical index.
+    ///
+    QCache<int, SectionLayout> mLayouts;
+
+    ///
+    /// \brief Rendered sections, where the key is the logical index.
+    ///
+    QCache<int, SectionPixmap> mPixmaps;
 };
 
 SymbolHierarchicalHeaderView::SymbolHierarchicalHeaderView(Qt::Orientation orientation,
@@ -341,19 +389,59 @@ QSharedPointer<AbstractModelInstance> SymbolHierarchicalHeaderView::modelInstanc
     return mModelInstance;
 }
 
+void SymbolHierarchicalHeaderView::setModel(QAbstractItemModel *model)
+{
+    if (model == this->model())
+        return;
+    for (const auto &connection : std::as_const(mModelConnections))
+        disconnect(connection);
+    mModelConnections.clear();
+    QHeaderView::setModel(model);
+    mPrivate->invalidate();
+    if (!model)
+        return;
+    mModelConnections << connect(model, &QAbstractItemModel::modelReset,
+                                 this, &SymbolHierarchicalHeaderView::invalidateLayout);
+    mModelConnections << connect(model, &QAbstractItemModel::layoutChanged,
+                                 this, &SymbolHierarchicalHeaderView::invalidateLayout);
+    mModelConnections << connect(model, &QAbstractItemModel::headerDataChanged,
+                                 this, &SymbolHierarchicalHeaderView::invalidateLayout);
+    mModelConnections << connect(model, &QAbstractItemModel::rowsInserted,
+                                 this, &SymbolHierarchicalHeaderView::invalidateLayout);
+    mModelConnections << connect(model, &QAbstractItemModel::rowsRemoved,
+                                 this, &SymbolHierarchicalHeaderView::invalidateLayout);
+    mModelConnections << connect(model, &QAbstractItemModel::columnsInserted,
+                                 this, &SymbolHierarchicalHeaderView::invalidateLayout);
+    mModelConnections << connect(model, &QAbstractItemModel::columnsRemoved,
+                                 this, &SymbolHierarchicalHeaderView::invalidateLayout);
+}
+
+void SymbolHierarchicalHeaderView::invalidateLayout()
+{
+    mPrivate->invalidate();
+    viewport()->update();
+}
+
+void SymbolHierarchicalHeaderView::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::FontChange ||
+            event->type() == QEvent::StyleChange ||
+            event->type() == QEvent::PaletteChange) {
+        mPrivate->updateCellSizes();
+        mPrivate->invalidate();
+    }
+    QHeaderView::changeEvent(event);
+}
+
 void SymbolHierarchicalHeaderView::paintSection(QPainter *painter,
                                                 const QRect &rect,
                                                 int logicalIndex) const
 {
     if (rect.isValid()) {
+        auto layout = mPrivate->layout(logicalIndex);
+        if (layout->SectionIndex < 0 ) return;
         auto option = styleOptionForCell(logicalIndex);
-        int sectionIdx = mPrivate->sectionIndex(logicalIndex);
-        if (sectionIdx < 0 ) return;
-        if (orientation() == Qt::Horizontal) {
-            mPrivate->paintHorizontalSection(painter, rect, option, logicalIndex, sectionIdx);
-        } else {
-            mPrivate->paintVerticalSection(painter, rect, option, logicalIndex, sectionIdx);
-        }
+        mPrivate->paintSection(painter, rect, option, logicalIndex, layout);
         return;
     }
     QHeaderView::paintSection(painter, rect, logicalIndex);
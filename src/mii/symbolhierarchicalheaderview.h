@@ -21,6 +21,7 @@
 #define SYMBOLHIERARCHICALHEADERVIEW_H
 
 #include <QHeaderView>
+#include <QVector>
 
 namespace gams {
 namespace studio{
@@ -42,10 +43,21 @@ public:
 
     QSharedPointer<AbstractModelInstance> modelInstance() const;
 
+    void setModel(QAbstractItemModel *model) override;
+
 signals:
     void filterChanged();
 
+private slots:
+    ///
+    /// \brief Drop the cached section layouts and pixmaps, e.g. after a
+    ///        filter change.
+    ///
+    void invalidateLayout();
+
 protected:
+    void changeEvent(QEvent *event) override;
+
     void paintSection(QPainter *painter, const QRect &rect,
                       int logicalIndex) const override;
 
@@ -58,6 +70,7 @@ private:
     class HierarchicalHeaderView_private;
     QSharedPointer<AbstractModelInstance> mModelInstance;
     HierarchicalHeaderView_private *mPrivate;
+    QVector<QMetaObject::Connection> mModelConnections;
 };
 
 }
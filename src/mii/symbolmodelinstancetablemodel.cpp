@@ -41,6 +41,7 @@ void SymbolModelInstanceTableModel::setModelInstance(const QSharedPointer<Abstra
 {
     beginResetModel();
     mModelInstance = modelInstance;
+    mTileBuffer.invalidate();
     endResetModel();
 }
 
@@ -49,8 +50,10 @@ QVariant SymbolModelInstanceTableModel::data(const QModelIndex &index, int role)
     if (role == Qt::TextAlignmentRole) {
         return Qt::AlignRight;
     }
-    if (role == Qt::FontRole) {
-        if (mModelInstance->nlFlag(index.row(), index.column(), mViewConfig->viewId())) {
+    if (role == Qt::FontRole && index.isValid()) {
+        const auto& cells = tile(index);
+        if (cells.contains(index.row(), index.column()) &&
+            cells.NlFlags[cells.offset(index.row(), index.column())]) {
             QFont font;
             font.setBold(true);
             font.setItalic(true);
@@ -58,7 +61,11 @@ QVariant SymbolModelInstanceTableModel::data(const QModelIndex &index, int role)
         }
     }
     if (role == Qt::DisplayRole && index.isValid()) {
-        return mModelInstance->data(index.row(), index.column(), mViewConfig->viewId());
+        const auto& cells = tile(index);
+        if (!cells.contains(index.row(), index.column()))
+            return QVariant();
+        int i = cells.offset(index.row(), index.column());
+        return cells.Mask[i] ? QVariant(cells.Values[i]) : QVariant();
     }
     if (role == ViewHelper::ColumnEntryRole) {
         return mModelInstance->columnEntryCount(index.column(), mViewConfig->viewId());
@@ -120,6 +127,22 @@ QHash<int, QByteArray> SymbolModelInstanceTableModel::roleNames() const
     return ViewHelper::roleNames();
 }
 
+void SymbolModelInstanceTableModel::prefetch(const QVector<int> &rows, const QVector<int> &columns)
+{
+    mTileBuffer.prefetch(mModelInstance, mViewConfig->viewId(), rows, columns);
+}
+
+DataTileBuffer *SymbolModelInstanceTableModel::tileBuffer()
+{
+    return &mTileBuffer;
+}
+
+const DataTile &SymbolModelInstanceTableModel::tile(const QModelIndex &index) const
+{
+    return mTileBuffer.tile(*mModelInstance, mViewConfig->viewId(),
+                            index.row(), index.column());
+}
+
 }
 }
 }
@@ -20,6 +20,8 @@
 #ifndef SYMBOLMODELINSTANCETABLEMODEL_H
 #define SYMBOLMODELINSTANCETABLEMODEL_H
 
+#include "datatilebuffer.h"
+
 #include <QAbstractTableModel>
 #include <QSharedPointer>
 
@@ -30,7 +32,7 @@ namespace mii {
 class AbstractModelInstance;
 class AbstractViewConfiguration;
 
-class SymbolModelInstanceTableModel final : public QAbstractTableModel
+class SymbolModelInstanceTableModel final : public QAbstractTableModel, public AbstractTileModel
 {
     Q_OBJECT
 
@@ -57,9 +59,17 @@ public:
 
     QHash<int, QByteArray> roleNames() const override;
 
+    void prefetch(const QVector<int> &rows, const QVector<int> &columns) override;
+
+    DataTileBuffer* tileBuffer() override;
+
+private:
+    const DataTile& tile(const QModelIndex &index) const;
+
 private:
     QSharedPointer<AbstractModelInstance> mModelInstance;
     QSharedPointer<AbstractViewConfiguration> mViewConfig;
+    mutable DataTileBuffer mTileBuffer;
 };
 
 }
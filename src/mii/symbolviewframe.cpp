@@ -79,8 +79,22 @@ void SymbolViewFrame::setupView(const QSharedPointer<AbstractModelInstance> &mod
 {
     mModelInstance = modelInstance;
     mViewConfig->setModelInstance(mModelInstance);
-    mModelInstance->loadViewData(mViewConfig);
-    setupView();
+    mSetupPending = true;
+    requestViewData();
+}
+
+void SymbolViewFrame::viewDataLoaded()
+{
+    setLoading(false);
+    if (mSetupPending) {
+        mSetupPending = false;
+        setupView();
+        return;
+    }
+    if (!mHeaderFilterModel)
+        return;
+    mHeaderFilterModel->evaluateFilters();
+    emit filtersChanged();
 }
 
 ViewHelper::ViewDataType SymbolViewFrame::type() const
@@ -110,9 +124,7 @@ void SymbolViewFrame::evaluateFilters()
 {
     if (!mHeaderFilterModel)
         return;
-    mModelInstance->loadViewData(mViewConfig);
-    mHeaderFilterModel->evaluateFilters();
-    emit filtersChanged();
+    requestViewData();
 }
 
 void SymbolViewFrame::customMenuRequested(const QPoint &pos)
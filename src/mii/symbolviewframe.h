@@ -49,6 +49,8 @@ public:
 
     void setupView(const QSharedPointer<AbstractModelInstance> &modelInstance) override;
 
+    void viewDataLoaded() override;
+
     ViewHelper::ViewDataType type() const override;
 
     void setShowAbsoluteValues(bool absoluteValues) override;
@@ -73,6 +75,12 @@ private:
     SymbolHierarchicalHeaderView* mHorizontalHeader = nullptr;
     SymbolHierarchicalHeaderView* mVerticalHeader = nullptr;
     SymbolFilterModel* mHeaderFilterModel = nullptr;
+
+    ///
+    /// \brief The headers are set up again once the requested data is
+    ///        loaded, otherwise only the filters are evaluated.
+    ///
+    bool mSetupPending = false;
 };
 
 }
@@ -98,9 +98,9 @@ QVariant PostoptValueFormatProxyModel::applyFilter(const QVariant &data) const
     double value = data.toDouble(&ok);
     if (ok) {
         if (!mValueFilter.ExcludeRange && value >= mValueFilter.MinValue && value <= mValueFilter.MaxValue)
-            return value;
+            return data;
         else if (mValueFilter.ExcludeRange && (value < mValueFilter.MinValue || value > mValueFilter.MaxValue))
-            return value;
+            return data;
         return QVariant();
     }
     return data;
@@ -166,6 +166,16 @@ public:
         mCurrentValueFilter = mDefaultValueFilter;
     }
 
+    ContributionFilter& currentContributionFilter()
+    {
+        return mCurrentContributionFilter;
+    }
+
+    void setCurrentContributionFilter(const ContributionFilter &filter)
+    {
+        mCurrentContributionFilter = filter;
+    }
+
     LabelCheckStates& currentAttributeFilter()
     {
         return mCurrentAttributeFilter;
@@ -237,6 +247,8 @@ protected:
     ValueFilter mCurrentValueFilter;
     ValueFilter mDefaultValueFilter;
 
+    ContributionFilter mCurrentContributionFilter;
+
     LabelCheckStates mCurrentAttributeFilter;
     LabelCheckStates mDefaultAttributeFilter;
 
@@ -0,0 +1,217 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "viewloadscheduler.h"
+#include "abstractmodelinstance.h"
+#include "viewconfigurationprovider.h"
+
+#include <QtConcurrent>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+ViewLoadScheduler::ViewLoadScheduler(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+ViewLoadScheduler::~ViewLoadScheduler()
+{
+    cancelAll();
+    mPool.waitForDone();
+}
+
+void ViewLoadScheduler::load(const QSharedPointer<AbstractModelInstance> &modelInstance,
+                             const QSharedPointer<AbstractViewConfiguration> &viewConfig)
+{
+    if (!viewConfig)
+        return;
+    if (mFinished == mTotal) {
+        mFinished = 0;
+        mTotal = 0;
+    }
+    ++mTotal;
+    Task task;
+    task.ViewId = viewConfig->viewId();
+    task.ModelInstance = modelInstance;
+    task.ViewConfig = viewConfig;
+    for (int i=0; i<mSerialQueue.size(); ++i) {
+        if (mSerialQueue.at(i).ViewId == task.ViewId) {
+            mSerialQueue.removeAt(i);
+            ++mFinished;
+            break;
+        }
+    }
+    if (mRunning.contains(task.ViewId)) {
+        // the new load starts after the old one, which would overwrite it otherwise
+        mRunning[task.ViewId].Token.cancel();
+        if (mWaiting.contains(task.ViewId))
+            ++mFinished;
+        mWaiting[task.ViewId] = task;
+        updateProgress();
+        return;
+    }
+    enqueue(task);
+    updateProgress();
+}
+
+void ViewLoadScheduler::cancel(int viewId)
+{
+    bool isCancelled = false;
+    for (int i=0; i<mSerialQueue.size(); ++i) {
+        if (mSerialQueue.at(i).ViewId == viewId) {
+            mSerialQueue.removeAt(i);
+            ++mFinished;
+            isCancelled = true;
+            break;
+        }
+    }
+    if (mWaiting.remove(viewId)) {
+        ++mFinished;
+        isCancelled = true;
+    }
+    if (mRunning.contains(viewId)) {
+        mRunning[viewId].Token.cancel();
+        return;
+    }
+    if (isCancelled) {
+        emit viewCancelled(viewId);
+        updateProgress();
+    }
+}
+
+void ViewLoadScheduler::cancelAll()
+{
+    QList<int> viewIds;
+    for (const auto& task : std::as_const(mSerialQueue))
+        viewIds << task.ViewId;
+    viewIds << mWaiting.keys() << mRunning.keys();
+    for (int viewId : std::as_const(viewIds))
+        cancel(viewId);
+}
+
+void ViewLoadScheduler::waitForFinished()
+{
+    while (!mRunning.isEmpty()) {
+        int viewId = mRunning.firstKey();
+        auto watcher = mRunning[viewId].Watcher;
+        watcher->waitForFinished();
+        watcher->disconnect(this);
+        taskFinished(viewId);
+    }
+}
+
+bool ViewLoadScheduler::isLoading(int viewId) const
+{
+    if (mRunning.contains(viewId) || mWaiting.contains(viewId))
+        return true;
+    for (const auto& task : mSerialQueue) {
+        if (task.ViewId == viewId)
+            return true;
+    }
+    return false;
+}
+
+int ViewLoadScheduler::pendingCount() const
+{
+    return mTotal - mFinished;
+}
+
+bool ViewLoadScheduler::isSerial(const QSharedPointer<AbstractViewConfiguration> &viewConfig)
+{
+    switch (viewConfig->viewType()) {
+    case ViewHelper::ViewDataType::BP_Scaling:
+    case ViewHelper::ViewDataType::BP_Overview:
+    case ViewHelper::ViewDataType::BP_Count:
+    case ViewHelper::ViewDataType::BP_Average:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void ViewLoadScheduler::enqueue(const Task &task)
+{
+    if (isSerial(task.ViewConfig)) {
+        mSerialQueue.enqueue(task);
+        startNextSerial();
+    } else {
+        start(task);
+    }
+}
+
+void ViewLoadScheduler::start(Task task)
+{
+    task.Watcher = new QFutureWatcher<void>(this);
+    const int viewId = task.ViewId;
+    connect(task.Watcher, &QFutureWatcher<void>::finished,
+            this, [this, viewId]{ taskFinished(viewId); });
+    mRunning[viewId] = task;
+    auto modelInstance = task.ModelInstance;
+    auto viewConfig = task.ViewConfig;
+    auto token = task.Token;
+    auto load = [modelInstance, viewConfig, token]{
+        if (token.isCancelled())
+            return;
+        modelInstance->loadViewData(viewConfig, token);
+    };
+    task.Watcher->setFuture(QtConcurrent::run(&mPool, load));
+}
+
+void ViewLoadScheduler::startNextSerial()
+{
+    if (mSerialRunning || mSerialQueue.isEmpty())
+        return;
+    mSerialRunning = true;
+    start(mSerialQueue.dequeue());
+}
+
+void ViewLoadScheduler::taskFinished(int viewId)
+{
+    if (!mRunning.contains(viewId))
+        return;
+    auto task = mRunning.take(viewId);
+    task.Watcher->deleteLater();
+    if (isSerial(task.ViewConfig))
+        mSerialRunning = false;
+    ++mFinished;
+    if (task.Token.isCancelled()) {
+        // the cancelled load didn't replace the provider of the view
+        emit viewCancelled(viewId);
+    } else {
+        emit viewLoaded(viewId);
+    }
+    if (mWaiting.contains(viewId))
+        enqueue(mWaiting.take(viewId));
+    startNextSerial();
+    updateProgress();
+}
+
+void ViewLoadScheduler::updateProgress()
+{
+    emit progressChanged(mFinished, mTotal);
+    if (mFinished == mTotal)
+        emit finished();
+}
+
+}
+}
+}
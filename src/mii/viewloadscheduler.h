@@ -0,0 +1,140 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VIEWLOADSCHEDULER_H
+#define VIEWLOADSCHEDULER_H
+
+#include "common.h"
+
+#include <QFutureWatcher>
+#include <QMap>
+#include <QObject>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QThreadPool>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class AbstractModelInstance;
+class AbstractViewConfiguration;
+
+///
+/// \brief Background loads of the view data, one future per view.
+///
+/// Loads of views which share the coefficient counts of the data handler
+/// (all block pictures) run one after the other in the order they were
+/// requested. All other views are loaded concurrently on a dedicated
+/// thread pool. A new request for a view cancels its running load, which
+/// stops at the next check of its CancellationToken; the result of a
+/// cancelled load is discarded and the view keeps its previous data.
+///
+class ViewLoadScheduler final : public QObject
+{
+    Q_OBJECT
+
+public:
+    ViewLoadScheduler(QObject *parent = nullptr);
+
+    ~ViewLoadScheduler() override;
+
+    ///
+    /// \brief Load the data of <c>viewConfig</c> in the background.
+    ///
+    void load(const QSharedPointer<AbstractModelInstance> &modelInstance,
+              const QSharedPointer<AbstractViewConfiguration> &viewConfig);
+
+    ///
+    /// \brief Cancel the load of <c>viewId</c> and discard its result.
+    ///
+    void cancel(int viewId);
+
+    void cancelAll();
+
+    ///
+    /// \brief Block until all queued and running loads are finished.
+    ///
+    void waitForFinished();
+
+    bool isLoading(int viewId) const;
+
+    ///
+    /// \brief Number of loads which are queued or running.
+    ///
+    int pendingCount() const;
+
+    ///
+    /// \brief Whether <c>viewConfig</c> must wait for the other block
+    ///        picture loads.
+    ///
+    static bool isSerial(const QSharedPointer<AbstractViewConfiguration> &viewConfig);
+
+signals:
+    void viewLoaded(int viewId);
+
+    ///
+    /// \brief The load of <c>viewId</c> was cancelled, where the data
+    ///        loaded before, if any, is still valid.
+    ///
+    void viewCancelled(int viewId);
+
+    ///
+    /// \brief Progress of the current batch, which ends when no load is
+    ///        pending anymore.
+    ///
+    void progressChanged(int finished, int total);
+
+    void finished();
+
+private:
+    struct Task
+    {
+        int ViewId = -1;
+        QSharedPointer<AbstractModelInstance> ModelInstance;
+        QSharedPointer<AbstractViewConfiguration> ViewConfig;
+        CancellationToken Token;
+        QFutureWatcher<void> *Watcher = nullptr;
+    };
+
+    void enqueue(const Task &task);
+
+    void start(Task task);
+
+    void startNextSerial();
+
+    void taskFinished(int viewId);
+
+    void updateProgress();
+
+private:
+    QThreadPool mPool;
+    QMap<int, Task> mRunning;
+    QMap<int, Task> mWaiting;
+    QQueue<Task> mSerialQueue;
+    bool mSerialRunning = false;
+    int mFinished = 0;
+    int mTotal = 0;
+};
+
+}
+}
+}
+
+#endif // VIEWLOADSCHEDULER_H
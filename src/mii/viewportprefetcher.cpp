@@ -0,0 +1,154 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "viewportprefetcher.h"
+#include "datatilebuffer.h"
+#include "dtoaformatproxymodel.h"
+
+#include <QAbstractProxyModel>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QTableView>
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+ViewportPrefetcher::ViewportPrefetcher(QTableView *view)
+    : QObject(view)
+    , mView(view)
+{
+    connect(mView->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &ViewportPrefetcher::verticalScrolled);
+    connect(mView->horizontalScrollBar(), &QScrollBar::valueChanged,
+            this, &ViewportPrefetcher::horizontalScrolled);
+}
+
+void ViewportPrefetcher::setModel(QAbstractItemModel *model)
+{
+    disconnect(mPreloadConnection);
+    mTileModel = nullptr;
+    mBaseModel = nullptr;
+    mVerticalValue = mView->verticalScrollBar()->value();
+    mHorizontalValue = mView->horizontalScrollBar()->value();
+    DtoaFormatProxyModel *formatModel = nullptr;
+    while (auto proxy = qobject_cast<QAbstractProxyModel*>(model)) {
+        if (!formatModel)
+            formatModel = qobject_cast<DtoaFormatProxyModel*>(proxy);
+        model = proxy->sourceModel();
+    }
+    mTileModel = dynamic_cast<AbstractTileModel*>(model);
+    if (!mTileModel)
+        return;
+    mBaseModel = model;
+    if (formatModel) {
+        mPreloadConnection = connect(mTileModel->tileBuffer(), &DataTileBuffer::tilesPrefetched,
+                                     formatModel, &DtoaFormatProxyModel::preloadTiles);
+    }
+}
+
+void ViewportPrefetcher::verticalScrolled(int value)
+{
+    auto rows = visibleRows();
+    int page = rows.second - rows.first + 1;
+    if (value > mVerticalValue)
+        prefetch(SectionRange(rows.second + 1, rows.second + page), visibleColumns());
+    else if (value < mVerticalValue)
+        prefetch(SectionRange(rows.first - page, rows.first - 1), visibleColumns());
+    mVerticalValue = value;
+}
+
+void ViewportPrefetcher::horizontalScrolled(int value)
+{
+    auto columns = visibleColumns();
+    int page = columns.second - columns.first + 1;
+    if (value > mHorizontalValue)
+        prefetch(visibleRows(), SectionRange(columns.second + 1, columns.second + page));
+    else if (value < mHorizontalValue)
+        prefetch(visibleRows(), SectionRange(columns.first - page, columns.first - 1));
+    mHorizontalValue = value;
+}
+
+SectionRange ViewportPrefetcher::visibleSections(QHeaderView *header, int extent) const
+{
+    if (!mView->model() || !header->count())
+        return SectionRange(0, -1);
+    int first = qMax(0, header->visualIndexAt(0));
+    int last = header->visualIndexAt(extent - 1);
+    return SectionRange(first, last < 0 ? header->count() - 1 : last);
+}
+
+SectionRange ViewportPrefetcher::visibleRows() const
+{
+    return visibleSections(mView->verticalHeader(), mView->viewport()->height());
+}
+
+SectionRange ViewportPrefetcher::visibleColumns() const
+{
+    return visibleSections(mView->horizontalHeader(), mView->viewport()->width());
+}
+
+void ViewportPrefetcher::prefetch(const SectionRange &rows, const SectionRange &columns)
+{
+    if (!mTileModel || !mBaseModel || !mView->model())
+        return;
+    auto baseRows = baseSections(Qt::Vertical, rows);
+    if (baseRows.isEmpty())
+        return;
+    auto baseColumns = baseSections(Qt::Horizontal, columns);
+    if (baseColumns.isEmpty())
+        return;
+    mTileModel->prefetch(baseRows, baseColumns);
+}
+
+QVector<int> ViewportPrefetcher::baseSections(Qt::Orientation orientation,
+                                              const SectionRange &range) const
+{
+    auto model = mView->model();
+    auto header = orientation == Qt::Vertical ? mView->verticalHeader()
+                                              : mView->horizontalHeader();
+    QVector<int> sections;
+    if (!model->rowCount() || !model->columnCount())
+        return sections;
+    int first = qMax(0, range.first);
+    int last = qMin(range.second, header->count() - 1);
+    for (int visual=first; visual<=last; ++visual) {
+        int logical = header->logicalIndex(visual);
+        if (logical < 0 || header->isSectionHidden(logical))
+            continue;
+        auto index = orientation == Qt::Vertical ? baseIndex(model->index(logical, 0))
+                                                 : baseIndex(model->index(0, logical));
+        if (index.isValid())
+            sections << (orientation == Qt::Vertical ? index.row() : index.column());
+    }
+    return sections;
+}
+
+QModelIndex ViewportPrefetcher::baseIndex(const QModelIndex &index) const
+{
+    auto current = index;
+    while (auto proxy = qobject_cast<const QAbstractProxyModel*>(current.model())) {
+        current = proxy->mapToSource(current);
+    }
+    return current.model() == mBaseModel.data() ? current : QModelIndex();
+}
+
+}
+}
+}
@@ -0,0 +1,99 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VIEWPORTPREFETCHER_H
+#define VIEWPORTPREFETCHER_H
+
+#include "datatile.h"
+
+#include <QObject>
+#include <QPointer>
+
+class QAbstractItemModel;
+class QHeaderView;
+class QModelIndex;
+class QTableView;
+
+namespace gams {
+namespace studio {
+namespace mii {
+
+class AbstractTileModel;
+
+///
+/// \brief Watches the viewport of a table view and prefetches the tiles of
+///        the region next to it in scroll direction, so that the base model
+///        and the format proxy can serve newly exposed cells from memory.
+///
+class ViewportPrefetcher final : public QObject
+{
+    Q_OBJECT
+
+public:
+    ViewportPrefetcher(QTableView *view);
+
+    ///
+    /// \brief Resolves the base model and format proxy of the view's proxy
+    ///        chain. Has to be called whenever the view's model changes.
+    ///
+    void setModel(QAbstractItemModel *model);
+
+private slots:
+    void verticalScrolled(int value);
+
+    void horizontalScrolled(int value);
+
+private:
+    ///
+    /// \brief First and last visual index shown in the viewport.
+    ///
+    SectionRange visibleSections(QHeaderView *header, int extent) const;
+
+    SectionRange visibleRows() const;
+
+    SectionRange visibleColumns() const;
+
+    ///
+    /// \brief Prefetches the cells of the given visual ranges.
+    ///
+    void prefetch(const SectionRange &rows, const SectionRange &columns);
+
+    ///
+    /// \brief Base model sections of the shown sections of a visual range,
+    ///        mapped one by one since sorting proxies and moved header
+    ///        sections reorder them and filter proxies leave gaps.
+    ///
+    QVector<int> baseSections(Qt::Orientation orientation, const SectionRange &range) const;
+
+    QModelIndex baseIndex(const QModelIndex &index) const;
+
+private:
+    QTableView *mView;
+    AbstractTileModel *mTileModel = nullptr;
+    QPointer<QAbstractItemModel> mBaseModel;
+    QMetaObject::Connection mPreloadConnection;
+    int mVerticalValue = 0;
+    int mHorizontalValue = 0;
+};
+
+}
+}
+}
+
+#endif // VIEWPORTPREFETCHER_H
@@ -0,0 +1,73 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MATRIXBUILDER_H
+#define MATRIXBUILDER_H
+
+#include "datamatrix.h"
+
+#include <memory>
+
+///
+/// \brief Jacobian entry of a makeMatrix() row.
+///
+struct Entry
+{
+    int Column = -1;
+    double Value = 0.0;
+    bool Nonlinear = false;
+};
+
+///
+/// \brief Matrix with one DataRow per element of <c>rows</c>, where an
+///        empty element is a row without entries.
+///
+inline gams::studio::mii::DataMatrix makeMatrix(int columns, const QVector<QVector<Entry>> &rows, int modelType = 0)
+{
+    using namespace gams::studio::mii;
+    DataMatrix matrix(rows.size(), columns, modelType);
+    for (int r=0; r<rows.size(); ++r) {
+        auto row = matrix.row(r);
+        *row = DataRow(rows.at(r).size());
+        for (int e=0; e<rows.at(r).size(); ++e) {
+            row->colIdx()[e] = rows.at(r).at(e).Column;
+            row->inputData()[e] = rows.at(r).at(e).Value;
+            row->nlFlags().set(e, rows.at(r).at(e).Nonlinear);
+        }
+    }
+    return matrix;
+}
+
+///
+/// \brief Set the NL overlay of <c>matrix</c> to the NL values of each
+///        row, i.e. one value per NL flag in entry order.
+///
+inline void setNlValues(gams::studio::mii::DataMatrix &matrix, const QVector<QVector<double>> &rows)
+{
+    auto overlay = std::make_shared<gams::studio::mii::NlOverlay>();
+    overlay->RowStart.fill(0, matrix.rowCount()+1);
+    for (int r=0; r<matrix.rowCount(); ++r) {
+        if (r < rows.size())
+            overlay->Values.append(rows.at(r));
+        overlay->RowStart[r+1] = overlay->Values.size();
+    }
+    matrix.setNlOverlay(overlay);
+}
+
+#endif // MATRIXBUILDER_H
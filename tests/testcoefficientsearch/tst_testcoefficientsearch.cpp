@@ -0,0 +1,138 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "coefficientsearch.h"
+#include "matrixbuilder.h"
+
+using namespace gams::studio::mii;
+
+class TestCoefficientSearch : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_CoefficientSearch();
+
+    void test_emptyAndNonlinearRows();
+};
+
+void TestCoefficientSearch::test_CoefficientSearch()
+{
+    CoefficientSearch::Range range;
+    QVERIFY(!CoefficientSearch::parse("", range));
+    QVERIFY(!CoefficientSearch::parse("1e-9", range));
+    QVERIFY(!CoefficientSearch::parse("< x", range));
+    QVERIFY(!CoefficientSearch::parse("< -1", range));
+    QVERIFY(CoefficientSearch::parse("> 1e9", range));
+    QCOMPARE(range.Minimum, 0.0);
+    QCOMPARE(range.Maximum, 1e9);
+    QVERIFY(CoefficientSearch::parse(" <1e-9 >1e9 ", range));
+    QCOMPARE(range.Minimum, 1e-9);
+    QCOMPARE(range.Maximum, 1e9);
+
+    // row r holds a_r0 = 10^(r-2), a_r1 = 0 and a_r2 = -10^(2-r)
+    QVector<QVector<Entry>> rows;
+    for (int r=0; r<5; ++r)
+        rows.append({ { 0, std::pow(10.0, r-2) }, { 1, 0.0 }, { 2, -std::pow(10.0, 2-r) } });
+    auto matrix = makeMatrix(3, rows);
+    range.Minimum = 0.05;
+    range.Maximum = 50.0;
+    qint64 total = 0;
+    auto hits = CoefficientSearch::run(matrix, false, range, CoefficientSearch::MaxHits, &total);
+    QCOMPARE(total, qint64(4));
+    QCOMPARE(hits.size(), 4);
+    QCOMPARE(hits.at(0).Row, 0);
+    QCOMPARE(hits.at(0).Column, 0);
+    QCOMPARE(hits.at(0).Value, 0.01);
+    QCOMPARE(hits.at(1).Row, 0);
+    QCOMPARE(hits.at(1).Column, 2);
+    QCOMPARE(hits.at(1).Value, -100.0);
+    QCOMPARE(hits.at(3).Row, 4);
+    QCOMPARE(hits.at(3).Column, 2);
+
+    hits = CoefficientSearch::run(matrix, false, range, 3, &total);
+    QCOMPARE(total, qint64(4));
+    QCOMPARE(hits.size(), 3);
+    QCOMPARE(hits.at(2).Row, 4);
+    QCOMPARE(hits.at(2).Column, 0);
+
+    // the shown sections are filtered before the hits are capped
+    QBitArray shownRows(5);
+    shownRows.setBit(4);
+    hits = CoefficientSearch::run(matrix, false, range, 1, &total, shownRows);
+    QCOMPARE(total, qint64(2));
+    QCOMPARE(hits.size(), 1);
+    QCOMPARE(hits.at(0).Row, 4);
+    QCOMPARE(hits.at(0).Column, 0);
+    shownRows.fill(true);
+    shownRows.clearBit(4);
+    QBitArray shownColumns(3);
+    shownColumns.setBit(0);
+    shownColumns.setBit(1);
+    hits = CoefficientSearch::run(matrix, false, range, CoefficientSearch::MaxHits, &total,
+                                  shownRows, shownColumns);
+    QCOMPARE(total, qint64(1));
+    QCOMPARE(hits.size(), 1);
+    QCOMPARE(hits.at(0).Row, 0);
+    QCOMPARE(hits.at(0).Column, 0);
+    hits = CoefficientSearch::run(matrix, false, range, CoefficientSearch::MaxHits, &total,
+                                  QBitArray(5), QBitArray());
+    QCOMPARE(total, qint64(0));
+    QVERIFY(hits.isEmpty());
+
+    // a cancelled scan skips the remaining row blocks
+    CancellationToken token;
+    token.cancel();
+    hits = CoefficientSearch::run(matrix, false, range, CoefficientSearch::MaxHits, &total,
+                                  QBitArray(), QBitArray(), token);
+    QCOMPARE(total, qint64(0));
+    QVERIFY(hits.isEmpty());
+}
+
+void TestCoefficientSearch::test_emptyAndNonlinearRows()
+{
+    //      x0        x1   x2
+    // e0:  2         -1
+    // e1:                        empty
+    // e2:  3 (NL: 30)     5 (NL: 50)
+    auto matrix = makeMatrix(3, { { { 0, 2 }, { 1, -1 } },
+                                  {},
+                                  { { 0, 3, true }, { 2, 5, true } } }, 1);
+    setNlValues(matrix, { {}, {}, { 30, 50 } });
+    QCOMPARE(matrix.row(1)->entries(), 0);
+    QCOMPARE(matrix.row(2)->entriesNl(), 2);
+
+    CoefficientSearch::Range range;
+    range.Maximum = 4.0;
+    qint64 total = 0;
+    auto hits = CoefficientSearch::run(matrix, false, range, CoefficientSearch::MaxHits, &total);
+    QCOMPARE(total, qint64(1));
+    QCOMPARE(hits.at(0).Row, 2);
+    QCOMPARE(hits.at(0).Value, 5.0);
+    hits = CoefficientSearch::run(matrix, true, range, CoefficientSearch::MaxHits, &total);
+    QCOMPARE(total, qint64(2));
+    QCOMPARE(hits.at(0).Value, 30.0);
+    QCOMPARE(hits.at(1).Value, 50.0);
+}
+
+QTEST_APPLESS_MAIN(TestCoefficientSearch)
+
+#include "tst_testcoefficientsearch.moc"
@@ -43,6 +43,10 @@ private slots:
     void test_default_valueFilter();
     void test_getSet_valueFilter();
 
+    void test_contributionFilter();
+
+    void test_cancellationToken();
+
     void test_AttributeHelper_attributeText();
     void test_AttributeHelper_attributeValue();
     void test_AttributeHelper_static();
@@ -95,9 +99,14 @@ void TestCommon::test_searchResult()
     QCOMPARE(result.IsRegEx, true);
     QVERIFY(!result.Entries.isEmpty());
 
+    QCOMPARE(result.IsCoefficientRange, false);
+    QCOMPARE(result.CoefficientCount, qint64(0));
+
     SearchResult::SearchEntry entry;
     QCOMPARE(entry.Index, -1);
     QCOMPARE(entry.Orientation, Qt::Horizontal);
+    QCOMPARE(entry.Column, -1);
+    QVERIFY(!entry.isCoefficient());
 
     entry.Index = 42;
     entry.Orientation = Qt::Vertical;
@@ -120,6 +129,9 @@ void TestCommon::test_searchOperators()
     QCOMPARE(entry1, entry2);
     SearchResult::SearchEntry entry3 { 1, Qt::Vertical};
     QVERIFY(entry1 != entry3);
+    SearchResult::SearchEntry entry4 { 0, Qt::Horizontal, 2, 1e10 };
+    QVERIFY(entry4.isCoefficient());
+    QVERIFY(entry1 != entry4);
 
     result1.Entries.append(entry1);
     QCOMPARE(result1, result1);
@@ -262,6 +274,60 @@ void TestCommon::test_getSet_valueFilter()
     QVERIFY(!filter.accepts(-42));
 }
 
+void TestCommon::test_contributionFilter()
+{
+    ContributionFilter filter;
+    QCOMPARE(filter.TopK, 0);
+    QCOMPARE(filter.Threshold, 0.0);
+    QVERIFY(!filter.isActive());
+
+    QVector<Contribution> contributions;
+    const double products[6] = { 1, -8, 0.5, 4, -2, 16 };
+    for (int i=0; i<6; ++i) {
+        Contribution contribution;
+        contribution.Section = i;
+        contribution.Product = products[i];
+        contributions.append(contribution);
+    }
+    auto all = contributions;
+    filter.apply(all);
+    QCOMPARE(all.size(), 6);
+    QCOMPARE(all.first().Section, 5);
+    QCOMPARE(all.last().Section, 2);
+
+    filter.TopK = 3;
+    QVERIFY(filter.isActive());
+    auto top = contributions;
+    filter.apply(top);
+    QCOMPARE(top.size(), 3);
+    QCOMPARE(top.at(0).Section, 5);
+    QCOMPARE(top.at(1).Section, 1);
+    QCOMPARE(top.at(2).Section, 3);
+
+    filter.TopK = 0;
+    filter.Threshold = 2;
+    auto above = contributions;
+    filter.apply(above);
+    QCOMPARE(above.size(), 4);
+    QCOMPARE(above.last().Section, 4);
+    QVERIFY(filter != ContributionFilter());
+}
+
+void TestCommon::test_cancellationToken()
+{
+    CancellationToken token;
+    QVERIFY(!token.isCancelled());
+    auto copy = token;
+    CancellationToken other;
+    copy.cancel();
+    QVERIFY(token.isCancelled());
+    QVERIFY(copy.isCancelled());
+    QVERIFY(!other.isCancelled());
+    token = CancellationToken();
+    QVERIFY(!token.isCancelled());
+    QVERIFY(copy.isCancelled());
+}
+
 void TestCommon::test_AttributeHelper_attributeText()
 {
     QCOMPARE(AttributeHelper::attributeText(AttributeHelper::Level), "Level");
@@ -347,6 +413,11 @@ void TestCommon::test_ViewHelper_isAggregatable()
     QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::BP_Average), false);
     QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::BP_Scaling), false);
     QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::Postopt), false);
+    QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::ScalingAdvisor), false);
+    QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::Histogram), false);
+    QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::Diagnostics), false);
+    QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::Components), false);
+    QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::Residuals), false);
     QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::Symbols), true);
     QCOMPARE(ViewHelper::isAggregatable(ViewHelper::ViewDataType::Unknown), false);
 }
@@ -0,0 +1,101 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "componentanalysis.h"
+#include "matrixbuilder.h"
+
+using namespace gams::studio::mii;
+
+class TestComponentAnalysis : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_ComponentAnalysis();
+
+    void test_emptyAndNonlinearRows();
+};
+
+void TestComponentAnalysis::test_ComponentAnalysis()
+{
+    DataMatrix empty;
+    auto partition = ComponentAnalysis::run(empty);
+    QCOMPARE(partition.count(), 0);
+    QCOMPARE(partition.RowStart, QVector<int>({ 0 }));
+
+    //      x0   x1   x2   x3   x4
+    // e0:  1         1
+    // e1:       1         1
+    // e2:                           empty
+    // e3:            1
+    // x4 is empty
+    auto matrix = makeMatrix(5, { { { 0, 1 }, { 2, 1 } }, { { 1, 1 }, { 3, 1 } }, {}, { { 2, 1 } } });
+    partition = ComponentAnalysis::run(matrix);
+    QCOMPARE(partition.count(), 4);
+    QCOMPARE(partition.RowComponent, QVector<int>({ 0, 1, 2, 0 }));
+    QCOMPARE(partition.ColumnComponent, QVector<int>({ 0, 1, 0, 1, 3 }));
+    QCOMPARE(partition.Info.at(0).Equations, 2);
+    QCOMPARE(partition.Info.at(0).Variables, 2);
+    QCOMPARE(partition.Info.at(0).NonZeros, qint64(3));
+    QVERIFY(partition.Info.at(2).isSingleton());
+    QVERIFY(partition.Info.at(3).isSingleton());
+    QCOMPARE(partition.RowOrder, QVector<int>({ 0, 3, 1, 2 }));
+    QCOMPARE(partition.RowStart, QVector<int>({ 0, 2, 3, 4, 4 }));
+    QCOMPARE(partition.ColumnOrder, QVector<int>({ 0, 2, 1, 3, 4 }));
+    QCOMPARE(partition.ColumnStart, QVector<int>({ 0, 2, 4, 4, 5 }));
+
+    // symbols e = {e0, e1}, f = {e2, e3} and x = {x0, x1}, y = {x2}, z = {x3, x4}
+    partition = ComponentAnalysis::run(matrix, { 0, 0, 1, 1 }, 2, { 0, 0, 1, 2, 2 }, 3);
+    QCOMPARE(partition.count(), 1);
+    QCOMPARE(partition.Info.at(0).Equations, 2);
+    QCOMPARE(partition.Info.at(0).Variables, 3);
+    QCOMPARE(partition.Info.at(0).NonZeros, qint64(5));
+
+    // a chain over many parallel blocks is a single component
+    const int rows = 5000;
+    QVector<QVector<Entry>> links;
+    for (int r=0; r<rows; ++r)
+        links.append({ { r, 1 }, { r+1, 1 } });
+    auto chain = makeMatrix(rows+1, links);
+    partition = ComponentAnalysis::run(chain);
+    QCOMPARE(partition.count(), 1);
+    QCOMPARE(partition.Info.at(0).NonZeros, qint64(2*rows));
+}
+
+void TestComponentAnalysis::test_emptyAndNonlinearRows()
+{
+    //      x0        x1   x2
+    // e0:  2         -1
+    // e1:                        empty
+    // e2:  3 (NL: 30)     5 (NL: 50)
+    auto matrix = makeMatrix(3, { { { 0, 2 }, { 1, -1 } },
+                                  {},
+                                  { { 0, 3, true }, { 2, 5, true } } }, 1);
+    setNlValues(matrix, { {}, {}, { 30, 50 } });
+
+    auto partition = ComponentAnalysis::run(matrix);
+    QCOMPARE(partition.count(), 2);
+    QCOMPARE(partition.RowComponent, QVector<int>({ 0, 1, 0 }));
+}
+
+QTEST_APPLESS_MAIN(TestComponentAnalysis)
+
+#include "tst_testcomponentanalysis.moc"
@@ -55,6 +55,19 @@ void TestDataHandler::test_DataHandler_empty()
     QCOMPARE(dataHandler.columnEntryCount(0, 0), 0);
     QCOMPARE(dataHandler.maxSymbolDimension(0, Qt::Horizontal), 0);
     QCOMPARE(dataHandler.maxSymbolDimension(0, Qt::Vertical), 0);
+    QVERIFY(dataHandler.rowIndices(0, 0).isEmpty());
+    QVERIFY(dataHandler.columnIndices(0, 0).isEmpty());
+    QCOMPARE(dataHandler.clone(0, 1), nullptr);
+    int revision = dataHandler.revision();
+    dataHandler.removeViewData(0);
+    dataHandler.removeViewData();
+    QCOMPARE(dataHandler.revision(), revision + 2);
+    QCOMPARE(dataHandler.rowCount(0), 0);
+    QCOMPARE(dataHandler.memoryBudget(), DataHandler::DefaultMemoryBudget);
+    dataHandler.setMemoryBudget(0);
+    QCOMPARE(dataHandler.memoryBudget(), qint64(0));
+    QCOMPARE(dataHandler.cacheSize(), qint64(0));
+    QVERIFY(!dataHandler.activateViewData(200));
     dataHandler.loadJacobian();
 }
 
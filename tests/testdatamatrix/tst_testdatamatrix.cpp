@@ -12,9 +12,14 @@ private slots:
     void test_DataRow();
     void test_DataRow_inputValue();
     void test_DataRow_outputValue();
+    void test_RowValues_rank();
+
+    void test_PackedBitSet();
 
     void test_DataMatrix_defaults();
     void test_DataMatrix();
+
+    void test_DataMatrix_nlOverlay();
 };
 
 void TestDataMatrix::test_DataRow()
@@ -24,46 +29,48 @@ void TestDataMatrix::test_DataRow()
     QCOMPARE(dataRow0.entriesNl(), 0);
     QCOMPARE(dataRow0.colIdx(), nullptr);
     QCOMPARE(dataRow0.inputData(), nullptr);
-    QCOMPARE(dataRow0.nlFlags(), nullptr);
+    QCOMPARE(dataRow0.nlFlags().size(), 0);
     DataRow dataRow1(8);
-    dataRow1.setEntriesNl(2);
+    dataRow1.nlFlags().set(1);
+    dataRow1.nlFlags().set(6);
     QCOMPARE(dataRow1.entries(), 8);
     QCOMPARE(dataRow1.entriesNl(), 2);
     QVERIFY(dataRow1.colIdx() != nullptr);
     QVERIFY(dataRow1.inputData() != nullptr);
-    QVERIFY(dataRow1.nlFlags() != nullptr);
+    QCOMPARE(dataRow1.nlFlags().size(), 8);
+    QVERIFY(dataRow1.isNonlinear(6));
+    QVERIFY(!dataRow1.isNonlinear(7));
     std::fill(dataRow1.colIdx(), dataRow1.colIdx()+dataRow1.entries(), 1);
     std::fill(dataRow1.inputData(), dataRow1.inputData()+dataRow1.entries(), 0);
-    std::fill(dataRow1.nlFlags(), dataRow1.nlFlags()+dataRow1.entries(), 0);
     DataRow dataRow2(dataRow1);
     QCOMPARE(dataRow2.entries(), dataRow1.entries());
     QCOMPARE(dataRow2.entriesNl(), 2);
     QVERIFY(std::equal(dataRow1.colIdx(), dataRow1.colIdx()+dataRow1.entries(), dataRow2.colIdx()));
     QVERIFY(std::equal(dataRow1.inputData(), dataRow1.inputData()+dataRow1.entries(), dataRow2.inputData()));
-    QVERIFY(std::equal(dataRow1.nlFlags(), dataRow1.nlFlags()+dataRow1.entries(), dataRow2.nlFlags()));
+    QCOMPARE(dataRow2.nlFlags(), dataRow1.nlFlags());
     DataRow dataRow3;
     dataRow3 = dataRow2;
     QCOMPARE(dataRow3.entries(), dataRow2.entries());
     QCOMPARE(dataRow3.entriesNl(), 2);
     QVERIFY(std::equal(dataRow2.colIdx(), dataRow2.colIdx()+dataRow2.entries(), dataRow3.colIdx()));
     QVERIFY(std::equal(dataRow2.inputData(), dataRow2.inputData()+dataRow2.entries(), dataRow3.inputData()));
-    QVERIFY(std::equal(dataRow2.nlFlags(), dataRow2.nlFlags()+dataRow2.entries(), dataRow3.nlFlags()));
+    QCOMPARE(dataRow3.nlFlags(), dataRow2.nlFlags());
     DataRow dataRow4 = std::move(dataRow3);
     //QCOMPARE(dataRow3.entries(), 0);
     //QCOMPARE(dataRow3.colIdx(), nullptr);
     //QCOMPARE(dataRow3.inputData(), nullptr);
-    //QCOMPARE(dataRow3.nlFlags(), nullptr);
+    //QCOMPARE(dataRow3.nlFlags().size(), 0);
     QCOMPARE(dataRow4.entries(), dataRow2.entries());
     QCOMPARE(dataRow4.entriesNl(), 2);
     QVERIFY(std::equal(dataRow2.colIdx(), dataRow2.colIdx()+dataRow2.entries(), dataRow4.colIdx()));
     QVERIFY(std::equal(dataRow2.inputData(), dataRow2.inputData()+dataRow2.entries(), dataRow4.inputData()));
-    QVERIFY(std::equal(dataRow2.nlFlags(), dataRow2.nlFlags()+dataRow2.entries(), dataRow4.nlFlags()));
+    QCOMPARE(dataRow4.nlFlags(), dataRow2.nlFlags());
     DataRow dataRow5(DataRow(12));
     QCOMPARE(dataRow5.entries(), 12);
     QCOMPARE(dataRow5.entriesNl(), 0);
     QVERIFY(dataRow5.colIdx() != nullptr);
     QVERIFY(dataRow5.inputData() != nullptr);
-    QVERIFY(dataRow5.nlFlags() != nullptr);
+    QCOMPARE(dataRow5.nlFlags().size(), 12);
 }
 
 void TestDataMatrix::test_DataRow_inputValue()
@@ -92,24 +99,100 @@ void TestDataMatrix::test_DataRow_inputValue()
 void TestDataMatrix::test_DataRow_outputValue()
 {
     DataRow dataRow0;
-    QCOMPARE(dataRow0.outputValue(-1, 10), QVariant());
-    QCOMPARE(dataRow0.outputValue(0, 10), QVariant());
-    QCOMPARE(dataRow0.outputValue(4, 1), QVariant());
+    QCOMPARE(dataRow0.outputValue(nullptr, -1, 10), QVariant());
+    QCOMPARE(dataRow0.outputValue(nullptr, 0, 10), QVariant());
+    QCOMPARE(dataRow0.outputValue(nullptr, 4, 1), QVariant());
     DataRow dataRow1(4);
-    dataRow1.outputData()[0] = 0;
-    dataRow1.outputData()[1] = 1;
-    dataRow1.outputData()[2] = 2;
-    dataRow1.outputData()[3] = 3;
+    dataRow1.inputData()[0] = 0;
+    dataRow1.inputData()[1] = 1;
+    dataRow1.inputData()[2] = 2;
+    dataRow1.inputData()[3] = 3;
+    dataRow1.nlFlags().set(2);
+    const double nl[] = { 20 };
     dataRow1.colIdx()[0] = 0;
     dataRow1.colIdx()[1] = 1;
     dataRow1.colIdx()[2] = 2;
     dataRow1.colIdx()[3] = 3;
-    QCOMPARE(dataRow1.outputValue(-1, -4), QVariant());
-    QCOMPARE(dataRow1.outputValue(0, 1).toDouble(), dataRow1.outputData()[0]);
-    QCOMPARE(dataRow1.outputValue(1, 4).toDouble(), dataRow1.outputData()[1]);
-    QCOMPARE(dataRow1.outputValue(2, 5).toDouble(), dataRow1.outputData()[2]);
-    QCOMPARE(dataRow1.outputValue(3, 4).toDouble(), dataRow1.outputData()[3]);
-    QCOMPARE(dataRow1.outputValue(3, -1), QVariant());
+    QCOMPARE(dataRow1.outputValue(nl, -1, -4), QVariant());
+    QCOMPARE(dataRow1.outputValue(nl, 0, 1).toDouble(), dataRow1.outputData(nl)[0]);
+    QCOMPARE(dataRow1.outputValue(nl, 1, 4).toDouble(), dataRow1.outputData(nl)[1]);
+    QCOMPARE(dataRow1.outputValue(nl, 2, 5).toDouble(), 20.0);
+    QCOMPARE(dataRow1.outputValue(nl, 3, 4).toDouble(), dataRow1.outputData(nl)[3]);
+    QCOMPARE(dataRow1.outputValue(nl, 3, -1), QVariant());
+    QCOMPARE(dataRow1.outputValue(nullptr, 2, 5).toDouble(), 2.0);
+    QCOMPARE(dataRow1.inputValue(2, 5).toDouble(), 2.0);
+    QCOMPARE(dataRow1.outputData(nullptr)[2], 2.0);
+    DataRow dataRow2(dataRow1);
+    QCOMPARE(dataRow2.outputData(nl)[2], 20.0);
+}
+
+void TestDataMatrix::test_RowValues_rank()
+{
+    // every third entry is NL, so the ranks cross the inline flag word
+    const int entries = 200;
+    DataRow row(entries);
+    QVector<double> nl;
+    for (int e=0; e<entries; ++e) {
+        row.colIdx()[e] = e;
+        row.inputData()[e] = e;
+        if (e % 3 == 0) {
+            row.nlFlags().set(e);
+            nl.append(-e);
+        }
+    }
+    auto values = row.outputData(nl.constData());
+    for (int e=0; e<entries; ++e)
+        QCOMPARE(values[e], e % 3 ? double(e) : double(-e));
+    // backwards and skipping entries restarts or advances the rank
+    for (int e=entries-1; e>=0; e-=7)
+        QCOMPARE(values[e], e % 3 ? double(e) : double(-e));
+    QCOMPARE(values[198], -198.0);
+    QCOMPARE(values[0], 0.0);
+    QCOMPARE(values[66], -66.0);
+    QCOMPARE(values[63], -63.0);
+    QCOMPARE(values[129], -129.0);
+}
+
+void TestDataMatrix::test_PackedBitSet()
+{
+    PackedBitSet empty;
+    QCOMPARE(empty.size(), 0);
+    QCOMPARE(empty.count(), 0);
+    QVERIFY(!empty.any());
+    QVector<int> flags(150, 0);
+    flags[0] = 1;
+    flags[63] = 1;
+    flags[64] = 1;
+    flags[100] = 1;
+    flags[149] = 1;
+    auto bits = PackedBitSet::fromFlags(flags.constData(), flags.size());
+    QCOMPARE(bits.size(), 150);
+    QCOMPARE(bits.byteSize(), qint64(2 * sizeof(quint64)));
+    QCOMPARE(bits.count(), 5);
+    QVERIFY(bits.any());
+    QVERIFY(bits.test(63));
+    QVERIFY(!bits.test(62));
+    QCOMPARE(bits.count(0, 0), 1);
+    QCOMPARE(bits.count(1, 62), 0);
+    QCOMPARE(bits.count(63, 64), 2);
+    QCOMPARE(bits.count(65, 149), 2);
+    QCOMPARE(bits.count(64, 63), 0);
+    bits.set(62);
+    QCOMPARE(bits.count(), 6);
+    bits.set(62, false);
+    QCOMPARE(bits.count(), 5);
+    QCOMPARE(bits, PackedBitSet::fromFlags(flags.constData(), flags.size()));
+    QVERIFY(bits != PackedBitSet(150));
+
+    // up to 64 bits are stored inline
+    auto inlineBits = PackedBitSet::fromFlags(flags.constData(), 64);
+    QCOMPARE(inlineBits.byteSize(), qint64(0));
+    QCOMPARE(inlineBits.count(), 2);
+    QCOMPARE(inlineBits.rank(63), 1);
+    inlineBits.set(5);
+    QCOMPARE(inlineBits.count(0, 62), 2);
+    QCOMPARE(PackedBitSet(65).byteSize(), qint64(sizeof(quint64)));
+    QVERIFY(!PackedBitSet(65).any());
 }
 
 void TestDataMatrix::test_DataMatrix_defaults()
@@ -168,6 +251,49 @@ void TestDataMatrix::test_DataMatrix()
     QVERIFY(dataMatrix5.evalPoint() != nullptr);
 }
 
+void TestDataMatrix::test_DataMatrix_nlOverlay()
+{
+    DataMatrix matrix(2, 3, 1);
+    int flags[2][3] = { { 0, 1, 1 }, { 0, 0, 0 } };
+    for (int r=0; r<2; ++r) {
+        auto row = matrix.row(r);
+        *row = DataRow(3);
+        for (int e=0; e<3; ++e) {
+            row->colIdx()[e] = e;
+            row->inputData()[e] = e + 1;
+        }
+        row->setNlFlags(flags[r]);
+    }
+    auto overlay = std::make_shared<NlOverlay>();
+    overlay->RowStart = { 0, 2, 2 };
+    overlay->Values = { 20, 30 };
+    QCOMPARE(overlay->byteSize(), qint64(3 * sizeof(qint64) + 2 * sizeof(double)));
+    matrix.setNlOverlay(overlay);
+    QVERIFY(matrix.nlOverlay() == overlay);
+    auto values = matrix.values(true);
+    QCOMPARE(values.row(0)[0], 1.0);
+    QCOMPARE(values.row(0)[1], 20.0);
+    QCOMPARE(values.row(0)[2], 30.0);
+    QCOMPARE(values.row(1)[1], 2.0);
+    QCOMPARE(values.value(0, 2, 2).toDouble(), 30.0);
+    QCOMPARE(matrix.values(false).row(0)[2], 3.0);
+    QCOMPARE(matrix.values(false).nlValues(0), nullptr);
+
+    // the values keep the overlay they were created with
+    auto next = std::make_shared<NlOverlay>(*overlay);
+    next->Values = { 21, 31 };
+    matrix.setNlOverlay(next);
+    QCOMPARE(values.row(0)[2], 30.0);
+    QCOMPARE(matrix.values(true).row(0)[2], 31.0);
+    DataMatrix copy(matrix);
+    QVERIFY(copy.nlOverlay() == matrix.nlOverlay());
+    matrix.setNlOverlay(nullptr);
+    QVERIFY(!matrix.nlOverlay());
+    QCOMPARE(matrix.values(true).nlValues(0), nullptr);
+    QCOMPARE(matrix.values(true).row(0)[2], 3.0);
+    QCOMPARE(copy.values(true).row(0)[2], 31.0);
+}
+
 QTEST_APPLESS_MAIN(TestDataMatrix)
 
 #include "tst_testdatamatrix.moc"
@@ -0,0 +1,14 @@
+include(../tests.pri)
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += $$SRCPATH/mii
+
+HEADERS +=  $$SRCPATH/mii/dtoaformatproxymodel.h
+
+SOURCES +=  tst_testdtoaformatproxymodel.cpp        \
+            $$SRCPATH/mii/dtoaformatproxymodel.cpp  \
+            $$SRCPATH/mii/numerics.cpp
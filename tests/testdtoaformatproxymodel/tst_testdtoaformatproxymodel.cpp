@@ -0,0 +1,85 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include <iterator>
+
+#include "dtoaformatproxymodel.h"
+
+using namespace gams::studio::mii;
+
+class TestDtoaFormatProxyModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_FormatCache_hits();
+    void test_FormatCache_capacity();
+};
+
+void TestDtoaFormatProxyModel::test_FormatCache_hits()
+{
+    const double values[] = {
+        0.0, -0.0, 1.0, -1.5, 3705.0, 1e-5, 1e300, 0.1 + 0.2,
+        std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN()
+    };
+    FormatCache cache;
+    QCOMPARE(cache.hitRate(), 0.0);
+    for (auto v : values) {
+        auto expected = DoubleFormatter::format(v, FormatCache::TextFormat,
+                                                FormatCache::TextPrecision, true);
+        QCOMPARE(cache.format(v), expected);
+        QCOMPARE(cache.format(v), expected);
+    }
+    QCOMPARE(cache.misses(), quint64(std::size(values)));
+    QCOMPARE(cache.hits(), quint64(std::size(values)));
+    QCOMPARE(cache.hitRate(), 0.5);
+    QCOMPARE(cache.format(3.14159265), QString("3.14159"));
+
+    cache.insert(2.0, "two");
+    QCOMPARE(cache.format(2.0), QString("two"));
+    cache.clear();
+    QCOMPARE(cache.hits(), quint64(0));
+    QCOMPARE(cache.misses(), quint64(0));
+    QCOMPARE(cache.format(2.0), DoubleFormatter::format(2.0, FormatCache::TextFormat,
+                                                        FormatCache::TextPrecision, true));
+    QCOMPARE(cache.misses(), quint64(1));
+}
+
+void TestDtoaFormatProxyModel::test_FormatCache_capacity()
+{
+    FormatCache cache(2);
+    QCOMPARE(cache.capacity(), 2);
+    cache.format(1.0);
+    cache.format(2.0);
+    cache.format(3.0);
+    cache.format(1.0);
+    QCOMPARE(cache.hits(), quint64(0));
+    QCOMPARE(cache.misses(), quint64(4));
+    cache.format(1.0);
+    QCOMPARE(cache.hits(), quint64(1));
+    cache.setCapacity(8);
+    QCOMPARE(cache.capacity(), 8);
+}
+
+QTEST_APPLESS_MAIN(TestDtoaFormatProxyModel)
+
+#include "tst_testdtoaformatproxymodel.moc"
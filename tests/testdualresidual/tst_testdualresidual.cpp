@@ -0,0 +1,133 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "dualresidual.h"
+#include "matrixbuilder.h"
+
+using namespace gams::studio::mii;
+
+class TestDualResidual : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_DualResidual();
+    void test_DualResidual_sense();
+
+    void test_emptyAndNonlinearRows();
+};
+
+void TestDualResidual::test_DualResidual()
+{
+    //      x0   x1   x2          y
+    // e0:  1    2                1
+    // e1:       1    -1          2
+    // e2:  2         1 (NL: 4)   0.5
+    // x3 has a nonlinear objective and is skipped
+    auto matrix = makeMatrix(4, { { { 0, 1 }, { 1, 2 } },
+                                  { { 1, 1 }, { 2, -1 } },
+                                  { { 0, 2 }, { 2, 1, true } } }, 1);
+    setNlValues(matrix, { {}, {}, { 4 } });
+
+    QCOMPARE(DualResidual::transposeProduct(matrix, false, { 1, 2, 0.5 }),
+             QVector<double>({ 2, 4, -1.5, 0 }));
+    QCOMPARE(DualResidual::transposeProduct(matrix, true, { 1, 2, 0.5 }),
+             QVector<double>({ 2, 4, 0, 0 }));
+
+    auto summaries = DualResidual::run(matrix, true, { 3, 4, 1, 0 }, { 0, 0, 0, 1 },
+                                       { 1, 2, 0.5 }, { 1, 0.5, 1, 7 }, { 0, 0, 1, 1 }, 2);
+    QCOMPARE(summaries.size(), 2);
+    QCOMPARE(summaries.at(0).Symbol, 0);
+    QCOMPARE(summaries.at(0).Columns, 2);
+    QCOMPARE(summaries.at(0).SkippedColumns, 0);
+    QCOMPARE(summaries.at(0).Mismatches, 1);
+    QCOMPARE(summaries.at(0).MismatchColumn, 1);
+    QCOMPARE(summaries.at(0).MaxMismatch, 0.5);
+    QCOMPARE(summaries.at(0).ComputedMarginal, 0.0);
+    QCOMPARE(summaries.at(0).ReportedMarginal, 0.5);
+    QCOMPARE(summaries.at(1).Columns, 1);
+    QCOMPARE(summaries.at(1).SkippedColumns, 1);
+    QCOMPARE(summaries.at(1).Mismatches, 0);
+    QCOMPARE(summaries.at(1).MismatchColumn, 2);
+
+    summaries = DualResidual::run(matrix, false, { 3, 4, 1, 0 }, QVector<int>(),
+                                  { 1, 2, 0.5 }, { 1, 0.5, 1, 0 }, { 0, 0, 1, 1 }, 2);
+    QCOMPARE(summaries.at(1).Columns, 2);
+    QCOMPARE(summaries.at(1).Mismatches, 1);
+    QCOMPARE(summaries.at(1).MaxMismatch, 1.5);
+    QCOMPARE(summaries.at(1).ComputedMarginal, 2.5);
+
+    // the rows are summed in several blocks
+    const int rows = 10000;
+    QVector<QVector<Entry>> entries;
+    for (int r=0; r<rows; ++r)
+        entries.append({ { r % 3, 1 }, { 3, r % 2 ? 1.0 : -1.0 } });
+    auto tall = makeMatrix(4, entries);
+    QCOMPARE(DualResidual::transposeProduct(tall, false, QVector<double>(rows, 2.0)),
+             QVector<double>({ 6668, 6666, 6666, 0 }));
+}
+
+void TestDualResidual::test_DualResidual_sense()
+{
+    // max 3 x0 + x1 or min -3 x0 - x1 subject to e0: x0 + x1 =L= 4, where
+    // x0 = 4 and x1 = 0 at the optimum. The GAMS marginals are the
+    // derivatives of the objective, i.e. y = 3, M(x1) = -2 for max and
+    // y = -3, M(x1) = 2 for min.
+    auto matrix = makeMatrix(2, { { { 0, 1 }, { 1, 1 } } });
+    auto summaries = DualResidual::run(matrix, false, { 3, 1 }, QVector<int>(),
+                                       { 3 }, { 0, -2 }, { 0, 1 }, 2);
+    QCOMPARE(summaries.at(0).Mismatches, 0);
+    QCOMPARE(summaries.at(1).Mismatches, 0);
+    QCOMPARE(summaries.at(1).ComputedMarginal, -2.0);
+
+    summaries = DualResidual::run(matrix, false, { -3, -1 }, QVector<int>(),
+                                  { -3 }, { 0, 2 }, { 0, 1 }, 2);
+    QCOMPARE(summaries.at(0).Mismatches, 0);
+    QCOMPARE(summaries.at(1).Mismatches, 0);
+    QCOMPARE(summaries.at(1).ComputedMarginal, 2.0);
+
+    // marginals of the opposite sign convention are reported
+    summaries = DualResidual::run(matrix, false, { 3, 1 }, QVector<int>(),
+                                  { 3 }, { 0, 2 }, { 0, 1 }, 2);
+    QCOMPARE(summaries.at(1).Mismatches, 1);
+    QCOMPARE(summaries.at(1).MaxMismatch, 4.0);
+}
+
+void TestDualResidual::test_emptyAndNonlinearRows()
+{
+    //      x0        x1   x2
+    // e0:  2         -1
+    // e1:                        empty
+    // e2:  3 (NL: 30)     5 (NL: 50)
+    auto matrix = makeMatrix(3, { { { 0, 2 }, { 1, -1 } },
+                                  {},
+                                  { { 0, 3, true }, { 2, 5, true } } }, 1);
+    setNlValues(matrix, { {}, {}, { 30, 50 } });
+
+    QCOMPARE(DualResidual::transposeProduct(matrix, false, { 1, 1, 1 }),
+             QVector<double>({ 5, -1, 5 }));
+    QCOMPARE(DualResidual::transposeProduct(matrix, true, { 1, 1, 1 }),
+             QVector<double>({ 32, -1, 50 }));
+}
+
+QTEST_APPLESS_MAIN(TestDualResidual)
+
+#include "tst_testdualresidual.moc"
@@ -12,4 +12,6 @@ SOURCES +=  tst_testemptymodelinstance.cpp           \
             $$SRCPATH/mii/datamatrix.cpp             \
             $$SRCPATH/mii/symbol.cpp                 \
             $$SRCPATH/mii/common.cpp                 \
-            $$SRCPATH/mii/postopttreeitem.cpp
+            $$SRCPATH/mii/postopttreeitem.cpp        \
+            $$SRCPATH/mii/searchindex.cpp            \
+            $$SRCPATH/mii/sparsitypyramid.cpp
@@ -32,6 +32,7 @@ private slots:
     void test_constructor_initialize();
     void test_default();
     void test_getSet();
+    void test_searchIndex();
 };
 
 void TestEmptyModelInstance::test_constructor_initialize()
@@ -99,6 +100,18 @@ void TestEmptyModelInstance::test_default()
     QCOMPARE(instance.rowEntryCount(-1, -1), 0);
     QCOMPARE(instance.columnEntryCount(0, 0), 0);
     QCOMPARE(instance.columnEntryCount(-1, -1), 0);
+    QCOMPARE(instance.dataRevision(), 0);
+    auto tile = instance.fetchTile(4, SectionRange(0, 1), SectionRange(2, 4));
+    QCOMPARE(tile.ViewId, 4);
+    QCOMPARE(tile.RowCount, 2);
+    QCOMPARE(tile.ColumnCount, 3);
+    QVERIFY(tile.contains(1, 4));
+    QVERIFY(!tile.contains(2, 4));
+    QCOMPARE(tile.offset(1, 3), 4);
+    QCOMPARE(tile.Mask, QVector<char>(6, 0));
+    QCOMPARE(tile.NlFlags, QVector<char>(6, 0));
+    QVERIFY(instance.searchIndex(Symbol::Equation).isEmpty());
+    QVERIFY(instance.searchIndex(Symbol::Variable).isEmpty());
 }
 
 void TestEmptyModelInstance::test_getSet()
@@ -114,6 +127,56 @@ void TestEmptyModelInstance::test_getSet()
     QCOMPARE(instance.useOutput(), true);
 }
 
+void TestEmptyModelInstance::test_searchIndex()
+{
+    Symbol demand;
+    demand.setName("Demand");
+    demand.setFirstSection(0);
+    demand.setEntries(2);
+    demand.sectionLabels()[0] = QStringList {"Seattle"};
+    demand.sectionLabels()[1] = QStringList {"San-Diego"};
+    Symbol supply;
+    supply.setName("supply");
+    supply.setFirstSection(2);
+    supply.setEntries(2);
+    supply.sectionLabels()[2] = QStringList {"seattle"};
+    supply.sectionLabels()[3] = QStringList {"Topeka"};
+    QVector<Symbol*> symbols {&demand, &supply};
+
+    SearchIndex index;
+    index.build(symbols, 4);
+    QVERIFY(!index.isEmpty());
+    QCOMPARE(index.sectionCount(), 4);
+    QCOMPARE(index.textCount(), 6);
+
+    auto matches = index.find(QString("SEATTLE"));
+    QCOMPARE(matches.count(true), 2);
+    QVERIFY(matches.testBit(0));
+    QVERIFY(matches.testBit(2));
+    matches = index.find(QString("mand"));
+    QCOMPARE(matches.count(true), 2);
+    QVERIFY(matches.testBit(0));
+    QVERIFY(matches.testBit(1));
+    matches = index.find(QString("a"));
+    QCOMPARE(matches.count(true), 4);
+    matches = index.find(QString("xyz"));
+    QCOMPARE(matches.count(true), 0);
+    matches = index.find(QRegularExpression("^[A-Z]"));
+    QCOMPARE(matches.count(true), 4);
+    matches = index.find(QRegularExpression("^s"));
+    QCOMPARE(matches.count(true), 2);
+    QVERIFY(matches.testBit(2));
+    QVERIFY(matches.testBit(3));
+    matches = index.find(QRegularExpression("^S"));
+    QCOMPARE(matches.count(true), 2);
+    QVERIFY(matches.testBit(0));
+    QVERIFY(matches.testBit(1));
+
+    index.clear();
+    QVERIFY(index.isEmpty());
+    QCOMPARE(index.find(QString("supply")).count(true), 0);
+}
+
 QTEST_APPLESS_MAIN(TestEmptyModelInstance)
 
 #include "tst_testemptymodelinstance.moc"
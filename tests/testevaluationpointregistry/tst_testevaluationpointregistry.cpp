@@ -0,0 +1,107 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "evaluationpointregistry.h"
+#include "datamatrix.h"
+
+using namespace gams::studio::mii;
+
+class TestEvaluationPointRegistry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_EvaluationPointRegistry();
+};
+
+void TestEvaluationPointRegistry::test_EvaluationPointRegistry()
+{
+    QCOMPARE(EvaluationPointRegistry::hash({ 0.0, 1.0 }), EvaluationPointRegistry::hash({ -0.0, 1.0 }));
+    QVERIFY(EvaluationPointRegistry::hash({ 0.0, 1.0 }) != EvaluationPointRegistry::hash({ 1.0, 0.0 }));
+    QVERIFY(EvaluationPointRegistry::hash({ 0.0 }) != EvaluationPointRegistry::hash({ 0.0, 0.0 }));
+
+    const double inf = std::numeric_limits<double>::infinity();
+    QCOMPARE(EvaluationPointRegistry::boundsMidpoint({ 0, 1, -inf, -inf }, { 4, inf, 2, inf }),
+             QVector<double>({ 2, 1, 2, 0 }));
+
+    bool ok = false;
+    QCOMPARE(EvaluationPointRegistry::parsePoint("1.5,-2;3e2\n 0\r\n", &ok),
+             QVector<double>({ 1.5, -2, 300, 0 }));
+    QVERIFY(ok);
+    QVERIFY(EvaluationPointRegistry::parsePoint("1,x,3", &ok).isEmpty());
+    QVERIFY(!ok);
+    QVERIFY(EvaluationPointRegistry::parsePoint(" \n", &ok).isEmpty());
+    QVERIFY(!ok);
+
+    EvaluationPointRegistry registry;
+    QCOMPARE(registry.count(), 0);
+    int evaluations = 0;
+    auto evaluate = [&evaluations](const QVector<double> &point) {
+        ++evaluations;
+        auto overlay = std::make_shared<NlOverlay>();
+        overlay->RowStart = { 0, 1 };
+        overlay->Values = { point.first() * 2 };
+        return std::shared_ptr<const NlOverlay>(overlay);
+    };
+    auto overlay = registry.overlay({ 3.0 }, evaluate);
+    QCOMPARE(overlay->Values, QVector<double>({ 6.0 }));
+    QCOMPARE(registry.overlay({ 3.0 }, evaluate), overlay);
+    QCOMPARE(evaluations, 1);
+    registry.overlay({ 4.0 }, evaluate);
+    QCOMPARE(evaluations, 2);
+    QCOMPARE(registry.count(), 2);
+    const qint64 entrySize = overlay->byteSize() + qint64(sizeof(double));
+    QCOMPARE(registry.byteSize(), 2 * entrySize);
+    QCOMPARE(registry.overlay({ 3.0 }), overlay);
+    auto zero = registry.overlay({ -0.0 }, evaluate);
+    QCOMPARE(registry.overlay({ 0.0 }), zero);
+    QCOMPARE(evaluations, 3);
+    QVERIFY(!registry.overlay({ 3.0, 0.0 }));
+
+    // inserting a cached point again replaces its overlay
+    auto other = registry.overlay({ 5.0 }, evaluate);
+    registry.insert({ 3.0 }, other);
+    QCOMPARE(registry.overlay({ 3.0 }), other);
+    QCOMPARE(registry.count(), 4);
+
+    // the least recently used points are dropped beyond the budget
+    registry.clear();
+    QCOMPARE(registry.memoryBudget(), EvaluationPointRegistry::DefaultMemoryBudget);
+    registry.setMemoryBudget(2 * entrySize);
+    registry.overlay({ 1.0 }, evaluate);
+    registry.overlay({ 2.0 }, evaluate);
+    QVERIFY(registry.overlay({ 1.0 }));
+    registry.overlay({ 3.0 }, evaluate);
+    QCOMPARE(registry.count(), 2);
+    QVERIFY(registry.overlay({ 1.0 }));
+    QVERIFY(!registry.overlay({ 2.0 }));
+    QVERIFY(registry.overlay({ 3.0 }));
+    registry.setMemoryBudget(0);
+    QCOMPARE(registry.count(), 1);
+    QVERIFY(registry.overlay({ 3.0 }));
+    registry.clear();
+    QCOMPARE(registry.count(), 0);
+    QVERIFY(!registry.overlay({ 3.0 }));
+}
+
+QTEST_APPLESS_MAIN(TestEvaluationPointRegistry)
+
+#include "tst_testevaluationpointregistry.moc"
@@ -0,0 +1,140 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "loghistogram.h"
+
+using namespace gams::studio::mii;
+
+class TestLogHistogram : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_LogHistogram();
+    void test_LogHistogram_worstScaled();
+    void test_LogHistogram_finish();
+};
+
+void TestLogHistogram::test_LogHistogram()
+{
+    QCOMPARE(LogHistogram::bucket(1e-11), 0);
+    QCOMPARE(LogHistogram::bucket(1e-10), 1);
+    QCOMPARE(LogHistogram::bucket(0.999), 10);
+    QCOMPARE(LogHistogram::bucket(1.0), 11);
+    QCOMPARE(LogHistogram::bucket(-9.99), 11);
+    QCOMPARE(LogHistogram::bucket(10.0), 12);
+    QCOMPARE(LogHistogram::bucket(1e10), LogHistogram::BucketCount-1);
+    QCOMPARE(LogHistogram::bucket(1e300), LogHistogram::BucketCount-1);
+    QCOMPARE(LogHistogram::bucket(1e-300), 0);
+    QCOMPARE(LogHistogram::bucketText(0), "< 1e-10");
+    QCOMPARE(LogHistogram::bucketText(8), "1e-3 .. 1e-2");
+    QCOMPARE(LogHistogram::bucketText(LogHistogram::BucketCount-1), ">= 1e10");
+
+    LogHistogram histogram(2, 3);
+    histogram.add(2, 5.0);
+    histogram.add(0, 0.5);
+    histogram.add(2, -50.0);
+    histogram.add(1, 0.0);
+    histogram.finishRow(0);
+    histogram.add(1, std::numeric_limits<double>::infinity());
+    histogram.finishRow(1);
+    QCOMPARE(histogram.nonZeros(), qint64(3));
+    QCOMPARE(histogram.blocks().size(), 2);
+    QCOMPARE(histogram.blocks().at(0).Column, 0);
+    QCOMPARE(histogram.blocks().at(1).Column, 2);
+    QVERIFY(!histogram.block(0, 1));
+    QVERIFY(!histogram.block(1, 2));
+    auto block = histogram.block(0, 2);
+    QVERIFY(block);
+    QCOMPARE(LogHistogram::sum(block->Counts), qint64(2));
+    QCOMPARE(block->Counts[11], quint32(1));
+    QCOMPARE(block->Counts[12], quint32(1));
+    QCOMPARE(histogram.total()[10], quint32(1));
+    QCOMPARE(block->Minimum, 5.0);
+    QCOMPARE(block->Maximum, 50.0);
+}
+
+void TestLogHistogram::test_LogHistogram_worstScaled()
+{
+    LogHistogram histogram(3, 4);
+    histogram.add(0, 1.0);
+    histogram.add(0, -1000.0);
+    histogram.add(1, 2.0);
+    histogram.add(1, 4.0);
+    histogram.finishRow(0);
+    histogram.add(1, 1e-3);
+    histogram.add(1, 1.0);
+    histogram.add(3, 5.0);
+    histogram.finishRow(2);
+
+    QVERIFY(histogram.worstScaled(LogHistogram::BlockRanks, 0).isEmpty());
+    auto ranks = histogram.worstScaled(LogHistogram::BlockRanks, 2);
+    QCOMPARE(ranks.size(), 2);
+    QCOMPARE(ranks.at(0).Row, 0);
+    QCOMPARE(ranks.at(0).Column, 0);
+    QCOMPARE(ranks.at(0).NonZeros, qint64(2));
+    QCOMPARE(ranks.at(1).Row, 2);
+    QCOMPARE(ranks.at(1).Column, 1);
+    QCOMPARE(histogram.worstScaled(LogHistogram::BlockRanks, 10).size(), 4);
+
+    ranks = histogram.worstScaled(LogHistogram::RowRanks, 10);
+    QCOMPARE(ranks.size(), 2);
+    QCOMPARE(ranks.at(0).Row, 2);
+    QCOMPARE(ranks.at(0).Column, -1);
+    QCOMPARE(ranks.at(0).Minimum, 1e-3);
+    QCOMPARE(ranks.at(0).Maximum, 5.0);
+    QCOMPARE(ranks.at(0).NonZeros, qint64(3));
+    QCOMPARE(ranks.at(1).Row, 0);
+
+    ranks = histogram.worstScaled(LogHistogram::ColumnRanks, 1);
+    QCOMPARE(ranks.size(), 1);
+    QCOMPARE(ranks.at(0).Row, -1);
+    QCOMPARE(ranks.at(0).Column, 1);
+    QCOMPARE(ranks.at(0).NonZeros, qint64(4));
+}
+
+void TestLogHistogram::test_LogHistogram_finish()
+{
+    // the rows of a symbol may be finished out of order
+    LogHistogram histogram(2, 2, true);
+    QVERIFY(histogram.usesOutput());
+    histogram.add(1, 300.0);
+    histogram.finishRow(1);
+    histogram.add(1, 0.5);
+    histogram.add(0, -7.0);
+    histogram.finishRow(0);
+    QCOMPARE(histogram.blocks().at(0).Row, 1);
+    QVERIFY(!histogram.block(1, 1));
+    histogram.finish();
+    QCOMPARE(histogram.blocks().size(), 3);
+    QCOMPARE(histogram.blocks().at(0).Row, 0);
+    QCOMPARE(histogram.blocks().at(0).Column, 0);
+    QCOMPARE(histogram.blocks().at(1).Column, 1);
+    QCOMPARE(histogram.blocks().at(2).Row, 1);
+    QVERIFY(histogram.block(1, 1));
+    QCOMPARE(histogram.block(1, 1)->Maximum, 300.0);
+    QCOMPARE(histogram.block(0, 1)->Minimum, 0.5);
+    QVERIFY(!LogHistogram(1, 1).usesOutput());
+}
+
+QTEST_APPLESS_MAIN(TestLogHistogram)
+
+#include "tst_testloghistogram.moc"
@@ -0,0 +1,14 @@
+include(../tests.pri)
+
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += $$SRCPATH/mii
+
+SOURCES +=  tst_testnumerics.cpp            \
+            $$SRCPATH/mii/numerics.cpp
@@ -0,0 +1,142 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include "numerics.h"
+
+using namespace gams::studio::mii;
+
+class TestNumerics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_x2gfmtToChars_special();
+    void test_x2gfmtToChars_random();
+    void test_x2gfmtBatch();
+
+    void benchmark_x2gfmt_data();
+    void benchmark_x2gfmt();
+
+private:
+    QString compare(double v, int nSigFigs, int squeeze, char decSep = '.');
+};
+
+QString TestNumerics::compare(double v, int nSigFigs, int squeeze, char decSep)
+{
+    char dtoaBuf[32], toCharsBuf[32];
+    int dtoaLen, toCharsLen;
+    auto dtoa = x2gfmt(v, nSigFigs, squeeze, dtoaBuf, &dtoaLen, decSep);
+    auto toChars = x2gfmtToChars(v, nSigFigs, squeeze, toCharsBuf, &toCharsLen, decSep);
+    if (!dtoa && !toChars)
+        return QString();
+    if (dtoa && toChars && dtoaLen == toCharsLen && !std::strcmp(dtoa, toChars))
+        return QString();
+    return QString("%1 (n=%2, squeeze=%3): %4 vs %5").arg(v, 0, 'g', 17)
+            .arg(nSigFigs).arg(squeeze)
+            .arg(dtoa ? dtoa : "NULL", toChars ? toChars : "NULL");
+}
+
+void TestNumerics::test_x2gfmtToChars_special()
+{
+    const double values[] = {
+        0.0, -0.0, 1.0, -1.0, 0.5, 2.5, 0.125, 100.0, 3100.0, 3705.0,
+        3005.0, 165050.0, 7619949951995.0, 1e15, 1e21, 1e22, 1e-5, 1e300,
+        1e-300, 5e-324, std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::lowest(), std::numeric_limits<double>::min(),
+        std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN()
+    };
+    for (auto v : values) {
+        for (int n=-1; n<=18; ++n) {
+            QCOMPARE(compare(v, n, true), QString());
+            QCOMPARE(compare(v, n, false), QString());
+        }
+        QCOMPARE(compare(v, 6, true, ','), QString());
+    }
+}
+
+void TestNumerics::test_x2gfmtToChars_random()
+{
+    std::mt19937_64 rng(20240201);
+    std::uniform_int_distribution<int> exponent(-40, 40);
+    std::uniform_int_distribution<qint64> integer(0, 999999999999999);
+    for (int i=0; i<1000000; ++i) {
+        auto bits = rng();
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        int n = i % 18;
+        int squeeze = i & 1;
+        QCOMPARE(compare(v, n, squeeze), QString());
+        v = std::ldexp(double(rng() % 1000000) / 7.0, exponent(rng));
+        QCOMPARE(compare(v, n, squeeze), QString());
+        v = double(integer(rng));
+        QCOMPARE(compare(v, n, squeeze), QString());
+        QCOMPARE(compare(-v * 0.001, n, squeeze), QString());
+    }
+}
+
+void TestNumerics::test_x2gfmtBatch()
+{
+    const double values[] = {1.5, -0.0, std::numeric_limits<double>::quiet_NaN(), 1e300, 3705.0};
+    char buffer[64];
+    int offsets[6];
+    QCOMPARE(x2gfmtBatch(values, 5, 3, true, buffer, sizeof(buffer), offsets, ','), 5);
+    QCOMPARE(QString(buffer+offsets[0]), "1,5");
+    QCOMPARE(QString(buffer+offsets[1]), "-0");
+    QCOMPARE(QString(buffer+offsets[2]), "");
+    QCOMPARE(QString(buffer+offsets[3]), "1e+300");
+    QCOMPARE(QString(buffer+offsets[4]), "3,70e+03");
+    QCOMPARE(offsets[5], 24);
+    QCOMPARE(x2gfmtBatch(values, 5, 3, true, buffer, 10, offsets, '.'), 3);
+    QCOMPARE(offsets[3], 8);
+}
+
+void TestNumerics::benchmark_x2gfmt_data()
+{
+    QTest::addColumn<bool>("toChars");
+    QTest::newRow("dtoaLoc") << false;
+    QTest::newRow("to_chars") << true;
+}
+
+void TestNumerics::benchmark_x2gfmt()
+{
+    QFETCH(bool, toChars);
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> exponent(-40, 40);
+    QVector<double> values(100000);
+    for (auto& v : values)
+        v = std::ldexp(double(rng() % 1000000) / 7.0, exponent(rng));
+    auto format = toChars ? x2gfmtToChars : x2gfmt;
+    char buffer[32];
+    int length;
+    QBENCHMARK {
+        for (auto v : values)
+            format(v, 6, true, buffer, &length, '.');
+    }
+}
+
+QTEST_APPLESS_MAIN(TestNumerics)
+
+#include "tst_testnumerics.moc"
@@ -34,6 +34,10 @@ private slots:
 
     void test_LinePostoptTreeItem_default();
     void test_LinePostoptTreeItem_get_set();
+
+    void test_ValuePostoptTreeItem();
+
+    void test_PostoptTreeArena();
 };
 
 void TestPostoptTreeItem::test_GroupPostoptTreeItem_default()
@@ -111,6 +115,55 @@ void TestPostoptTreeItem::test_LinePostoptTreeItem_get_set()
     delete root;
 }
 
+void TestPostoptTreeItem::test_ValuePostoptTreeItem()
+{
+    ValuePostoptTreeItem item("x(i1)", 2.0, 0.5, 1.0);
+    QCOMPARE(item.data(0).toString(), "x(i1)");
+    QCOMPARE(item.data(1).toDouble(), 2.0);
+    QCOMPARE(item.data(2).toDouble(), 0.5);
+    QCOMPARE(item.data(3).toDouble(), 1.0);
+    QCOMPARE(item.data(4), QVariant());
+    QCOMPARE(item.data(-1), QVariant());
+    QCOMPARE(item.columnCount(), 4);
+    QCOMPARE(item.type(), PostoptTreeItem::LineItem);
+}
+
+void TestPostoptTreeItem::test_PostoptTreeArena()
+{
+    QSharedPointer<RootPostoptTreeItem> root(new RootPostoptTreeItem);
+    auto& arena = root->arena();
+    QCOMPARE(arena.itemCount(), 0);
+    QCOMPARE(arena.blockCount(), 0);
+
+    auto group = arena.create<GroupPostoptTreeItem>("G1", root.get());
+    root->append(group);
+    auto mark = arena.mark();
+    auto line = arena.create<LinePostoptTreeItem>(QVector<QVariant>({"I1", "E"}), group);
+    line->append(arena.create<ValuePostoptTreeItem>("x", 1.0, 2.0, 2.0, line));
+    QCOMPARE(arena.itemCount(), 3);
+    QCOMPARE(arena.blockCount(), 1);
+    arena.rollback(mark);
+    QCOMPARE(arena.itemCount(), 1);
+    QCOMPARE(group->rowCount(), 0);
+
+    mark = arena.mark();
+    for (int i=0; i<10000; ++i)
+        arena.create<ValuePostoptTreeItem>();
+    QCOMPARE(arena.itemCount(), 10001);
+    const int blocks = arena.blockCount();
+    QVERIFY(blocks > 1);
+    arena.rollback(mark);
+    QCOMPARE(arena.itemCount(), 1);
+
+    for (int i=0; i<10000; ++i)
+        group->append(arena.create<ValuePostoptTreeItem>(QString::number(i), i, 1.0, i, group));
+    QCOMPARE(arena.blockCount(), blocks);
+    QCOMPARE(group->rowCount(), 10000);
+    QCOMPARE(group->child(9999)->data(0).toString(), "9999");
+    QCOMPARE(group->child(9999)->data(3).toDouble(), 9999.0);
+    QCOMPARE(root->child(0), group);
+}
+
 QTEST_APPLESS_MAIN(TestPostoptTreeItem)
 
 #include "tst_testpostopttreeitem.moc"
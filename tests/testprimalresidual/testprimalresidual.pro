@@ -0,0 +1,18 @@
+include(../tests.pri)
+
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += $$SRCPATH/mii \
+               $$TESTSROOT
+
+HEADERS +=  $$TESTSROOT/matrixbuilder.h
+
+SOURCES +=  tst_testprimalresidual.cpp       \
+            $$SRCPATH/mii/datamatrix.cpp     \
+            $$SRCPATH/mii/primalresidual.cpp
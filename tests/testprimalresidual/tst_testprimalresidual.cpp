@@ -0,0 +1,71 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "primalresidual.h"
+#include "matrixbuilder.h"
+
+using namespace gams::studio::mii;
+
+class TestPrimalResidual : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_PrimalResidual();
+};
+
+void TestPrimalResidual::test_PrimalResidual()
+{
+    QCOMPARE(PrimalResidual::violation('E', 1.0, 2.0), 1.0);
+    QCOMPARE(PrimalResidual::violation('G', 1.0, 2.0), 1.0);
+    QCOMPARE(PrimalResidual::violation('G', 3.0, 2.0), 0.0);
+    QCOMPARE(PrimalResidual::violation('L', 3.0, 2.0), 1.0);
+    QCOMPARE(PrimalResidual::violation('N', 3.0, 2.0), 0.0);
+
+    //      x0   x1   x2          level  rhs
+    // e0:  1    2                3      3    =E=
+    // e1:       1    -1          0.5    1    =G=  violated
+    // e2:  1e6       1           1      -    =N=  residual 1e6
+    // f0:  1    1    1 (NL)      0      0    =L=  nonlinear
+    auto matrix = makeMatrix(3, { { { 0, 1 }, { 1, 2 } },
+                                  { { 1, 1 }, { 2, -1 } },
+                                  { { 0, 1e6 }, { 2, 1 } },
+                                  { { 0, 1 }, { 1, 1 }, { 2, 1, true } } }, 1);
+    auto summaries = PrimalResidual::run(matrix, { 1, 1, 0.5 }, { 3, 0.5, 1, 0 }, { 3, 1, 0, 0 },
+                                         "EGNL", { 0, 0, 0, 1 }, 2);
+    QCOMPARE(summaries.size(), 2);
+    QCOMPARE(summaries.at(0).Symbol, 0);
+    QCOMPARE(summaries.at(0).Rows, 3);
+    QCOMPARE(summaries.at(0).NonlinearRows, 0);
+    QCOMPARE(summaries.at(0).ResidualRow, 2);
+    QCOMPARE(summaries.at(0).MaxResidual, 1e6 + 0.5 - 1);
+    QVERIFY(summaries.at(0).MaxRelativeResidual < 1.0);
+    QCOMPARE(summaries.at(0).Violations, 1);
+    QCOMPARE(summaries.at(0).ViolationRow, 1);
+    QCOMPARE(summaries.at(0).MaxViolation, 0.5);
+    QCOMPARE(summaries.at(1).Rows, 0);
+    QCOMPARE(summaries.at(1).NonlinearRows, 1);
+    QCOMPARE(summaries.at(1).ResidualRow, -1);
+}
+
+QTEST_APPLESS_MAIN(TestPrimalResidual)
+
+#include "tst_testprimalresidual.moc"
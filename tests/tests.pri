@@ -1,4 +1,4 @@
-QT += core gui widgets testlib
+QT += core gui widgets testlib concurrent
 
 CONFIG += c++17
 CONFIG -= app_bundle
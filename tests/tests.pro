@@ -1,14 +1,28 @@
 TEMPLATE = subdirs
 
-SUBDIRS +=                          \
-    testcommon                      \
-    testdatahandler                 \
-    testdatamatrix                  \
-    testemptymodelinstance          \
-    testfiltertreeitem              \
-    testlabeltreeitem               \
-    testmodelinstance               \
-    testpostopttreeitem             \
-    testsectiontreeitem             \
-    testsymbol                      \
-    testviewconfigurationprovider
+SUBDIRS +=                           \
+    testcoefficientsearch            \
+    testcommon                       \
+    testcomponentanalysis            \
+    testdatahandler                  \
+    testdatamatrix                   \
+    testdtoaformatproxymodel         \
+    testdualresidual                 \
+    testemptymodelinstance           \
+    testevaluationpointregistry      \
+    testfiltertreeitem               \
+    testlabeltreeitem                \
+    testloghistogram                 \
+    testmodelinstance                \
+    testnumerics                     \
+    testpostopttreeitem              \
+    testprimalresidual               \
+    testscalingadvisor               \
+    testsearch                       \
+    testsectiontreeitem              \
+    testsparsitypyramid              \
+    teststructuraldiagnostics        \
+    testsymbol                       \
+    testsymbolhierarchicalheaderview \
+    testviewconfigurationprovider    \
+    testviewportprefetcher
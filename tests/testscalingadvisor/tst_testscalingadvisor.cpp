@@ -0,0 +1,83 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "scalingadvisor.h"
+#include "symbol.h"
+#include "matrixbuilder.h"
+
+using namespace gams::studio::mii;
+
+class TestScalingAdvisor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_ScalingAdvisor();
+};
+
+void TestScalingAdvisor::test_ScalingAdvisor()
+{
+    QCOMPARE(ScalingAdvisor::round(3.0, ScalingAdvisor::PowerOfTwo), 4.0);
+    QCOMPARE(ScalingAdvisor::round(3000.0, ScalingAdvisor::PowerOfTen), 1000.0);
+    QCOMPARE(ScalingAdvisor::round(3.0, ScalingAdvisor::NoRounding), 3.0);
+    QCOMPARE(ScalingAdvisor::round(-1.0, ScalingAdvisor::PowerOfTwo), 1.0);
+
+    DataMatrix empty;
+    auto advice = ScalingAdvisor::run(empty, false, {}, {}, ScalingAdvisor::Options());
+    QVERIFY(advice->isEmpty());
+
+    // | 1      1000 |
+    // | 0.001  1    |
+    auto matrix = makeMatrix(2, { { { 0, 1.0 }, { 1, 1000.0 } }, { { 0, 0.001 }, { 1, 1.0 } } });
+    advice = ScalingAdvisor::run(matrix, false, {}, {}, ScalingAdvisor::Options());
+    QCOMPARE(advice->NonZeros, qint64(4));
+    QVERIFY(advice->Passes > 0);
+    QVERIFY(qFuzzyCompare(advice->UnscaledRatio, 1e6));
+    QVERIFY(qFuzzyCompare(advice->CurrentRatio, 1e6));
+    QVERIFY(advice->SuggestedRatio < 2.0);
+    QCOMPARE(advice->EquationScales, QVector<double>({ 32.0, 0.03125 }));
+    QCOMPARE(advice->VariableScales, QVector<double>({ 32.0, 0.03125 }));
+
+    ScalingAdvisor::Options options;
+    options.Round = ScalingAdvisor::NoRounding;
+    advice = ScalingAdvisor::run(matrix, false, { 1.0, 1000.0 }, {}, options);
+    QVERIFY(qFuzzyCompare(advice->CurrentRatio, 1e9));
+    QVERIFY(qFuzzyCompare(advice->SuggestedRatio, 1.0));
+    QCOMPARE(advice->CurrentEquationScales, QVector<double>({ 1.0, 1000.0 }));
+    QCOMPARE(advice->CurrentVariableScales, QVector<double>({ 1.0, 1.0 }));
+
+    Symbol symbol;
+    symbol.setFirstSection(0);
+    symbol.setEntries(2);
+    auto scales = ScalingAdvisor::symbolScales({ &symbol },
+                                               advice->CurrentEquationScales,
+                                               advice->EquationScales,
+                                               ScalingAdvisor::PowerOfTen);
+    QCOMPARE(scales.size(), 1);
+    QVERIFY(qFuzzyCompare(scales.at(0).Current, std::sqrt(1000.0)));
+    QCOMPARE(scales.at(0).Suggested, 1.0);
+    QVERIFY(qFuzzyCompare(scales.at(0).Minimum, 1.0 / std::sqrt(1000.0)));
+    QVERIFY(qFuzzyCompare(scales.at(0).Maximum, std::sqrt(1000.0)));
+}
+
+QTEST_APPLESS_MAIN(TestScalingAdvisor)
+
+#include "tst_testscalingadvisor.moc"
@@ -0,0 +1,33 @@
+include(../tests.pri)
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += $$SRCPATH/mii
+
+HEADERS +=  $$SRCPATH/mii/search.h
+
+SOURCES +=  tst_testsearch.cpp                           \
+            $$SRCPATH/mii/abstractmodelinstance.cpp      \
+            $$SRCPATH/mii/modelinstance.cpp              \
+            $$SRCPATH/mii/datahandler.cpp                \
+            $$SRCPATH/mii/datamatrix.cpp                 \
+            $$SRCPATH/mii/labeltreeitem.cpp              \
+            $$SRCPATH/mii/symbol.cpp                     \
+            $$SRCPATH/mii/search.cpp                     \
+            $$SRCPATH/mii/viewconfigurationprovider.cpp  \
+            $$SRCPATH/mii/common.cpp                     \
+            $$SRCPATH/mii/coefficientsearch.cpp          \
+            $$SRCPATH/mii/postopttreeitem.cpp            \
+            $$SRCPATH/mii/numerics.cpp                   \
+            $$SRCPATH/mii/searchindex.cpp                \
+            $$SRCPATH/mii/sparsitypyramid.cpp            \
+            $$SRCPATH/mii/scalingadvisor.cpp             \
+            $$SRCPATH/mii/loghistogram.cpp               \
+            $$SRCPATH/mii/structuraldiagnostics.cpp      \
+            $$SRCPATH/mii/componentanalysis.cpp          \
+            $$SRCPATH/mii/dualresidual.cpp               \
+            $$SRCPATH/mii/evaluationpointregistry.cpp    \
+            $$SRCPATH/mii/primalresidual.cpp
@@ -0,0 +1,172 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+#include <QAbstractTableModel>
+
+#include "abstractmodelinstance.h"
+#include "search.h"
+#include "searchindex.h"
+#include "viewconfigurationprovider.h"
+
+using namespace gams::studio::mii;
+
+///
+/// \brief Static header model with the labels <c>x0</c>, <c>x1</c>, ...
+///        for columns and <c>e0</c>, <c>e1</c>, ... for rows.
+///
+class LabelModel : public QAbstractTableModel
+{
+public:
+    LabelModel(int rows, int columns)
+        : mRows(rows)
+        , mColumns(columns)
+    {
+
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : mRows;
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : mColumns;
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        Q_UNUSED(index);
+        Q_UNUSED(role);
+        return QVariant();
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override
+    {
+        if (role != ViewHelper::SectionLabelRole)
+            return QVariant();
+        auto prefix = orientation == Qt::Horizontal ? "x" : "e";
+        return QStringList { prefix + QString::number(section) };
+    }
+
+private:
+    int mRows;
+    int mColumns;
+};
+
+class TestSearch : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_regExSearch_staticHeader();
+    void test_regExSearch_invalid();
+    void test_regExSearch_indexEntries();
+
+private:
+    QSharedPointer<AbstractViewConfiguration> viewConfiguration() const;
+};
+
+void TestSearch::test_regExSearch_staticHeader()
+{
+    // more rows than a single chunk holds
+    LabelModel model(5000, 10);
+    auto viewConfig = viewConfiguration();
+    RegExSearch search(viewConfig, &model, "7$");
+    QSignalSpy foundSpy(&search, &RegExSearch::entriesFound);
+    QSignalSpy finishedSpy(&search, &RegExSearch::finished);
+    search.start();
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(finishedSpy.first().first().toBool(), false);
+    QVERIFY(foundSpy.count() > 1);
+
+    const auto& entries = search.result().Entries;
+    QCOMPARE(entries.size(), 501);
+    QCOMPARE(entries.first(), SearchResult::SearchEntry({7, Qt::Horizontal}));
+    for (int i=1; i<entries.size(); ++i) {
+        QCOMPARE(entries.at(i).Orientation, Qt::Vertical);
+        QCOMPARE(entries.at(i).Index, 10*(i-1) + 7);
+    }
+    QVERIFY(search.result().IsRegEx);
+    QCOMPARE(search.result().Term, "7$");
+}
+
+void TestSearch::test_regExSearch_invalid()
+{
+    LabelModel model(10, 10);
+    auto viewConfig = viewConfiguration();
+    RegExSearch search(viewConfig, &model, "(x");
+    QSignalSpy finishedSpy(&search, &RegExSearch::finished);
+    search.start();
+    QCOMPARE(finishedSpy.count(), 1);
+    QVERIFY(!search.isRunning());
+    QVERIFY(search.result().Entries.isEmpty());
+}
+
+void TestSearch::test_regExSearch_indexEntries()
+{
+    Symbol demand;
+    demand.setName("Demand");
+    demand.setFirstSection(0);
+    demand.setEntries(2);
+    demand.sectionLabels()[0] = QStringList {"Seattle"};
+    demand.sectionLabels()[1] = QStringList {"San-Diego"};
+    Symbol supply;
+    supply.setName("supply");
+    supply.setFirstSection(2);
+    supply.setEntries(2);
+    supply.sectionLabels()[2] = QStringList {"seattle"};
+    supply.sectionLabels()[3] = QStringList {"Topeka"};
+    SearchIndex index;
+    index.build({&demand, &supply}, 4);
+
+    // the view shows the sections in reverse order and hides section 1
+    QVector<int> sections { 3, 2, -1, 0 };
+    auto matches = index.find(QRegularExpression("^[Ss]eattle$"));
+    auto entries = RegExSearch::indexEntries(matches, sections, 0, sections.size()-1, Qt::Vertical);
+    QCOMPARE(entries.size(), 2);
+    QCOMPARE(entries.at(0), SearchResult::SearchEntry({1, Qt::Vertical}));
+    QCOMPARE(entries.at(1), SearchResult::SearchEntry({3, Qt::Vertical}));
+
+    // a symbol name match covers all its sections
+    matches = index.find(QRegularExpression("^Dem"));
+    entries = RegExSearch::indexEntries(matches, sections, 0, sections.size()-1, Qt::Horizontal);
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(entries.at(0), SearchResult::SearchEntry({3, Qt::Horizontal}));
+
+    // only the chunk range is resolved
+    matches = index.find(QRegularExpression("e"));
+    entries = RegExSearch::indexEntries(matches, sections, 1, 2, Qt::Vertical);
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(entries.at(0).Index, 1);
+    QVERIFY(RegExSearch::indexEntries(QBitArray(), sections, 0, 3, Qt::Vertical).isEmpty());
+}
+
+QSharedPointer<AbstractViewConfiguration> TestSearch::viewConfiguration() const
+{
+    QSharedPointer<AbstractModelInstance> modelInstance(new EmptyModelInstance);
+    return QSharedPointer<AbstractViewConfiguration>(
+                ViewConfigurationProvider::configuration(ViewHelper::ViewDataType::BP_Overview,
+                                                         modelInstance));
+}
+
+QTEST_GUILESS_MAIN(TestSearch)
+
+#include "tst_testsearch.moc"
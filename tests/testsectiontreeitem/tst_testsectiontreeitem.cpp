@@ -63,12 +63,26 @@ void TestSectionTreeItem::test_setTypeText()
     QCOMPARE(item.type(), ViewHelper::ViewDataType::BP_Count);
     item.setType(ViewHelper::BPAverage);
     QCOMPARE(item.type(), ViewHelper::ViewDataType::BP_Average);
+    item.setType(ViewHelper::BPSparsity);
+    QCOMPARE(item.type(), ViewHelper::ViewDataType::BP_Sparsity);
     item.setType(ViewHelper::Postopt);
     QCOMPARE(item.type(), ViewHelper::ViewDataType::Postopt);
+    item.setType(ViewHelper::ScalingAdvisor);
+    QCOMPARE(item.type(), ViewHelper::ViewDataType::ScalingAdvisor);
+    item.setType(ViewHelper::Histogram);
+    QCOMPARE(item.type(), ViewHelper::ViewDataType::Histogram);
+    item.setType(ViewHelper::Diagnostics);
+    QCOMPARE(item.type(), ViewHelper::ViewDataType::Diagnostics);
+    item.setType(ViewHelper::Components);
+    QCOMPARE(item.type(), ViewHelper::ViewDataType::Components);
+    item.setType(ViewHelper::Residuals);
+    QCOMPARE(item.type(), ViewHelper::ViewDataType::Residuals);
     item.setType(ViewHelper::SymbolView);
     QCOMPARE(item.type(), ViewHelper::ViewDataType::Symbols);
     item.setType(ViewHelper::Blockpic);
     QCOMPARE(item.type(), ViewHelper::ViewDataType::BlockpicGroup);
+    item.setType(ViewHelper::Analysis);
+    QCOMPARE(item.type(), ViewHelper::ViewDataType::AnalysisGroup);
     item.setType("lala");
     QCOMPARE(item.type(), ViewHelper::ViewDataType::Unknown);
 }
@@ -186,6 +200,18 @@ void TestSectionTreeItem::test_SectionGroupTreeItem_isGroup()
     QCOMPARE(item.isGroup(), false);
     item.setType(ViewHelper::ViewDataType::Symbols);
     QCOMPARE(item.isGroup(), false);
+    item.setType(ViewHelper::ViewDataType::ScalingAdvisor);
+    QCOMPARE(item.isGroup(), false);
+    item.setType(ViewHelper::ViewDataType::Histogram);
+    QCOMPARE(item.isGroup(), false);
+    item.setType(ViewHelper::ViewDataType::Diagnostics);
+    QCOMPARE(item.isGroup(), false);
+    item.setType(ViewHelper::ViewDataType::Components);
+    QCOMPARE(item.isGroup(), false);
+    item.setType(ViewHelper::ViewDataType::Residuals);
+    QCOMPARE(item.isGroup(), false);
+    item.setType(ViewHelper::ViewDataType::AnalysisGroup);
+    QCOMPARE(item.isGroup(), true);
     item.setType(ViewHelper::ViewDataType::BlockpicGroup);
     QCOMPARE(item.isGroup(), true);
     item.setType(ViewHelper::ViewDataType::SymbolsGroup);
@@ -0,0 +1,153 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "sparsitypyramid.h"
+#include "matrixbuilder.h"
+
+using namespace gams::studio::mii;
+
+class TestSparsityPyramid : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_SparsityPyramid();
+
+    void test_emptyAndNonlinearRows();
+};
+
+void TestSparsityPyramid::test_SparsityPyramid()
+{
+    DataMatrix empty;
+    auto pyramid0 = SparsityPyramid::build(empty, false);
+    QVERIFY(pyramid0->isEmpty());
+    QCOMPARE(pyramid0->levelCount(), 0);
+
+    // diagonal 5x5 matrix with a_ii = i+1 and one extra entry a_04 = -8
+    auto matrix = makeMatrix(5, { { { 0, 1 }, { 4, -8 } }, { { 1, 2 } }, { { 2, 3 } },
+                                  { { 3, 4 } }, { { 4, 5 } } });
+
+    auto pyramid1 = SparsityPyramid::build(matrix, false, 4);
+    QCOMPARE(pyramid1->rowCount(), 5);
+    QCOMPARE(pyramid1->columnCount(), 5);
+    QCOMPARE(pyramid1->nonZeros(), 6);
+    QCOMPARE(pyramid1->minimumAbs(), 1.0);
+    QCOMPARE(pyramid1->maximumAbs(), 8.0);
+    QCOMPARE(pyramid1->levelCount(), 2);
+    QCOMPARE(pyramid1->level(0).RowBucket, 3);
+    QCOMPARE(pyramid1->level(0).Rows, 2);
+    QCOMPARE(pyramid1->level(0).Columns, 2);
+    QCOMPARE(pyramid1->level(1).Rows, 1);
+    QCOMPARE(pyramid1->level(1).Count.at(0), quint32(6));
+    QCOMPARE(pyramid1->level(1).MaxAbs.at(0), 8.0);
+
+    quint32 count = 0;
+    double maxAbs = 0.0;
+    pyramid1->aggregate(0, 0, 2, 0, 2, count, maxAbs);
+    QCOMPARE(count, quint32(3));
+    QCOMPARE(maxAbs, 3.0);
+    pyramid1->aggregate(0, 0, 2, 3, 4, count, maxAbs);
+    QCOMPARE(count, quint32(1));
+    QCOMPARE(maxAbs, 8.0);
+    pyramid1->aggregate(0, 3, 4, 0, 2, count, maxAbs);
+    QCOMPARE(count, quint32(0));
+
+    QVERIFY(pyramid1->hasExactLevel());
+    QCOMPARE(pyramid1->levelFor(3, 3), 0);
+    QCOMPARE(pyramid1->levelFor(6, 6), 1);
+    QCOMPARE(pyramid1->levelFor(1, 1), int(SparsityPyramid::ExactLevel));
+
+    // below the base buckets the exact pattern is used
+    pyramid1->aggregate(SparsityPyramid::ExactLevel, 0, 0, 4, 4, count, maxAbs);
+    QCOMPARE(count, quint32(1));
+    QCOMPARE(maxAbs, 8.0);
+    pyramid1->aggregate(SparsityPyramid::ExactLevel, 1, 2, 0, 1, count, maxAbs);
+    QCOMPARE(count, quint32(1));
+    QCOMPARE(maxAbs, 2.0);
+    QVector<quint32> counts;
+    QVector<double> maxAbsValues;
+    // two pixels for row 0, the second column pixel spans the columns 1 to 4
+    auto maxCount = pyramid1->rasterize({ qMakePair(0, 0), qMakePair(0, 0) },
+                                        { qMakePair(0, 0), qMakePair(1, 4) },
+                                        counts, maxAbsValues);
+    QCOMPARE(maxCount, quint32(1));
+    QCOMPARE(counts, QVector<quint32>({ 1, 1, 1, 1 }));
+    QCOMPARE(maxAbsValues, QVector<double>({ 1.0, 8.0, 1.0, 8.0 }));
+
+    // the exact pattern is read from the rows, whose entries need no order
+    auto unsorted = makeMatrix(5, { { { 4, -8 }, { 0, 1 } }, { { 1, 2 } }, { { 2, 3 } },
+                                    { { 3, 4 } }, { { 4, 5 } } });
+    auto pyramid5 = SparsityPyramid::build(unsorted, false, 4);
+    maxCount = pyramid5->rasterize({ qMakePair(0, 0), qMakePair(1, 4) },
+                                   { qMakePair(0, 1), qMakePair(2, 2), qMakePair(3, 4) },
+                                   counts, maxAbsValues);
+    QCOMPARE(maxCount, quint32(2));
+    QCOMPARE(counts, QVector<quint32>({ 1, 0, 1, 1, 1, 2 }));
+    QCOMPARE(maxAbsValues, QVector<double>({ 1.0, 0.0, 8.0, 2.0, 3.0, 5.0 }));
+    pyramid5->aggregate(SparsityPyramid::ExactLevel, 0, 4, 3, 4, count, maxAbs);
+    QCOMPARE(count, quint32(3));
+    QCOMPARE(maxAbs, 8.0);
+
+    auto pyramid2 = SparsityPyramid::build(matrix, false);
+    QCOMPARE(pyramid2->level(0).RowBucket, 1);
+    QCOMPARE(pyramid2->level(0).Rows, 5);
+    QCOMPARE(pyramid2->levelCount(), 4);
+    QCOMPARE(pyramid2->level(pyramid2->levelCount()-1).Count.at(0), quint32(6));
+    QVERIFY(!pyramid2->hasExactLevel());
+    QCOMPARE(pyramid2->levelFor(0.5, 0.5), 0);
+
+    // magnitudes outside the float range
+    auto extreme = makeMatrix(1, { { { 0, 1e300 } }, { { 0, -1e-300 } } });
+    auto pyramid3 = SparsityPyramid::build(extreme, false);
+    QCOMPARE(pyramid3->level(0).MaxAbs.at(0), 1e300);
+    QCOMPARE(pyramid3->level(0).MaxAbs.at(1), 1e-300);
+    QCOMPARE(pyramid3->minimumAbs(), 1e-300);
+
+    // a narrow matrix keeps all its columns and spends the cells on rows
+    DataMatrix narrow(1000, 2, 0);
+    auto pyramid4 = SparsityPyramid::build(narrow, false, 200);
+    QCOMPARE(pyramid4->level(0).ColumnBucket, 1);
+    QCOMPARE(pyramid4->level(0).Columns, 2);
+    QCOMPARE(pyramid4->level(0).RowBucket, 10);
+    QCOMPARE(pyramid4->level(0).Rows, 100);
+}
+
+void TestSparsityPyramid::test_emptyAndNonlinearRows()
+{
+    //      x0        x1   x2
+    // e0:  2         -1
+    // e1:                        empty
+    // e2:  3 (NL: 30)     5 (NL: 50)
+    auto matrix = makeMatrix(3, { { { 0, 2 }, { 1, -1 } },
+                                  {},
+                                  { { 0, 3, true }, { 2, 5, true } } }, 1);
+    setNlValues(matrix, { {}, {}, { 30, 50 } });
+
+    auto pyramid = SparsityPyramid::build(matrix, true);
+    QCOMPARE(pyramid->nonZeros(), qint64(4));
+    QCOMPARE(pyramid->maximumAbs(), 50.0);
+    QCOMPARE(pyramid->level(0).Count.at(3), quint32(0));
+    QCOMPARE(SparsityPyramid::build(matrix, false)->maximumAbs(), 5.0);
+}
+
+QTEST_APPLESS_MAIN(TestSparsityPyramid)
+
+#include "tst_testsparsitypyramid.moc"
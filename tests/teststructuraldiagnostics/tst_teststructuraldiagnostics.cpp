@@ -0,0 +1,113 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+
+#include "structuraldiagnostics.h"
+#include "matrixbuilder.h"
+
+using namespace gams::studio::mii;
+
+class TestStructuralDiagnostics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_StructuralDiagnostics();
+
+    void test_emptyAndNonlinearRows();
+};
+
+void TestStructuralDiagnostics::test_StructuralDiagnostics()
+{
+    DataMatrix empty;
+    QVERIFY(StructuralDiagnostics::run(empty, false, QByteArray(), {}, {}).isEmpty());
+
+    //      x0   x1   x2   x3   x4
+    // e0:  1    2                   =E=
+    // e1:  3    6                   =G=  3 * e0
+    // e2:                           =E=  empty
+    // e3:            4              =L=  singleton
+    // e4:  1    1    1              =N=  free
+    // e5:       0.3       0.1       =E=
+    // x2 is fixed and x4 is empty
+    auto matrix = makeMatrix(5, { { { 0, 1 }, { 1, 2 } },
+                                  { { 0, 3 }, { 1, 6 } },
+                                  {},
+                                  { { 2, 4 } },
+                                  { { 0, 1 }, { 1, 1 }, { 2, 1 } },
+                                  { { 1, 0.3 }, { 3, 0.1 } } });
+    auto findings = StructuralDiagnostics::run(matrix, false, "EGELNE",
+                                               { 0, 0, 1, 0, 0 }, { 10, 10, 1, 10, 10 });
+    QCOMPARE(findings.size(), 6);
+    QCOMPARE(findings.at(0).Type, StructuralFinding::EmptyRow);
+    QCOMPARE(findings.at(0).Section, 2);
+    QCOMPARE(findings.at(1).Type, StructuralFinding::EmptyColumn);
+    QCOMPARE(findings.at(1).Section, 4);
+    QCOMPARE(findings.at(2).Type, StructuralFinding::SingletonRow);
+    QCOMPARE(findings.at(2).Section, 3);
+    QCOMPARE(findings.at(3).Type, StructuralFinding::FixedVariable);
+    QCOMPARE(findings.at(3).Section, 2);
+    QCOMPARE(findings.at(4).Type, StructuralFinding::FreeRow);
+    QCOMPARE(findings.at(4).Section, 4);
+    QCOMPARE(findings.at(5).Type, StructuralFinding::DuplicateRow);
+    QCOMPARE(findings.at(5).Section, 1);
+    QCOMPARE(findings.at(5).Original, 0);
+    QCOMPARE(findings.at(5).Factor, 3.0);
+    QVERIFY(findings.at(0).Entries.isEmpty());
+    QCOMPARE(findings.at(2).Entries, QVector<int>({ 2 }));
+    QCOMPARE(findings.at(3).Entries, QVector<int>({ 3, 4 }));
+    QCOMPARE(findings.at(4).Entries, QVector<int>({ 0, 1, 2 }));
+    QCOMPARE(findings.at(5).Entries, QVector<int>({ 0, 1 }));
+
+    // | 1    2   |
+    // | 0.1  0.2 |
+    auto parallel = makeMatrix(2, { { { 0, 1.0 }, { 1, 2.0 } }, { { 0, 0.1 }, { 1, 0.2 } } });
+    findings = StructuralDiagnostics::run(parallel, false, "EE", {}, {});
+    QCOMPARE(findings.size(), 2);
+    QCOMPARE(findings.at(0).Type, StructuralFinding::DuplicateRow);
+    QVERIFY(qFuzzyCompare(findings.at(0).Factor, 0.1));
+    QCOMPARE(findings.at(1).Type, StructuralFinding::DuplicateColumn);
+    QCOMPARE(findings.at(1).Section, 1);
+    QCOMPARE(findings.at(1).Factor, 2.0);
+
+    parallel.row(1)->nlFlags().set(0);
+    QVERIFY(StructuralDiagnostics::run(parallel, false, "EE", {}, {}).isEmpty());
+}
+
+void TestStructuralDiagnostics::test_emptyAndNonlinearRows()
+{
+    //      x0        x1   x2
+    // e0:  2         -1
+    // e1:                        empty
+    // e2:  3 (NL: 30)     5 (NL: 50)
+    auto matrix = makeMatrix(3, { { { 0, 2 }, { 1, -1 } },
+                                  {},
+                                  { { 0, 3, true }, { 2, 5, true } } }, 1);
+    setNlValues(matrix, { {}, {}, { 30, 50 } });
+
+    auto findings = StructuralDiagnostics::run(matrix, false, "EEE", {}, {});
+    QVERIFY(!findings.isEmpty());
+    QCOMPARE(findings.at(0).Type, StructuralFinding::EmptyRow);
+    QCOMPARE(findings.at(0).Section, 1);
+}
+
+QTEST_APPLESS_MAIN(TestStructuralDiagnostics)
+
+#include "tst_teststructuraldiagnostics.moc"
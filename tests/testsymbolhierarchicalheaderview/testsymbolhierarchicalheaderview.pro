@@ -0,0 +1,21 @@
+include(../tests.pri)
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += $$SRCPATH/mii
+
+HEADERS +=  $$SRCPATH/mii/symbolhierarchicalheaderview.h
+
+SOURCES +=  tst_testsymbolhierarchicalheaderview.cpp            \
+            $$SRCPATH/mii/abstractmodelinstance.cpp             \
+            $$SRCPATH/mii/common.cpp                            \
+            $$SRCPATH/mii/datamatrix.cpp                        \
+            $$SRCPATH/mii/numerics.cpp                          \
+            $$SRCPATH/mii/postopttreeitem.cpp                   \
+            $$SRCPATH/mii/searchindex.cpp                       \
+            $$SRCPATH/mii/sparsitypyramid.cpp                   \
+            $$SRCPATH/mii/symbol.cpp                            \
+            $$SRCPATH/mii/symbolhierarchicalheaderview.cpp
@@ -0,0 +1,126 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+#include <QAbstractTableModel>
+
+#include "abstractmodelinstance.h"
+#include "symbolhierarchicalheaderview.h"
+
+using namespace gams::studio::mii;
+
+///
+/// \brief Table model which exposes the number of connected receivers.
+///
+class ReceiverModel : public QAbstractTableModel
+{
+public:
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : 3;
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : 2;
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        Q_UNUSED(index);
+        Q_UNUSED(role);
+        return QVariant();
+    }
+
+    QVector<int> receiverCounts() const
+    {
+        return { receivers(SIGNAL(modelReset())),
+                 receivers(SIGNAL(layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint))),
+                 receivers(SIGNAL(headerDataChanged(Qt::Orientation,int,int))),
+                 receivers(SIGNAL(rowsInserted(QModelIndex,int,int))),
+                 receivers(SIGNAL(rowsRemoved(QModelIndex,int,int))),
+                 receivers(SIGNAL(columnsInserted(QModelIndex,int,int))),
+                 receivers(SIGNAL(columnsRemoved(QModelIndex,int,int))) };
+    }
+
+    void resetContents()
+    {
+        beginResetModel();
+        endResetModel();
+    }
+};
+
+class TestSymbolHierarchicalHeaderView : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_swapModel();
+    void test_resetModel();
+
+private:
+    QSharedPointer<AbstractModelInstance> mModelInstance =
+            QSharedPointer<AbstractModelInstance>(new EmptyModelInstance);
+};
+
+void TestSymbolHierarchicalHeaderView::test_swapModel()
+{
+    ReceiverModel first;
+    ReceiverModel second;
+    auto firstCounts = first.receiverCounts();
+    auto secondCounts = second.receiverCounts();
+
+    SymbolHierarchicalHeaderView header(Qt::Horizontal, mModelInstance);
+    header.setModel(&first);
+    auto connectedCounts = first.receiverCounts();
+    for (int i=0; i<connectedCounts.size(); ++i)
+        QVERIFY(connectedCounts.at(i) > firstCounts.at(i));
+
+    header.setModel(&second);
+    QCOMPARE(first.receiverCounts(), firstCounts);
+    QCOMPARE(second.receiverCounts(), connectedCounts);
+
+    // swapping back must not stack the connections
+    header.setModel(&first);
+    header.setModel(&second);
+    header.setModel(&first);
+    QCOMPARE(first.receiverCounts(), connectedCounts);
+    QCOMPARE(second.receiverCounts(), secondCounts);
+
+    header.setModel(nullptr);
+    QCOMPARE(first.receiverCounts(), firstCounts);
+}
+
+void TestSymbolHierarchicalHeaderView::test_resetModel()
+{
+    QScopedPointer<ReceiverModel> first(new ReceiverModel);
+    ReceiverModel second;
+    SymbolHierarchicalHeaderView header(Qt::Vertical, mModelInstance);
+    header.setModel(first.data());
+    header.setModel(&second);
+    first->resetContents();
+    first.reset();
+    second.resetContents();
+    QCOMPARE(header.model(), &second);
+    QCOMPARE(header.count(), 3);
+}
+
+QTEST_MAIN(TestSymbolHierarchicalHeaderView)
+
+#include "tst_testsymbolhierarchicalheaderview.moc"
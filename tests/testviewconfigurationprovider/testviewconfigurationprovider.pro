@@ -19,5 +19,15 @@ SOURCES +=  tst_testviewconfigurationprovider.cpp        \
             $$SRCPATH/mii/symbol.cpp                     \
             $$SRCPATH/mii/viewconfigurationprovider.cpp  \
             $$SRCPATH/mii/common.cpp                     \
+            $$SRCPATH/mii/coefficientsearch.cpp          \
             $$SRCPATH/mii/postopttreeitem.cpp            \
-            $$SRCPATH/mii/numerics.cpp
+            $$SRCPATH/mii/numerics.cpp                   \
+            $$SRCPATH/mii/searchindex.cpp                \
+            $$SRCPATH/mii/sparsitypyramid.cpp            \
+            $$SRCPATH/mii/scalingadvisor.cpp             \
+            $$SRCPATH/mii/loghistogram.cpp               \
+            $$SRCPATH/mii/structuraldiagnostics.cpp      \
+            $$SRCPATH/mii/componentanalysis.cpp          \
+            $$SRCPATH/mii/dualresidual.cpp               \
+            $$SRCPATH/mii/evaluationpointregistry.cpp    \
+            $$SRCPATH/mii/primalresidual.cpp
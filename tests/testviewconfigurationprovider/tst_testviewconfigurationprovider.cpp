@@ -132,6 +132,13 @@ void TestViewConfigurationProvider::test_viewConfiguration(AbstractViewConfigura
     viewConfig->resetValueFilter();
     QCOMPARE(viewConfig->currentValueFilter(), viewConfig->defaultValueFilter());
 
+    // test contribution filter
+    QCOMPARE(viewConfig->currentContributionFilter(), ContributionFilter());
+    viewConfig->currentContributionFilter().TopK = 10;
+    QVERIFY(viewConfig->currentContributionFilter() != ContributionFilter());
+    viewConfig->setCurrentContributionFilter(ContributionFilter());
+    QCOMPARE(viewConfig->currentContributionFilter(), ContributionFilter());
+
     // test attribute filters
     if (type == ViewHelper::ViewDataType::Postopt) {
         QCOMPARE(viewConfig->currentAttributeFilter().size(), AttributeHelper::attributeTextList().size());
@@ -0,0 +1,25 @@
+include(../tests.pri)
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += $$SRCPATH/mii
+
+HEADERS +=  $$SRCPATH/mii/datatilebuffer.h          \
+            $$SRCPATH/mii/dtoaformatproxymodel.h    \
+            $$SRCPATH/mii/viewportprefetcher.h
+
+SOURCES +=  tst_testviewportprefetcher.cpp          \
+            $$SRCPATH/mii/abstractmodelinstance.cpp \
+            $$SRCPATH/mii/common.cpp                \
+            $$SRCPATH/mii/datamatrix.cpp            \
+            $$SRCPATH/mii/datatilebuffer.cpp        \
+            $$SRCPATH/mii/dtoaformatproxymodel.cpp  \
+            $$SRCPATH/mii/numerics.cpp              \
+            $$SRCPATH/mii/postopttreeitem.cpp       \
+            $$SRCPATH/mii/searchindex.cpp           \
+            $$SRCPATH/mii/sparsitypyramid.cpp       \
+            $$SRCPATH/mii/symbol.cpp                \
+            $$SRCPATH/mii/viewportprefetcher.cpp
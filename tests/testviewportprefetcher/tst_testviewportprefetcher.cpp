@@ -0,0 +1,229 @@
+/**
+ * GAMS Model Instance Inspector (MII)
+ *
+ * Copyright (c) 2023-2024 GAMS Software GmbH <support@gams.com>
+ * Copyright (c) 2023-2024 GAMS Development Corp. <support@gams.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QtTest>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QSortFilterProxyModel>
+#include <QTableView>
+
+#include "datatilebuffer.h"
+#include "viewportprefetcher.h"
+
+using namespace gams::studio::mii;
+
+///
+/// \brief Base model which records the prefetch requests.
+///
+class PrefetchRecorder : public QAbstractTableModel, public AbstractTileModel
+{
+public:
+    PrefetchRecorder(int rows, int columns)
+        : mRows(rows)
+        , mColumns(columns)
+    {
+
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : mRows;
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : mColumns;
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (role == Qt::DisplayRole)
+            return index.row();
+        return QVariant();
+    }
+
+    void prefetch(const QVector<int> &rows, const QVector<int> &columns) override
+    {
+        PrefetchedRows = rows;
+        PrefetchedColumns = columns;
+        ++Requests;
+    }
+
+    DataTileBuffer* tileBuffer() override
+    {
+        return &mBuffer;
+    }
+
+    QVector<int> PrefetchedRows;
+    QVector<int> PrefetchedColumns;
+    int Requests = 0;
+
+private:
+    int mRows;
+    int mColumns;
+    DataTileBuffer mBuffer;
+};
+
+///
+/// \brief Keeps the even base rows in descending order.
+///
+class EvenRowsProxyModel : public QSortFilterProxyModel
+{
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override
+    {
+        Q_UNUSED(sourceParent);
+        return !(sourceRow % 2);
+    }
+};
+
+class TestViewportPrefetcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void test_sortedFilteredRows();
+    void test_movedColumns();
+    void test_hiddenSections();
+
+private:
+    QVector<int> baseRows(int firstVisual, int lastVisual) const;
+
+    QVector<int> baseColumns(int firstVisual, int lastVisual) const;
+
+    QScopedPointer<QTableView> mView;
+    QScopedPointer<PrefetchRecorder> mBaseModel;
+    QScopedPointer<EvenRowsProxyModel> mProxyModel;
+    ViewportPrefetcher *mPrefetcher = nullptr;
+};
+
+void TestViewportPrefetcher::init()
+{
+    mBaseModel.reset(new PrefetchRecorder(1000, 200));
+    mProxyModel.reset(new EvenRowsProxyModel);
+    mProxyModel->setSourceModel(mBaseModel.data());
+    mProxyModel->sort(0, Qt::DescendingOrder);
+    mView.reset(new QTableView);
+    mView->setModel(mProxyModel.data());
+    mView->resize(400, 300);
+    mView->show();
+    QVERIFY(QTest::qWaitForWindowExposed(mView.data()));
+    mPrefetcher = new ViewportPrefetcher(mView.data());
+    mPrefetcher->setModel(mProxyModel.data());
+}
+
+void TestViewportPrefetcher::cleanup()
+{
+    mView.reset();
+    mProxyModel.reset();
+    mBaseModel.reset();
+}
+
+void TestViewportPrefetcher::test_sortedFilteredRows()
+{
+    QCOMPARE(mProxyModel->rowCount(), 500);
+    mView->verticalScrollBar()->setValue(1);
+    QCOMPARE(mBaseModel->Requests, 1);
+
+    auto header = mView->verticalHeader();
+    int first = header->visualIndexAt(0);
+    int last = header->visualIndexAt(mView->viewport()->height() - 1);
+    int page = last - first + 1;
+    QVector<int> expected;
+    for (int v=last+1; v<=last+page; ++v)
+        expected << 998 - 2*v;
+    QCOMPARE(mBaseModel->PrefetchedRows, expected);
+    for (auto row : std::as_const(mBaseModel->PrefetchedRows))
+        QVERIFY(!(row % 2));
+    QCOMPARE(mBaseModel->PrefetchedColumns,
+             baseColumns(mView->horizontalHeader()->visualIndexAt(0),
+                         mView->horizontalHeader()->visualIndexAt(mView->viewport()->width() - 1)));
+
+    mView->verticalScrollBar()->setValue(0);
+    QCOMPARE(mBaseModel->Requests, 1);
+}
+
+void TestViewportPrefetcher::test_movedColumns()
+{
+    auto header = mView->horizontalHeader();
+    header->moveSection(150, 0);
+    header->moveSection(10, 1);
+    mView->horizontalScrollBar()->setValue(1);
+    QCOMPARE(mBaseModel->Requests, 1);
+
+    int first = header->visualIndexAt(0);
+    int last = header->visualIndexAt(mView->viewport()->width() - 1);
+    int page = last - first + 1;
+    auto expected = baseColumns(last + 1, last + page);
+    QCOMPARE(mBaseModel->PrefetchedColumns, expected);
+    QVERIFY(!mBaseModel->PrefetchedColumns.contains(150));
+    QVERIFY(!mBaseModel->PrefetchedColumns.contains(10));
+
+    mView->horizontalScrollBar()->setValue(0);
+    QCOMPARE(mBaseModel->Requests, 1);
+}
+
+void TestViewportPrefetcher::test_hiddenSections()
+{
+    auto header = mView->verticalHeader();
+    int last = header->visualIndexAt(mView->viewport()->height() - 1);
+    int hidden = 2*last;
+    mView->setRowHidden(hidden, true);
+    mView->verticalScrollBar()->setValue(1);
+    QCOMPARE(mBaseModel->Requests, 1);
+
+    int first = header->visualIndexAt(0);
+    last = header->visualIndexAt(mView->viewport()->height() - 1);
+    int page = last - first + 1;
+    QVERIFY(hidden > last && hidden <= last + page);
+    QCOMPARE(mBaseModel->PrefetchedRows, baseRows(last + 1, last + page));
+    QCOMPARE(mBaseModel->PrefetchedRows.size(), page - 1);
+    QVERIFY(!mBaseModel->PrefetchedRows.contains(998 - 2*hidden));
+}
+
+QVector<int> TestViewportPrefetcher::baseRows(int firstVisual, int lastVisual) const
+{
+    QVector<int> rows;
+    auto header = mView->verticalHeader();
+    for (int v=firstVisual; v<=lastVisual && v<header->count(); ++v) {
+        int logical = header->logicalIndex(v);
+        if (!header->isSectionHidden(logical))
+            rows << mProxyModel->mapToSource(mProxyModel->index(logical, 0)).row();
+    }
+    return rows;
+}
+
+QVector<int> TestViewportPrefetcher::baseColumns(int firstVisual, int lastVisual) const
+{
+    QVector<int> columns;
+    auto header = mView->horizontalHeader();
+    for (int v=qMax(0, firstVisual); v<=lastVisual && v<header->count(); ++v) {
+        int logical = header->logicalIndex(v);
+        if (!header->isSectionHidden(logical))
+            columns << mProxyModel->mapToSource(mProxyModel->index(0, logical)).column();
+    }
+    return columns;
+}
+
+QTEST_MAIN(TestViewportPrefetcher)
+
+#include "tst_testviewportprefetcher.moc"